@@ -182,6 +182,17 @@ void BindNodeVisitor::Visit(parser::CopyStatement *node) {
 void BindNodeVisitor::Visit(parser::CreateFunctionStatement *) {}
 void BindNodeVisitor::Visit(parser::CreateStatement *node) {
   node->TryBindDatabaseName(default_database_name_);
+
+  // The predicate of a partial index refers to the indexed table
+  if (node->type == parser::CreateStatement::kIndex &&
+      node->index_predicate != nullptr) {
+    context_ = std::make_shared<BinderContext>(nullptr);
+    context_->AddRegularTable(node->GetDatabaseName(), node->GetSchemaName(),
+                              node->GetTableName(), node->GetTableName(), txn_);
+    node->index_predicate->Accept(this);
+    node->index_predicate->DeriveDepth();
+    context_ = nullptr;
+  }
 }
 void BindNodeVisitor::Visit(parser::InsertStatement *node) {
   node->TryBindDatabaseName(default_database_name_);
@@ -618,6 +618,10 @@ ResultType Catalog::CreatePrimaryIndex(concurrency::TransactionContext *txn,
  * @param   index_name       name of the table to add index on
  * @param   unique_keys      index supports duplicate key or not
  * @param   index_type       the type of index(default value is BWTREE)
+ * @param   include_attrs    non-key columns covered by the index (these are
+ * not recorded in pg_index)
+ * @param   predicate        only tuples satisfying it are indexed, if given
+ * (this is not recorded in pg_index either)
  * @param   txn              TransactionContext
  * @param   is_catalog       index is built on catalog table or not(useful in
  * catalog table Initialization)
@@ -630,7 +634,9 @@ ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
                                 const std::string &index_name,
                                 const std::vector<oid_t> &key_attrs,
                                 bool unique_keys,
-                                IndexType index_type) {
+                                IndexType index_type,
+                                const std::vector<oid_t> &include_attrs,
+                                const expression::AbstractExpression *predicate) {
   if (txn == nullptr)
     throw CatalogException("Do not have transaction to create database " +
         index_name);
@@ -667,7 +673,9 @@ ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
                                    key_attrs,
                                    unique_keys,
                                    index_type,
-                                   index_constraint);
+                                   index_constraint,
+                                   include_attrs,
+                                   predicate);
 
   return success;
 }
@@ -681,7 +689,9 @@ ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
                                 const std::vector<oid_t> &key_attrs,
                                 bool unique_keys,
                                 IndexType index_type,
-                                IndexConstraintType index_constraint) {
+                                IndexConstraintType index_constraint,
+                                const std::vector<oid_t> &include_attrs,
+                                const expression::AbstractExpression *predicate) {
   if (txn == nullptr)
     throw CatalogException("Do not have transaction to create index " +
         index_name);
@@ -719,7 +729,8 @@ ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
   // Set index metadata
   auto index_metadata = new index::IndexMetadata(
       index_name, index_oid, table_oid, database_oid, index_type,
-      index_constraint, schema, key_schema, key_attrs, unique_keys);
+      index_constraint, schema, key_schema, key_attrs, unique_keys,
+      include_attrs, predicate);
 
   // Add index to table
   std::shared_ptr<index::Index> key_index(
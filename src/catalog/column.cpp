@@ -15,6 +15,7 @@
 #include <sstream>
 
 #include "common/internal_types.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace catalog {
@@ -25,7 +26,7 @@ void Column::SetLength(size_t column_length) {
     fixed_length_ = column_length;
     variable_length_ = 0;
   } else {
-    fixed_length_ = sizeof(uintptr_t);
+    fixed_length_ = sizeof(type::VarlenSlot);
     variable_length_ = column_length;
   }
 }
@@ -29,7 +29,12 @@ TableMetricsCatalog::TableMetricsCatalog(concurrency::TransactionContext *txn,
     "updates        INT NOT NULL, "
     "deletes        INT NOT NULL, "
     "inserts        INT NOT NULL, "
-    "time_stamp     INT NOT NULL);") {
+    "time_stamp     INT NOT NULL, "
+    "tile_bytes     BIGINT NOT NULL, "
+    "header_bytes   BIGINT NOT NULL, "
+    "varlen_bytes   BIGINT NOT NULL, "
+    "indirection_bytes BIGINT NOT NULL, "
+    "version_bytes  BIGINT NOT NULL);") {
   // Add secondary index here if necessary
 }
 
@@ -42,6 +47,7 @@ bool TableMetricsCatalog::InsertTableMetrics(concurrency::TransactionContext *tx
                                              int64_t deletes,
                                              int64_t inserts,
                                              int64_t time_stamp,
+                                             const stats::MemoryMetric &memory,
                                              type::AbstractPool *pool) {
   std::unique_ptr<storage::Tuple> tuple(
       new storage::Tuple(catalog_table_->GetSchema(), true));
@@ -52,6 +58,11 @@ bool TableMetricsCatalog::InsertTableMetrics(concurrency::TransactionContext *tx
   auto val4 = type::ValueFactory::GetIntegerValue(deletes);
   auto val5 = type::ValueFactory::GetIntegerValue(inserts);
   auto val6 = type::ValueFactory::GetIntegerValue(time_stamp);
+  auto val7 = type::ValueFactory::GetBigIntValue(memory.GetTileBytes());
+  auto val8 = type::ValueFactory::GetBigIntValue(memory.GetHeaderBytes());
+  auto val9 = type::ValueFactory::GetBigIntValue(memory.GetVarlenBytes());
+  auto val10 = type::ValueFactory::GetBigIntValue(memory.GetIndirectionBytes());
+  auto val11 = type::ValueFactory::GetBigIntValue(memory.GetVersionBytes());
 
   tuple->SetValue(ColumnId::TABLE_OID, val1, pool);
   tuple->SetValue(ColumnId::READS, val2, pool);
@@ -59,6 +70,11 @@ bool TableMetricsCatalog::InsertTableMetrics(concurrency::TransactionContext *tx
   tuple->SetValue(ColumnId::DELETES, val4, pool);
   tuple->SetValue(ColumnId::INSERTS, val5, pool);
   tuple->SetValue(ColumnId::TIME_STAMP, val6, pool);
+  tuple->SetValue(ColumnId::TILE_BYTES, val7, pool);
+  tuple->SetValue(ColumnId::HEADER_BYTES, val8, pool);
+  tuple->SetValue(ColumnId::VARLEN_BYTES, val9, pool);
+  tuple->SetValue(ColumnId::INDIRECTION_BYTES, val10, pool);
+  tuple->SetValue(ColumnId::VERSION_BYTES, val11, pool);
 
   // Insert the tuple
   return InsertTuple(txn, std::move(tuple));
@@ -12,7 +12,13 @@
 
 #include "codegen/code_context.h"
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "llvm/Config/llvm-config.h"
 #include "llvm/ExecutionEngine/MCJIT.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Verifier.h"
@@ -26,6 +32,8 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "settings/settings_manager.h"
+#include "util/hash_util.h"
+#include "util/string_util.h"
 
 namespace peloton {
 namespace codegen {
@@ -43,10 +51,11 @@ namespace {
 
 class PelotonMemoryManager : public llvm::SectionMemoryManager {
  public:
-  explicit PelotonMemoryManager(
+  PelotonMemoryManager(
       const std::unordered_map<std::string,
-                               std::pair<llvm::Function *, CodeContext::FuncPtr>> &builtins)
-      : builtins_(builtins) {}
+                               std::pair<llvm::Function *, CodeContext::FuncPtr>> &builtins,
+      const std::unordered_map<std::string, void *> &external_pointers)
+      : builtins_(builtins), external_pointers_(external_pointers) {}
 
 #if LLVM_VERSION_GE(4, 0)
 #define RET_TYPE llvm::JITSymbol
@@ -86,6 +95,16 @@ class PelotonMemoryManager : public llvm::SectionMemoryManager {
       }
     }
 
+    // Check for an external pointer, with or without the leading '_'
+    auto pointer_iter = external_pointers_.find(name);
+    if (pointer_iter == external_pointers_.end() && !name.empty() &&
+        name[0] == '_') {
+      pointer_iter = external_pointers_.find(name.substr(1));
+    }
+    if (pointer_iter != external_pointers_.end()) {
+      return pointer_iter->second;
+    }
+
     // Nothing
     return nullptr;
   }
@@ -95,8 +114,90 @@ class PelotonMemoryManager : public llvm::SectionMemoryManager {
   const std::unordered_map<std::string,
                            std::pair<llvm::Function *, CodeContext::FuncPtr>>
       &builtins_;
+
+  // The external pointers of the code context
+  const std::unordered_map<std::string, void *> &external_pointers_;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Persistent Object Cache
+///
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An object cache that keeps the compiled code of one module in a file. The
+ * file holds the description of the code it was compiled from (target and
+ * unoptimized IR), followed by the object code. The code is only used if the
+ * description matches exactly, so that colliding file names are harmless.
+ */
+class PersistentObjectCache : public llvm::ObjectCache {
+ public:
+  PersistentObjectCache(std::string path, std::string description)
+      : path_(std::move(path)), description_(std::move(description)) {}
+
+  // Read the cache file. Returns true if it holds code for our description.
+  bool Load() {
+    std::ifstream in{path_, std::ios::binary};
+    uint64_t description_size;
+    if (!in.read(reinterpret_cast<char *>(&description_size),
+                 sizeof(description_size)) ||
+        description_size != description_.size()) {
+      return false;
+    }
+    std::string description(description_size, '\0');
+    if (!in.read(&description[0], description_size) ||
+        description != description_) {
+      return false;
+    }
+    std::ostringstream object;
+    object << in.rdbuf();
+    object_ = object.str();
+    return !object_.empty();
+  }
+
+  void notifyObjectCompiled(const llvm::Module *,
+                            llvm::MemoryBufferRef object) override {
+    // Write to a temporary file first, so that concurrent readers never see
+    // a partial entry
+    std::string tmp_path = path_ + ".tmp" + std::to_string(kTmpCounter++);
+    {
+      std::ofstream out{tmp_path, std::ios::binary | std::ios::trunc};
+      uint64_t description_size = description_.size();
+      out.write(reinterpret_cast<const char *>(&description_size),
+                sizeof(description_size));
+      out.write(description_.data(), description_size);
+      out.write(object.getBufferStart(), object.getBufferSize());
+      if (!out) {
+        LOG_DEBUG("Could not write object cache entry '%s'", path_.c_str());
+        std::remove(tmp_path.c_str());
+        return;
+      }
+    }
+    if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+      std::remove(tmp_path.c_str());
+    }
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *) override {
+    if (object_.empty()) {
+      return nullptr;
+    }
+    LOG_TRACE("Loading cached object code from '%s'", path_.c_str());
+    return llvm::MemoryBuffer::getMemBufferCopy(object_);
+  }
+
+ private:
+  // Makes temporary file names unique within this process
+  static std::atomic<uint64_t> kTmpCounter;
+
+  std::string path_;
+  std::string description_;
+  std::string object_;
+};
+
+std::atomic<uint64_t> PersistentObjectCache::kTmpCounter{0};
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// Instruction Count Pass
@@ -177,6 +278,7 @@ CodeContext::CodeContext()
       func_(nullptr),
       udf_func_ptr_(nullptr),
       pass_manager_(nullptr),
+      object_cache_(nullptr),
       engine_(nullptr),
       is_verified_(false) {
   // Initialize JIT stuff
@@ -201,7 +303,8 @@ CodeContext::CodeContext()
   engine_.reset(
       llvm::EngineBuilder(std::move(m))
           .setEngineKind(llvm::EngineKind::JIT)
-          .setMCJITMemoryManager(llvm::make_unique<PelotonMemoryManager>(builtins_))
+          .setMCJITMemoryManager(llvm::make_unique<PelotonMemoryManager>(
+              builtins_, external_pointers_))
           .setMCPU(llvm::sys::getHostCPUName())
           .setErrorStr(&err_str_)
           .create());
@@ -277,6 +380,28 @@ std::pair<llvm::Function *, CodeContext::FuncPtr> CodeContext::LookupBuiltin(con
   return (iter == builtins_.end() ? std::make_pair<llvm::Function *, CodeContext::FuncPtr>(nullptr, nullptr) : iter->second);
 }
 
+llvm::GlobalVariable *CodeContext::RegisterExternalPointer(const void *ptr) {
+  auto iter = pointer_globals_.find(ptr);
+  if (iter != pointer_globals_.end()) {
+    return iter->second;
+  }
+
+  // Globals are numbered in the order they are registered, so that the same
+  // plan gets the same names in every context
+  std::string name = "_ptr_" + std::to_string(pointer_globals_.size());
+  auto *global_var = new llvm::GlobalVariable(
+      GetModule(), int8_type_, true, llvm::GlobalValue::ExternalLinkage,
+      nullptr, name);
+  pointer_globals_[ptr] = global_var;
+  external_pointers_[name] = const_cast<void *>(ptr);
+  return global_var;
+}
+
+void *CodeContext::LookupExternalPointer(const std::string &name) const {
+  auto iter = external_pointers_.find(name);
+  return iter == external_pointers_.end() ? nullptr : iter->second;
+}
+
 /// Verify all the functions that were created in this context
 void CodeContext::Verify() {
   // Verify the module is okay
@@ -306,6 +431,51 @@ void CodeContext::Optimize() {
   pass_manager_->doFinalization();
 }
 
+bool CodeContext::FindCachedObject() {
+  const std::string directory = settings::SettingsManager::GetString(
+      settings::SettingId::codegen_object_cache_directory);
+  if (directory.empty()) {
+    return false;
+  }
+
+  // The code compiled from the IR depends on the target it is compiled for.
+  // The IR itself captures the plan, the schema and the layout of all state.
+  NormalizeNames();
+  auto *target_machine = engine_->getTargetMachine();
+  std::string description = StringUtil::Format(
+      "LLVM %s, %s, %s, %s\n", LLVM_VERSION_STRING,
+      target_machine->getTargetTriple().str().c_str(),
+      target_machine->getTargetCPU().str().c_str(),
+      target_machine->getTargetFeatureString().str().c_str());
+  description += GetIR();
+
+  hash_t hash = HashUtil::HashBytes(description.data(), description.size());
+  std::string path =
+      StringUtil::Format("%s/%016zx.o", directory.c_str(), hash);
+
+  std::unique_ptr<PersistentObjectCache> object_cache{
+      new PersistentObjectCache(path, std::move(description))};
+  bool found = object_cache->Load();
+  engine_->setObjectCache(object_cache.get());
+  object_cache_ = std::move(object_cache);
+  return found;
+}
+
+void CodeContext::NormalizeNames() {
+  module_->setModuleIdentifier("_plan");
+#if LLVM_VERSION_GE(3, 9)
+  module_->setSourceFileName("_plan");
+#endif
+
+  const std::string prefix = "_" + std::to_string(id_) + "_";
+  for (auto &func_iter : functions_) {
+    llvm::Function *func = func_iter.first;
+    if (!func->isDeclaration() && func->getName().startswith(prefix)) {
+      func->setName("_" + func->getName().substr(prefix.size()).str());
+    }
+  }
+}
+
 /// JIT compile all the functions that were created in this context
 void CodeContext::Compile() {
   // make sure the code is verified
@@ -93,6 +93,15 @@ llvm::Constant *CodeGen::NullPtr(llvm::PointerType *type) const {
   return llvm::ConstantPointerNull::get(type);
 }
 
+llvm::Constant *CodeGen::ConstPointer(const void *ptr,
+                                      llvm::PointerType *type) const {
+  if (ptr == nullptr) {
+    return NullPtr(type);
+  }
+  auto *global_var = code_context_.RegisterExternalPointer(ptr);
+  return llvm::ConstantExpr::getBitCast(global_var, type);
+}
+
 llvm::Value *CodeGen::AllocateVariable(llvm::Type *type,
                                        const std::string &name) {
   // To allocate a variable, a function must be under construction
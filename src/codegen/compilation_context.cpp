@@ -92,18 +92,22 @@ void CompilationContext::GeneratePlan(Query &query,
   if (stats != nullptr) {
     timer.Stop();
     stats->ir_gen_ms = timer.GetDuration();
+    for (const auto *pipeline : pipelines_) {
+      stats->num_parallel_pipelines += pipeline->IsParallel() ? 1 : 0;
+    }
     timer.Reset();
     timer.Start();
   }
 
   // Next, we prepare the query statement with the functions we've generated
   Query::LLVMFunctions funcs = {init, plan, tear_down};
-  query.Prepare(funcs);
+  bool object_cache_hit = query.Prepare(funcs);
 
   // We're done
   if (stats != nullptr) {
     timer.Stop();
     stats->optimize_ms = timer.GetDuration();
+    stats->object_cache_hit = object_cache_hit;
   }
 }
 
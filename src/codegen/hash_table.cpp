@@ -174,11 +174,27 @@ void HashTable::MergeLazyUnfinished(CodeGen &codegen, llvm::Value *global_ht,
   codegen.Call(HashTableProxy::MergeLazyUnfinished, {global_ht, local_ht});
 }
 
+void HashTable::PartitionLazyUnfinished(CodeGen &codegen, llvm::Value *ht_ptr,
+                                        llvm::Value *partitions,
+                                        llvm::Value *num_partitions) const {
+  codegen.Call(HashTableProxy::PartitionLazyUnfinished,
+               {ht_ptr, partitions, num_partitions});
+}
+
 void HashTable::Iterate(CodeGen &codegen, llvm::Value *ht_ptr,
                         IterateCallback &callback) const {
+  IterateStrided(codegen, ht_ptr, codegen.Const64(0), codegen.Const64(1),
+                 callback);
+}
+
+void HashTable::IterateStrided(CodeGen &codegen, llvm::Value *ht_ptr,
+                               llvm::Value *start_bucket, llvm::Value *stride,
+                               IterateCallback &callback) const {
   llvm::Value *buckets_ptr = codegen.Load(HashTableProxy::directory, ht_ptr);
   llvm::Value *num_buckets = codegen.Load(HashTableProxy::size, ht_ptr);
-  llvm::Value *bucket_num = codegen.Const64(0);
+  llvm::Value *bucket_num =
+      codegen->CreateZExtOrBitCast(start_bucket, codegen.Int64Type());
+  stride = codegen->CreateZExtOrBitCast(stride, codegen.Int64Type());
   llvm::Value *bucket_cond = codegen->CreateICmpULT(bucket_num, num_buckets);
 
   lang::Loop bucket_loop{codegen, bucket_cond, {{"bucketNum", bucket_num}}};
@@ -186,33 +202,45 @@ void HashTable::Iterate(CodeGen &codegen, llvm::Value *ht_ptr,
     bucket_num = bucket_loop.GetLoopVar(0);
     llvm::Value *bucket =
         codegen->CreateLoad(codegen->CreateGEP(buckets_ptr, bucket_num));
-    llvm::Value *null_bucket =
-        codegen.NullPtr(llvm::cast<llvm::PointerType>(bucket->getType()));
+    IterateChain(codegen, bucket, callback);
 
-    lang::Loop chain_loop{codegen,
-                          codegen->CreateICmpNE(bucket, null_bucket),
-                          {{"entry", bucket}}};
-    {
-      llvm::Type *ht_entry_type = EntryProxy::GetType(codegen);
-      llvm::Value *entry = chain_loop.GetLoopVar(0);
-      llvm::Value *entry_data =
-          codegen->CreateConstInBoundsGEP2_32(ht_entry_type, entry, 1, 0);
-
-      // Pull out keys and invoke callback
-      std::vector<codegen::Value> keys;
-      auto *data_area_ptr = key_storage_.LoadValues(codegen, entry_data, keys);
-      callback.ProcessEntry(codegen, keys, data_area_ptr);
-
-      entry = codegen.Load(EntryProxy::next, entry);
-      chain_loop.LoopEnd(codegen->CreateICmpNE(entry, null_bucket), {entry});
-    }
     // Move to next bucket
-    bucket_num = codegen->CreateAdd(bucket_num, codegen.Const64(1));
+    bucket_num = codegen->CreateAdd(bucket_num, stride);
     bucket_loop.LoopEnd(codegen->CreateICmpULT(bucket_num, num_buckets),
                         {bucket_num});
   }
 }
 
+void HashTable::IterateLazy(CodeGen &codegen, llvm::Value *ht_ptr,
+                            IterateCallback &callback) const {
+  // Lazily inserted entries form a list whose head is in the first bucket
+  llvm::Value *buckets_ptr = codegen.Load(HashTableProxy::directory, ht_ptr);
+  IterateChain(codegen, codegen->CreateLoad(buckets_ptr), callback);
+}
+
+void HashTable::IterateChain(CodeGen &codegen, llvm::Value *head,
+                             IterateCallback &callback) const {
+  llvm::Value *null_entry =
+      codegen.NullPtr(llvm::cast<llvm::PointerType>(head->getType()));
+
+  lang::Loop chain_loop{codegen, codegen->CreateICmpNE(head, null_entry),
+                        {{"entry", head}}};
+  {
+    llvm::Type *ht_entry_type = EntryProxy::GetType(codegen);
+    llvm::Value *entry = chain_loop.GetLoopVar(0);
+    llvm::Value *entry_data =
+        codegen->CreateConstInBoundsGEP2_32(ht_entry_type, entry, 1, 0);
+
+    // Pull out keys and invoke callback
+    std::vector<codegen::Value> keys;
+    auto *data_area_ptr = key_storage_.LoadValues(codegen, entry_data, keys);
+    callback.ProcessEntry(codegen, keys, data_area_ptr);
+
+    entry = codegen.Load(EntryProxy::next, entry);
+    chain_loop.LoopEnd(codegen->CreateICmpNE(entry, null_entry), {entry});
+  }
+}
+
 void HashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
                         const std::vector<codegen::Value> &key,
                         IterateCallback &callback) const {
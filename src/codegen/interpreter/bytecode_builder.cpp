@@ -302,6 +302,15 @@ value_t BytecodeBuilder::GetConstantValue(
       }
 
       case llvm::Type::PointerTyID: {
+        // Pointers to objects of this process stand behind external globals
+        if (auto *global_var = llvm::dyn_cast<llvm::GlobalVariable>(
+                constant->stripPointerCasts())) {
+          if (auto *ptr = code_context_.LookupExternalPointer(
+                  global_var->getName().str())) {
+            return reinterpret_cast<value_t>(ptr);
+          }
+        }
+
         if (constant->getNumOperands() > 0) {
           if (auto *constant_int =
                   llvm::dyn_cast<llvm::ConstantInt>(constant->getOperand(0))) {
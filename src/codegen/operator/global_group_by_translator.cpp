@@ -23,7 +23,9 @@ GlobalGroupByTranslator::GlobalGroupByTranslator(
     const planner::AggregatePlan &plan, CompilationContext &context,
     Pipeline &pipeline)
     : OperatorTranslator(plan, context, pipeline),
-      child_pipeline_(this, Pipeline::Parallelism::Serial),
+      child_pipeline_(this, Aggregation::IsMergeable(plan.GetUniqueAggTerms())
+                                ? Pipeline::Parallelism::Flexible
+                                : Pipeline::Parallelism::Serial),
       aggregation_(context.GetQueryState()) {
   LOG_DEBUG("Constructing GlobalGroupByTranslator ...");
 
@@ -64,6 +66,38 @@ void GlobalGroupByTranslator::InitializeQueryState() {
   aggregation_.InitializeQueryState(GetCodeGen());
 }
 
+void GlobalGroupByTranslator::RegisterPipelineState(
+    PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    local_buffer_id_ = pipeline_ctx.RegisterState(
+        "localBuf", aggregation_.GetAggregateStorage().GetStorageType());
+  }
+}
+
+void GlobalGroupByTranslator::InitializePipelineState(
+    PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    CodeGen &codegen = GetCodeGen();
+    aggregation_.CreateInitialGlobalValues(
+        codegen, pipeline_ctx.LoadStatePtr(codegen, local_buffer_id_));
+  }
+}
+
+void GlobalGroupByTranslator::FinishPipeline(PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    // Merge the partial aggregates of each thread into the global buffer. There
+    // is a single group, so this is cheap enough to do serially.
+    CodeGen &codegen = GetCodeGen();
+    PipelineContext::LoopOverStates loop_states{pipeline_ctx};
+    loop_states.Do([this, &pipeline_ctx, &codegen](llvm::Value *thread_state) {
+      PipelineContext::SetState state_access{pipeline_ctx, thread_state};
+      aggregation_.MergeValues(
+          codegen, LoadStatePtr(mat_buffer_id_),
+          pipeline_ctx.LoadStatePtr(codegen, local_buffer_id_));
+    });
+  }
+}
+
 void GlobalGroupByTranslator::Produce() const {
   // Initialize aggregation for global aggregation
   aggregation_.CreateInitialGlobalValues(GetCodeGen(),
@@ -109,8 +143,10 @@ void GlobalGroupByTranslator::Produce() const {
   GetPipeline().RunSerial(producer);
 }
 
-void GlobalGroupByTranslator::Consume(ConsumerContext &,
+void GlobalGroupByTranslator::Consume(ConsumerContext &ctx,
                                       RowBatch::Row &row) const {
+  CodeGen &codegen = GetCodeGen();
+
   // Get the updates to advance the aggregates
   const auto &plan = GetPlanAs<planner::AggregatePlan>();
 
@@ -119,13 +155,22 @@ void GlobalGroupByTranslator::Consume(ConsumerContext &,
   for (uint32_t i = 0; i < aggregates.size(); i++) {
     const auto &agg_term = aggregates[i];
     if (agg_term.expression != nullptr) {
-      vals[i] = row.DeriveValue(GetCodeGen(), *agg_term.expression);
+      vals[i] = row.DeriveValue(codegen, *agg_term.expression);
     }
   }
 
+  // Parallel pipelines aggregate into a thread-local buffer
+  llvm::Value *buffer_ptr = nullptr;
+  if (ctx.GetPipeline().IsParallel()) {
+    buffer_ptr =
+        ctx.GetPipelineContext()->LoadStatePtr(codegen, local_buffer_id_);
+  } else {
+    buffer_ptr = LoadStatePtr(mat_buffer_id_);
+  }
+
   // Just advance each of the aggregates in the buffer with the provided
   // new values
-  aggregation_.AdvanceValues(GetCodeGen(), LoadStatePtr(mat_buffer_id_), vals);
+  aggregation_.AdvanceValues(codegen, buffer_ptr, vals);
 }
 
 // Cleanup by destroying the aggregation hash-table
@@ -14,6 +14,7 @@
 
 #include "codegen/compilation_context.h"
 #include "codegen/lang/if.h"
+#include "codegen/proxy/executor_context_proxy.h"
 #include "codegen/proxy/oa_hash_table_proxy.h"
 #include "codegen/operator/projection_translator.h"
 #include "codegen/lang/vectorized_loop.h"
@@ -24,6 +25,8 @@ namespace codegen {
 
 std::atomic<bool> HashGroupByTranslator::kUsePrefetch{false};
 
+uint32_t HashGroupByTranslator::kNumMergePartitions = 16;
+
 //===----------------------------------------------------------------------===//
 // HASH GROUP BY TRANSLATOR
 //===----------------------------------------------------------------------===//
@@ -33,7 +36,10 @@ HashGroupByTranslator::HashGroupByTranslator(
     const planner::AggregatePlan &group_by, CompilationContext &context,
     Pipeline &pipeline)
     : OperatorTranslator(group_by, context, pipeline),
-      child_pipeline_(this, Pipeline::Parallelism::Serial),
+      child_pipeline_(this,
+                      Aggregation::IsMergeable(group_by.GetUniqueAggTerms())
+                          ? Pipeline::Parallelism::Flexible
+                          : Pipeline::Parallelism::Serial),
       aggregation_(context.GetQueryState()) {
   // If we should be prefetching into the hash-table, install a boundary in the
   // pipeline at the input into this translator to ensure it receives a vector
@@ -42,15 +48,21 @@ HashGroupByTranslator::HashGroupByTranslator(
     child_pipeline_.InstallStageBoundary(this);
   }
 
-  // Register the hash-table instance in the runtime state
-  CodeGen &codegen = GetCodeGen();
-  QueryState &query_state = context.GetQueryState();
-  hash_table_id_ =
-      query_state.RegisterState("groupBy", OAHashTableProxy::GetType(codegen));
-
   // Prepare the input operator to this group by
   context.Prepare(*group_by.GetChild(0), child_pipeline_);
 
+  // Register the hash-table instance in the runtime state. If the child
+  // pipeline runs in parallel, each thread pre-aggregates into a local table.
+  // Local tables are then merged into a set of partitions, in parallel.
+  CodeGen &codegen = GetCodeGen();
+  QueryState &query_state = context.GetQueryState();
+  llvm::Type *hash_table_type = OAHashTableProxy::GetType(codegen);
+  if (child_pipeline_.IsParallel()) {
+    hash_table_type =
+        llvm::ArrayType::get(hash_table_type, kNumMergePartitions);
+  }
+  hash_table_id_ = query_state.RegisterState("groupBy", hash_table_type);
+
   // Prepare the predicate if one exists
   if (group_by.GetPredicate() != nullptr) {
     context.Prepare(*group_by.GetPredicate());
@@ -89,8 +101,84 @@ HashGroupByTranslator::HashGroupByTranslator(
 
 // Initialize the hash table instance
 void HashGroupByTranslator::InitializeQueryState() {
-  hash_table_.Init(GetCodeGen(), LoadStatePtr(hash_table_id_));
-  aggregation_.InitializeQueryState(GetCodeGen());
+  CodeGen &codegen = GetCodeGen();
+  if (child_pipeline_.IsParallel()) {
+    ForEachPartition([this, &codegen](llvm::Value *partition_ht) {
+      hash_table_.Init(codegen, partition_ht);
+    });
+  } else {
+    hash_table_.Init(codegen, LoadStatePtr(hash_table_id_));
+  }
+  aggregation_.InitializeQueryState(codegen);
+}
+
+void HashGroupByTranslator::RegisterPipelineState(
+    PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    local_hash_table_id_ = pipeline_ctx.RegisterState(
+        "localGroupBy", OAHashTableProxy::GetType(GetCodeGen()));
+  }
+}
+
+void HashGroupByTranslator::InitializePipelineState(
+    PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    CodeGen &codegen = GetCodeGen();
+    hash_table_.Init(codegen,
+                     pipeline_ctx.LoadStatePtr(codegen, local_hash_table_id_));
+  }
+}
+
+// Merge the thread-local hash tables into the partitions. Groups are assigned
+// to partitions using the high bits of their hash (the low bits select the
+// bucket). Each thread merges the partitions whose index modulo the number of
+// threads is its own, scanning all local tables for groups in them.
+void HashGroupByTranslator::FinishPipeline(PipelineContext &pipeline_ctx) {
+  if (!IsParallelChildPipeline(pipeline_ctx)) {
+    return;
+  }
+
+  CodeGen &codegen = GetCodeGen();
+  PipelineContext::LoopOverStates loop_states{pipeline_ctx};
+  loop_states.DoParallel([this, &pipeline_ctx, &codegen, &loop_states](
+      UNUSED_ATTRIBUTE llvm::Value *thread_state) {
+    llvm::Value *num_threads = pipeline_ctx.LoadNumThreads(codegen);
+    llvm::Value *tid = pipeline_ctx.LoadThreadIndex(codegen);
+
+    llvm::Value *num_partitions = codegen.Const32(kNumMergePartitions);
+    lang::Loop partition_loop{codegen,
+                              codegen->CreateICmpULT(tid, num_partitions),
+                              {{"partitionIdx", tid}}};
+    {
+      llvm::Value *partition_idx = partition_loop.GetLoopVar(0);
+      llvm::Value *partition_ht = LoadPartitionPtr(partition_idx);
+
+      // Merge the groups of this partition from every thread's local table
+      loop_states.Do([this, &pipeline_ctx, &codegen, partition_ht,
+                      partition_idx](llvm::Value *local_state) {
+        PipelineContext::SetState state_access{pipeline_ctx, local_state};
+        llvm::Value *local_ht =
+            pipeline_ctx.LoadStatePtr(codegen, local_hash_table_id_);
+        MergePartition merge{hash_table_, aggregation_, partition_ht,
+                             partition_idx};
+        hash_table_.Iterate(codegen, local_ht, merge);
+      });
+
+      partition_idx = codegen->CreateAdd(partition_idx, num_threads);
+      partition_loop.LoopEnd(
+          codegen->CreateICmpULT(partition_idx, num_partitions),
+          {partition_idx});
+    }
+  });
+}
+
+void HashGroupByTranslator::TearDownPipelineState(
+    PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    CodeGen &codegen = GetCodeGen();
+    hash_table_.Destroy(
+        codegen, pipeline_ctx.LoadStatePtr(codegen, local_hash_table_id_));
+  }
 }
 
 // Produce!
@@ -111,8 +199,15 @@ void HashGroupByTranslator::Produce() const {
     // Iterate
     const auto &plan = GetPlanAs<planner::AggregatePlan>();
     ProduceResults produce_results{ctx, plan, aggregation_};
-    hash_table_.VectorizedIterate(codegen, LoadStatePtr(hash_table_id_),
-                                  selection_vec, produce_results);
+    if (child_pipeline_.IsParallel()) {
+      ForEachPartition([&](llvm::Value *partition_ht) {
+        hash_table_.VectorizedIterate(codegen, partition_ht, selection_vec,
+                                      produce_results);
+      });
+    } else {
+      hash_table_.VectorizedIterate(codegen, LoadStatePtr(hash_table_id_),
+                                    selection_vec, produce_results);
+    }
   };
 
   GetPipeline().RunSerial(producer);
@@ -160,8 +255,8 @@ void HashGroupByTranslator::Consume(ConsumerContext &context,
       hashes.SetValue(codegen, p, hash_val);
 
       // Prefetch the actual hash table bucket
-      hash_table_.PrefetchBucket(codegen, LoadStatePtr(hash_table_id_),
-                                 hash_val, OAHashTable::PrefetchType::Read,
+      hash_table_.PrefetchBucket(codegen, LoadHashTablePtr(context), hash_val,
+                                 OAHashTable::PrefetchType::Read,
                                  OAHashTable::Locality::Medium);
 
       // End prefetch loop
@@ -205,7 +300,7 @@ void HashGroupByTranslator::Consume(ConsumerContext &context,
 }
 
 // Consume the tuples from the context, grouping them into the hash table
-void HashGroupByTranslator::Consume(ConsumerContext &,
+void HashGroupByTranslator::Consume(ConsumerContext &context,
                                     RowBatch::Row &row) const {
   CodeGen &codegen = GetCodeGen();
 
@@ -231,7 +326,7 @@ void HashGroupByTranslator::Consume(ConsumerContext &,
   }
 
   // Perform the insertion into the hash table
-  llvm::Value *hash_table = LoadStatePtr(hash_table_id_);
+  llvm::Value *hash_table = LoadHashTablePtr(context);
   ConsumerProbe probe{GetCompilationContext(), aggregation_, vals, key};
   ConsumerInsert insert{aggregation_, vals, key};
   hash_table_.ProbeOrInsert(codegen, hash_table, hash, key, probe, insert);
@@ -239,8 +334,15 @@ void HashGroupByTranslator::Consume(ConsumerContext &,
 
 // Cleanup by destroying the aggregation hash-table
 void HashGroupByTranslator::TearDownQueryState() {
-  hash_table_.Destroy(GetCodeGen(), LoadStatePtr(hash_table_id_));
-  aggregation_.TearDownQueryState(GetCodeGen());
+  CodeGen &codegen = GetCodeGen();
+  if (child_pipeline_.IsParallel()) {
+    ForEachPartition([this, &codegen](llvm::Value *partition_ht) {
+      hash_table_.Destroy(codegen, partition_ht);
+    });
+  } else {
+    hash_table_.Destroy(codegen, LoadStatePtr(hash_table_id_));
+  }
+  aggregation_.TearDownQueryState(codegen);
 }
 
 // Estimate the size of the dynamically constructed hash-table
@@ -255,6 +357,42 @@ bool HashGroupByTranslator::UsePrefetching() const {
   return kUsePrefetch;
 }
 
+llvm::Value *HashGroupByTranslator::LoadHashTablePtr(
+    ConsumerContext &context) const {
+  if (context.GetPipeline().IsParallel()) {
+    return context.GetPipelineContext()->LoadStatePtr(GetCodeGen(),
+                                                      local_hash_table_id_);
+  } else {
+    return LoadStatePtr(hash_table_id_);
+  }
+}
+
+llvm::Value *HashGroupByTranslator::LoadPartitionPtr(
+    llvm::Value *partition_idx) const {
+  CodeGen &codegen = GetCodeGen();
+  return codegen->CreateInBoundsGEP(LoadStatePtr(hash_table_id_),
+                                    {codegen.Const32(0), partition_idx});
+}
+
+void HashGroupByTranslator::ForEachPartition(
+    const std::function<void(llvm::Value *partition_ht)> &body) const {
+  CodeGen &codegen = GetCodeGen();
+  llvm::Value *num_partitions = codegen.Const32(kNumMergePartitions);
+  llvm::Value *partition_idx = codegen.Const32(0);
+  llvm::Value *loop_cond =
+      codegen->CreateICmpULT(partition_idx, num_partitions);
+  lang::Loop partition_loop{
+      codegen, loop_cond, {{"partitionIdx", partition_idx}}};
+  {
+    partition_idx = partition_loop.GetLoopVar(0);
+    body(LoadPartitionPtr(partition_idx));
+    partition_idx = codegen->CreateAdd(partition_idx, codegen.Const32(1));
+    partition_loop.LoopEnd(
+        codegen->CreateICmpULT(partition_idx, num_partitions),
+        {partition_idx});
+  }
+}
+
 void HashGroupByTranslator::CollectHashKeys(
     RowBatch::Row &row, std::vector<codegen::Value> &key) const {
   CodeGen &codegen = GetCodeGen();
@@ -264,6 +402,51 @@ void HashGroupByTranslator::CollectHashKeys(
   }
 }
 
+//===----------------------------------------------------------------------===//
+// MERGE PARTITION
+//===----------------------------------------------------------------------===//
+
+HashGroupByTranslator::MergePartition::MergePartition(
+    const OAHashTable &hash_table, const Aggregation &aggregation,
+    llvm::Value *partition_ht, llvm::Value *partition_idx)
+    : hash_table_(hash_table),
+      aggregation_(aggregation),
+      partition_ht_(partition_ht),
+      partition_idx_(partition_idx) {}
+
+void HashGroupByTranslator::MergePartition::ProcessEntry(
+    CodeGen &codegen, const std::vector<codegen::Value> &keys,
+    llvm::Value *values) const {
+  // Skip groups belonging to other partitions
+  llvm::Value *hash = hash_table_.HashKey(codegen, keys);
+  llvm::Value *partition = codegen->CreateURem(
+      codegen->CreateLShr(hash, 32), codegen.Const64(kNumMergePartitions));
+  llvm::Value *in_partition = codegen->CreateICmpEQ(
+      partition, codegen->CreateZExt(partition_idx_, codegen.Int64Type()));
+  lang::If is_in_partition{codegen, in_partition, "mergeIfInPartition"};
+  {
+    auto probe_result =
+        hash_table_.ProbeOrInsert(codegen, partition_ht_, hash, keys);
+    lang::If group_exists{codegen, probe_result.key_exists, "mergeIfExists"};
+    {
+      // Merge the partial aggregates into the existing group
+      aggregation_.MergeValues(codegen, probe_result.data_ptr, values);
+    }
+    group_exists.ElseBlock("mergeIfNew");
+    {
+      // Copy the partial aggregates over as the aggregates of the new group
+      llvm::Type *storage_type =
+          aggregation_.GetAggregateStorage().GetStorageType()->getPointerTo();
+      llvm::Value *src = codegen->CreateBitCast(values, storage_type);
+      llvm::Value *dest =
+          codegen->CreateBitCast(probe_result.data_ptr, storage_type);
+      codegen->CreateStore(codegen->CreateLoad(src), dest);
+    }
+    group_exists.EndIf();
+  }
+  is_in_partition.EndIf();
+}
+
 //===----------------------------------------------------------------------===//
 // AGGREGATE FINALIZER
 //===----------------------------------------------------------------------===//
@@ -14,9 +14,13 @@
 
 #include "codegen/expression/tuple_value_translator.h"
 #include "codegen/lang/if.h"
+#include "codegen/lang/loop.h"
 #include "codegen/lang/vectorized_loop.h"
 #include "codegen/proxy/bloom_filter_proxy.h"
 #include "codegen/proxy/hash_table_proxy.h"
+#include "codegen/type/sql_type.h"
+#include "codegen/vector.h"
+#include "common/platform.h"
 #include "expression/tuple_value_expression.h"
 #include "planner/hash_join_plan.h"
 
@@ -25,6 +29,12 @@ namespace codegen {
 
 std::atomic<bool> HashJoinTranslator::kUsePrefetch{false};
 
+std::atomic<uint64_t> HashJoinTranslator::kRadixPartitionThreshold{1 << 20};
+
+const uint32_t HashJoinTranslator::kMaxRadixPartitions = 256;
+
+const uint64_t HashJoinTranslator::kRadixPartitionSize = 1 << 16;
+
 /**
  * The callback used when we probe the hash table with right-side tuples during
  * the probe phase of the join.
@@ -38,10 +48,13 @@ class HashJoinTranslator::ProbeRight : public HashTable::IterateCallback {
    * @param context The context reference
    * @param row A reference to the row from the right side of the join
    * @param right_key A reference to the key from the right side of the join
+   * @param probe_matched A variable to set when the row finds a join partner,
+   * or null if the join doesn't need to know
    */
   ProbeRight(const HashJoinTranslator &join_translator,
              ConsumerContext &context, RowBatch::Row &row,
-             const std::vector<codegen::Value> &right_key);
+             const std::vector<codegen::Value> &right_key,
+             llvm::Value *probe_matched);
 
   /**
    * The callback function called to process each matching tuple found in the
@@ -65,6 +78,9 @@ class HashJoinTranslator::ProbeRight : public HashTable::IterateCallback {
 
   // The value of the key used during the probe
   const std::vector<codegen::Value> &right_key_;
+
+  // The variable tracking whether the row found a join partner
+  llvm::Value *probe_matched_;
 };
 
 /**
@@ -76,21 +92,26 @@ class HashJoinTranslator::InsertLeft : public HashTable::InsertCallback {
   /**
    * Constructor
    *
-   * @param storage The storage format to serialize values into the table
+   * @param join_translator The translator reference
    * @param values The actual values to store in the table
    */
-  InsertLeft(const CompactStorage &storage,
+  InsertLeft(const HashJoinTranslator &join_translator,
              const std::vector<codegen::Value> &values)
-      : storage_(storage), values_(values) {}
+      : join_translator_(join_translator), values_(values) {}
 
   /**
-   * Callback used to serialize a set of values into the table.
+   * Callback used to serialize a set of values into the table. If the join
+   * tracks matches, the entry's match flag starts out cleared.
    *
    * @param codegen The codegen instance
    * @param data_space Memory space where the value can be stored.
    */
   void StoreValue(CodeGen &codegen, llvm::Value *space) const override {
-    storage_.StoreValues(codegen, space, values_);
+    join_translator_.left_value_storage_.StoreValues(codegen, space, values_);
+    if (join_translator_.TracksBuildMatches()) {
+      codegen->CreateStore(codegen.Const8(0),
+                           join_translator_.MatchFlagPtr(codegen, space));
+    }
   }
 
   /**
@@ -100,17 +121,127 @@ class HashJoinTranslator::InsertLeft : public HashTable::InsertCallback {
    * @return The number of bytes needed to store the value
    */
   llvm::Value *GetValueSize(CodeGen &codegen) const override {
-    return codegen.Const32(storage_.MaxStorageSize());
+    return codegen.Const32(join_translator_.hash_table_value_size_);
   }
 
  private:
-  // The storage format of the values in the hash table
-  const CompactStorage &storage_;
+  // The translator (we need its storage format)
+  const HashJoinTranslator &join_translator_;
 
   // The attribute values from the left side
   const std::vector<codegen::Value> &values_;
 };
 
+/**
+ * The callback used when producing the build-side tuples of outer, semi and
+ * anti joins once the probe is done.
+ */
+class HashJoinTranslator::ProduceLeft : public HashTable::IterateCallback {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param join_translator The translator reference
+   * @param context The context to push the build-side tuples into
+   */
+  ProduceLeft(const HashJoinTranslator &join_translator,
+              ConsumerContext &context)
+      : join_translator_(join_translator), context_(context) {}
+
+  /**
+   * Push the tuple of the given entry into the pipeline if it qualifies.
+   * Semi joins produce the tuples that found a join partner, all others
+   * produce those that didn't.
+   *
+   * @param codegen The codegen instance
+   * @param key The key stored in the table
+   * @param data_area Memory space where the value is stored
+   */
+  void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &key,
+                    llvm::Value *data_area) const override;
+
+ private:
+  // The translator (we need lots of its state)
+  const HashJoinTranslator &join_translator_;
+
+  // The context
+  ConsumerContext &context_;
+};
+
+/**
+ * The callback functor used when materializing probe-side tuples of
+ * radix-partitioned joins.
+ */
+class HashJoinTranslator::InsertRight : public HashTable::InsertCallback {
+ public:
+  /**
+   * Constructor
+   *
+   * @param join_translator The translator reference
+   * @param values The actual values to store in the table
+   */
+  InsertRight(const HashJoinTranslator &join_translator,
+              const std::vector<codegen::Value> &values)
+      : join_translator_(join_translator), values_(values) {}
+
+  void StoreValue(CodeGen &codegen, llvm::Value *space) const override {
+    join_translator_.right_value_storage_.StoreValues(codegen, space, values_);
+  }
+
+  llvm::Value *GetValueSize(CodeGen &codegen) const override {
+    return codegen.Const32(
+        join_translator_.right_value_storage_.MaxStorageSize());
+  }
+
+ private:
+  // The translator (we need its storage format)
+  const HashJoinTranslator &join_translator_;
+
+  // The attribute values from the right side
+  const std::vector<codegen::Value> &values_;
+};
+
+/**
+ * The callback used when joining a partition of a radix-partitioned join. It
+ * probes the hash table built over the build-side partition with each tuple of
+ * the probe-side partition.
+ */
+class HashJoinTranslator::ProbePartition : public HashTable::IterateCallback {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param join_translator The translator reference
+   * @param context The context to push the joined tuples into
+   * @param build_ht The hash table built over the build-side partition
+   */
+  ProbePartition(const HashJoinTranslator &join_translator,
+                 ConsumerContext &context, llvm::Value *build_ht)
+      : join_translator_(join_translator),
+        context_(context),
+        build_ht_(build_ht) {}
+
+  /**
+   * Probe the build-side partition with the tuple of the given entry.
+   *
+   * @param codegen The codegen instance
+   * @param key The probe-side key stored in the table
+   * @param data_area Memory space where the value is stored
+   */
+  void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &key,
+                    llvm::Value *data_area) const override;
+
+ private:
+  // The translator (we need lots of its state)
+  const HashJoinTranslator &join_translator_;
+
+  // The context
+  ConsumerContext &context_;
+
+  // The hash table over the build-side partition
+  llvm::Value *build_ht_;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// Hash Join Translator
@@ -133,6 +264,14 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
     pipeline.InstallStageBoundary(this);
   }
 
+  // If the join produces build-side tuples after the probe, or joins the
+  // partitions of its inputs, it does so at the end of the probe-side pipeline
+  can_radix_partition_ =
+      join.GetJoinType() == JoinType::INNER && !UsePrefetching();
+  if (TracksBuildMatches() || CanRadixPartition()) {
+    pipeline.InstallEpilogue(this);
+  }
+
   // Allocate state for our hash table and bloom filter
   hash_table_id_ =
       query_state.RegisterState("join", HashTableProxy::GetType(codegen));
@@ -141,6 +280,19 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
     bloom_filter_id_ = query_state.RegisterState(
         "bloomfilter", BloomFilterProxy::GetType(codegen));
   }
+  if (CanRadixPartition()) {
+    num_partitions_id_ =
+        query_state.RegisterState("joinNumParts", codegen.Int32Type());
+    llvm::Type *hash_table_type = HashTableProxy::GetType(codegen);
+    llvm::Type *partitions_type =
+        llvm::ArrayType::get(hash_table_type, kMaxRadixPartitions);
+    build_partitions_id_ =
+        query_state.RegisterState("joinBuildParts", partitions_type);
+    probe_partitions_id_ =
+        query_state.RegisterState("joinProbeParts", partitions_type);
+    probe_buffer_id_ =
+        query_state.RegisterState("joinProbe", hash_table_type);
+  }
 
   // Prepare translators for the left and right input operators
   context.Prepare(*join.GetChild(0), left_pipeline_);
@@ -203,6 +355,12 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
   }
   left_value_storage_.Setup(codegen, left_value_types);
 
+  // Tag on the match flag, if we need it
+  hash_table_value_size_ = left_value_storage_.MaxStorageSize();
+  if (TracksBuildMatches()) {
+    hash_table_value_size_ += 1;
+  }
+
   // Check if the join needs an output vector to store saved probes
   if (pipeline.GetTranslatorStage(this) != 0) {
     // The join isn't the last operator in the pipeline, let's use a vector
@@ -213,8 +371,45 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
   needs_output_vector_ = false;
 
   // Create the hash table
-  hash_table_ =
-      HashTable{codegen, left_key_type, left_value_storage_.MaxStorageSize()};
+  hash_table_ = HashTable{codegen, left_key_type, hash_table_value_size_};
+
+  // Radix-partitioned joins also materialize the probe-side attributes that
+  // the predicate and the parent need, except for the keys
+  if (CanRadixPartition()) {
+    std::unordered_set<const planner::AttributeInfo *> non_right_ais{
+        left_key_ais.begin(), left_key_ais.end()};
+    non_right_ais.insert(join.GetLeftAttributes().begin(),
+                         join.GetLeftAttributes().end());
+    for (auto *right_key_exp : right_key_exprs_) {
+      if (right_key_exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+        auto *tve = static_cast<const expression::TupleValueExpression *>(
+            right_key_exp);
+        non_right_ais.insert(tve->GetAttributeRef());
+      }
+    }
+
+    std::vector<const planner::AttributeInfo *> right_ais{
+        join.GetRightAttributes().begin(), join.GetRightAttributes().end()};
+    if (predicate != nullptr) {
+      std::unordered_set<const planner::AttributeInfo *> used_ais;
+      predicate->GetUsedAttributes(used_ais);
+      right_ais.insert(right_ais.end(), used_ais.begin(), used_ais.end());
+    }
+    for (const auto *right_ai : right_ais) {
+      if (non_right_ais.insert(right_ai).second) {
+        right_val_ais_.push_back(right_ai);
+      }
+    }
+
+    std::vector<type::Type> right_value_types;
+    for (const auto *right_val_ai : right_val_ais_) {
+      right_value_types.push_back(right_val_ai->type);
+    }
+    right_value_storage_.Setup(codegen, right_value_types);
+
+    probe_buffer_ = HashTable{codegen, right_key_type,
+                              right_value_storage_.MaxStorageSize()};
+  }
 }
 
 // Initialize the hash-table instance
@@ -225,6 +420,11 @@ void HashJoinTranslator::InitializeQueryState() {
     bloom_filter_.Init(GetCodeGen(), LoadStatePtr(bloom_filter_id_),
                        EstimateCardinalityLeft());
   }
+  if (CanRadixPartition()) {
+    // The partitions are only set up once we know we need them
+    CodeGen &codegen = GetCodeGen();
+    codegen->CreateStore(codegen.Const32(0), LoadStatePtr(num_partitions_id_));
+  }
 }
 
 // Produce!
@@ -371,7 +571,7 @@ void HashJoinTranslator::ConsumeFromLeft(ConsumerContext &ctx,
   }
 
   // Insert tuples from the left side into the hash table
-  InsertLeft insert_left{left_value_storage_, vals};
+  InsertLeft insert_left{*this, vals};
   hash_table_.InsertLazy(codegen, ht_ptr, hash, key, insert_left);
 
   // Update bloom filter, if enabled
@@ -381,55 +581,192 @@ void HashJoinTranslator::ConsumeFromLeft(ConsumerContext &ctx,
 }
 
 void HashJoinTranslator::RegisterPipelineState(PipelineContext &pipeline_ctx) {
-  if (pipeline_ctx.IsParallel() && IsLeftPipeline(pipeline_ctx.GetPipeline())) {
+  if (!pipeline_ctx.IsParallel()) {
+    return;
+  }
+  if (IsLeftPipeline(pipeline_ctx.GetPipeline())) {
     hash_table_tl_id_ = pipeline_ctx.RegisterState(
         "localHT", HashTableProxy::GetType(GetCodeGen()));
+  } else if (CanRadixPartition()) {
+    probe_buffer_tl_id_ = pipeline_ctx.RegisterState(
+        "localProbe", HashTableProxy::GetType(GetCodeGen()));
   }
 }
 
 void HashJoinTranslator::InitializePipelineState(
     PipelineContext &pipeline_ctx) {
-  if (pipeline_ctx.IsParallel() && IsLeftPipeline(pipeline_ctx.GetPipeline())) {
-    CodeGen &codegen = GetCodeGen();
+  if (!pipeline_ctx.IsParallel()) {
+    return;
+  }
+  CodeGen &codegen = GetCodeGen();
+  if (IsLeftPipeline(pipeline_ctx.GetPipeline())) {
     hash_table_.Init(codegen, GetExecutorContextPtr(),
                      pipeline_ctx.LoadStatePtr(codegen, hash_table_tl_id_));
+  } else if (CanRadixPartition()) {
+    lang::If radix_partitioned{codegen, IsRadixPartitioned()};
+    {
+      probe_buffer_.Init(
+          codegen, GetExecutorContextPtr(),
+          pipeline_ctx.LoadStatePtr(codegen, probe_buffer_tl_id_));
+    }
+    radix_partitioned.EndIf();
   }
 }
 
 void HashJoinTranslator::FinishPipeline(PipelineContext &pipeline_ctx) {
-  if (IsLeftPipeline(pipeline_ctx.GetPipeline())) {
-    CodeGen &codegen = GetCodeGen();
-    llvm::Value *global_ht_ptr = LoadStatePtr(hash_table_id_);
-    if (!pipeline_ctx.IsParallel()) {
-      // Build the hash table over the lazily inserted tuples
-      hash_table_.BuildLazy(codegen, global_ht_ptr);
-    } else {
-      // First size the global hash table
-      hash_table_.ReserveLazy(
-          codegen, global_ht_ptr, GetThreadStatesPtr(),
-          pipeline_ctx.GetEntryOffset(codegen, hash_table_tl_id_));
-
-      // Then merge each local table in parallel
-      PipelineContext::LoopOverStates loop_states{pipeline_ctx};
-      loop_states.DoParallel([this, &pipeline_ctx, &codegen](
-          UNUSED_ATTRIBUTE llvm::Value *thread_state) {
-        llvm::Value *global_ht_ptr = LoadStatePtr(hash_table_id_);
-        llvm::Value *local_ht_ptr =
-            pipeline_ctx.LoadStatePtr(codegen, hash_table_tl_id_);
-        hash_table_.MergeLazyUnfinished(codegen, global_ht_ptr, local_ht_ptr);
-      });
-    }
+  if (!IsLeftPipeline(pipeline_ctx.GetPipeline())) {
+    return;
+  }
+
+  if (!CanRadixPartition()) {
+    BuildHashTable(pipeline_ctx);
+    return;
+  }
+
+  // Radix-partitioned joins build their hash tables when they join the
+  // partitions, so we only scatter the build-side tuples into partitions
+  ChooseNumPartitions(pipeline_ctx);
+  lang::If radix_partitioned{GetCodeGen(), IsRadixPartitioned()};
+  {
+    PartitionTuples(pipeline_ctx, hash_table_, hash_table_id_,
+                    hash_table_tl_id_, build_partitions_id_);
+  }
+  radix_partitioned.ElseBlock();
+  {
+    BuildHashTable(pipeline_ctx);
+  }
+  radix_partitioned.EndIf();
+}
+
+void HashJoinTranslator::BuildHashTable(PipelineContext &pipeline_ctx) const {
+  CodeGen &codegen = GetCodeGen();
+  llvm::Value *global_ht_ptr = LoadStatePtr(hash_table_id_);
+  if (!pipeline_ctx.IsParallel()) {
+    // Build the hash table over the lazily inserted tuples
+    hash_table_.BuildLazy(codegen, global_ht_ptr);
+  } else {
+    // First size the global hash table
+    hash_table_.ReserveLazy(
+        codegen, global_ht_ptr, GetThreadStatesPtr(),
+        pipeline_ctx.GetEntryOffset(codegen, hash_table_tl_id_));
+
+    // Then merge each local table in parallel
+    PipelineContext::LoopOverStates loop_states{pipeline_ctx};
+    loop_states.DoParallel([this, &pipeline_ctx, &codegen](
+        UNUSED_ATTRIBUTE llvm::Value *thread_state) {
+      llvm::Value *global_ht_ptr = LoadStatePtr(hash_table_id_);
+      llvm::Value *local_ht_ptr =
+          pipeline_ctx.LoadStatePtr(codegen, hash_table_tl_id_);
+      hash_table_.MergeLazyUnfinished(codegen, global_ht_ptr, local_ht_ptr);
+    });
+  }
+}
+
+void HashJoinTranslator::ChooseNumPartitions(
+    PipelineContext &pipeline_ctx) const {
+  CodeGen &codegen = GetCodeGen();
+
+  // Count the materialized build-side tuples
+  llvm::Value *num_tuples = nullptr;
+  if (!pipeline_ctx.IsParallel()) {
+    num_tuples =
+        codegen.Load(HashTableProxy::num_elems, LoadStatePtr(hash_table_id_));
+  } else {
+    llvm::Value *num_tuples_ptr =
+        codegen.AllocateVariable(codegen.Int64Type(), "numBuildTuples");
+    codegen->CreateStore(codegen.Const64(0), num_tuples_ptr);
+    PipelineContext::LoopOverStates loop_states{pipeline_ctx};
+    loop_states.Do([this, &pipeline_ctx, &codegen, num_tuples_ptr](
+        llvm::Value *thread_state) {
+      PipelineContext::SetState state_access{pipeline_ctx, thread_state};
+      llvm::Value *local_ht_ptr =
+          pipeline_ctx.LoadStatePtr(codegen, hash_table_tl_id_);
+      llvm::Value *local_tuples =
+          codegen.Load(HashTableProxy::num_elems, local_ht_ptr);
+      codegen->CreateStore(
+          codegen->CreateAdd(codegen->CreateLoad(num_tuples_ptr), local_tuples),
+          num_tuples_ptr);
+    });
+    num_tuples = codegen->CreateLoad(num_tuples_ptr);
   }
+
+  llvm::Value *num_partitions = codegen.Call(
+      HashTableProxy::NumPartitions,
+      {num_tuples, codegen.Const64(kRadixPartitionThreshold),
+       codegen.Const64(kRadixPartitionSize),
+       codegen.Const32(kMaxRadixPartitions)});
+  codegen->CreateStore(num_partitions, LoadStatePtr(num_partitions_id_));
+
+  // Set up the partitions, and the table materializing the probe side
+  lang::If radix_partitioned{codegen, IsRadixPartitioned()};
+  {
+    llvm::Value *exec_ctx_ptr = GetExecutorContextPtr();
+    probe_buffer_.Init(codegen, exec_ctx_ptr, LoadStatePtr(probe_buffer_id_));
+    ForEachPartition(build_partitions_id_, [&](llvm::Value *partition_ht) {
+      hash_table_.Init(codegen, exec_ctx_ptr, partition_ht);
+    });
+    ForEachPartition(probe_partitions_id_, [&](llvm::Value *partition_ht) {
+      probe_buffer_.Init(codegen, exec_ctx_ptr, partition_ht);
+    });
+  }
+  radix_partitioned.EndIf();
+}
+
+llvm::Value *HashJoinTranslator::LoadNumPartitions() const {
+  return GetCodeGen()->CreateLoad(LoadStatePtr(num_partitions_id_));
+}
+
+llvm::Value *HashJoinTranslator::IsRadixPartitioned() const {
+  CodeGen &codegen = GetCodeGen();
+  return codegen->CreateICmpNE(LoadNumPartitions(), codegen.Const32(0));
 }
 
 void HashJoinTranslator::TearDownPipelineState(PipelineContext &pipeline_ctx) {
-  if (pipeline_ctx.IsParallel() && IsLeftPipeline(pipeline_ctx.GetPipeline())) {
-    CodeGen &codegen = GetCodeGen();
+  if (!pipeline_ctx.IsParallel()) {
+    return;
+  }
+  CodeGen &codegen = GetCodeGen();
+  if (IsLeftPipeline(pipeline_ctx.GetPipeline())) {
     auto *local_ht_ptr = pipeline_ctx.LoadStatePtr(codegen, hash_table_tl_id_);
     hash_table_.Destroy(codegen, local_ht_ptr);
+  } else if (CanRadixPartition()) {
+    lang::If radix_partitioned{codegen, IsRadixPartitioned()};
+    {
+      auto *local_ht_ptr =
+          pipeline_ctx.LoadStatePtr(codegen, probe_buffer_tl_id_);
+      probe_buffer_.Destroy(codegen, local_ht_ptr);
+    }
+    radix_partitioned.EndIf();
   }
 }
 
+void HashJoinTranslator::PartitionTuples(PipelineContext &pipeline_ctx,
+                                         const HashTable &table,
+                                         QueryState::Id ht_id,
+                                         PipelineContext::Id ht_tl_id,
+                                         QueryState::Id partitions_id) const {
+  CodeGen &codegen = GetCodeGen();
+  if (!pipeline_ctx.IsParallel()) {
+    llvm::Value *partitions =
+        LoadPartitionPtr(partitions_id, codegen.Const32(0));
+    table.PartitionLazyUnfinished(codegen, LoadStatePtr(ht_id), partitions,
+                                  LoadNumPartitions());
+    return;
+  }
+
+  // Each thread-local table is partitioned in parallel
+  PipelineContext::LoopOverStates loop_states{pipeline_ctx};
+  loop_states.DoParallel([this, &pipeline_ctx, &codegen, &table, ht_tl_id,
+                          partitions_id](
+      UNUSED_ATTRIBUTE llvm::Value *thread_state) {
+    llvm::Value *partitions =
+        LoadPartitionPtr(partitions_id, codegen.Const32(0));
+    llvm::Value *local_ht_ptr = pipeline_ctx.LoadStatePtr(codegen, ht_tl_id);
+    table.PartitionLazyUnfinished(codegen, local_ht_ptr, partitions,
+                                  LoadNumPartitions());
+  });
+}
+
 // The given row is from the right child. Probe hash-table.
 void HashJoinTranslator::ConsumeFromRight(ConsumerContext &context,
                                           RowBatch::Row &row) const {
@@ -437,39 +774,288 @@ void HashJoinTranslator::ConsumeFromRight(ConsumerContext &context,
   std::vector<codegen::Value> key;
   CollectKeys(row, right_key_exprs_, key);
 
+  // Radix-partitioned joins probe once all tuples are partitioned. Values
+  // derived in one branch can't be used in the other, so each gets its own row.
+  if (CanRadixPartition()) {
+    CodeGen &codegen = GetCodeGen();
+    lang::If radix_partitioned{codegen, IsRadixPartitioned()};
+    {
+      RowBatch::Row buffered_row = row;
+      BufferRight(context, buffered_row, key);
+    }
+    radix_partitioned.ElseBlock();
+    {
+      CodegenHashProbe(context, row, key);
+    }
+    radix_partitioned.EndIf();
+    return;
+  }
+
+  // Probe the hash table
+  CodegenHashProbe(context, row, key);
+}
+
+void HashJoinTranslator::BufferRight(ConsumerContext &context,
+                                     RowBatch::Row &row,
+                                     std::vector<codegen::Value> &key) const {
+  CodeGen &codegen = GetCodeGen();
+
+  std::vector<codegen::Value> vals;
+  CollectValues(row, right_val_ais_, vals);
+
+  llvm::Value *ht_ptr = nullptr;
+  if (context.GetPipeline().IsParallel()) {
+    ht_ptr = context.GetPipelineContext()->LoadStatePtr(codegen,
+                                                        probe_buffer_tl_id_);
+  } else {
+    ht_ptr = LoadStatePtr(probe_buffer_id_);
+  }
+
+  InsertRight insert_right{*this, vals};
   if (GetJoinPlan().IsBloomFilterEnabled()) {
-    // Prefilter the tuple using Bloom Filter
+    // Only keep the tuples that pass the bloom filter
     llvm::Value *contains = bloom_filter_.Contains(
-        GetCodeGen(), LoadStatePtr(bloom_filter_id_), key);
+        codegen, LoadStatePtr(bloom_filter_id_), key);
 
-    lang::If is_valid_row{GetCodeGen(), contains};
+    lang::If is_valid_row{codegen, contains};
     {
-      // For each tuple that passes the bloom filter, probe the hash table
-      // to eliminate the false positives.
-      CodegenHashProbe(context, row, key);
+      probe_buffer_.InsertLazy(codegen, ht_ptr, nullptr, key, insert_right);
     }
     is_valid_row.EndIf();
   } else {
-    // Bloom filter is not enabled. Directly probe the hash table
-    CodegenHashProbe(context, row, key);
+    probe_buffer_.InsertLazy(codegen, ht_ptr, nullptr, key, insert_right);
   }
 }
 
 void HashJoinTranslator::CodegenHashProbe(
     ConsumerContext &context, RowBatch::Row &row,
     std::vector<codegen::Value> &key) const {
-  if (GetJoinPlan().GetJoinType() == JoinType::INNER) {
-    // For inner joins, find all join partners
-    ProbeRight probe_right{*this, context, row, key};
-    hash_table_.FindAll(GetCodeGen(), LoadStatePtr(hash_table_id_), key,
+  CodeGen &codegen = GetCodeGen();
+
+  // If the join produces probe-side tuples without a join partner, track
+  // whether the tuple finds one. The attributes the probe puts into the row
+  // are only valid inside of it, so we keep the row as it was before.
+  llvm::Value *probe_matched = nullptr;
+  if (EmitsUnmatchedProbes()) {
+    probe_matched = codegen.AllocateVariable(codegen.BoolType(), "matched");
+    codegen->CreateStore(codegen.ConstBool(false), probe_matched);
+  }
+  RowBatch::Row unmatched_row = row;
+
+  // Find all join partners
+  ProbeRight probe_right{*this, context, row, key, probe_matched};
+  if (GetJoinPlan().IsBloomFilterEnabled()) {
+    // Prefilter the tuple using Bloom Filter
+    llvm::Value *contains = bloom_filter_.Contains(
+        codegen, LoadStatePtr(bloom_filter_id_), key);
+
+    lang::If is_valid_row{codegen, contains};
+    {
+      // For each tuple that passes the bloom filter, probe the hash table
+      // to eliminate the false positives.
+      hash_table_.FindAll(codegen, LoadStatePtr(hash_table_id_), key,
+                          probe_right);
+    }
+    is_valid_row.EndIf();
+  } else {
+    // Bloom filter is not enabled. Directly probe the hash table
+    hash_table_.FindAll(codegen, LoadStatePtr(hash_table_id_), key,
                         probe_right);
   }
+
+  // Produce the tuple padded with NULLs if it didn't find a join partner
+  if (probe_matched != nullptr) {
+    llvm::Value *matched = codegen->CreateLoad(probe_matched);
+    lang::If no_match{codegen, codegen->CreateNot(matched), "noMatch"};
+    {
+      // The matches have moved the pipeline along, move back to the join
+      GetPipeline().MoveTo(this);
+      RegisterNulls(codegen, unmatched_row, GetJoinPlan().GetLeftAttributes());
+      context.Consume(unmatched_row);
+    }
+    no_match.EndIf();
+  }
+}
+
+void HashJoinTranslator::PrepareEpilogue(PipelineContext &pipeline_ctx) const {
+  if (CanRadixPartition()) {
+    lang::If radix_partitioned{GetCodeGen(), IsRadixPartitioned()};
+    {
+      PartitionTuples(pipeline_ctx, probe_buffer_, probe_buffer_id_,
+                      probe_buffer_tl_id_, probe_partitions_id_);
+    }
+    radix_partitioned.EndIf();
+  }
+}
+
+void HashJoinTranslator::ProduceEpilogue(ConsumerContext &context,
+                                         llvm::Value *thread_idx,
+                                         llvm::Value *num_threads) const {
+  if (CanRadixPartition()) {
+    CodeGen &codegen = GetCodeGen();
+
+    // Each thread joins its share of the partitions. There are none if the
+    // join turned out not to be radix-partitioned.
+    llvm::Value *num_partitions = LoadNumPartitions();
+    llvm::Value *partition_idx = thread_idx;
+    lang::Loop partition_loop{
+        codegen, codegen->CreateICmpULT(partition_idx, num_partitions),
+        {{"partitionIdx", partition_idx}}};
+    {
+      partition_idx = partition_loop.GetLoopVar(0);
+
+      // Build the hash table over the build-side partition, and probe it with
+      // the tuples of the probe-side partition
+      llvm::Value *build_ht =
+          LoadPartitionPtr(build_partitions_id_, partition_idx);
+      hash_table_.BuildLazy(codegen, build_ht);
+
+      ProbePartition probe_partition{*this, context, build_ht};
+      probe_buffer_.IterateLazy(
+          codegen, LoadPartitionPtr(probe_partitions_id_, partition_idx),
+          probe_partition);
+
+      partition_idx = codegen->CreateAdd(partition_idx, num_threads);
+      partition_loop.LoopEnd(
+          codegen->CreateICmpULT(partition_idx, num_partitions),
+          {partition_idx});
+    }
+    return;
+  }
+
+  // Each thread produces the tuples in its share of the buckets
+  ProduceLeft produce_left{*this, context};
+  hash_table_.IterateStrided(GetCodeGen(), LoadStatePtr(hash_table_id_),
+                             thread_idx, num_threads, produce_left);
+}
+
+void HashJoinTranslator::RegisterBuildValues(
+    CodeGen &codegen, RowBatch::Row &row,
+    const std::vector<codegen::Value> &key, llvm::Value *data_area) const {
+  // LoadValues all the values from the hash entry
+  std::vector<codegen::Value> left_vals;
+  left_value_storage_.LoadValues(codegen, data_area, left_vals);
+
+  // Put the values directly into the row
+  for (uint32_t i = 0; i < left_val_ais_.size(); i++) {
+    row.RegisterAttributeValue(left_val_ais_[i], left_vals[i]);
+  }
+
+  for (uint32_t i = 0; i < left_key_exprs_.size(); i++) {
+    const auto *exp = left_key_exprs_[i];
+    if (exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+      auto *tve = static_cast<const expression::TupleValueExpression *>(exp);
+      LOG_DEBUG("Putting AI %s (%p) into row",
+                tve->GetAttributeRef()->name.c_str(), tve->GetAttributeRef());
+      row.RegisterAttributeValue(tve->GetAttributeRef(), key[i]);
+    }
+  }
+}
+
+void HashJoinTranslator::RegisterProbeValues(
+    CodeGen &codegen, RowBatch::Row &row,
+    const std::vector<codegen::Value> &key, llvm::Value *data_area) const {
+  std::vector<codegen::Value> right_vals;
+  right_value_storage_.LoadValues(codegen, data_area, right_vals);
+  for (uint32_t i = 0; i < right_val_ais_.size(); i++) {
+    row.RegisterAttributeValue(right_val_ais_[i], right_vals[i]);
+  }
+
+  for (uint32_t i = 0; i < right_key_exprs_.size(); i++) {
+    const auto *exp = right_key_exprs_[i];
+    if (exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+      auto *tve = static_cast<const expression::TupleValueExpression *>(exp);
+      row.RegisterAttributeValue(tve->GetAttributeRef(), key[i]);
+    }
+  }
+}
+
+void HashJoinTranslator::RegisterNulls(
+    CodeGen &codegen, RowBatch::Row &row,
+    const std::vector<const planner::AttributeInfo *> &ais) const {
+  for (const auto *ai : ais) {
+    row.RegisterAttributeValue(ai, ai->type.GetSqlType().GetNullValue(codegen));
+  }
+}
+
+bool HashJoinTranslator::EmitsMatches() const {
+  switch (GetJoinPlan().GetJoinType()) {
+    case JoinType::SEMI:
+    case JoinType::ANTI:
+      return false;
+    default:
+      return true;
+  }
+}
+
+bool HashJoinTranslator::TracksBuildMatches() const {
+  switch (GetJoinPlan().GetJoinType()) {
+    case JoinType::LEFT:
+    case JoinType::OUTER:
+    case JoinType::SEMI:
+    case JoinType::ANTI:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool HashJoinTranslator::EmitsUnmatchedProbes() const {
+  auto join_type = GetJoinPlan().GetJoinType();
+  return join_type == JoinType::RIGHT || join_type == JoinType::OUTER;
+}
+
+llvm::Value *HashJoinTranslator::MatchFlagPtr(CodeGen &codegen,
+                                              llvm::Value *data_area) const {
+  llvm::Value *values = codegen->CreatePointerCast(data_area,
+                                                   codegen.CharPtrType());
+  return codegen->CreateConstInBoundsGEP1_32(
+      codegen.ByteType(), values, left_value_storage_.MaxStorageSize());
+}
+
+llvm::Value *HashJoinTranslator::LoadPartitionPtr(
+    QueryState::Id partitions_id, llvm::Value *partition_idx) const {
+  CodeGen &codegen = GetCodeGen();
+  return codegen->CreateInBoundsGEP(LoadStatePtr(partitions_id),
+                                    {codegen.Const32(0), partition_idx});
+}
+
+void HashJoinTranslator::ForEachPartition(
+    QueryState::Id partitions_id,
+    const std::function<void(llvm::Value *partition_ht)> &body) const {
+  CodeGen &codegen = GetCodeGen();
+  llvm::Value *num_partitions = LoadNumPartitions();
+  llvm::Value *partition_idx = codegen.Const32(0);
+  lang::Loop partition_loop{
+      codegen, codegen->CreateICmpULT(partition_idx, num_partitions),
+      {{"partitionIdx", partition_idx}}};
+  {
+    partition_idx = partition_loop.GetLoopVar(0);
+    body(LoadPartitionPtr(partitions_id, partition_idx));
+    partition_idx = codegen->CreateAdd(partition_idx, codegen.Const32(1));
+    partition_loop.LoopEnd(
+        codegen->CreateICmpULT(partition_idx, num_partitions),
+        {partition_idx});
+  }
 }
 
 // Cleanup by destroying the hash-table instance
 void HashJoinTranslator::TearDownQueryState() {
   CodeGen &codegen = GetCodeGen();
   hash_table_.Destroy(codegen, LoadStatePtr(hash_table_id_));
+  if (CanRadixPartition()) {
+    lang::If radix_partitioned{codegen, IsRadixPartitioned()};
+    {
+      probe_buffer_.Destroy(codegen, LoadStatePtr(probe_buffer_id_));
+      ForEachPartition(build_partitions_id_, [&](llvm::Value *partition_ht) {
+        hash_table_.Destroy(codegen, partition_ht);
+      });
+      ForEachPartition(probe_partitions_id_, [&](llvm::Value *partition_ht) {
+        probe_buffer_.Destroy(codegen, partition_ht);
+      });
+    }
+    radix_partitioned.EndIf();
+  }
   if (GetJoinPlan().IsBloomFilterEnabled()) {
     bloom_filter_.Destroy(GetCodeGen(), LoadStatePtr(bloom_filter_id_));
   }
@@ -524,43 +1110,52 @@ const planner::HashJoinPlan &HashJoinTranslator::GetJoinPlan() const {
 
 HashJoinTranslator::ProbeRight::ProbeRight(
     const HashJoinTranslator &join_translator, ConsumerContext &context,
-    RowBatch::Row &row, const std::vector<codegen::Value> &right_key)
+    RowBatch::Row &row, const std::vector<codegen::Value> &right_key,
+    llvm::Value *probe_matched)
     : join_translator_(join_translator),
       context_(context),
       row_(row),
-      right_key_(right_key) {}
+      right_key_(right_key),
+      probe_matched_(probe_matched) {}
 
 void HashJoinTranslator::ProbeRight::ProcessEntry(
     CodeGen &codegen, const std::vector<codegen::Value> &key,
     llvm::Value *data_area) const {
-  const auto &storage = join_translator_.left_value_storage_;
-
   if (join_translator_.needs_output_vector_) {
     // Use output vector for attribute access
     throw Exception{"Shouldn't need output"};
   } else {
-    // LoadValues all the values from the hash entry
-    std::vector<codegen::Value> left_vals;
-    storage.LoadValues(codegen, data_area, left_vals);
-
-    // Put the values directly into the row
-    const auto &left_val_ais = join_translator_.left_val_ais_;
-    for (uint32_t i = 0; i < left_val_ais.size(); i++) {
-      row_.RegisterAttributeValue(left_val_ais[i], left_vals[i]);
-    }
+    join_translator_.RegisterBuildValues(codegen, row_, key, data_area);
+  }
 
-    const auto &left_key_exprs = join_translator_.left_key_exprs_;
-    for (uint32_t i = 0; i < left_key_exprs.size(); i++) {
-      const auto *exp = left_key_exprs[i];
-      if (exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
-        auto *tve = static_cast<const expression::TupleValueExpression *>(exp);
-        codegen::Value v = key[i];
-        LOG_DEBUG("Putting AI %s (%p) into row",
-                  tve->GetAttributeRef()->name.c_str(), tve->GetAttributeRef());
-        row_.RegisterAttributeValue(tve->GetAttributeRef(), v);
+  // What to do with a pair of tuples that joins
+  auto on_match = [this, &codegen, data_area]() {
+    // Mark the build-side tuple as matched. Many threads may find the same
+    // tuple, but they all store the same value and nobody reads the flag
+    // until the probe is done. Only storing into unset flags keeps the
+    // entries of frequent join partners from bouncing between caches.
+    if (join_translator_.TracksBuildMatches()) {
+      llvm::Value *flag_ptr = join_translator_.MatchFlagPtr(codegen, data_area);
+      llvm::Value *flag = codegen->CreateLoad(flag_ptr);
+      lang::If not_marked{codegen,
+                          codegen->CreateICmpEQ(flag, codegen.Const8(0)),
+                          "notMarked"};
+      {
+        codegen->CreateStore(codegen.Const8(1), flag_ptr);
       }
+      not_marked.EndIf();
     }
-  }
+
+    // Remember that the probe-side tuple found a partner
+    if (probe_matched_ != nullptr) {
+      codegen->CreateStore(codegen.ConstBool(true), probe_matched_);
+    }
+
+    // Send the row up to the parent
+    if (join_translator_.EmitsMatches()) {
+      context_.Consume(row_);
+    }
+  };
 
   // Check predicate if one exists
   auto *predicate = join_translator_.GetJoinPlan().GetPredicate();
@@ -569,14 +1164,70 @@ void HashJoinTranslator::ProbeRight::ProcessEntry(
     auto valid_row = row_.DeriveValue(codegen, *predicate);
     lang::If is_valid_row{codegen, valid_row};
     {
-      // Send row up to the parent
-      context_.Consume(row_);
+      on_match();
     }
     is_valid_row.EndIf();
   } else {
-    // Send the row up to the parent
-    context_.Consume(row_);
+    on_match();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// ProbePartition
+///
+////////////////////////////////////////////////////////////////////////////////
+
+void HashJoinTranslator::ProbePartition::ProcessEntry(
+    CodeGen &codegen, const std::vector<codegen::Value> &key,
+    llvm::Value *data_area) const {
+  // A single-row batch for the probe-side tuple
+  RowBatch::WithSingleRow(context_.GetCompilationContext(), [&](
+      RowBatch::Row &row) {
+    join_translator_.RegisterProbeValues(codegen, row, key, data_area);
+
+    // Find all join partners in the build-side partition
+    ProbeRight probe_right{join_translator_, context_, row, key, nullptr};
+    join_translator_.hash_table_.FindAll(codegen, build_ht_, key, probe_right);
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// ProduceLeft
+///
+////////////////////////////////////////////////////////////////////////////////
+
+void HashJoinTranslator::ProduceLeft::ProcessEntry(
+    CodeGen &codegen, const std::vector<codegen::Value> &key,
+    llvm::Value *data_area) const {
+  const auto &join_plan = join_translator_.GetJoinPlan();
+
+  // Does the tuple qualify?
+  llvm::Value *flag =
+      codegen->CreateLoad(join_translator_.MatchFlagPtr(codegen, data_area));
+  llvm::Value *matched = codegen->CreateICmpNE(flag, codegen.Const8(0));
+  llvm::Value *qualifies = join_plan.GetJoinType() == JoinType::SEMI
+                               ? matched
+                               : codegen->CreateNot(matched);
+
+  lang::If produce_tuple{codegen, qualifies, "produceTuple"};
+  {
+    // A single-row batch for the tuple
+    RowBatch::WithSingleRow(context_.GetCompilationContext(), [&](
+        RowBatch::Row &row) {
+      // Outer joins pad the tuple with NULLs for the probe side
+      join_translator_.RegisterBuildValues(codegen, row, key, data_area);
+      if (join_translator_.EmitsMatches()) {
+        join_translator_.RegisterNulls(codegen, row,
+                                       join_plan.GetRightAttributes());
+      }
+
+      // Send the row up to the parent
+      context_.Consume(row);
+    });
   }
+  produce_tuple.EndIf();
 }
 
 }  // namespace codegen
@@ -0,0 +1,269 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_translator.cpp
+//
+// Identification: src/codegen/operator/index_scan_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/operator/index_scan_translator.h"
+
+#include "codegen/lang/loop.h"
+#include "codegen/proxy/executor_context_proxy.h"
+#include "codegen/proxy/index_scanner_proxy.h"
+#include "codegen/proxy/runtime_functions_proxy.h"
+#include "codegen/proxy/transaction_runtime_proxy.h"
+#include "codegen/type/boolean_type.h"
+#include "codegen/vector.h"
+#include "planner/index_scan_plan.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace codegen {
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// AttributeAccess
+///
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class enables deferred access to any one available attribute in an input
+ * row, loading it from the tile group the row's batch belongs to.
+ */
+class IndexScanTranslator::AttributeAccess : public RowBatch::AttributeAccess {
+ public:
+  AttributeAccess(const TileGroup::TileGroupAccess &access,
+                  const planner::AttributeInfo *ai)
+      : tile_group_access_(access), ai_(ai) {}
+
+  // Access an attribute in the given row
+  codegen::Value Access(CodeGen &codegen, RowBatch::Row &row) override {
+    auto raw_row = tile_group_access_.GetRow(row.GetTID(codegen));
+    return raw_row.LoadColumn(codegen, ai_->attribute_id);
+  }
+
+  const planner::AttributeInfo *GetAttributeRef() const { return ai_; }
+
+ private:
+  // The accessor we use to load column values
+  const TileGroup::TileGroupAccess &tile_group_access_;
+  // The attribute we will access
+  const planner::AttributeInfo *ai_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Index Scan Translator
+///
+////////////////////////////////////////////////////////////////////////////////
+
+IndexScanTranslator::IndexScanTranslator(const planner::IndexScanPlan &scan,
+                                         CompilationContext &context,
+                                         Pipeline &pipeline)
+    : OperatorTranslator(scan, context, pipeline),
+      tile_group_(*scan.GetTable()->GetSchema()) {
+  // Set ourselves as the source of the pipeline. The tuples are produced in
+  // index order, so the scan is always serial.
+  pipeline.MarkSource(this, Pipeline::Parallelism::Serial);
+
+  // If there is a predicate, prepare a translator for it
+  const auto *predicate = scan.GetPredicate();
+  if (predicate != nullptr) {
+    context.Prepare(*predicate);
+  }
+
+  // Register the index scanner instance
+  scanner_id_ = context.GetQueryState().RegisterState(
+      "indexScanner", IndexScannerProxy::GetType(GetCodeGen()));
+}
+
+void IndexScanTranslator::InitializeQueryState() {
+  CodeGen &codegen = GetCodeGen();
+  const auto &scan = GetScanPlan();
+
+  // The key values are consecutive query parameters
+  uint32_t key_param_idx = 0;
+  const auto &values = scan.GetValuesWithParams();
+  if (!values.empty()) {
+    auto &parameter_cache = GetCompilationContext().GetParameterCache();
+    key_param_idx = parameter_cache.GetIndex(&values[0]);
+  }
+
+  // Call IndexScanner::Init()
+  llvm::Value *plan_ptr = codegen.ConstPointer(
+      &scan, IndexScanPlanProxy::GetType(codegen)->getPointerTo());
+  codegen.Call(IndexScannerProxy::Init,
+               {LoadStatePtr(scanner_id_), plan_ptr, GetExecutorContextPtr(),
+                codegen.Const32(key_param_idx),
+                codegen.Const32(Vector::kDefaultVectorSize.load())});
+}
+
+void IndexScanTranslator::TearDownQueryState() {
+  GetCodeGen().Call(IndexScannerProxy::Destroy, {LoadStatePtr(scanner_id_)});
+}
+
+// Generate the loop over the batches of the index scanner
+//
+// @code
+// scanner.Scan()
+// for (batch := 0; batch < scanner.GetNumBatches(); batch++) {
+//   tile_group := scanner.GetTileGroup(batch)
+//   sel_vec.num_elements := scanner.FillSelectionVector(batch, sel_vec)
+//   ProduceBatch(tile_group, sel_vec)
+//   if (pipeline terminated) break
+// }
+// @endcode
+//
+void IndexScanTranslator::Produce() const {
+  auto producer = [this](ConsumerContext &ctx) {
+    CodeGen &codegen = GetCodeGen();
+    llvm::Value *scanner_ptr = LoadStatePtr(scanner_id_);
+
+    // Look up the index
+    codegen.Call(IndexScannerProxy::Scan, {scanner_ptr});
+
+    // Allocate some space for the column layouts
+    const auto num_columns = static_cast<uint32_t>(
+        GetScanPlan().GetTable()->GetSchema()->GetColumnCount());
+    llvm::Value *column_layouts = codegen.AllocateBuffer(
+        ColumnLayoutInfoProxy::GetType(codegen), num_columns, "columnLayout");
+
+    // The selection vector for the scan
+    auto *i32_type = codegen.Int32Type();
+    auto vec_size = Vector::kDefaultVectorSize.load();
+    auto *raw_vec = codegen.AllocateBuffer(i32_type, vec_size, "scanPosList");
+    Vector selection_vector{raw_vec, vec_size, i32_type};
+
+    llvm::Value *num_batches =
+        codegen.Call(IndexScannerProxy::GetNumBatches, {scanner_ptr});
+    llvm::Value *batch_idx = codegen.Const32(0);
+    lang::Loop loop{codegen, codegen->CreateICmpULT(batch_idx, num_batches),
+                    {{"batchIdx", batch_idx}}};
+    {
+      batch_idx = loop.GetLoopVar(0);
+
+      // The tile group of the batch
+      llvm::Value *tile_group_ptr = codegen.Call(
+          IndexScannerProxy::GetTileGroup, {scanner_ptr, batch_idx});
+      llvm::Value *tile_group_id =
+          tile_group_.GetTileGroupId(codegen, tile_group_ptr);
+      auto col_layouts =
+          tile_group_.GetColumnLayouts(codegen, tile_group_ptr, column_layouts);
+      TileGroup::TileGroupAccess tile_group_access{tile_group_, col_layouts};
+
+      // The tuples of the batch
+      llvm::Value *num_tuples =
+          codegen.Call(IndexScannerProxy::FillSelectionVector,
+                       {scanner_ptr, batch_idx, raw_vec});
+      selection_vector.SetNumElements(num_tuples);
+
+      ProduceBatch(ctx, tile_group_id, tile_group_ptr, tile_group_access,
+                   selection_vector);
+
+      // Move to the next batch, unless the pipeline was terminated
+      batch_idx = codegen->CreateAdd(batch_idx, codegen.Const32(1));
+      llvm::Value *more_batches =
+          codegen->CreateICmpULT(batch_idx, num_batches);
+      llvm::Value *stop = ctx.GetPipeline().IsTerminated(codegen);
+      if (stop != nullptr) {
+        more_batches =
+            codegen->CreateAnd(more_batches, codegen->CreateNot(stop));
+      }
+      loop.LoopEnd(more_batches, {batch_idx});
+    }
+  };
+
+  // Execute serially
+  GetPipeline().RunSerial(producer);
+}
+
+void IndexScanTranslator::ProduceBatch(
+    ConsumerContext &ctx, llvm::Value *tile_group_id,
+    llvm::Value *tile_group_ptr, TileGroup::TileGroupAccess &tile_group_access,
+    Vector &selection_vector) const {
+  CodeGen &codegen = GetCodeGen();
+  const auto &plan = GetScanPlan();
+
+  // The scanner only hands out visible tuples, and fills the selection vector
+  // with their offsets. Every row batch over it is filtered.
+  llvm::Value *tid_start = codegen.Const32(0);
+  llvm::Value *tid_end = selection_vector.GetNumElements();
+
+  // 1. Filter rows by the given predicate (if one exists). Besides the
+  //    residual conditions, the predicate re-checks the key conditions, which
+  //    the index can't answer exactly for open ranges or for secondary keys.
+  const auto *predicate = plan.GetPredicate();
+  if (predicate != nullptr) {
+    RowBatch batch{ctx.GetCompilationContext(), tile_group_id, tid_start,
+                   tid_end, selection_vector, true};
+
+    std::unordered_set<const planner::AttributeInfo *> used_attributes;
+    predicate->GetUsedAttributes(used_attributes);
+
+    std::vector<AttributeAccess> attribute_accessors;
+    for (const auto *ai : used_attributes) {
+      attribute_accessors.emplace_back(tile_group_access, ai);
+    }
+    for (auto &accessor : attribute_accessors) {
+      batch.AddAttribute(accessor.GetAttributeRef(), &accessor);
+    }
+
+    batch.Iterate(codegen, [&](RowBatch::Row &row) {
+      // Evaluate the predicate to determine row validity
+      codegen::Value valid_row = row.DeriveValue(codegen, *predicate);
+
+      // Reify the boolean value since it may be NULL
+      PELOTON_ASSERT(valid_row.GetType().GetSqlType() ==
+                     type::Boolean::Instance());
+      llvm::Value *bool_val =
+          type::Boolean::Instance().Reify(codegen, valid_row);
+
+      // Set the validity of the row
+      row.SetValidity(codegen, bool_val);
+    });
+  }
+
+  // 2. Record reads for all of the tuples that pass the predicate
+  ExecutionConsumer &ec = ctx.GetCompilationContext().GetExecutionConsumer();
+  llvm::Value *txn = ec.GetTransactionPtr(ctx.GetCompilationContext());
+  llvm::Value *is_for_update = codegen.ConstBool(plan.IsForUpdate());
+  llvm::Value *out_idx =
+      codegen.Call(TransactionRuntimeProxy::PerformVectorizedRead,
+                   {txn, tile_group_ptr, selection_vector.GetVectorPtr(),
+                    selection_vector.GetNumElements(), is_for_update});
+  selection_vector.SetNumElements(out_idx);
+
+  // 3. Setup the (filtered) row batch with all the output attributes
+  RowBatch batch{ctx.GetCompilationContext(), tile_group_id, tid_start,
+                 tid_end, selection_vector, true};
+
+  std::vector<const planner::AttributeInfo *> ais;
+  plan.GetAttributes(ais);
+  const auto &output_col_ids = plan.GetColumnIds();
+
+  std::vector<AttributeAccess> attribute_accesses;
+  attribute_accesses.reserve(output_col_ids.size());
+  for (oid_t col_idx = 0; col_idx < output_col_ids.size(); col_idx++) {
+    attribute_accesses.emplace_back(tile_group_access,
+                                    ais[output_col_ids[col_idx]]);
+  }
+  for (oid_t col_idx = 0; col_idx < output_col_ids.size(); col_idx++) {
+    batch.AddAttribute(ais[output_col_ids[col_idx]],
+                       &attribute_accesses[col_idx]);
+  }
+
+  // 4. Push the batch into the pipeline
+  ctx.Consume(batch);
+}
+
+const planner::IndexScanPlan &IndexScanTranslator::GetScanPlan() const {
+  return GetPlanAs<planner::IndexScanPlan>();
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// limit_translator.cpp
+//
+// Identification: src/codegen/operator/limit_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/operator/limit_translator.h"
+
+#include "codegen/compilation_context.h"
+#include "codegen/consumer_context.h"
+#include "codegen/lang/if.h"
+#include "codegen/proxy/runtime_functions_proxy.h"
+#include "planner/limit_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+LimitTranslator::LimitTranslator(const planner::LimitPlan &plan,
+                                 CompilationContext &context,
+                                 Pipeline &pipeline)
+    : OperatorTranslator(plan, context, pipeline) {
+  // Prepare translator for our child
+  PELOTON_ASSERT(plan.GetChildrenSize() == 1);
+  context.Prepare(*plan.GetChild(0), pipeline);
+
+  // Register the row counter
+  CodeGen &codegen = GetCodeGen();
+  counter_id_ =
+      context.GetQueryState().RegisterState("limitCount", codegen.Int64Type());
+
+  // Let us stop the source of the pipeline once we've seen enough rows
+  pipeline.AllowEarlyTermination();
+}
+
+void LimitTranslator::InitializeQueryState() {
+  CodeGen &codegen = GetCodeGen();
+  codegen->CreateStore(codegen.Const64(0), LoadStatePtr(counter_id_));
+}
+
+void LimitTranslator::Produce() const {
+  GetCompilationContext().Produce(*GetPlan().GetChild(0));
+}
+
+// Count the row, and pass it on if it falls between the offset and the limit.
+// The row that reaches the limit terminates the pipeline.
+//
+// @code
+// count := ++limitCount
+// if (count > offset && count - offset <= limit) {
+//   consume(row)
+// }
+// if (count >= offset && count - offset >= limit) {
+//   terminate pipeline
+// }
+// @endcode
+//
+void LimitTranslator::Consume(ConsumerContext &context,
+                              RowBatch::Row &row) const {
+  CodeGen &codegen = GetCodeGen();
+  const auto &plan = GetPlanAs<planner::LimitPlan>();
+
+  // The limit and offset are query parameters
+  auto &parameter_cache = GetCompilationContext().GetParameterCache();
+  llvm::Value *limit =
+      parameter_cache.GetValue(parameter_cache.GetIndex(&plan.GetLimit()))
+          .GetValue();
+  llvm::Value *offset =
+      parameter_cache.GetValue(parameter_cache.GetIndex(&plan.GetOffset()))
+          .GetValue();
+
+  // Count the row. Threads of a parallel pipeline share the counter.
+  llvm::Value *counter_ptr = LoadStatePtr(counter_id_);
+  llvm::Value *count = nullptr;
+  if (context.GetPipeline().IsParallel()) {
+    count = codegen.Call(RuntimeFunctionsProxy::IncrementCounter,
+                         {counter_ptr});
+  } else {
+    count = codegen->CreateAdd(codegen->CreateLoad(counter_ptr),
+                               codegen.Const64(1));
+    codegen->CreateStore(count, counter_ptr);
+  }
+
+  // The number of rows past the offset, which is only meaningful once we are
+  // past the offset
+  llvm::Value *past_offset = codegen->CreateSub(count, offset);
+
+  // Pass on the row if it falls in the window
+  llvm::Value *in_window = codegen->CreateAnd(
+      codegen->CreateICmpUGT(count, offset),
+      codegen->CreateICmpULE(past_offset, limit));
+  lang::If row_in_window{codegen, in_window, "rowInWindow"};
+  {
+    context.Consume(row);
+  }
+  row_in_window.EndIf();
+
+  // Stop the pipeline once we've reached the limit
+  llvm::Value *done = codegen->CreateAnd(
+      codegen->CreateICmpUGE(count, offset),
+      codegen->CreateICmpUGE(past_offset, limit));
+  lang::If limit_reached{codegen, done, "limitReached"};
+  {
+    context.GetPipeline().Terminate(codegen);
+  }
+  limit_reached.EndIf();
+}
+
+}  // namespace codegen
+}  // namespace peloton
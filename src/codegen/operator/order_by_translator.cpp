@@ -13,6 +13,7 @@
 #include "codegen/operator/order_by_translator.h"
 
 #include "codegen/function_builder.h"
+#include "codegen/proxy/query_parameters_proxy.h"
 #include "codegen/proxy/runtime_functions_proxy.h"
 #include "codegen/proxy/sorter_proxy.h"
 #include "codegen/type/integer_type.h"
@@ -120,11 +121,14 @@ void OrderByTranslator::ProduceResults::ProcessEntries(
 ///
 ////////////////////////////////////////////////////////////////////////////////
 
+std::atomic<bool> OrderByTranslator::kUseTopK{true};
+
 OrderByTranslator::OrderByTranslator(const planner::OrderByPlan &plan,
                                      CompilationContext &context,
                                      Pipeline &pipeline)
     : OperatorTranslator(plan, context, pipeline),
-      child_pipeline_(this, Pipeline::Parallelism::Serial) {
+      child_pipeline_(this, Pipeline::Parallelism::Serial),
+      use_top_k_(kUseTopK && plan.GetLimit()) {
   // Aggregations happen serially (for now ...)
   pipeline.SetSerial();
 
@@ -196,7 +200,39 @@ OrderByTranslator::OrderByTranslator(const planner::OrderByPlan &plan,
 void OrderByTranslator::InitializeQueryState() {
   auto *sorter_ptr = LoadStatePtr(sorter_id_);
   auto *exec_ctx_ptr = GetExecutorContextPtr();
-  sorter_.Init(GetCodeGen(), sorter_ptr, exec_ctx_ptr, compare_func_);
+  sorter_.Init(GetCodeGen(), sorter_ptr, exec_ctx_ptr, compare_func_,
+               LoadTopK(GetCodeGen()));
+}
+
+// With a limit, only the first (limit + offset) tuples can make it into the
+// result, so the sorter needn't retain any others. We produce all of these
+// tuples, skipping the offset is left to the limit above us. A sum that
+// overflows means there is effectively no limit.
+llvm::Value *OrderByTranslator::LoadTopK(CodeGen &codegen) const {
+  if (!use_top_k_) {
+    return codegen.Const64(0);
+  }
+
+  // The limit and offset are query parameters. The parameter cache is only
+  // populated in pipeline functions, so we read them from the parameters.
+  const auto &plan = GetPlanAs<planner::OrderByPlan>();
+  auto &compilation_ctx = GetCompilationContext();
+  const auto &parameter_cache = compilation_ctx.GetParameterCache();
+  llvm::Value *query_params =
+      compilation_ctx.GetExecutionConsumer().GetQueryParametersPtr(
+          compilation_ctx);
+  llvm::Value *limit = codegen.Call(
+      QueryParametersProxy::GetBigInt,
+      {query_params,
+       codegen.Const32(parameter_cache.GetIndex(&plan.GetLimitNumber()))});
+  llvm::Value *offset = codegen.Call(
+      QueryParametersProxy::GetBigInt,
+      {query_params,
+       codegen.Const32(parameter_cache.GetIndex(&plan.GetLimitOffset()))});
+
+  llvm::Value *top_k = codegen->CreateAdd(limit, offset);
+  return codegen->CreateSelect(codegen->CreateICmpULT(top_k, limit),
+                               codegen.Const64(0), top_k);
 }
 
 void OrderByTranslator::TearDownQueryState() {
@@ -363,7 +399,8 @@ void OrderByTranslator::InitializePipelineState(PipelineContext &pipeline_ctx) {
     CodeGen &codegen = GetCodeGen();
     auto *sorter_ptr = pipeline_ctx.LoadStatePtr(codegen, thread_sorter_id_);
     auto *exec_ctx_ptr = GetExecutorContextPtr();
-    sorter_.Init(codegen, sorter_ptr, exec_ctx_ptr, compare_func_);
+    sorter_.Init(codegen, sorter_ptr, exec_ctx_ptr, compare_func_,
+                 LoadTopK(codegen));
   }
 }
 
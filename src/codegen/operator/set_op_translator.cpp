@@ -0,0 +1,452 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// set_op_translator.cpp
+//
+// Identification: src/codegen/operator/set_op_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/operator/set_op_translator.h"
+
+#include "codegen/lang/loop.h"
+#include "codegen/proxy/hash_table_proxy.h"
+#include "codegen/vector.h"
+#include "planner/append_plan.h"
+#include "planner/set_op_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+/**
+ * The callback used to add a set of counts to the entry of a key, which it
+ * inserts with the counts if the key isn't in the hash table yet.
+ */
+class SetOpTranslator::AddCounts : public HashTable::ProbeCallback,
+                                   public HashTable::InsertCallback {
+ public:
+  /**
+   * Constructor
+   *
+   * @param translator The translator reference
+   * @param counts The counts to add, one for every counter of an entry
+   */
+  AddCounts(const SetOpTranslator &translator,
+            const std::vector<llvm::Value *> &counts)
+      : translator_(translator), counts_(counts) {}
+
+  /**
+   * Add the counts to those of the existing entry
+   *
+   * @param codegen The codegen instance
+   * @param data_area Memory space where the counts of the entry are stored
+   */
+  void ProcessEntry(CodeGen &codegen, llvm::Value *data_area) const override {
+    std::vector<llvm::Value *> counts;
+    translator_.LoadCounts(codegen, data_area, counts);
+    for (uint32_t i = 0; i < counts_.size(); i++) {
+      counts[i] = codegen->CreateAdd(counts[i], counts_[i]);
+    }
+    StoreCounts(codegen, data_area, counts);
+  }
+
+  /**
+   * Store the counts in a new entry
+   *
+   * @param codegen The codegen instance
+   * @param space Memory space where the counts can be stored
+   */
+  void StoreValue(CodeGen &codegen, llvm::Value *space) const override {
+    StoreCounts(codegen, space, counts_);
+  }
+
+  /**
+   * Return the size of the counts of an entry
+   *
+   * @param codegen The codegen instance
+   * @return The number of bytes needed to store the counts
+   */
+  llvm::Value *GetValueSize(CodeGen &codegen) const override {
+    return codegen.Const32(translator_.num_counters_ * sizeof(int64_t));
+  }
+
+ private:
+  void StoreCounts(CodeGen &codegen, llvm::Value *data_area,
+                   const std::vector<llvm::Value *> &counts) const {
+    llvm::Value *counters = codegen->CreatePointerCast(
+        data_area, codegen.Int64Type()->getPointerTo());
+    for (uint32_t i = 0; i < counts.size(); i++) {
+      codegen->CreateStore(counts[i], codegen->CreateConstInBoundsGEP1_32(
+                                          codegen.Int64Type(), counters, i));
+    }
+  }
+
+ private:
+  // The translator (we need its counter layout)
+  const SetOpTranslator &translator_;
+
+  // The counts to add
+  const std::vector<llvm::Value *> &counts_;
+};
+
+/**
+ * The callback used to add the entries of a thread-local hash table to the
+ * global hash table.
+ */
+class SetOpTranslator::MergeCounts : public HashTable::IterateCallback {
+ public:
+  /**
+   * Constructor
+   *
+   * @param translator The translator reference
+   * @param global_ht_ptr A pointer to the global hash table
+   */
+  MergeCounts(const SetOpTranslator &translator, llvm::Value *global_ht_ptr)
+      : translator_(translator), global_ht_ptr_(global_ht_ptr) {}
+
+  /**
+   * Add the counts of the given entry of the local table to the global table
+   *
+   * @param codegen The codegen instance
+   * @param key The key stored in the local table
+   * @param data_area Memory space where the counts of the entry are stored
+   */
+  void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &key,
+                    llvm::Value *data_area) const override {
+    std::vector<llvm::Value *> counts;
+    translator_.LoadCounts(codegen, data_area, counts);
+    AddCounts add_counts{translator_, counts};
+    translator_.hash_table_.ProbeOrInsert(codegen, global_ht_ptr_, nullptr,
+                                          key, add_counts, add_counts);
+  }
+
+ private:
+  // The translator (we need its hash table)
+  const SetOpTranslator &translator_;
+
+  // The global hash table
+  llvm::Value *global_ht_ptr_;
+};
+
+/**
+ * The callback used to produce the rows of the entries in the hash table.
+ */
+class SetOpTranslator::ProduceRows : public HashTable::IterateCallback {
+ public:
+  /**
+   * Constructor
+   *
+   * @param translator The translator reference
+   * @param context The context to push the rows into
+   */
+  ProduceRows(const SetOpTranslator &translator, ConsumerContext &context)
+      : translator_(translator), context_(context) {}
+
+  /**
+   * Push the row of the given entry into the pipeline as many times as its
+   * counts demand
+   *
+   * @param codegen The codegen instance
+   * @param key The key stored in the table, i.e., the row
+   * @param data_area Memory space where the counts of the entry are stored
+   */
+  void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &key,
+                    llvm::Value *data_area) const override;
+
+ private:
+  // The translator (we need lots of its state)
+  const SetOpTranslator &translator_;
+
+  // The context
+  ConsumerContext &context_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Set Operation Translator
+///
+////////////////////////////////////////////////////////////////////////////////
+
+SetOpTranslator::SetOpTranslator(const planner::SetOpPlan &set_op,
+                                 CompilationContext &context,
+                                 Pipeline &pipeline)
+    : OperatorTranslator(set_op, context, pipeline) {
+  // Both inputs are counted, the left one in the first counter and the right
+  // one in the second
+  PELOTON_ASSERT(set_op.GetChildrenSize() == 2);
+  Setup(context, 0);
+}
+
+SetOpTranslator::SetOpTranslator(const planner::AppendPlan &append,
+                                 CompilationContext &context,
+                                 Pipeline &pipeline)
+    : OperatorTranslator(append, context, pipeline) {
+  // The rows of the other inputs are produced at the end of our pipeline
+  pipeline.InstallEpilogue(this);
+
+  // The first input streams through our pipeline, all others are counted
+  context.Prepare(*append.GetChild(0), pipeline);
+  Setup(context, 1);
+}
+
+void SetOpTranslator::Setup(CompilationContext &context,
+                            uint32_t first_counted_input) {
+  CodeGen &codegen = GetCodeGen();
+  const auto &input_ais = GetInputAttributes();
+
+  // Prepare the counted inputs, each in its own pipeline
+  first_counted_input_ = first_counted_input;
+  for (uint32_t i = first_counted_input; i < input_ais.size(); i++) {
+    input_pipelines_.emplace_back(
+        new Pipeline(this, Pipeline::Parallelism::Flexible));
+    context.Prepare(*GetPlan().GetChild(i), *input_pipelines_.back());
+  }
+
+  // Rows are keyed on all columns. A column is nullable if it is in any input.
+  std::vector<type::Type> key_type;
+  for (uint32_t col_idx = 0; col_idx < input_ais[0].size(); col_idx++) {
+    type::Type col_type = input_ais[0][col_idx]->type;
+    for (const auto &ais : input_ais) {
+      if (ais[col_idx]->type.nullable) {
+        col_type = col_type.AsNullable();
+      }
+    }
+    key_type.push_back(col_type);
+  }
+
+  // Register the hash table instance in the runtime state
+  hash_table_id_ = context.GetQueryState().RegisterState(
+      "setOp", HashTableProxy::GetType(codegen));
+
+  // Create the hash table, with a counter for every counted input of an
+  // intersection or difference, or a single one for an append
+  num_counters_ = IsAppend() ? 1 : 2;
+  auto value_size = static_cast<uint32_t>(num_counters_ * sizeof(int64_t));
+  hash_table_ = HashTable{codegen, key_type, value_size};
+}
+
+void SetOpTranslator::InitializeQueryState() {
+  hash_table_.Init(GetCodeGen(), GetExecutorContextPtr(),
+                   LoadStatePtr(hash_table_id_));
+}
+
+void SetOpTranslator::RegisterPipelineState(PipelineContext &pipeline_ctx) {
+  if (IsParallelInputPipeline(pipeline_ctx)) {
+    local_hash_table_id_ = pipeline_ctx.RegisterState(
+        "localSetOp", HashTableProxy::GetType(GetCodeGen()));
+  }
+}
+
+void SetOpTranslator::InitializePipelineState(PipelineContext &pipeline_ctx) {
+  if (IsParallelInputPipeline(pipeline_ctx)) {
+    CodeGen &codegen = GetCodeGen();
+    hash_table_.Init(codegen, GetExecutorContextPtr(),
+                     pipeline_ctx.LoadStatePtr(codegen, local_hash_table_id_));
+  }
+}
+
+// Add up the counts of the thread-local tables in the global table. Different
+// threads may count the same rows, so the merge runs serially.
+void SetOpTranslator::FinishPipeline(PipelineContext &pipeline_ctx) {
+  if (!IsParallelInputPipeline(pipeline_ctx)) {
+    return;
+  }
+
+  CodeGen &codegen = GetCodeGen();
+  PipelineContext::LoopOverStates loop_states{pipeline_ctx};
+  loop_states.Do([this, &pipeline_ctx, &codegen](llvm::Value *thread_state) {
+    PipelineContext::SetState state_access{pipeline_ctx, thread_state};
+    MergeCounts merge_counts{*this, LoadStatePtr(hash_table_id_)};
+    hash_table_.Iterate(
+        codegen, pipeline_ctx.LoadStatePtr(codegen, local_hash_table_id_),
+        merge_counts);
+  });
+}
+
+void SetOpTranslator::TearDownPipelineState(PipelineContext &pipeline_ctx) {
+  if (IsParallelInputPipeline(pipeline_ctx)) {
+    CodeGen &codegen = GetCodeGen();
+    hash_table_.Destroy(
+        codegen, pipeline_ctx.LoadStatePtr(codegen, local_hash_table_id_));
+  }
+}
+
+void SetOpTranslator::Produce() const {
+  // Let the counted inputs produce their rows, which we count in the table
+  for (uint32_t i = 0; i < input_pipelines_.size(); i++) {
+    const auto *input = GetPlan().GetChild(first_counted_input_ + i);
+    GetCompilationContext().Produce(*input);
+  }
+
+  // Appends stream their first input through, and produce the counted rows in
+  // the epilogue of the pipeline
+  if (IsAppend()) {
+    GetCompilationContext().Produce(*GetPlan().GetChild(0));
+    return;
+  }
+
+  // Intersections and differences produce the counted rows in a new pipeline
+  auto producer = [this](ConsumerContext &ctx) {
+    ProduceRows produce_rows{*this, ctx};
+    hash_table_.Iterate(GetCodeGen(), LoadStatePtr(hash_table_id_),
+                        produce_rows);
+  };
+  GetPipeline().RunSerial(producer);
+}
+
+void SetOpTranslator::Consume(ConsumerContext &context,
+                              RowBatch::Row &row) const {
+  CodeGen &codegen = GetCodeGen();
+
+  // The rows of the first input of an append go straight to the parent
+  uint32_t input_idx = InputIndex(context.GetPipeline());
+  if (IsAppend() && input_idx == 0) {
+    context.Consume(row);
+    return;
+  }
+
+  // The row is the key
+  std::vector<codegen::Value> key;
+  for (const auto *ai : GetInputAttributes()[input_idx]) {
+    key.push_back(row.DeriveValue(codegen, ai));
+  }
+
+  // Count the row once, for its input
+  std::vector<llvm::Value *> counts(num_counters_, codegen.Const64(0));
+  counts[CounterIndex(input_idx)] = codegen.Const64(1);
+
+  llvm::Value *ht_ptr = nullptr;
+  if (context.GetPipeline().IsParallel()) {
+    ht_ptr = context.GetPipelineContext()->LoadStatePtr(codegen,
+                                                        local_hash_table_id_);
+  } else {
+    ht_ptr = LoadStatePtr(hash_table_id_);
+  }
+
+  AddCounts add_counts{*this, counts};
+  hash_table_.ProbeOrInsert(codegen, ht_ptr, nullptr, key, add_counts,
+                            add_counts);
+}
+
+void SetOpTranslator::ProduceEpilogue(ConsumerContext &context,
+                                      llvm::Value *thread_idx,
+                                      llvm::Value *num_threads) const {
+  // Each thread produces the rows in its share of the buckets
+  ProduceRows produce_rows{*this, context};
+  hash_table_.IterateStrided(GetCodeGen(), LoadStatePtr(hash_table_id_),
+                             thread_idx, num_threads, produce_rows);
+}
+
+void SetOpTranslator::TearDownQueryState() {
+  hash_table_.Destroy(GetCodeGen(), LoadStatePtr(hash_table_id_));
+}
+
+uint32_t SetOpTranslator::InputIndex(const Pipeline &pipeline) const {
+  for (uint32_t i = 0; i < input_pipelines_.size(); i++) {
+    if (*input_pipelines_[i] == pipeline) {
+      return first_counted_input_ + i;
+    }
+  }
+  PELOTON_ASSERT(IsAppend() && pipeline == GetPipeline());
+  return 0;
+}
+
+llvm::Value *SetOpTranslator::NumCopies(
+    CodeGen &codegen, const std::vector<llvm::Value *> &counts) const {
+  if (IsAppend()) {
+    return counts[0];
+  }
+
+  llvm::Value *left = counts[0];
+  llvm::Value *right = counts[1];
+  llvm::Value *zero = codegen.Const64(0);
+  switch (GetPlanAs<planner::SetOpPlan>().GetSetOp()) {
+    case SetOpType::INTERSECT: {
+      llvm::Value *in_both =
+          codegen->CreateAnd(codegen->CreateICmpUGT(left, zero),
+                             codegen->CreateICmpUGT(right, zero));
+      return codegen->CreateZExt(in_both, codegen.Int64Type());
+    }
+    case SetOpType::INTERSECT_ALL: {
+      return codegen->CreateSelect(codegen->CreateICmpULT(left, right), left,
+                                   right);
+    }
+    case SetOpType::EXCEPT: {
+      llvm::Value *left_only =
+          codegen->CreateAnd(codegen->CreateICmpUGT(left, zero),
+                             codegen->CreateICmpEQ(right, zero));
+      return codegen->CreateZExt(left_only, codegen.Int64Type());
+    }
+    case SetOpType::EXCEPT_ALL: {
+      return codegen->CreateSelect(codegen->CreateICmpUGT(left, right),
+                                   codegen->CreateSub(left, right), zero);
+    }
+    default: {
+      throw Exception{"Set operation type not supported: " +
+                      SetOpTypeToString(
+                          GetPlanAs<planner::SetOpPlan>().GetSetOp())};
+    }
+  }
+}
+
+void SetOpTranslator::LoadCounts(CodeGen &codegen, llvm::Value *data_area,
+                                 std::vector<llvm::Value *> &counts) const {
+  llvm::Value *counters = codegen->CreatePointerCast(
+      data_area, codegen.Int64Type()->getPointerTo());
+  for (uint32_t i = 0; i < num_counters_; i++) {
+    counts.push_back(codegen->CreateLoad(codegen->CreateConstInBoundsGEP1_32(
+        codegen.Int64Type(), counters, i)));
+  }
+}
+
+const std::vector<std::vector<const planner::AttributeInfo *>>
+    &SetOpTranslator::GetInputAttributes() const {
+  if (IsAppend()) {
+    return GetPlanAs<planner::AppendPlan>().GetInputAttributes();
+  } else {
+    return GetPlanAs<planner::SetOpPlan>().GetInputAttributes();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// ProduceRows
+///
+////////////////////////////////////////////////////////////////////////////////
+
+void SetOpTranslator::ProduceRows::ProcessEntry(
+    CodeGen &codegen, const std::vector<codegen::Value> &key,
+    llvm::Value *data_area) const {
+  std::vector<llvm::Value *> counts;
+  translator_.LoadCounts(codegen, data_area, counts);
+  llvm::Value *num_copies = translator_.NumCopies(codegen, counts);
+
+  llvm::Value *copy = codegen.Const64(0);
+  lang::Loop copy_loop{codegen, codegen->CreateICmpULT(copy, num_copies),
+                       {{"copy", copy}}};
+  {
+    copy = copy_loop.GetLoopVar(0);
+
+    // A single-row batch for the row
+    RowBatch::WithSingleRow(context_.GetCompilationContext(), [&](
+        RowBatch::Row &row) {
+      // The output attributes are those of the first input
+      const auto &output_ais = translator_.GetInputAttributes()[0];
+      for (uint32_t i = 0; i < output_ais.size(); i++) {
+        row.RegisterAttributeValue(output_ais[i], key[i]);
+      }
+
+      // Send the row up to the parent
+      context_.Consume(row);
+    });
+
+    copy = codegen->CreateAdd(copy, codegen.Const64(1));
+    copy_loop.LoopEnd(codegen->CreateICmpULT(copy, num_copies), {copy});
+  }
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -13,6 +13,7 @@
 #include "codegen/operator/table_scan_translator.h"
 
 #include "codegen/lang/if.h"
+#include "codegen/proxy/bitmap_index_proxy.h"
 #include "codegen/proxy/executor_context_proxy.h"
 #include "codegen/proxy/runtime_functions_proxy.h"
 #include "codegen/proxy/storage_manager_proxy.h"
@@ -21,6 +22,7 @@
 #include "codegen/type/boolean_type.h"
 #include "codegen/vector.h"
 #include "planner/seq_scan_plan.h"
+#include "storage/bitmap_index.h"
 #include "storage/data_table.h"
 
 namespace peloton {
@@ -74,10 +76,13 @@ class TableScanTranslator::ScanConsumer : public codegen::ScanCallback {
  public:
   // Constructor
   ScanConsumer(ConsumerContext &ctx, const planner::SeqScanPlan &plan,
-               Vector &selection_vector)
+               Vector &selection_vector, llvm::Value *bitmap_predicate_ptr,
+               const SimdPredicate *simd_predicate)
       : ctx_(ctx),
         plan_(plan),
         selection_vector_(selection_vector),
+        bitmap_predicate_ptr_(bitmap_predicate_ptr),
+        simd_predicate_(simd_predicate),
         tile_group_id_(nullptr),
         tile_group_ptr_(nullptr) {}
 
@@ -96,6 +101,11 @@ class TableScanTranslator::ScanConsumer : public codegen::ScanCallback {
   // The callback when finishing iteration over a tile group
   void TileGroupFinish(CodeGen &, llvm::Value *) override {}
 
+  // Stop scanning once the pipeline was terminated (e.g., by a limit)
+  llvm::Value *ShouldStop(CodeGen &codegen) override {
+    return ctx_.GetPipeline().IsTerminated(codegen);
+  }
+
  private:
   void SetupRowBatch(RowBatch &batch,
                      TileGroup::TileGroupAccess &tile_group_access,
@@ -114,6 +124,13 @@ class TableScanTranslator::ScanConsumer : public codegen::ScanCallback {
                              llvm::Value *tid_start, llvm::Value *tid_end,
                              Vector &selection_vector) const;
 
+  // Filter the rows by evaluating the predicate on one row at a time
+  void FilterRowsByScalarPredicate(CodeGen &codegen,
+                                   const TileGroup::TileGroupAccess &access,
+                                   llvm::Value *tid_start,
+                                   llvm::Value *tid_end,
+                                   Vector &selection_vector) const;
+
  private:
   // The consumer context
   ConsumerContext &ctx_;
@@ -121,6 +138,10 @@ class TableScanTranslator::ScanConsumer : public codegen::ScanCallback {
   const planner::SeqScanPlan &plan_;
   // The selection vector used for vectorized scans
   Vector &selection_vector_;
+  // The bitmap predicate used to produce candidate tuples (may be null)
+  llvm::Value *bitmap_predicate_ptr_;
+  // The predicate evaluated with SIMD instructions (may be null)
+  const SimdPredicate *simd_predicate_;
   // The current tile group id we're scanning over
   llvm::Value *tile_group_id_;
   // The current tile group we're scanning over
@@ -133,10 +154,15 @@ class TableScanTranslator::ScanConsumer : public codegen::ScanCallback {
 ///
 ////////////////////////////////////////////////////////////////////////////////
 
+std::atomic<bool> TableScanTranslator::kUseSimdPredicates{true};
+
 TableScanTranslator::TableScanTranslator(const planner::SeqScanPlan &scan,
                                          CompilationContext &context,
                                          Pipeline &pipeline)
-    : OperatorTranslator(scan, context, pipeline), table_(*scan.GetTable()) {
+    : OperatorTranslator(scan, context, pipeline),
+      table_(*scan.GetTable()),
+      use_bitmap_index_(false),
+      use_simd_predicate_(false) {
   // Set ourselves as the source of the pipeline
   auto parallelism = scan.IsParallel() ? Pipeline::Parallelism::Parallel
                                        : Pipeline::Parallelism::Serial;
@@ -146,6 +172,49 @@ TableScanTranslator::TableScanTranslator(const planner::SeqScanPlan &scan,
   const auto *predicate = scan.GetPredicate();
   if (predicate != nullptr) {
     context.Prepare(*predicate);
+
+    // Check if the predicate is simple enough for SIMD instructions
+    use_simd_predicate_ =
+        kUseSimdPredicates && simd_predicate_.Setup(*predicate);
+  }
+
+  // If some of the predicate can be answered by tile group bitmap indexes, we
+  // keep a storage::BitmapPredicate in the query state to produce the
+  // candidate tuples of every batch
+  if (storage::BitmapPredicate::CollectTerms(predicate, bitmap_terms_)) {
+    use_bitmap_index_ = true;
+    bitmap_predicate_id_ = context.GetQueryState().RegisterState(
+        "bitmapPredicate", BitmapPredicateProxy::GetType(GetCodeGen()));
+  }
+}
+
+void TableScanTranslator::InitializeQueryState() {
+  if (use_bitmap_index_) {
+    CodeGen &codegen = GetCodeGen();
+    llvm::Value *bitmap_predicate_ptr = LoadStatePtr(bitmap_predicate_id_);
+    codegen.Call(BitmapPredicateProxy::Init, {bitmap_predicate_ptr});
+
+    // The values of the terms are read from the query parameters, since the
+    // compiled query is reused for other values of the plan's constants
+    const auto &parameter_cache =
+        GetCompilationContext().GetParameterCache();
+    for (const auto &term : bitmap_terms_) {
+      codegen.Call(BitmapPredicateProxy::AddTerm,
+                   {bitmap_predicate_ptr, codegen.Const32(term.col_id)});
+      for (const auto *value : term.values) {
+        uint32_t param_idx = parameter_cache.GetIndex(value);
+        codegen.Call(BitmapPredicateProxy::AddValue,
+                     {bitmap_predicate_ptr, GetExecutorContextPtr(),
+                      codegen.Const32(param_idx)});
+      }
+    }
+  }
+}
+
+void TableScanTranslator::TearDownQueryState() {
+  if (use_bitmap_index_) {
+    GetCodeGen().Call(BitmapPredicateProxy::Destroy,
+                      {LoadStatePtr(bitmap_predicate_id_)});
   }
 }
 
@@ -164,6 +233,20 @@ llvm::Value *TableScanTranslator::LoadTablePtr(CodeGen &codegen) const {
                       {GetStorageManagerPtr(), db_oid, table_oid});
 }
 
+llvm::Value *TableScanTranslator::LoadPredicatePtr(CodeGen &codegen) const {
+  auto *predicate = GetScanPlan().GetPredicate();
+  return codegen.ConstPointer(
+      predicate, AbstractExpressionProxy::GetType(codegen)->getPointerTo());
+}
+
+const SimdPredicate *TableScanTranslator::GetSimdPredicate() const {
+  return use_simd_predicate_ ? &simd_predicate_ : nullptr;
+}
+
+llvm::Value *TableScanTranslator::LoadBitmapPredicatePtr() const {
+  return use_bitmap_index_ ? LoadStatePtr(bitmap_predicate_id_) : nullptr;
+}
+
 void TableScanTranslator::ProduceSerial() const {
   auto producer = [this](ConsumerContext &ctx) {
     CodeGen &codegen = GetCodeGen();
@@ -179,9 +262,7 @@ void TableScanTranslator::ProduceSerial() const {
 
     auto predicate = const_cast<expression::AbstractExpression *>(
         GetScanPlan().GetPredicate());
-    llvm::Value *predicate_ptr = codegen->CreateIntToPtr(
-        codegen.Const64((int64_t)predicate),
-        AbstractExpressionProxy::GetType(codegen)->getPointerTo());
+    llvm::Value *predicate_ptr = LoadPredicatePtr(codegen);
     size_t num_preds = 0;
 
     auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
@@ -191,7 +272,8 @@ void TableScanTranslator::ProduceSerial() const {
       }
     }
 
-    ScanConsumer scan_consumer{ctx, GetScanPlan(), position_list};
+    ScanConsumer scan_consumer{ctx, GetScanPlan(), position_list,
+                               LoadBitmapPredicatePtr(), GetSimdPredicate()};
     table_.GenerateScan(codegen, table_ptr, nullptr, nullptr, vec_size,
                         predicate_ptr, num_preds, scan_consumer);
   };
@@ -236,9 +318,7 @@ void TableScanTranslator::ProduceParallel() const {
     // zonemap
     auto predicate = const_cast<expression::AbstractExpression *>(
         GetScanPlan().GetPredicate());
-    llvm::Value *predicate_ptr = codegen->CreateIntToPtr(
-        codegen.Const64((int64_t)predicate),
-        AbstractExpressionProxy::GetType(codegen)->getPointerTo());
+    llvm::Value *predicate_ptr = LoadPredicatePtr(codegen);
     size_t num_preds = 0;
 
     auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
@@ -249,7 +329,8 @@ void TableScanTranslator::ProduceParallel() const {
     }
 
     // Scan the given range of the table
-    ScanConsumer scan_consumer{ctx, GetScanPlan(), position_list};
+    ScanConsumer scan_consumer{ctx, GetScanPlan(), position_list,
+                               LoadBitmapPredicatePtr(), GetSimdPredicate()};
     table_.GenerateScan(codegen, table_ptr, tilegroup_start, tilegroup_end,
                         vec_size, predicate_ptr, num_preds, scan_consumer);
   };
@@ -338,10 +419,20 @@ void TableScanTranslator::ScanConsumer::FilterRowsByVisibility(
   llvm::Value *txn = ec.GetTransactionPtr(ctx_.GetCompilationContext());
   llvm::Value *raw_sel_vec = selection_vector.GetVectorPtr();
 
-  // Invoke TransactionRuntime::PerformVisibilityCheck(...)
-  llvm::Value *out_idx =
-      codegen.Call(TransactionRuntimeProxy::PerformVisibilityCheck,
-                   {txn, tile_group_ptr_, tid_start, tid_end, raw_sel_vec});
+  llvm::Value *out_idx = nullptr;
+  if (bitmap_predicate_ptr_ != nullptr) {
+    // Invoke TransactionRuntime::PerformBitmapVisibilityCheck(...), which only
+    // checks the tuples the tile group's bitmap indexes let through
+    out_idx = codegen.Call(
+        TransactionRuntimeProxy::PerformBitmapVisibilityCheck,
+        {txn, tile_group_ptr_, bitmap_predicate_ptr_, tid_start, tid_end,
+         raw_sel_vec});
+  } else {
+    // Invoke TransactionRuntime::PerformVisibilityCheck(...)
+    out_idx =
+        codegen.Call(TransactionRuntimeProxy::PerformVisibilityCheck,
+                     {txn, tile_group_ptr_, tid_start, tid_end, raw_sel_vec});
+  }
   selection_vector.SetNumElements(out_idx);
 }
 
@@ -349,6 +440,41 @@ void TableScanTranslator::ScanConsumer::FilterRowsByPredicate(
     CodeGen &codegen, const TileGroup::TileGroupAccess &access,
     llvm::Value *tid_start, llvm::Value *tid_end,
     Vector &selection_vector) const {
+  if (simd_predicate_ == nullptr) {
+    FilterRowsByScalarPredicate(codegen, access, tid_start, tid_end,
+                                selection_vector);
+    return;
+  }
+
+  // SIMD instructions can only load the values of contiguous columns. Which
+  // columns are contiguous depends on the layout of the tile group.
+  llvm::Value *num_visible = selection_vector.GetNumElements();
+  llvm::Value *num_simd = nullptr, *num_scalar = nullptr;
+  lang::If is_contiguous{
+      codegen, simd_predicate_->IsApplicable(codegen, access), "simdFilter"};
+  {
+    RowBatch batch{ctx_.GetCompilationContext(), tile_group_id_, tid_start,
+                   tid_end, selection_vector, true};
+    simd_predicate_->Filter(codegen,
+                            ctx_.GetCompilationContext().GetParameterCache(),
+                            access, batch, tid_start, tid_end);
+    num_simd = selection_vector.GetNumElements();
+  }
+  is_contiguous.ElseBlock("scalarFilter");
+  {
+    selection_vector.SetNumElements(num_visible);
+    FilterRowsByScalarPredicate(codegen, access, tid_start, tid_end,
+                                selection_vector);
+    num_scalar = selection_vector.GetNumElements();
+  }
+  is_contiguous.EndIf();
+  selection_vector.SetNumElements(is_contiguous.BuildPHI(num_simd, num_scalar));
+}
+
+void TableScanTranslator::ScanConsumer::FilterRowsByScalarPredicate(
+    CodeGen &codegen, const TileGroup::TileGroupAccess &access,
+    llvm::Value *tid_start, llvm::Value *tid_end,
+    Vector &selection_vector) const {
   // The batch we're filtering
   RowBatch batch{ctx_.GetCompilationContext(), tile_group_id_, tid_start,
                  tid_end, selection_vector, true};
@@ -43,6 +43,10 @@ codegen::Value ParameterCache::GetValue(
   return GetValue(parameters_map_.GetIndex(expr));
 }
 
+uint32_t ParameterCache::GetIndex(const void *value) const {
+  return parameters_map_.GetIndex(value);
+}
+
 void ParameterCache::Reset() { values_.clear(); }
 
 codegen::Value ParameterCache::DeriveParameterValue(
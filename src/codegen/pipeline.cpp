@@ -222,6 +222,34 @@ bool PipelineContext::HasState() const {
   return state_components_.size() > 1;
 }
 
+llvm::Value *PipelineContext::LoadNumThreads(CodeGen &codegen) const {
+  auto &compilation_ctx = pipeline_.GetCompilationContext();
+  llvm::Value *thread_states =
+      compilation_ctx.GetExecutionConsumer().GetThreadStatesPtr(
+          compilation_ctx);
+  return codegen.Load(ThreadStatesProxy::num_threads, thread_states);
+}
+
+llvm::Value *PipelineContext::LoadThreadIndex(CodeGen &codegen) const {
+  auto &compilation_ctx = pipeline_.GetCompilationContext();
+  llvm::Value *thread_states =
+      compilation_ctx.GetExecutionConsumer().GetThreadStatesPtr(
+          compilation_ctx);
+  llvm::Value *state_size =
+      codegen.Load(ThreadStatesProxy::state_size, thread_states);
+  llvm::Value *states = codegen.Load(ThreadStatesProxy::states, thread_states);
+
+  // The states are laid out contiguously, so the index follows from the
+  // offset of the current state
+  llvm::Value *offset = codegen->CreateSub(
+      codegen->CreatePtrToInt(AccessThreadState(codegen), codegen.Int64Type()),
+      codegen->CreatePtrToInt(states, codegen.Int64Type()));
+  return codegen->CreateTrunc(
+      codegen->CreateUDiv(offset,
+                          codegen->CreateZExt(state_size, codegen.Int64Type())),
+      codegen.Int32Type());
+}
+
 bool PipelineContext::IsParallel() const { return pipeline_.IsParallel(); }
 
 Pipeline &PipelineContext::GetPipeline() { return pipeline_; }
@@ -235,7 +263,9 @@ Pipeline &PipelineContext::GetPipeline() { return pipeline_; }
 Pipeline::Pipeline(CompilationContext &compilation_ctx)
     : compilation_ctx_(compilation_ctx),
       pipeline_index_(0),
-      parallelism_(Pipeline::Parallelism::Flexible) {
+      parallelism_(Pipeline::Parallelism::Flexible),
+      terminable_(false),
+      terminated_flag_id_(0) {
   id_ = compilation_ctx.RegisterPipeline(*this);
 }
 
@@ -303,6 +333,13 @@ const OperatorTranslator *Pipeline::NextStep() {
   }
 }
 
+// Move back to the given translator in this pipeline
+void Pipeline::MoveTo(const OperatorTranslator *translator) {
+  auto iter = std::find(pipeline_.begin(), pipeline_.end(), translator);
+  PELOTON_ASSERT(iter != pipeline_.end());
+  pipeline_index_ = static_cast<uint32_t>(iter - pipeline_.begin());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// Stage-related functionality
@@ -349,6 +386,104 @@ uint32_t Pipeline::GetTranslatorStage(
   return GetNumStages() - stage - 1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Epilogues
+///
+////////////////////////////////////////////////////////////////////////////////
+
+void Pipeline::InstallEpilogue(
+    UNUSED_ATTRIBUTE const OperatorTranslator *translator) {
+  // Validate the assumption
+  PELOTON_ASSERT(pipeline_[pipeline_index_] == translator);
+  epilogues_.push_back(pipeline_index_);
+}
+
+// Let each operator that installed an epilogue produce its remaining rows.
+// Operators are added to the pipeline from the top down, so the epilogues are
+// installed in the same order. We produce them bottom up, since the rows of a
+// lower operator's epilogue flow through the operators above it. For the same
+// reason, an epilogue is only prepared once all epilogues below it are done.
+void Pipeline::ProduceEpilogues(PipelineContext &pipeline_ctx) {
+  CodeGen &codegen = compilation_ctx_.GetCodeGen();
+  auto &execution_consumer = compilation_ctx_.GetExecutionConsumer();
+
+  for (auto riter = epilogues_.rbegin(), rend = epilogues_.rend();
+       riter != rend; ++riter) {
+    uint32_t epilogue_index = *riter;
+    pipeline_[epilogue_index]->PrepareEpilogue(pipeline_ctx);
+
+    if (!IsParallel()) {
+      ProduceEpilogue(pipeline_ctx, epilogue_index, codegen.Const32(0),
+                      codegen.Const32(1));
+      continue;
+    }
+
+    // Each thread state produces its share of the epilogue. All of them are
+    // done before the next epilogue is prepared.
+    PipelineContext::LoopOverStates loop_states{pipeline_ctx};
+    loop_states.DoParallel([this, &pipeline_ctx, &codegen, &execution_consumer,
+                            epilogue_index](
+        UNUSED_ATTRIBUTE llvm::Value *thread_state) {
+      // The epilogue runs in its own function, so the consumer sets up again
+      execution_consumer.InitializePipelineState(pipeline_ctx);
+
+      ProduceEpilogue(pipeline_ctx, epilogue_index,
+                      pipeline_ctx.LoadThreadIndex(codegen),
+                      pipeline_ctx.LoadNumThreads(codegen));
+    });
+  }
+}
+
+void Pipeline::ProduceEpilogue(PipelineContext &pipeline_ctx,
+                               uint32_t epilogue_index, llvm::Value *thread_idx,
+                               llvm::Value *num_threads) {
+  pipeline_index_ = epilogue_index;
+  ConsumerContext ctx{compilation_ctx_, *this, &pipeline_ctx};
+  pipeline_[pipeline_index_]->ProduceEpilogue(ctx, thread_idx, num_threads);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Early termination
+///
+////////////////////////////////////////////////////////////////////////////////
+
+void Pipeline::AllowEarlyTermination() {
+  if (terminable_) {
+    return;
+  }
+
+  // The query state is zeroed before every execution, so the pipeline starts
+  // out running
+  CodeGen &codegen = compilation_ctx_.GetCodeGen();
+  terminated_flag_id_ = compilation_ctx_.GetQueryState().RegisterState(
+      "pipeline" + std::to_string(id_) + "Terminated", codegen.BoolType());
+  terminable_ = true;
+}
+
+llvm::Value *Pipeline::IsTerminated(CodeGen &codegen) const {
+  if (!terminable_) {
+    return nullptr;
+  }
+
+  // The flag may be set by another thread in a parallel pipeline. A volatile
+  // load keeps it from being hoisted out of the scan loops.
+  auto &query_state = compilation_ctx_.GetQueryState();
+  llvm::Value *flag_ptr =
+      query_state.LoadStatePtr(codegen, terminated_flag_id_);
+  llvm::LoadInst *flag = codegen->CreateLoad(flag_ptr);
+  flag->setVolatile(true);
+  return flag;
+}
+
+void Pipeline::Terminate(CodeGen &codegen) const {
+  PELOTON_ASSERT(terminable_);
+  auto &query_state = compilation_ctx_.GetQueryState();
+  codegen->CreateStore(codegen.ConstBool(true),
+                       query_state.LoadStatePtr(codegen, terminated_flag_id_));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// Serial/parallel execution functionality
@@ -554,6 +689,11 @@ void Pipeline::DoRun(
     ConsumerContext ctx{compilation_ctx_, *this, &pipeline_ctx};
     body(ctx, pipeline_args);
 
+    // A serial pipeline produces its epilogues once the source is done
+    if (!IsParallel()) {
+      ProduceEpilogues(pipeline_ctx);
+    }
+
     // Finish
     func.ReturnAndFinish();
   }
@@ -599,6 +739,11 @@ void Pipeline::DoRun(
   } else {
     codegen.CallFunc(func.GetFunction(), invoke_args);
   }
+
+  // A parallel pipeline produces its epilogues once all threads are done
+  if (IsParallel()) {
+    ProduceEpilogues(pipeline_ctx);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
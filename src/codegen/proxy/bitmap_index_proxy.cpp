@@ -0,0 +1,29 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bitmap_index_proxy.cpp
+//
+// Identification: src/codegen/proxy/bitmap_index_proxy.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/bitmap_index_proxy.h"
+
+#include "codegen/proxy/executor_context_proxy.h"
+#include "codegen/proxy/runtime_functions_proxy.h"
+
+namespace peloton {
+namespace codegen {
+
+DEFINE_TYPE(BitmapPredicate, "peloton::storage::BitmapPredicate", opaque);
+
+DEFINE_METHOD(peloton::storage, BitmapPredicate, Init);
+DEFINE_METHOD(peloton::storage, BitmapPredicate, AddTerm);
+DEFINE_METHOD(peloton::storage, BitmapPredicate, AddValue);
+DEFINE_METHOD(peloton::storage, BitmapPredicate, Destroy);
+
+}  // namespace codegen
+}  // namespace peloton
@@ -50,6 +50,8 @@ DEFINE_METHOD(peloton::codegen::util, HashTable, InsertLazy);
 DEFINE_METHOD(peloton::codegen::util, HashTable, BuildLazy);
 DEFINE_METHOD(peloton::codegen::util, HashTable, ReserveLazy);
 DEFINE_METHOD(peloton::codegen::util, HashTable, MergeLazyUnfinished);
+DEFINE_METHOD(peloton::codegen::util, HashTable, PartitionLazyUnfinished);
+DEFINE_METHOD(peloton::codegen::util, HashTable, NumPartitions);
 DEFINE_METHOD(peloton::codegen::util, HashTable, Destroy);
 
 }  // namespace codegen
@@ -35,6 +35,7 @@ DEFINE_METHOD(peloton::codegen, RuntimeFunctions, GetTileGroupLayout);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, FillPredicateArray);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ExecuteTableScan);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ExecutePerState);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, IncrementCounter);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ThrowDivideByZeroException);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ThrowOverflowException);
 
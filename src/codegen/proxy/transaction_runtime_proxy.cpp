@@ -13,6 +13,7 @@
 #include "codegen/proxy/transaction_runtime_proxy.h"
 
 #include "codegen/transaction_runtime.h"
+#include "codegen/proxy/bitmap_index_proxy.h"
 #include "codegen/proxy/data_table_proxy.h"
 #include "codegen/proxy/transaction_context_proxy.h"
 #include "codegen/proxy/tile_group_proxy.h"
@@ -23,6 +24,8 @@ namespace codegen {
 
 DEFINE_METHOD(peloton::codegen, TransactionRuntime, PerformVectorizedRead);
 DEFINE_METHOD(peloton::codegen, TransactionRuntime, PerformVisibilityCheck);
+DEFINE_METHOD(peloton::codegen, TransactionRuntime,
+              PerformBitmapVisibilityCheck);
 
 }  // namespace codegen
 }  // namespace peloton
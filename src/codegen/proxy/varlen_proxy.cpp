@@ -15,7 +15,7 @@
 namespace peloton {
 namespace codegen {
 
-DEFINE_TYPE(Varlen, "peloton::Varlen", length, ptr);
+DEFINE_TYPE(Varlen, "peloton::type::VarlenSlot", length, prefix, data);
 
 }  // namespace codegen
 }  // namespace peloton
\ No newline at end of file
@@ -11,6 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "codegen/query.h"
+
+#include <mutex>
+
 #include "codegen/interpreter/bytecode_builder.h"
 #include "codegen/interpreter/bytecode_interpreter.h"
 #include "codegen/query_compiler.h"
@@ -20,27 +23,52 @@
 #include "executor/executor_context.h"
 #include "storage/storage_manager.h"
 #include "settings/settings_manager.h"
+#include "threadpool/mono_queue_pool.h"
 
 namespace peloton {
 namespace codegen {
 
+// The query functions translated to bytecode
+struct Query::BytecodeFunctions {
+  interpreter::BytecodeFunction init_func;
+  interpreter::BytecodeFunction plan_func;
+  interpreter::BytecodeFunction tear_down_func;
+};
+
+// The state shared between a query and its background compilation
+struct Query::CompilationState {
+  // Held while compiling or translating to bytecode
+  std::mutex lock;
+
+  // Whether a background compilation has been scheduled
+  bool scheduled = false;
+
+  // Set when the query is destroyed before its background compilation ran
+  bool cancelled = false;
+};
+
 // Constructor
 Query::Query(const planner::AbstractPlan &query_plan)
-    : query_plan_(query_plan) {}
+    : query_plan_(query_plan),
+      parameter_size_(0),
+      is_compiled_(false),
+      bytecode_functions_(nullptr),
+      compilation_state_(new CompilationState()) {}
+
+Query::~Query() {
+  {
+    std::lock_guard<std::mutex> guard{compilation_state_->lock};
+    compilation_state_->cancelled = true;
+  }
+  delete bytecode_functions_.load();
+}
 
 void Query::Execute(executor::ExecutorContext &executor_context,
                     ExecutionConsumer &consumer, RuntimeStats *stats) {
-  CodeGen codegen{code_context_};
-
-  llvm::Type *query_state_type = query_state_.GetType();
-  size_t parameter_size = codegen.SizeOf(query_state_type);
-  PELOTON_ASSERT((parameter_size % 8 == 0) &&
-      "parameter size not multiple of 8");
-
   // Allocate some space for the function arguments
-  std::unique_ptr<char[]> param_data{new char[parameter_size]};
+  std::unique_ptr<char[]> param_data{new char[parameter_size_]};
   char *param = param_data.get();
-  PELOTON_MEMSET(param, 0, parameter_size);
+  PELOTON_MEMSET(param, 0, parameter_size_);
 
   // Set up the function arguments
   auto *func_args = reinterpret_cast<FunctionArguments *>(param_data.get());
@@ -54,31 +82,50 @@ void Query::Execute(executor::ExecutorContext &executor_context,
     ExecuteNative(func_args, stats);
   } else {
     try {
-      ExecuteInterpreter(func_args, stats);
+      ExecuteInterpreter(func_args, stats, !force_interpreter);
     } catch (interpreter::NotSupportedException e) {
       LOG_ERROR("query not supported by interpreter: %s", e.what());
     }
   }
 }
 
-void Query::Prepare(const LLVMFunctions &query_funcs) {
+bool Query::Prepare(const LLVMFunctions &query_funcs) {
   llvm_functions_ = query_funcs;
 
+  CodeGen codegen{code_context_};
+  parameter_size_ = codegen.SizeOf(query_state_.GetType());
+  PELOTON_ASSERT((parameter_size_ % 8 == 0) &&
+      "parameter size not multiple of 8");
+
   // verify the functions
   // will also be done by Optimize() or Compile() if not done before,
   // but we do not want to mix up the timings, so do it here
   code_context_.Verify();
 
-  // optimize the functions
+  // optimize the functions, unless the code has been compiled in an
+  // earlier run already
   // TODO(marcel): add switch to enable/disable optimization
   // TODO(marcel): add timer to measure time used for optimization (see
   // RuntimeStats)
-  code_context_.Optimize();
+  bool found_cached_object = code_context_.FindCachedObject();
+  if (!found_cached_object) {
+    code_context_.Optimize();
+  }
 
   is_compiled_ = false;
+  return found_cached_object;
 }
 
 void Query::Compile(CompileStats *stats) {
+  std::lock_guard<std::mutex> guard{compilation_state_->lock};
+  CompileLocked(stats);
+}
+
+void Query::CompileLocked(CompileStats *stats) {
+  if (is_compiled_) {
+    return;
+  }
+
   // Timer
   Timer<std::milli> timer;
   if (stats != nullptr) {
@@ -117,6 +164,46 @@ void Query::Compile(CompileStats *stats) {
   }
 }
 
+void Query::CompileInBackground() {
+  if (is_compiled_) {
+    return;
+  }
+
+  // The bytecode has to be built before compilation starts, since both read
+  // the LLVM module. If the interpreter can't run the query, compile it now.
+  try {
+    PrepareInterpreter(nullptr);
+  } catch (interpreter::NotSupportedException &e) {
+    LOG_DEBUG("query not supported by interpreter, compiling: %s", e.what());
+    Compile();
+    return;
+  }
+
+  std::shared_ptr<CompilationState> state = compilation_state_;
+  {
+    std::lock_guard<std::mutex> guard{state->lock};
+    if (state->scheduled) {
+      return;
+    }
+    state->scheduled = true;
+  }
+
+  // The task keeps the shared state alive and only touches the query while
+  // holding the lock, which the destructor takes before the query goes away
+  auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+  work_pool.SubmitTask([this, state] {
+    std::lock_guard<std::mutex> guard{state->lock};
+    if (state->cancelled) {
+      return;
+    }
+    try {
+      CompileLocked(nullptr);
+    } catch (Exception &e) {
+      LOG_ERROR("background compilation failed: %s", e.what());
+    }
+  });
+}
+
 void Query::ExecuteNative(FunctionArguments *function_arguments,
                           RuntimeStats *stats) {
   // Start timer
@@ -173,42 +260,27 @@ void Query::ExecuteNative(FunctionArguments *function_arguments,
 }
 
 void Query::ExecuteInterpreter(FunctionArguments *function_arguments,
-                               RuntimeStats *stats) {
-  LOG_INFO("Using codegen interpreter to execute plan");
-
-  // Timer
-  Timer<std::milli> timer;
-  if (stats != nullptr) {
-    timer.Start();
-  }
+                               RuntimeStats *stats, bool allow_native) {
+  LOG_DEBUG("Using codegen interpreter to execute plan");
 
   // Create Bytecode
-  interpreter::BytecodeFunction init_bytecode =
-      interpreter::BytecodeBuilder::CreateBytecodeFunction(
-          code_context_, llvm_functions_.init_func);
-  interpreter::BytecodeFunction plan_bytecode =
-      interpreter::BytecodeBuilder::CreateBytecodeFunction(
-          code_context_, llvm_functions_.plan_func);
-  interpreter::BytecodeFunction tear_down_bytecode =
-      interpreter::BytecodeBuilder::CreateBytecodeFunction(
-          code_context_, llvm_functions_.tear_down_func);
+  PrepareInterpreter(stats);
+  const BytecodeFunctions &bytecode = *bytecode_functions_.load();
 
-  // Time initialization
+  // Timer
+  Timer<std::milli> timer;
   if (stats != nullptr) {
-    timer.Stop();
-    stats->interpreter_prepare_ms = timer.GetDuration();
-    timer.Reset();
     timer.Start();
   }
 
   // Call init
   LOG_TRACE("Calling query's init() ...");
   try {
-    interpreter::BytecodeInterpreter::ExecuteFunction(
-        init_bytecode, reinterpret_cast<char *>(function_arguments));
+    CallFunction(compiled_functions_.init_func, bytecode.init_func,
+                 function_arguments, allow_native);
   } catch (...) {
-    interpreter::BytecodeInterpreter::ExecuteFunction(
-        tear_down_bytecode, reinterpret_cast<char *>(function_arguments));
+    CallFunction(compiled_functions_.tear_down_func, bytecode.tear_down_func,
+                 function_arguments, allow_native);
     throw;
   }
 
@@ -222,11 +294,11 @@ void Query::ExecuteInterpreter(FunctionArguments *function_arguments,
   // Execute the query!
   LOG_TRACE("Calling query's plan() ...");
   try {
-    interpreter::BytecodeInterpreter::ExecuteFunction(
-        plan_bytecode, reinterpret_cast<char *>(function_arguments));
+    CallFunction(compiled_functions_.plan_func, bytecode.plan_func,
+                 function_arguments, allow_native);
   } catch (...) {
-    interpreter::BytecodeInterpreter::ExecuteFunction(
-        tear_down_bytecode, reinterpret_cast<char *>(function_arguments));
+    CallFunction(compiled_functions_.tear_down_func, bytecode.tear_down_func,
+                 function_arguments, allow_native);
     throw;
   }
 
@@ -240,8 +312,8 @@ void Query::ExecuteInterpreter(FunctionArguments *function_arguments,
 
   // Clean up
   LOG_TRACE("Calling query's tearDown() ...");
-  interpreter::BytecodeInterpreter::ExecuteFunction(
-      tear_down_bytecode, reinterpret_cast<char *>(function_arguments));
+  CallFunction(compiled_functions_.tear_down_func, bytecode.tear_down_func,
+               function_arguments, allow_native);
 
   // No need to cleanup if we get an exception while cleaning up...
   if (stats != nullptr) {
@@ -250,5 +322,50 @@ void Query::ExecuteInterpreter(FunctionArguments *function_arguments,
   }
 }
 
+void Query::CallFunction(const compiled_function_t &native_func,
+                         const interpreter::BytecodeFunction &bytecode_func,
+                         FunctionArguments *function_arguments,
+                         bool allow_native) {
+  // The functions share the layout of the query state, so a query that was
+  // initialized in the interpreter can carry on natively
+  if (allow_native && is_compiled_) {
+    native_func(function_arguments);
+  } else {
+    interpreter::BytecodeInterpreter::ExecuteFunction(
+        bytecode_func, reinterpret_cast<char *>(function_arguments));
+  }
+}
+
+void Query::PrepareInterpreter(RuntimeStats *stats) {
+  if (bytecode_functions_.load() != nullptr) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard{compilation_state_->lock};
+  if (bytecode_functions_.load() != nullptr) {
+    return;
+  }
+
+  // Timer
+  Timer<std::milli> timer;
+  if (stats != nullptr) {
+    timer.Start();
+  }
+
+  bytecode_functions_.store(new BytecodeFunctions{
+      interpreter::BytecodeBuilder::CreateBytecodeFunction(
+          code_context_, llvm_functions_.init_func),
+      interpreter::BytecodeBuilder::CreateBytecodeFunction(
+          code_context_, llvm_functions_.plan_func),
+      interpreter::BytecodeBuilder::CreateBytecodeFunction(
+          code_context_, llvm_functions_.tear_down_func)});
+
+  // Time bytecode translation
+  if (stats != nullptr) {
+    timer.Stop();
+    stats->interpreter_prepare_ms = timer.GetDuration();
+  }
+}
+
 }  // namespace codegen
 }  // namespace peloton
@@ -15,8 +15,10 @@
 #include "codegen/compilation_context.h"
 #include "planner/aggregate_plan.h"
 #include "planner/hash_join_plan.h"
+#include "planner/index_scan_plan.h"
 #include "planner/projection_plan.h"
 #include "planner/seq_scan_plan.h"
+#include "planner/set_op_plan.h"
 
 namespace peloton {
 namespace codegen {
@@ -48,6 +50,7 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan) {
     case PlanNodeType::SEQSCAN:
     case PlanNodeType::CSVSCAN:
     case PlanNodeType::ORDERBY:
+    case PlanNodeType::LIMIT:
     case PlanNodeType::DELETE:
     case PlanNodeType::INSERT:
     case PlanNodeType::UPDATE:
@@ -71,15 +74,40 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan) {
       }
       break;
     }
-    case PlanNodeType::NESTLOOP:
+    case PlanNodeType::INDEXSCAN: {
+      // Keys computed at runtime, and index scans whose limit was pushed down
+      // into them, still go through the interpreted executor
+      auto &scan_plan = static_cast<const planner::IndexScanPlan &>(plan);
+      if (!scan_plan.GetRunTimeKeys().empty() || scan_plan.GetLimit()) {
+        return false;
+      }
+      break;
+    }
+    case PlanNodeType::NESTLOOP: {
+      const auto &join = static_cast<const planner::AbstractJoinPlan &>(plan);
+      // Right now, nested-loop joins only support inner joins
+      if (join.GetJoinType() != JoinType::INNER) {
+        return false;
+      }
+      break;
+    }
     case PlanNodeType::HASHJOIN: {
       const auto &join = static_cast<const planner::AbstractJoinPlan &>(plan);
-      // Right now, only support inner joins
-      if (join.GetJoinType() == JoinType::INNER) {
-        break;
+      // Hash joins support inner, outer, semi and anti joins
+      if (join.GetJoinType() == JoinType::INVALID) {
+        return false;
       }
+      break;
     }
-    case PlanNodeType::HASH: {
+    case PlanNodeType::SETOP: {
+      const auto &set_op = static_cast<const planner::SetOpPlan &>(plan);
+      if (set_op.GetSetOp() == SetOpType::INVALID) {
+        return false;
+      }
+      break;
+    }
+    case PlanNodeType::HASH:
+    case PlanNodeType::APPEND: {
       break;
     }
     default: { return false; }
@@ -93,6 +121,11 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan) {
       pred = scan_plan.GetPredicate();
       break;
     }
+    case PlanNodeType::INDEXSCAN: {
+      auto &scan_plan = static_cast<const planner::IndexScanPlan &>(plan);
+      pred = scan_plan.GetPredicate();
+      break;
+    }
     case PlanNodeType::AGGREGATE_V2: {
       auto &agg_plan = static_cast<const planner::AggregatePlan &>(plan);
       pred = agg_plan.GetPredicate();
@@ -285,6 +285,15 @@ void RowBatch::Iterate(CodeGen &codegen,
   Iterate(codegen, adapter);
 }
 
+void RowBatch::WithSingleRow(CompilationContext &ctx,
+                             const std::function<void(RowBatch::Row &)> &cb) {
+  CodeGen &codegen = ctx.GetCodeGen();
+  Vector v{nullptr, 1, nullptr};
+  RowBatch one{ctx, codegen.Const32(0), codegen.Const32(1), v, false};
+  RowBatch::Row row{one, nullptr, nullptr};
+  cb(row);
+}
+
 // Iterate over all valid rows in this batch in vectors of a given size
 void RowBatch::VectorizedIterate(CodeGen &codegen,
                                  RowBatch::VectorizedIterateCallback &cb) {
@@ -18,6 +18,8 @@
 
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/numa.h"
+#include "common/platform.h"
 #include "common/timer.h"
 #include "common/synchronization/count_down_latch.h"
 #include "expression/abstract_expression.h"
@@ -145,6 +147,69 @@ void RuntimeFunctions::GetTileGroupLayout(const storage::TileGroup *tile_group,
                  (last_col_idx == (num_cols - 1)));
 }
 
+namespace {
+
+/// A contiguous range of tile groups [start, stop) scanned by a single task,
+/// together with the NUMA node the task should run on
+struct TableScanRange {
+  uint32_t start;
+  uint32_t stop;
+  int numa_node;
+};
+
+/// Split the table into (at most) one equally sized range per worker,
+/// without regard to where the tile groups live.
+std::vector<TableScanRange> PartitionScanEvenly(uint32_t num_tilegroups,
+                                                uint32_t num_workers) {
+  // Determine the number of tasks to generate. In this case, we use:
+  // num_tasks := num_tile_groups / num_workers
+  uint32_t num_tasks = std::min(num_workers, num_tilegroups);
+  uint32_t num_tilegroups_per_task = num_tilegroups / num_tasks;
+
+  std::vector<TableScanRange> ranges;
+  for (uint32_t task_id = 0; task_id < num_tasks; task_id++) {
+    bool last_task = (task_id == num_tasks - 1);
+    auto tilegroup_start = task_id * num_tilegroups_per_task;
+    auto tilegroup_stop =
+        last_task ? num_tilegroups : tilegroup_start + num_tilegroups_per_task;
+    ranges.push_back({tilegroup_start, tilegroup_stop, NumaUtil::kInvalidNode});
+  }
+  return ranges;
+}
+
+/// Split the table into runs of consecutive tile groups that live on the same
+/// NUMA node. Runs longer than a worker's fair share are split further so all
+/// workers get work. Returns an empty list if the placement is too fragmented
+/// to produce a reasonable number of tasks.
+std::vector<TableScanRange> PartitionScanByNumaNode(
+    const storage::DataTable &table, uint32_t num_tilegroups,
+    uint32_t num_workers) {
+  // Limit on the number of tasks before we give up on locality
+  const uint32_t max_num_tasks = num_workers * 4;
+  const uint32_t max_tilegroups_per_task =
+      (num_tilegroups + num_workers - 1) / num_workers;
+
+  std::vector<TableScanRange> ranges;
+  for (uint32_t tg = 0; tg < num_tilegroups; tg++) {
+    auto tile_group = table.GetTileGroup(tg);
+    int node = (tile_group != nullptr ? tile_group->GetNumaNode()
+                                      : NumaUtil::kInvalidNode);
+    if (!ranges.empty() && ranges.back().numa_node == node &&
+        ranges.back().stop - ranges.back().start < max_tilegroups_per_task) {
+      // Extend the current run
+      ranges.back().stop = tg + 1;
+      continue;
+    }
+    if (ranges.size() == max_num_tasks) {
+      return {};
+    }
+    ranges.push_back({tg, tg + 1, node});
+  }
+  return ranges;
+}
+
+}  // namespace
+
 void RuntimeFunctions::ExecuteTableScan(
     void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
     uint32_t db_oid, uint32_t table_oid, void *func) {
@@ -160,10 +225,17 @@ void RuntimeFunctions::ExecuteTableScan(
   auto *table = sm->GetTableWithOid(db_oid, table_oid);
   auto num_tilegroups = static_cast<uint32_t>(table->GetTileGroupCount());
 
-  // Determine the number of tasks to generate. In this case, we use:
-  // num_tasks := num_tile_groups / num_workers
-  uint32_t num_tasks = std::min(worker_pool.NumWorkers(), num_tilegroups);
-  uint32_t num_tilegroups_per_task = num_tilegroups / num_tasks;
+  // Carve the table into ranges. On NUMA machines, ranges follow the placement
+  // of the tile groups so that each task only touches memory of a single node.
+  std::vector<TableScanRange> ranges;
+  if (NumaUtil::IsNumaAware()) {
+    ranges = PartitionScanByNumaNode(*table, num_tilegroups,
+                                     worker_pool.NumWorkers());
+  }
+  if (ranges.empty()) {
+    ranges = PartitionScanEvenly(num_tilegroups, worker_pool.NumWorkers());
+  }
+  auto num_tasks = static_cast<uint32_t>(ranges.size());
 
   // Allocate states for each task
   thread_states.Allocate(num_tasks);
@@ -173,24 +245,28 @@ void RuntimeFunctions::ExecuteTableScan(
 
   // Now, submit the tasks
   for (uint32_t task_id = 0; task_id < num_tasks; task_id++) {
-    bool last_task = (task_id == num_tasks - 1);
-    auto tilegroup_start = task_id * num_tilegroups_per_task;
-    auto tilegroup_stop =
-        last_task ? num_tilegroups : tilegroup_start + num_tilegroups_per_task;
+    auto tilegroup_start = ranges[task_id].start;
+    auto tilegroup_stop = ranges[task_id].stop;
+    auto numa_node = ranges[task_id].numa_node;
     auto work = [&query_state, &thread_states, &scanner, &latch, task_id,
-                 tilegroup_start, tilegroup_stop]() {
-      LOG_DEBUG("Task-%u scanning tile groups [%u-%u)", task_id,
-                tilegroup_start, tilegroup_stop);
+                 tilegroup_start, tilegroup_stop, numa_node]() {
+      LOG_DEBUG("Task-%u scanning tile groups [%u-%u) on node %d", task_id,
+                tilegroup_start, tilegroup_stop, numa_node);
 
       // Time this
       Timer<std::milli> timer;
       timer.Start();
 
-      // Pull out this task's thread state
-      auto thread_state = thread_states.AccessThreadState(task_id);
+      {
+        // Run on the node holding the tile groups for the duration of the scan
+        NumaNodeGuard node_guard{numa_node};
+
+        // Pull out this task's thread state
+        auto thread_state = thread_states.AccessThreadState(task_id);
 
-      // Invoke scan function
-      scanner(query_state, thread_state, tilegroup_start, tilegroup_stop);
+        // Invoke scan function
+        scanner(query_state, thread_state, tilegroup_start, tilegroup_stop);
+      }
 
       // Count down latch
       latch.CountDown();
@@ -247,6 +323,10 @@ void RuntimeFunctions::ExecutePerState(
   latch.Await(0);
 }
 
+uint64_t RuntimeFunctions::IncrementCounter(uint64_t *counter) {
+  return atomic_add(counter, static_cast<uint64_t>(1)) + 1;
+}
+
 void RuntimeFunctions::ThrowDivideByZeroException() {
   throw DivideByZeroException("ERROR: division by zero");
 }
@@ -0,0 +1,290 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// simd_predicate.cpp
+//
+// Identification: src/codegen/simd_predicate.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/simd_predicate.h"
+
+#include "codegen/lang/loop.h"
+#include "codegen/parameter_cache.h"
+#include "codegen/row_batch.h"
+#include "codegen/type/sql_type.h"
+#include "codegen/vector.h"
+#include "expression/tuple_value_expression.h"
+
+namespace peloton {
+namespace codegen {
+
+constexpr uint32_t SimdPredicate::kNumLanes;
+
+namespace {
+
+// Is the given type a fixed-width integer whose values compare as signed ints?
+bool IsSignedInteger(peloton::type::TypeId type_id) {
+  switch (type_id) {
+    case peloton::type::TypeId::TINYINT:
+    case peloton::type::TypeId::SMALLINT:
+    case peloton::type::TypeId::INTEGER:
+    case peloton::type::TypeId::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Return the LLVM type the values of the given type are stored as
+llvm::Type *GetColumnType(CodeGen &codegen, peloton::type::TypeId type_id) {
+  llvm::Type *col_type = nullptr, *col_len_type = nullptr;
+  type::SqlType::LookupType(type_id)
+      .GetTypeForMaterialization(codegen, col_type, col_len_type);
+  PELOTON_ASSERT(col_type != nullptr && col_len_type == nullptr);
+  return col_type;
+}
+
+}  // namespace
+
+bool SimdPredicate::Setup(const expression::AbstractExpression &predicate) {
+  comparisons_.clear();
+  if (!CollectComparisons(predicate)) {
+    comparisons_.clear();
+  }
+  return !comparisons_.empty();
+}
+
+bool SimdPredicate::CollectComparisons(
+    const expression::AbstractExpression &expr) {
+  // All children of a conjunction must be supported
+  if (expr.GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+    for (uint32_t i = 0; i < expr.GetChildrenSize(); i++) {
+      if (!CollectComparisons(*expr.GetChild(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  llvm::CmpInst::Predicate cmp;
+  switch (expr.GetExpressionType()) {
+    case ExpressionType::COMPARE_EQUAL:
+      cmp = llvm::CmpInst::Predicate::ICMP_EQ;
+      break;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      cmp = llvm::CmpInst::Predicate::ICMP_NE;
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+      cmp = llvm::CmpInst::Predicate::ICMP_SLT;
+      break;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      cmp = llvm::CmpInst::Predicate::ICMP_SLE;
+      break;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      cmp = llvm::CmpInst::Predicate::ICMP_SGT;
+      break;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      cmp = llvm::CmpInst::Predicate::ICMP_SGE;
+      break;
+    default:
+      return false;
+  }
+
+  // Put the column on the left side
+  const auto *left = expr.GetChild(0);
+  const auto *right = expr.GetChild(1);
+  if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+    std::swap(left, right);
+    cmp = llvm::CmpInst::getSwappedPredicate(cmp);
+  }
+  if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+      (right->GetExpressionType() != ExpressionType::VALUE_CONSTANT &&
+       right->GetExpressionType() != ExpressionType::VALUE_PARAMETER)) {
+    return false;
+  }
+
+  // The constant must have the column's type, so no casts are needed
+  const auto *ai =
+      static_cast<const expression::TupleValueExpression *>(left)
+          ->GetAttributeRef();
+  if (!IsSignedInteger(ai->type.type_id) ||
+      right->GetValueType() != ai->type.type_id) {
+    return false;
+  }
+
+  comparisons_.push_back(Comparison{ai->attribute_id, ai->type.type_id,
+                                    ai->type.nullable, cmp, right});
+  return true;
+}
+
+llvm::Value *SimdPredicate::IsApplicable(
+    CodeGen &codegen, const TileGroup::TileGroupAccess &access) const {
+  llvm::Value *contiguous = codegen.ConstBool(true);
+  for (const auto &comparison : comparisons_) {
+    const auto &layout = access.GetLayout(comparison.col_id);
+    llvm::Type *col_type = GetColumnType(codegen, comparison.type_id);
+    llvm::Value *value_size = llvm::ConstantInt::get(
+        layout.col_stride->getType(), codegen.SizeOf(col_type));
+    contiguous = codegen->CreateAnd(
+        contiguous, codegen->CreateICmpEQ(layout.col_stride, value_size));
+  }
+  return contiguous;
+}
+
+// Filter the batch in two passes:
+//
+// @code
+// // 1. Evaluate the predicate for all tuples, kNumLanes at a time
+// for (offset := 0; offset < num_full; offset += kNumLanes) {
+//   masks[offset / kNumLanes] := bitcast(pred(col[tid_start + offset, ...]))
+// }
+// for (offset := num_full; offset < num_tuples; offset++) {
+//   masks[num_full / kNumLanes] |= pred(col[tid_start + offset])
+//                                      << (offset - num_full)
+// }
+//
+// // 2. Keep the rows of the batch whose bit is set
+// for (tid : batch) {
+//   valid := masks[offset / kNumLanes] >> (offset % kNumLanes) & 1
+// }
+// @endcode
+//
+void SimdPredicate::Filter(CodeGen &codegen,
+                           const ParameterCache &parameter_cache,
+                           const TileGroup::TileGroupAccess &access,
+                           RowBatch &batch, llvm::Value *tid_start,
+                           llvm::Value *tid_end) const {
+  // The columns and constants of all comparisons. Since all comparisons must
+  // hold, a NULL constant fails every row.
+  std::vector<llvm::Value *> col_ptrs, constants;
+  llvm::Value *constants_valid = codegen.ConstBool(true);
+  for (const auto &comparison : comparisons_) {
+    const auto &layout = access.GetLayout(comparison.col_id);
+    llvm::Type *col_type = GetColumnType(codegen, comparison.type_id);
+    col_ptrs.push_back(codegen->CreateBitCast(layout.col_start_ptr,
+                                              col_type->getPointerTo()));
+
+    codegen::Value constant = parameter_cache.GetValue(comparison.constant);
+    constants.push_back(constant.GetValue());
+    if (constant.IsNullable()) {
+      constants_valid = codegen->CreateAnd(
+          constants_valid, codegen->CreateNot(constant.IsNull(codegen)));
+    }
+  }
+
+  // The bitmask of the tuples that pass the predicate
+  llvm::Type *mask_type =
+      llvm::Type::getIntNTy(codegen.GetContext(), kNumLanes);
+  uint32_t num_masks =
+      (batch.GetSelectionVector().GetCapacity() + kNumLanes - 1) / kNumLanes;
+  llvm::Value *masks = codegen.AllocateBuffer(mask_type, num_masks, "simdMask");
+  llvm::Value *num_lanes = codegen.Const32(kNumLanes);
+
+  // 1. Evaluate the predicate over vectors of kNumLanes tuples
+  llvm::Value *num_tuples = codegen->CreateSub(tid_end, tid_start);
+  llvm::Value *num_full =
+      codegen->CreateAnd(num_tuples, codegen.Const32(~(kNumLanes - 1)));
+  llvm::Value *offset = codegen.Const32(0);
+  lang::Loop vector_loop{codegen, codegen->CreateICmpULT(offset, num_full),
+                         {{"simdOffset", offset}}};
+  {
+    offset = vector_loop.GetLoopVar(0);
+    llvm::Value *tid = codegen->CreateAdd(tid_start, offset);
+    llvm::Value *matches =
+        Evaluate(codegen, col_ptrs, constants, tid, kNumLanes);
+    llvm::Value *mask_ptr = codegen->CreateInBoundsGEP(
+        mask_type, masks, codegen->CreateUDiv(offset, num_lanes));
+    codegen->CreateStore(codegen->CreateBitCast(matches, mask_type), mask_ptr);
+
+    offset = codegen->CreateAdd(offset, codegen.Const32(kNumLanes));
+    vector_loop.LoopEnd(codegen->CreateICmpULT(offset, num_full), {offset});
+  }
+
+  // The remaining tuples are evaluated one at a time
+  llvm::Value *tail_mask_ptr = codegen->CreateInBoundsGEP(
+      mask_type, masks, codegen->CreateUDiv(num_full, num_lanes));
+  llvm::Value *tail_mask = llvm::ConstantInt::get(mask_type, 0);
+  lang::Loop tail_loop{codegen, codegen->CreateICmpULT(num_full, num_tuples),
+                       {{"simdOffset", num_full}, {"simdMask", tail_mask}}};
+  {
+    offset = tail_loop.GetLoopVar(0);
+    tail_mask = tail_loop.GetLoopVar(1);
+    llvm::Value *tid = codegen->CreateAdd(tid_start, offset);
+    llvm::Value *match = Evaluate(codegen, col_ptrs, constants, tid, 1);
+    llvm::Value *shift =
+        codegen->CreateZExt(codegen->CreateSub(offset, num_full), mask_type);
+    tail_mask = codegen->CreateOr(
+        tail_mask,
+        codegen->CreateShl(codegen->CreateZExt(match, mask_type), shift));
+    codegen->CreateStore(tail_mask, tail_mask_ptr);
+
+    offset = codegen->CreateAdd(offset, codegen.Const32(1));
+    tail_loop.LoopEnd(codegen->CreateICmpULT(offset, num_tuples),
+                      {offset, tail_mask});
+  }
+
+  // 2. Filter the rows of the batch by their bits
+  batch.Iterate(codegen, [&](RowBatch::Row &row) {
+    llvm::Value *row_offset =
+        codegen->CreateSub(row.GetTID(codegen), tid_start);
+    llvm::Value *mask = codegen->CreateLoad(
+        mask_type,
+        codegen->CreateInBoundsGEP(mask_type, masks,
+                                   codegen->CreateUDiv(row_offset, num_lanes)));
+    llvm::Value *lane = codegen->CreateZExt(
+        codegen->CreateURem(row_offset, num_lanes), mask_type);
+    llvm::Value *valid = codegen->CreateTrunc(codegen->CreateLShr(mask, lane),
+                                              codegen.BoolType());
+    row.SetValidity(codegen, codegen->CreateAnd(valid, constants_valid));
+  });
+}
+
+llvm::Value *SimdPredicate::Evaluate(
+    CodeGen &codegen, const std::vector<llvm::Value *> &col_ptrs,
+    const std::vector<llvm::Value *> &constants, llvm::Value *tid,
+    uint32_t num_lanes) const {
+  llvm::Value *result = nullptr;
+  for (uint32_t i = 0; i < comparisons_.size(); i++) {
+    const auto &comparison = comparisons_[i];
+    llvm::Type *col_type = GetColumnType(codegen, comparison.type_id);
+    llvm::Value *col_ptr =
+        codegen->CreateInBoundsGEP(col_type, col_ptrs[i], tid);
+
+    // Load the values. Columns are only aligned to the size of their values.
+    llvm::Value *vals = nullptr;
+    llvm::Value *constant = constants[i];
+    llvm::Value *null_val = nullptr;
+    if (comparison.nullable) {
+      const auto &sql_type = type::SqlType::LookupType(comparison.type_id);
+      null_val = sql_type.GetNullValue(codegen).GetValue();
+    }
+    if (num_lanes == 1) {
+      vals = codegen->CreateLoad(col_type, col_ptr);
+    } else {
+      llvm::Type *vector_type = llvm::VectorType::get(col_type, num_lanes);
+      vals = codegen->CreateAlignedLoad(
+          codegen->CreateBitCast(col_ptr, vector_type->getPointerTo()),
+          codegen.SizeOf(col_type));
+      constant = codegen->CreateVectorSplat(num_lanes, constant);
+      if (null_val != nullptr) {
+        null_val = codegen->CreateVectorSplat(num_lanes, null_val);
+      }
+    }
+
+    // Compare, and rule out NULLs, which are stored as a reserved value
+    llvm::Value *match = codegen->CreateICmp(comparison.cmp, vals, constant);
+    if (null_val != nullptr) {
+      match =
+          codegen->CreateAnd(match, codegen->CreateICmpNE(vals, null_val));
+    }
+    result = result == nullptr ? match : codegen->CreateAnd(result, match);
+  }
+  return result;
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -36,10 +36,13 @@ Sorter::Sorter(CodeGen &codegen, const std::vector<type::Type> &row_desc) {
 
 void Sorter::Init(CodeGen &codegen, llvm::Value *sorter_ptr,
                   llvm::Value *executor_ctx,
-                  llvm::Value *comparison_func) const {
+                  llvm::Value *comparison_func, llvm::Value *top_k) const {
   auto *tuple_size = codegen.Const32(storage_format_.GetStorageSize());
-  codegen.Call(SorterProxy::Init,
-               {sorter_ptr, executor_ctx, comparison_func, tuple_size});
+  if (top_k == nullptr) {
+    top_k = codegen.Const64(0);
+  }
+  codegen.Call(SorterProxy::Init, {sorter_ptr, executor_ctx, comparison_func,
+                                   tuple_size, top_k});
 }
 
 void Sorter::Append(CodeGen &codegen, llvm::Value *sorter_ptr,
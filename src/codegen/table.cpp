@@ -95,8 +95,18 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
       (tilegroup_end != nullptr ? tilegroup_end
                                 : GetTileGroupCount(codegen, table_ptr));
 
-  lang::Loop loop{codegen,
-                  codegen->CreateICmpULT(tile_group_idx, num_tile_groups),
+  // The condition to visit the next tile group. If the consumer can stop the
+  // scan early, we also check that it hasn't.
+  auto more_tile_groups = [&](llvm::Value *idx) {
+    llvm::Value *cond = codegen->CreateICmpULT(idx, num_tile_groups);
+    llvm::Value *stop = consumer.ShouldStop(codegen);
+    if (stop != nullptr) {
+      cond = codegen->CreateAnd(cond, codegen->CreateNot(stop));
+    }
+    return cond;
+  };
+
+  lang::Loop loop{codegen, more_tile_groups(tile_group_idx),
                   {{"tileGroupIdx", tile_group_idx}}};
   {
     // Get the tile group with the given tile group ID
@@ -128,8 +138,7 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
 
     // Move to next tile group in the table
     tile_group_idx = codegen->CreateAdd(tile_group_idx, codegen.Const64(1));
-    loop.LoopEnd(codegen->CreateICmpULT(tile_group_idx, num_tile_groups),
-                 {tile_group_idx});
+    loop.LoopEnd(more_tile_groups(tile_group_idx), {tile_group_idx});
   }
 }
 
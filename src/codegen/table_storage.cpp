@@ -42,6 +42,7 @@ void TableStorage::StoreValues(CodeGen &codegen, llvm::Value *tuple_ptr,
       auto val_ptr = codegen->CreateBitCast(ptr, val_type);
       lang::If value_is_null{codegen, value.IsNull(codegen)};
       {
+        // Zeroing the leading length word marks the varlen slot as NULL
         auto null_val = sql_type.GetNullValue(codegen);
         codegen->CreateStore(
             null_val.GetValue(),
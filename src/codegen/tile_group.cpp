@@ -61,6 +61,14 @@ void TileGroup::GenerateTidScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
     consumer.ProcessTuples(codegen, curr_range.start, curr_range.end,
                            tile_group_access);
 
+    // Stop early if the consumer has seen enough
+    llvm::Value *stop = consumer.ShouldStop(codegen);
+    if (stop != nullptr) {
+      lang::If should_stop{codegen, stop, "shouldStop"};
+      loop.Break();
+      should_stop.EndIf();
+    }
+
     loop.LoopEnd(codegen, {});
   }
 }
@@ -129,14 +137,13 @@ codegen::Value TileGroup::LoadColumn(
   // Check if it's a string or numeric value
   if (sql_type.IsVariableLength()) {
     auto *varlen_type = VarlenProxy::GetType(codegen);
-    auto *varlen_ptr_ptr = codegen->CreateBitCast(
-        col_address, varlen_type->getPointerTo()->getPointerTo());
+    auto *slot_ptr =
+        codegen->CreateBitCast(col_address, varlen_type->getPointerTo());
     if (is_nullable) {
-      codegen::Varlen::GetPtrAndLength(
-          codegen, codegen->CreateLoad(varlen_ptr_ptr), val, length, is_null);
+      codegen::Varlen::GetPtrAndLength(codegen, slot_ptr, val, length,
+                                       is_null);
     } else {
-      codegen::Varlen::SafeGetPtrAndLength(
-          codegen, codegen->CreateLoad(varlen_ptr_ptr), val, length);
+      codegen::Varlen::SafeGetPtrAndLength(codegen, slot_ptr, val, length);
     }
     PELOTON_ASSERT(val != nullptr && length != nullptr);
   } else {
@@ -17,6 +17,7 @@
 #include "concurrency/transaction_context.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
+#include "storage/bitmap_index.h"
 #include "storage/tile_group.h"
 
 namespace peloton {
@@ -45,6 +46,37 @@ uint32_t TransactionRuntime::PerformVisibilityCheck(
   return out_idx;
 }
 
+uint32_t TransactionRuntime::PerformBitmapVisibilityCheck(
+    concurrency::TransactionContext &txn, storage::TileGroup &tile_group,
+    const storage::BitmapPredicate &predicate, uint32_t tid_start,
+    uint32_t tid_end, uint32_t *selection_vector) {
+  // Let the bitmap indexes produce the candidate tuples
+  uint32_t num_candidates = 0;
+  auto bitmap_index = tile_group.GetBitmapIndex();
+  if (bitmap_index == nullptr ||
+      !bitmap_index->Select(predicate, tid_start, tid_end, selection_vector,
+                            num_candidates)) {
+    return PerformVisibilityCheck(txn, tile_group, tid_start, tid_end,
+                                  selection_vector);
+  }
+
+  // Get the transaction manager
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // Get the tile group header
+  auto tile_group_header = tile_group.GetHeader();
+
+  // Check visibility of the candidates, compacting the selection vector
+  uint32_t out_idx = 0;
+  for (uint32_t idx = 0; idx < num_candidates; idx++) {
+    uint32_t tid = selection_vector[idx];
+    auto visibility = txn_manager.IsVisible(&txn, tile_group_header, tid);
+    selection_vector[out_idx] = tid;
+    out_idx += (visibility == VisibilityType::OK);
+  }
+  return out_idx;
+}
+
 uint32_t TransactionRuntime::PerformVectorizedRead(
     concurrency::TransactionContext &txn, storage::TileGroup &tile_group,
     uint32_t *selection_vector, uint32_t end_idx, bool is_for_update) {
@@ -29,9 +29,12 @@
 #include "codegen/operator/hash_group_by_translator.h"
 #include "codegen/operator/hash_join_translator.h"
 #include "codegen/operator/hash_translator.h"
+#include "codegen/operator/index_scan_translator.h"
 #include "codegen/operator/insert_translator.h"
+#include "codegen/operator/limit_translator.h"
 #include "codegen/operator/order_by_translator.h"
 #include "codegen/operator/projection_translator.h"
+#include "codegen/operator/set_op_translator.h"
 #include "codegen/operator/table_scan_translator.h"
 #include "codegen/operator/update_translator.h"
 #include "expression/aggregate_expression.h"
@@ -43,15 +46,19 @@
 #include "expression/operator_expression.h"
 #include "expression/tuple_value_expression.h"
 #include "planner/aggregate_plan.h"
+#include "planner/append_plan.h"
 #include "planner/csv_scan_plan.h"
 #include "planner/delete_plan.h"
 #include "planner/hash_join_plan.h"
 #include "planner/hash_plan.h"
+#include "planner/index_scan_plan.h"
 #include "planner/insert_plan.h"
+#include "planner/limit_plan.h"
 #include "planner/nested_loop_join_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/projection_plan.h"
 #include "planner/seq_scan_plan.h"
+#include "planner/set_op_plan.h"
 #include "planner/update_plan.h"
 
 namespace peloton {
@@ -70,6 +77,11 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTranslator(
       translator = new TableScanTranslator(scan, context, pipeline);
       break;
     }
+    case PlanNodeType::INDEXSCAN: {
+      auto &scan = static_cast<const planner::IndexScanPlan &>(plan_node);
+      translator = new IndexScanTranslator(scan, context, pipeline);
+      break;
+    }
     case PlanNodeType::CSVSCAN: {
       auto &scan = static_cast<const planner::CSVScanPlan &>(plan_node);
       translator = new CSVScanTranslator(scan, context, pipeline);
@@ -116,6 +128,21 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTranslator(
       translator = new OrderByTranslator(order_by, context, pipeline);
       break;
     }
+    case PlanNodeType::LIMIT: {
+      auto &limit = static_cast<const planner::LimitPlan &>(plan_node);
+      translator = new LimitTranslator(limit, context, pipeline);
+      break;
+    }
+    case PlanNodeType::SETOP: {
+      auto &set_op = static_cast<const planner::SetOpPlan &>(plan_node);
+      translator = new SetOpTranslator(set_op, context, pipeline);
+      break;
+    }
+    case PlanNodeType::APPEND: {
+      auto &append = static_cast<const planner::AppendPlan &>(plan_node);
+      translator = new SetOpTranslator(append, context, pipeline);
+      break;
+    }
     case PlanNodeType::DELETE: {
       auto &delete_plan = static_cast<const planner::DeletePlan &>(plan_node);
       translator = new DeleteTranslator(delete_plan, context, pipeline);
@@ -47,12 +47,58 @@ struct CompareVarchar : public TypeSystem::ExpensiveComparisonHandleNull {
   // Call ValuesRuntime::CompareStrings(). This function behaves like strcmp(),
   // returning a values less than, equal to, or greater than zero if left is
   // found to be less than, matches, or is greater than the right value.
+  //
+  // Most strings already differ in their first byte, so we compare that
+  // inline and only call into the runtime when it matches.
   llvm::Value *CompareStrings(CodeGen &codegen, const Value &left,
                               const Value &right) const {
-    // Setup the function arguments and invoke the call
-    std::vector<llvm::Value *> args = {left.GetValue(), left.GetLength(),
-                                       right.GetValue(), right.GetLength()};
-    return codegen.Call(StringFunctionsProxy::CompareStrings, args);
+    auto *left_len = left.GetLength(), *right_len = right.GetLength();
+    auto *both_non_empty =
+        codegen->CreateAnd(codegen->CreateICmpNE(left_len, codegen.Const32(0)),
+                           codegen->CreateICmpNE(right_len, codegen.Const32(0)));
+
+    llvm::Value *prefix_diff = nullptr;
+    lang::If non_empty{codegen, both_non_empty, "nonEmpty"};
+    {
+      auto *left_byte = codegen->CreateZExt(
+          codegen->CreateLoad(codegen.ByteType(), left.GetValue()),
+          codegen.Int32Type());
+      auto *right_byte = codegen->CreateZExt(
+          codegen->CreateLoad(codegen.ByteType(), right.GetValue()),
+          codegen.Int32Type());
+      prefix_diff = codegen->CreateSub(left_byte, right_byte);
+    }
+    non_empty.EndIf();
+    prefix_diff = non_empty.BuildPHI(prefix_diff, codegen.Const32(0));
+
+    llvm::Value *result = nullptr;
+    lang::If same_prefix{
+        codegen, codegen->CreateICmpEQ(prefix_diff, codegen.Const32(0)),
+        "samePrefix"};
+    {
+      // Setup the function arguments and invoke the call
+      std::vector<llvm::Value *> args = {left.GetValue(), left_len,
+                                         right.GetValue(), right_len};
+      result = codegen.Call(StringFunctionsProxy::CompareStrings, args);
+    }
+    same_prefix.EndIf();
+    return same_prefix.BuildPHI(result, prefix_diff);
+  }
+
+  // Check two strings for equality. Strings of different lengths can never be
+  // equal, so the comparison is skipped for them.
+  llvm::Value *EqualStrings(CodeGen &codegen, const Value &left,
+                            const Value &right) const {
+    auto *same_len =
+        codegen->CreateICmpEQ(left.GetLength(), right.GetLength());
+    llvm::Value *is_eq = nullptr;
+    lang::If same_length{codegen, same_len, "sameLength"};
+    {
+      llvm::Value *result = CompareStrings(codegen, left, right);
+      is_eq = codegen->CreateICmpEQ(result, codegen.Const32(0));
+    }
+    same_length.EndIf();
+    return same_length.BuildPHI(is_eq, codegen.ConstBool(false));
   }
 
   Value CompareLtImpl(CodeGen &codegen, const Value &left,
@@ -76,19 +122,14 @@ struct CompareVarchar : public TypeSystem::ExpensiveComparisonHandleNull {
   Value CompareEqImpl(CodeGen &codegen, const Value &left,
                       const Value &right) const override {
     PELOTON_ASSERT(SupportsTypes(left.GetType(), right.GetType()));
-    // Call CompareStrings, check is result is == 0
-    llvm::Value *result = CompareStrings(codegen, left, right);
-    llvm::Value *is_eq_0 = codegen->CreateICmpEQ(result, codegen.Const32(0));
-    return Value{Boolean::Instance(), is_eq_0};
+    return Value{Boolean::Instance(), EqualStrings(codegen, left, right)};
   }
 
   Value CompareNeImpl(CodeGen &codegen, const Value &left,
                       const Value &right) const override {
     PELOTON_ASSERT(SupportsTypes(left.GetType(), right.GetType()));
-    // Call CompareStrings, check is result is != 0
-    llvm::Value *result = CompareStrings(codegen, left, right);
-    llvm::Value *is_ne_0 = codegen->CreateICmpNE(result, codegen.Const32(0));
-    return Value{Boolean::Instance(), is_ne_0};
+    llvm::Value *is_eq = EqualStrings(codegen, left, right);
+    return Value{Boolean::Instance(), codegen->CreateNot(is_eq)};
   }
 
   Value CompareGtImpl(CodeGen &codegen, const Value &left,
@@ -12,6 +12,9 @@
 
 #include "codegen/util/hash_table.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "common/platform.h"
 #include "type/abstract_pool.h"
 
@@ -279,6 +282,66 @@ void HashTable::MergeLazyUnfinished(HashTable &other) {
   other.entry_buffer_.TransferMemoryBlocks(entry_buffer_);
 }
 
+void HashTable::PartitionLazyUnfinished(HashTable *partitions,
+                                        uint32_t num_partitions) {
+  PELOTON_ASSERT(num_partitions > 0 &&
+                 (num_partitions & (num_partitions - 1)) == 0);
+  uint64_t radix_bits = 63 - CountLeadingZeroes(num_partitions);
+
+  // First chain up our entries by partition, so that each chain is spliced
+  // into its partition with a single CAS
+  std::vector<Entry *> heads(num_partitions, nullptr);
+  std::vector<Entry *> tails(num_partitions, nullptr);
+  std::vector<uint64_t> counts(num_partitions, 0);
+
+  auto *head = directory_[0];
+  while (head != nullptr) {
+    uint64_t part = (radix_bits == 0 ? 0 : head->hash >> (64 - radix_bits));
+    Entry *next = head->next;
+    head->next = heads[part];
+    heads[part] = head;
+    if (tails[part] == nullptr) {
+      tails[part] = head;
+    }
+    counts[part]++;
+    head = next;
+  }
+
+  // Now splice each chain into the lazy entry list of its partition
+  for (uint32_t part = 0; part < num_partitions; part++) {
+    if (heads[part] == nullptr) {
+      continue;
+    }
+
+    HashTable &partition = partitions[part];
+    Entry *curr;
+    do {
+      curr = partition.directory_[0];
+      tails[part]->next = curr;
+    } while (!::peloton::atomic_cas(partition.directory_, curr, heads[part]));
+
+    ::peloton::atomic_add(&partition.num_elems_, counts[part]);
+  }
+
+  // Transfer all allocated memory blocks into the first partition
+  PELOTON_ASSERT(&memory_ == &partitions[0].memory_);
+  directory_[0] = directory_[1] = nullptr;
+  num_elems_ = capacity_ = 0;
+  entry_buffer_.TransferMemoryBlocks(partitions[0].entry_buffer_);
+}
+
+uint32_t HashTable::NumPartitions(uint64_t num_elems, uint64_t min_elems,
+                                  uint64_t partition_size,
+                                  uint32_t max_partitions) {
+  if (num_elems < min_elems) {
+    return 0;
+  }
+  uint64_t num_partitions =
+      NextPowerOf2(std::max<uint64_t>(2, num_elems / partition_size));
+  return static_cast<uint32_t>(
+      std::min<uint64_t>(max_partitions, num_partitions));
+}
+
 void HashTable::Resize() {
   // Sanity check
   PELOTON_ASSERT(NeedsResize());
@@ -0,0 +1,170 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scanner.cpp
+//
+// Identification: src/codegen/util/index_scanner.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/util/index_scanner.h"
+
+#include <algorithm>
+
+#include "concurrency/transaction_context.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "index/index.h"
+#include "index/scan_optimizer.h"
+#include "planner/index_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace codegen {
+namespace util {
+
+IndexScanner::IndexScanner(const planner::IndexScanPlan &plan,
+                           executor::ExecutorContext &executor_context,
+                           uint32_t key_param_idx, uint32_t batch_size)
+    : plan_(plan),
+      executor_context_(executor_context),
+      key_param_idx_(key_param_idx),
+      batch_size_(batch_size) {
+  PELOTON_ASSERT(batch_size_ > 0);
+}
+
+void IndexScanner::Init(IndexScanner &scanner,
+                        const planner::IndexScanPlan &plan,
+                        executor::ExecutorContext &executor_context,
+                        uint32_t key_param_idx, uint32_t batch_size) {
+  // Forward to constructor
+  new (&scanner)
+      IndexScanner(plan, executor_context, key_param_idx, batch_size);
+}
+
+void IndexScanner::Destroy(IndexScanner &scanner) {
+  // Forward to destructor
+  scanner.~IndexScanner();
+}
+
+void IndexScanner::Scan() {
+  tile_groups_.clear();
+  offsets_.clear();
+  batches_.clear();
+
+  auto index = plan_.GetTable()->GetIndexWithOid(plan_.GetIndexId());
+  PELOTON_ASSERT(index != nullptr);
+
+  // Probe the index
+  std::vector<ItemPointer *> tuple_location_ptrs;
+  const auto &key_column_ids = plan_.GetKeyColumnIds();
+  if (key_column_ids.empty()) {
+    index->ScanAllKeys(tuple_location_ptrs);
+  } else {
+    // The key values are the query parameters registered by the plan
+    const auto &params = executor_context_.GetParamValues();
+    auto key_begin = params.begin() + key_param_idx_;
+    std::vector<peloton::type::Value> values(
+        key_begin, key_begin + key_column_ids.size());
+
+    index::IndexScanPredicate index_predicate;
+    index_predicate.AddConjunctionScanPredicate(
+        index.get(), values, key_column_ids, plan_.GetExprTypes());
+    index->Scan(values, key_column_ids, plan_.GetExprTypes(),
+                ScanDirectionType::FORWARD, tuple_location_ptrs,
+                &index_predicate.GetConjunctionList()[0]);
+  }
+
+  // Batch the visible versions of all matches by tile group, in index order
+  auto &txn = *executor_context_.GetTransaction();
+  auto *storage_manager = storage::StorageManager::GetInstance();
+  oid_t last_block = INVALID_OID;
+  offsets_.reserve(tuple_location_ptrs.size());
+  for (auto *tuple_location_ptr : tuple_location_ptrs) {
+    ItemPointer location = *tuple_location_ptr;
+    if (!FindVisibleVersion(txn, location)) {
+      continue;
+    }
+
+    // Start a new batch when moving to another tile group, or when the
+    // current batch is full
+    bool new_tile_group = (location.block != last_block);
+    if (new_tile_group) {
+      tile_groups_.push_back(storage_manager->GetTileGroup(location.block));
+      last_block = location.block;
+    }
+    if (new_tile_group ||
+        batches_.back().end - batches_.back().start == batch_size_) {
+      auto tile_group_idx = static_cast<uint32_t>(tile_groups_.size() - 1);
+      auto offset = static_cast<uint32_t>(offsets_.size());
+      batches_.push_back(Batch{tile_group_idx, offset, offset});
+    }
+    offsets_.push_back(location.offset);
+    batches_.back().end++;
+  }
+}
+
+uint32_t IndexScanner::FillSelectionVector(uint32_t batch_idx,
+                                           uint32_t *selection_vector) const {
+  const auto &batch = batches_[batch_idx];
+  std::copy(offsets_.begin() + batch.start, offsets_.begin() + batch.end,
+            selection_vector);
+  return batch.end - batch.start;
+}
+
+// This follows the version chain the same way the index scan executor does
+bool IndexScanner::FindVisibleVersion(concurrency::TransactionContext &txn,
+                                      ItemPointer &location) const {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto *storage_manager = storage::StorageManager::GetInstance();
+
+  auto tile_group = storage_manager->GetTileGroup(location.block);
+  auto *tile_group_header = tile_group->GetHeader();
+  size_t chain_length = 0;
+  while (true) {
+    ++chain_length;
+
+    auto visibility =
+        txn_manager.IsVisible(&txn, tile_group_header, location.offset);
+    if (visibility == VisibilityType::DELETED) {
+      return false;
+    } else if (visibility == VisibilityType::OK) {
+      return true;
+    }
+
+    PELOTON_ASSERT(visibility == VisibilityType::INVISIBLE);
+
+    bool is_acquired = (tile_group_header->GetTransactionId(location.offset) ==
+                        INITIAL_TXN_ID);
+    bool is_alive = (tile_group_header->GetEndCommitId(location.offset) <=
+                     txn.GetReadId());
+    if (is_acquired && is_alive) {
+      // Another transaction has modified the version chain since we found
+      // this version, so we start over from the head of the chain
+      location = *(tile_group_header->GetIndirection(location.offset));
+      chain_length = 0;
+    } else {
+      location = tile_group_header->GetNextItemPointer(location.offset);
+      if (location.IsNull()) {
+        // There is no visible version. That's expected only for an aborted
+        // version that is alone in its chain.
+        if (chain_length != 1) {
+          txn_manager.SetTransactionResult(&txn, ResultType::FAILURE);
+        }
+        return false;
+      }
+    }
+    tile_group = storage_manager->GetTileGroup(location.block);
+    tile_group_header = tile_group->GetHeader();
+  }
+}
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
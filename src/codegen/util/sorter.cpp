@@ -24,13 +24,14 @@ namespace codegen {
 namespace util {
 
 Sorter::Sorter(::peloton::type::AbstractPool &memory, ComparisonFunction func,
-               uint32_t tuple_size)
+               uint32_t tuple_size, uint64_t top_k)
     : memory_(memory),
       cmp_func_(func),
       tuple_size_(tuple_size),
       buffer_pos_(nullptr),
       buffer_end_(nullptr),
       next_alloc_size_(kInitialBufferSize),
+      top_k_(top_k),
       tuples_start_(nullptr),
       tuples_end_(nullptr) {
   // No memory allocation
@@ -54,13 +55,18 @@ Sorter::~Sorter() {
 }
 
 void Sorter::Init(Sorter &sorter, executor::ExecutorContext &exec_ctx,
-                  ComparisonFunction func, uint32_t tuple_size) {
-  new (&sorter) Sorter(*exec_ctx.GetPool(), func, tuple_size);
+                  ComparisonFunction func, uint32_t tuple_size,
+                  uint64_t top_k) {
+  new (&sorter) Sorter(*exec_ctx.GetPool(), func, tuple_size, top_k);
 }
 
 void Sorter::Destroy(Sorter &sorter) { sorter.~Sorter(); }
 
 char *Sorter::StoreInputTuple() {
+  if (top_k_ != 0) {
+    return StoreTopKInputTuple();
+  }
+
   // Make room for a new tuple
   MakeRoomForNewTuple();
 
@@ -75,6 +81,46 @@ char *Sorter::StoreInputTuple() {
   return ret;
 }
 
+char *Sorter::StoreTopKInputTuple() {
+  // Add the previous tuple to the heap
+  if (!tuples_.empty()) {
+    AddLastTupleToHeap();
+  }
+
+  // If the heap is full, the tuple at the end was evicted. Reuse its space.
+  if (tuples_.size() > top_k_) {
+    return tuples_.back();
+  }
+
+  // Otherwise, the heap is still growing
+  MakeRoomForNewTuple();
+  char *ret = buffer_pos_;
+  buffer_pos_ += tuple_size_;
+  tuples_.push_back(ret);
+  return ret;
+}
+
+void Sorter::AddLastTupleToHeap() {
+  PELOTON_ASSERT(!tuples_.empty() && tuples_.size() <= top_k_ + 1);
+  auto cmp = [this](char *l, char *r) { return cmp_func_(l, r) < 0; };
+
+  // If the heap isn't full, simply add the tuple
+  if (tuples_.size() <= top_k_) {
+    std::push_heap(tuples_.begin(), tuples_.end(), cmp);
+    return;
+  }
+
+  // The heap is full. If the new tuple is smaller than the largest tuple in the
+  // heap, replace the largest tuple with it. Either way, the tuple that doesn't
+  // make it ends up at the end.
+  auto heap_end = tuples_.begin() + top_k_;
+  if (cmp(tuples_.back(), tuples_.front())) {
+    std::pop_heap(tuples_.begin(), heap_end, cmp);
+    std::swap(*(heap_end - 1), tuples_.back());
+    std::push_heap(tuples_.begin(), heap_end, cmp);
+  }
+}
+
 void Sorter::Sort() {
   // Short-circuit
   if (tuples_.empty()) {
@@ -85,11 +131,20 @@ void Sorter::Sort() {
   Timer<std::milli> timer;
   timer.Start();
 
-  // Sort the sucker
-  // TODO(pmenon): The standard std::sort is super slow. We should consider a
-  //               switch to IPS4O which is up to 3-4x faster.
   auto cmp = [this](char *l, char *r) { return cmp_func_(l, r) < 0; };
-  std::sort(tuples_.begin(), tuples_.end(), cmp);
+  if (top_k_ != 0) {
+    // Add the last tuple and drop whatever was evicted, the rest is a heap
+    AddLastTupleToHeap();
+    if (tuples_.size() > top_k_) {
+      tuples_.pop_back();
+    }
+    std::sort_heap(tuples_.begin(), tuples_.end(), cmp);
+  } else {
+    // Sort the sucker
+    // TODO(pmenon): The standard std::sort is super slow. We should consider a
+    //               switch to IPS4O which is up to 3-4x faster.
+    std::sort(tuples_.begin(), tuples_.end(), cmp);
+  }
 
   // Setup pointers
   tuples_start_ = tuples_.data();
@@ -138,6 +193,12 @@ void Sorter::SortParallel(
                                   num_tuples += sorter->NumTuples();
                                 });
 
+  // In top-k mode, every thread-local sorter retains at most k tuples
+  if (top_k_ != 0) {
+    SortParallelTopK(sorters);
+    return;
+  }
+
   // The worker pool we use to execute parallel work
   auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
 
@@ -307,6 +368,39 @@ void Sorter::SortParallel(
   LOG_DEBUG("Merging sorted runs time: %.2lf ms", timer.GetDuration());
 }
 
+void Sorter::SortParallelTopK(const std::vector<Sorter *> &sorters) {
+  Timer<std::milli> timer;
+  timer.Start();
+
+  // Sort the (bounded) heaps of each thread-local sorter and collect the
+  // retained tuples
+  tuples_.clear();
+  for (auto *sorter : sorters) {
+    sorter->Sort();
+    tuples_.insert(tuples_.end(), sorter->tuples_.begin(),
+                   sorter->tuples_.end());
+  }
+
+  // Only keep the top-k tuples overall
+  auto cmp = [this](char *l, char *r) { return cmp_func_(l, r) < 0; };
+  auto num_tuples = std::min<uint64_t>(top_k_, tuples_.size());
+  std::partial_sort(tuples_.begin(), tuples_.begin() + num_tuples,
+                    tuples_.end(), cmp);
+  tuples_.resize(num_tuples);
+
+  // Transfer ownership of thread-local memory
+  for (auto *sorter : sorters) {
+    sorter->TransferMemoryBlocks(*this);
+  }
+
+  tuples_start_ = tuples_.data();
+  tuples_end_ = tuples_start_ + tuples_.size();
+
+  timer.Stop();
+  LOG_DEBUG("Merged top-%" PRIu64 " tuples of %zu sorters in %.2lf ms",
+            top_k_, sorters.size(), timer.GetDuration());
+}
+
 void Sorter::MakeRoomForNewTuple() {
   bool has_room =
       (buffer_pos_ != nullptr && buffer_pos_ + tuple_size_ < buffer_end_);
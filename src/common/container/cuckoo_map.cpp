@@ -25,6 +25,10 @@ namespace storage {
 class TileGroup;
 }
 
+namespace index {
+struct CoveringPayload;
+}  // namespace index
+
 namespace stats {
 class BackendStatsContext;
 class IndexMetric;
@@ -125,4 +129,8 @@ template class CuckooMap<std::shared_ptr<oid_t>, std::shared_ptr<oid_t>>;
 // Used in StatementCacheManager
 template class CuckooMap<StatementCache *, StatementCache *>;
 
+// Used in CoveringPayloadStore
+template class CuckooMap<uint64_t,
+                         std::shared_ptr<const index::CoveringPayload>>;
+
 }  // namespace peloton
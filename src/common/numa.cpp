@@ -0,0 +1,199 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa.cpp
+//
+// Identification: src/common/numa.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/numa.h"
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "common/logger.h"
+#include "settings/settings_manager.h"
+
+namespace peloton {
+
+namespace {
+
+/// The NUMA topology of the machine, discovered once on first use
+struct NumaTopology {
+  // The number of nodes
+  uint32_t num_nodes = 1;
+  // Maps a CPU id to the node it belongs to
+  std::vector<int> cpu_to_node;
+#ifdef __linux__
+  // The CPUs belonging to each node
+  std::vector<cpu_set_t> node_cpus;
+  // The CPU mask of the process at startup
+  cpu_set_t process_cpus;
+#endif
+
+  NumaTopology() { Discover(); }
+
+  // Parse a sysfs CPU list of the form "0-3,8,10-11" into the given callback
+  template <typename F>
+  static void ParseCpuList(const std::string &list, F callback) {
+    std::size_t pos = 0;
+    while (pos < list.size()) {
+      std::size_t end = list.find(',', pos);
+      if (end == std::string::npos) end = list.size();
+      std::string range = list.substr(pos, end - pos);
+      pos = end + 1;
+      if (range.empty()) continue;
+
+      std::size_t dash = range.find('-');
+      int lo = std::stoi(range.substr(0, dash));
+      int hi = (dash == std::string::npos) ? lo
+                                           : std::stoi(range.substr(dash + 1));
+      for (int cpu = lo; cpu <= hi; cpu++) {
+        callback(cpu);
+      }
+    }
+  }
+
+  void Discover() {
+#ifdef __linux__
+    CPU_ZERO(&process_cpus);
+    sched_getaffinity(0, sizeof(process_cpus), &process_cpus);
+
+    const std::string node_dir = "/sys/devices/system/node/node";
+    for (uint32_t node = 0;; node++) {
+      std::ifstream cpulist(node_dir + std::to_string(node) + "/cpulist");
+      if (!cpulist.good()) break;
+
+      std::string list;
+      std::getline(cpulist, list);
+
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      try {
+        ParseCpuList(list, [this, &cpus, node](int cpu) {
+          if (cpu < 0 || cpu >= CPU_SETSIZE) return;
+          CPU_SET(cpu, &cpus);
+          if (static_cast<std::size_t>(cpu) >= cpu_to_node.size()) {
+            cpu_to_node.resize(cpu + 1, 0);
+          }
+          cpu_to_node[cpu] = static_cast<int>(node);
+        });
+      } catch (const std::exception &) {
+        LOG_WARN("Could not parse CPU list '%s' of NUMA node %u",
+                 list.c_str(), node);
+      }
+      node_cpus.push_back(cpus);
+    }
+    num_nodes = std::max<uint32_t>(1, node_cpus.size());
+#endif
+    LOG_DEBUG("Discovered %u NUMA node(s)", num_nodes);
+  }
+};
+
+const NumaTopology &GetTopology() {
+  static NumaTopology topology;
+  return topology;
+}
+
+}  // namespace
+
+uint32_t NumaUtil::GetNumNodes() { return GetTopology().num_nodes; }
+
+bool NumaUtil::IsNumaAware() {
+  return GetNumNodes() > 1 &&
+         settings::SettingsManager::GetBool(
+             settings::SettingId::numa_aware_placement);
+}
+
+int NumaUtil::GetCurrentNode() {
+  const auto &topology = GetTopology();
+  if (topology.num_nodes <= 1) {
+    return 0;
+  }
+#ifdef __linux__
+  int cpu = sched_getcpu();
+  if (cpu >= 0 &&
+      static_cast<std::size_t>(cpu) < topology.cpu_to_node.size()) {
+    return topology.cpu_to_node[cpu];
+  }
+#endif
+  return 0;
+}
+
+void *NumaUtil::Allocate(std::size_t size, int node) {
+  // Anonymous mappings are zero-filled and page aligned, which is what mbind()
+  // needs. Pages are only materialized on first touch, on the preferred node.
+  void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+
+#ifdef __linux__
+  const auto &topology = GetTopology();
+  if (node != kInvalidNode && topology.num_nodes > 1 &&
+      static_cast<uint32_t>(node) < topology.num_nodes) {
+    constexpr std::size_t kBitsPerWord = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> node_mask(topology.num_nodes / kBitsPerWord + 1,
+                                         0);
+    node_mask[node / kBitsPerWord] |= 1ul << (node % kBitsPerWord);
+    long ret = syscall(SYS_mbind, ptr, size, MPOL_PREFERRED, node_mask.data(),
+                       node_mask.size() * kBitsPerWord, 0);
+    if (ret != 0) {
+      LOG_TRACE("mbind() to node %d failed, using default placement", node);
+    }
+  }
+#endif
+
+  return ptr;
+}
+
+void NumaUtil::Free(void *ptr, std::size_t size) {
+  if (ptr != nullptr) {
+    munmap(ptr, size);
+  }
+}
+
+bool NumaUtil::BindCurrentThreadToNode(UNUSED_ATTRIBUTE int node) {
+#ifdef __linux__
+  const auto &topology = GetTopology();
+  if (topology.num_nodes <= 1 || node < 0 ||
+      static_cast<uint32_t>(node) >= topology.num_nodes) {
+    return false;
+  }
+  // Never widen the mask beyond what the process was allowed to use
+  cpu_set_t cpus;
+  CPU_AND(&cpus, &topology.node_cpus[node], &topology.process_cpus);
+  if (CPU_COUNT(&cpus) == 0) {
+    return false;
+  }
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+  return false;
+#endif
+}
+
+void NumaUtil::UnbindCurrentThread() {
+#ifdef __linux__
+  const auto &topology = GetTopology();
+  sched_setaffinity(0, sizeof(topology.process_cpus), &topology.process_cpus);
+#endif
+}
+
+}  // namespace peloton
@@ -241,7 +241,9 @@ bool CreateExecutor::CreateIndex(const planner::CreatePlan &node) {
                                                                    index_name,
                                                                    key_attrs,
                                                                    unique_flag,
-                                                                   index_type);
+                                                                   index_type,
+                                                                   {},
+                                                                   node.GetIndexPredicate());
   txn->SetResult(result);
 
   if (txn->GetResult() == ResultType::SUCCESS) {
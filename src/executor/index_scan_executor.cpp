@@ -12,8 +12,11 @@
 
 #include "executor/index_scan_executor.h"
 
+#include <algorithm>
+
 #include "catalog/catalog.h"
 #include "catalog/manager.h"
+#include "catalog/schema.h"
 #include "common/container_tuple.h"
 #include "common/internal_types.h"
 #include "common/logger.h"
@@ -22,10 +25,12 @@
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "expression/abstract_expression.h"
+#include "index/covering_payload_store.h"
 #include "index/index.h"
 #include "planner/index_scan_plan.h"
 #include "storage/data_table.h"
 #include "storage/masked_tuple.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "storage/storage_manager.h"
@@ -79,6 +84,7 @@ bool IndexScanExecutor::DInit() {
   limit_number_ = node.GetLimitNumber();
   limit_offset_ = node.GetLimitOffset();
   descend_ = node.GetDescend();
+  limit_fetch_count_ = static_cast<uint64_t>(limit_offset_ + limit_number_);
 
   if (runtime_keys_.size() != 0) {
     PELOTON_ASSERT(runtime_keys_.size() == values_.size());
@@ -108,6 +114,14 @@ bool IndexScanExecutor::DInit() {
   index_ = table_->GetIndexWithOid(index_id);
   PELOTON_ASSERT(index_ != nullptr);
 
+  // Index-only scans need every returned column in the payloads, and can't
+  // hand out the table's tuples to updates
+  payload_store_ = index_->GetPayloadStore();
+  index_only_ = node.GetIndexOnly() && payload_store_ != nullptr &&
+                node.IsForUpdate() == false &&
+                payload_store_->CoversColumns(
+                    column_ids_.empty() ? full_column_ids_ : column_ids_);
+
   // Then add the only conjunction predicate into the index predicate list
   // (at least for now we only supports single conjunction)
   //
@@ -164,44 +178,19 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
   PELOTON_ASSERT(index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY);
 
-  if (0 == key_column_ids_.size()) {
-    index_->ScanAllKeys(tuple_location_ptrs);
-  } else {
-    // Limit clause accelerate
-    if (limit_) {
-      // invoke index scan limit
-      if (!descend_) {
-        LOG_TRACE("ASCENDING SCAN LIMIT in Primary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::FORWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-      } else {
-        LOG_TRACE("DESCENDING SCAN LIMIT in Primary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::BACKWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-
-        LOG_TRACE("1-Result size is %lu", result_.size());
-      }
-    }
-    // Normal SQL (without limit)
-    else {
-      LOG_TRACE("Index Scan in Primary Index");
-      index_->Scan(values_, key_column_ids_, expr_types_,
-                   ScanDirectionType::FORWARD, tuple_location_ptrs,
-                   &index_predicate_.GetConjunctionList()[0]);
-    }
-
-    LOG_TRACE("tuple_location_ptrs:%lu", tuple_location_ptrs.size());
-  }
+  ScanIndex(tuple_location_ptrs);
 
   if (tuple_location_ptrs.size() == 0) {
     LOG_TRACE("no tuple is retrieved from index.");
     return false;
   }
 
+  if (index_only_) {
+    bool served = false;
+    auto status = ExecIndexOnlyLookup(tuple_location_ptrs, served);
+    if (served) return status;
+  }
+
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
@@ -243,6 +232,10 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         LOG_TRACE("perform read: %u, %u", tuple_location.block,
                   tuple_location.offset);
 
+        if (index_only_) {
+          RecordPayload(tuple_location_ptr, tuple_location, tile_group.get());
+        }
+
         bool eval = true;
         // if having predicate, then perform evaluation.
         if (predicate_ != nullptr) {
@@ -333,7 +326,13 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
             visible_tuple_locations.size());
 
   // Check whether the boundaries satisfy the required condition
-  CheckOpenRangeWithReturnedTuples(visible_tuple_locations);
+  if (limit_) {
+    if (ApplyLimit(visible_tuple_locations) == false) {
+      return ExecPrimaryIndexLookup();
+    }
+  } else {
+    CheckOpenRangeWithReturnedTuples(visible_tuple_locations);
+  }
 
   LOG_TRACE("%ld tuples after pruning boundaries",
             visible_tuple_locations.size());
@@ -401,44 +400,19 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   // Grab info from plan node
   bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
 
-  if (0 == key_column_ids_.size()) {
-    index_->ScanAllKeys(tuple_location_ptrs);
-  } else {
-    // Limit clause accelerate
-    if (limit_) {
-      // invoke index scan limit
-      if (!descend_) {
-        LOG_TRACE("ASCENDING SCAN LIMIT in Secondary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::FORWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-      } else {
-        LOG_TRACE("DESCENDING SCAN LIMIT in Secondary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::BACKWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-
-        if (tuple_location_ptrs.size() == 0) {
-          LOG_TRACE("2-Result size is %lu", tuple_location_ptrs.size());
-        }
-      }
-    }
-    // Normal SQL (without limit)
-    else {
-      LOG_TRACE("Index Scan in Primary Index");
-      index_->Scan(values_, key_column_ids_, expr_types_,
-                   ScanDirectionType::FORWARD, tuple_location_ptrs,
-                   &index_predicate_.GetConjunctionList()[0]);
-    }
-  }
+  ScanIndex(tuple_location_ptrs);
 
   if (tuple_location_ptrs.size() == 0) {
     LOG_TRACE("no tuple is retrieved from index.");
     return false;
   }
 
+  if (index_only_) {
+    bool served = false;
+    auto status = ExecIndexOnlyLookup(tuple_location_ptrs, served);
+    if (served) return status;
+  }
+
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
@@ -496,6 +470,10 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
         LOG_TRACE("perform read: %u, %u", tuple_location.block,
                   tuple_location.offset);
 
+        if (index_only_) {
+          RecordPayload(tuple_location_ptr, tuple_location, tile_group.get());
+        }
+
         // Further check if the version has the secondary key
         ContainerTuple<storage::TileGroup> candidate_tuple(
             tile_group.get(), tuple_location.offset);
@@ -603,7 +581,13 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
             num_tuples_examined, index_->GetName().c_str(), num_blocks_reused);
 
   // Check whether the boundaries satisfy the required condition
-  CheckOpenRangeWithReturnedTuples(visible_tuple_locations);
+  if (limit_) {
+    if (ApplyLimit(visible_tuple_locations) == false) {
+      return ExecSecondaryIndexLookup();
+    }
+  } else {
+    CheckOpenRangeWithReturnedTuples(visible_tuple_locations);
+  }
 
   // Add the tuple locations to the result vector in the order returned by
   // the index scan. We might end up reading the same tile group multiple
@@ -657,6 +641,209 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   return true;
 }
 
+bool IndexScanExecutor::ExecIndexOnlyLookup(
+    const std::vector<ItemPointer *> &tuple_location_ptrs, bool &served) {
+  PELOTON_ASSERT(!done_);
+  PELOTON_ASSERT(payload_store_ != nullptr);
+  served = false;
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto &indexed_columns = index_->GetKeySchema()->GetIndexedColumns();
+
+  std::vector<ItemPointer> visible_tuple_locations;
+  std::vector<storage::TileGroupHeader *> tile_group_headers;
+  std::vector<std::shared_ptr<const index::CoveringPayload>> payloads;
+
+  // Only the tile group headers are read here. The head version of every
+  // entry must be either deleted or visible with a payload recorded from it,
+  // otherwise the version chain has to be walked on the table after all.
+  oid_t last_block = INVALID_OID;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+  for (auto tuple_location_ptr : tuple_location_ptrs) {
+    ItemPointer tuple_location = *tuple_location_ptr;
+    if (tuple_location.block != last_block) {
+      tile_group_header =
+          storage_manager->GetTileGroup(tuple_location.block)->GetHeader();
+      last_block = tuple_location.block;
+    }
+
+    auto visibility = transaction_manager.IsVisible(
+        current_txn, tile_group_header, tuple_location.offset);
+    if (visibility == VisibilityType::DELETED) {
+      continue;
+    } else if (visibility != VisibilityType::OK) {
+      LOG_TRACE("Head version not visible: %u, %u", tuple_location.block,
+                tuple_location.offset);
+      return false;
+    }
+
+    auto payload = payload_store_->Get(
+        tuple_location_ptr, tuple_location,
+        tile_group_header->GetBeginCommitId(tuple_location.offset));
+    if (payload == nullptr) {
+      LOG_TRACE("No payload for: %u, %u", tuple_location.block,
+                tuple_location.offset);
+      return false;
+    }
+
+    // Entries may be stale or outside of an open range, so the key is checked
+    // like it is on the table's tuples
+    index::CoveringTuple tuple(*payload_store_, *payload);
+    storage::MaskedTuple key_tuple(&tuple, indexed_columns);
+    if (index_->Compare(key_tuple, key_column_ids_, expr_types_, values_) ==
+        false) {
+      continue;
+    }
+    if (predicate_ != nullptr &&
+        predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue() ==
+            false) {
+      continue;
+    }
+
+    visible_tuple_locations.push_back(tuple_location);
+    tile_group_headers.push_back(tile_group_header);
+    payloads.push_back(std::move(payload));
+  }
+
+  // The table path fetches more entries if the window cannot be filled
+  if (limit_) {
+    if (LimitWindowIsShort(visible_tuple_locations.size())) {
+      return false;
+    }
+    size_t begin, end;
+    GetLimitWindow(visible_tuple_locations.size(), begin, end);
+    visible_tuple_locations.erase(visible_tuple_locations.begin() + end,
+                                  visible_tuple_locations.end());
+    visible_tuple_locations.erase(visible_tuple_locations.begin(),
+                                  visible_tuple_locations.begin() + begin);
+    tile_group_headers.erase(tile_group_headers.begin() + end,
+                             tile_group_headers.end());
+    tile_group_headers.erase(tile_group_headers.begin(),
+                             tile_group_headers.begin() + begin);
+    payloads.erase(payloads.begin() + end, payloads.end());
+    payloads.erase(payloads.begin(), payloads.begin() + begin);
+  }
+
+  served = true;
+
+  for (size_t i = 0; i < visible_tuple_locations.size(); i++) {
+    auto res = transaction_manager.PerformRead(
+        current_txn, visible_tuple_locations[i], tile_group_headers[i], false);
+    if (!res) {
+      transaction_manager.SetTransactionResult(current_txn,
+                                               ResultType::FAILURE);
+      return res;
+    }
+  }
+
+  // Materialize the returned columns in index order
+  if (!payloads.empty()) {
+    const auto &output_column_ids =
+        column_ids_.empty() ? full_column_ids_ : column_ids_;
+    std::unique_ptr<catalog::Schema> output_schema(
+        catalog::Schema::CopySchema(table_->GetSchema(), output_column_ids));
+    std::shared_ptr<storage::Tile> tile(storage::TileFactory::GetTempTile(
+        *output_schema, static_cast<int>(payloads.size())));
+
+    for (oid_t tuple_id = 0; tuple_id < payloads.size(); tuple_id++) {
+      index::CoveringTuple tuple(*payload_store_, *payloads[tuple_id]);
+      for (oid_t col_id = 0; col_id < output_column_ids.size(); col_id++) {
+        tile->SetValue(tuple.GetValue(output_column_ids[col_id]), tuple_id,
+                       col_id);
+      }
+    }
+    result_.push_back(LogicalTileFactory::WrapTiles({tile}));
+  }
+
+  done_ = true;
+
+  LOG_TRACE("Index-only scan returned %lu tuples", payloads.size());
+
+  return true;
+}
+
+void IndexScanExecutor::RecordPayload(const ItemPointer *tuple_location_ptr,
+                                      const ItemPointer &tuple_location,
+                                      storage::TileGroup *tile_group) {
+  if (!(*tuple_location_ptr == tuple_location)) {
+    return;
+  }
+
+  // Committed versions never change, uncommitted ones may
+  cid_t begin_cid =
+      tile_group->GetHeader()->GetBeginCommitId(tuple_location.offset);
+  if (begin_cid == MAX_CID) {
+    return;
+  }
+
+  ContainerTuple<storage::TileGroup> tuple(tile_group, tuple_location.offset);
+  payload_store_->Put(tuple_location_ptr, tuple_location, begin_cid, tuple);
+}
+
+void IndexScanExecutor::ScanIndex(
+    std::vector<ItemPointer *> &tuple_location_ptrs) {
+  // The limit and offset only hold for the tuples that pass the visibility,
+  // predicate and boundary checks, so they are applied after those checks.
+  // The index is asked for offset + limit entries at first, and for more if
+  // too many of them are filtered out.
+  if (limit_) {
+    auto direction =
+        descend_ ? ScanDirectionType::BACKWARD : ScanDirectionType::FORWARD;
+    index_->ScanLimit(values_, key_column_ids_, expr_types_, direction,
+                      tuple_location_ptrs,
+                      &index_predicate_.GetConjunctionList()[0],
+                      limit_fetch_count_, 0);
+    scan_exhausted_ = tuple_location_ptrs.size() < limit_fetch_count_;
+  } else if (key_column_ids_.empty()) {
+    index_->ScanAllKeys(tuple_location_ptrs);
+  } else {
+    index_->Scan(values_, key_column_ids_, expr_types_,
+                 ScanDirectionType::FORWARD, tuple_location_ptrs,
+                 &index_predicate_.GetConjunctionList()[0]);
+  }
+
+  LOG_TRACE("tuple_location_ptrs:%lu", tuple_location_ptrs.size());
+}
+
+void IndexScanExecutor::GetLimitWindow(size_t count, size_t &begin,
+                                       size_t &end) const {
+  begin = std::min(count, static_cast<size_t>(limit_offset_));
+  end = std::min(count, begin + static_cast<size_t>(limit_number_));
+}
+
+bool IndexScanExecutor::LimitWindowIsShort(size_t count) const {
+  return scan_exhausted_ == false &&
+         count < static_cast<uint64_t>(limit_offset_ + limit_number_);
+}
+
+bool IndexScanExecutor::ApplyLimit(std::vector<ItemPointer> &tuple_locations) {
+  // A backward scan returns the tuples beyond an open boundary at either end,
+  // so they are pruned wherever they are
+  if (left_open_ || right_open_) {
+    tuple_locations.erase(
+        std::remove_if(tuple_locations.begin(), tuple_locations.end(),
+                       [this](const ItemPointer &tuple_location) {
+                         return CheckKeyConditions(tuple_location) == false;
+                       }),
+        tuple_locations.end());
+  }
+
+  if (LimitWindowIsShort(tuple_locations.size())) {
+    limit_fetch_count_ *= 2;
+    return false;
+  }
+
+  size_t begin, end;
+  GetLimitWindow(tuple_locations.size(), begin, end);
+  tuple_locations.erase(tuple_locations.begin() + end, tuple_locations.end());
+  tuple_locations.erase(tuple_locations.begin(),
+                        tuple_locations.begin() + begin);
+  return true;
+}
+
 void IndexScanExecutor::CheckOpenRangeWithReturnedTuples(
     std::vector<ItemPointer> &tuple_locations) {
   while (left_open_) {
@@ -59,7 +59,15 @@ static void CompileAndExecutePlan(
     codegen::QueryCompiler compiler;
     auto compiled_query = compiler.Compile(
         *plan, executor_context.GetParams().GetQueryParametersMap(), consumer);
-    compiled_query->Compile();
+
+    // Either compile the query right away, or start executing it in the
+    // interpreter while it is compiled in the background
+    if (settings::SettingsManager::GetBool(
+            settings::SettingId::codegen_tiered_execution)) {
+      compiled_query->CompileInBackground();
+    } else {
+      compiled_query->Compile();
+    }
 
     // Grab an instance to the plan
     query = compiled_query.get();
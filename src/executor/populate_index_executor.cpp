@@ -11,14 +11,13 @@
 //===----------------------------------------------------------------------===//
 
 #include "common/logger.h"
-#include "type/value.h"
-#include "executor/logical_tile.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "executor/populate_index_executor.h"
 #include "executor/executor_context.h"
+#include "index/index.h"
+#include "index/index_builder.h"
 #include "planner/populate_index_plan.h"
-#include "expression/tuple_value_expression.h"
 #include "storage/data_table.h"
-#include "storage/tile.h"
 
 namespace peloton {
 namespace executor {
@@ -43,6 +42,7 @@ bool PopulateIndexExecutor::DInit() {
       GetPlanNode<planner::PopulateIndexPlan>();
   target_table_ = node.GetTable();
   column_ids_ = node.GetColumnIds();
+  index_name_ = node.GetIndexName();
   done_ = false;
 
   return true;
@@ -52,50 +52,39 @@ bool PopulateIndexExecutor::DExecute() {
   LOG_TRACE("Populate Index Executor");
   PELOTON_ASSERT(executor_context_ != nullptr);
   auto current_txn = executor_context_->GetTransaction();
-  auto executor_pool = executor_context_->GetPool();
   if (done_ == false) {
-    //Get the output from seq_scan
-    while (children_[0]->Execute()) {
-      child_tiles_.emplace_back(children_[0]->GetOutput());
-    }
+    done_ = true;
 
-    if (child_tiles_.size() == 0) {
-      LOG_TRACE("PopulateIndex Executor : false -- no child tiles ");
+    // The child creates the index
+    children_[0]->Execute();
+    if (current_txn->GetResult() != ResultType::SUCCESS) {
+      LOG_TRACE("PopulateIndex Executor : false -- index not created ");
       return false;
     }
 
-    auto target_table_schema = target_table_->GetSchema();
-
-    std::unique_ptr<storage::Tuple> tuple(
-        new storage::Tuple(target_table_schema, true));
-
-    // Go over the logical tile and insert in the index the values
-    for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
-         child_tile_itr++) {
-      auto tile = child_tiles_[child_tile_itr].get();
-
-      // Go over all tuples in the logical tile
-      for (oid_t tuple_id : *tile) {
-        ContainerTuple<LogicalTile> cur_tuple(tile, tuple_id);
-
-        // Materialize the logical tile tuple
-        for (oid_t column_itr = 0; column_itr < column_ids_.size();
-             column_itr++) {
-          type::Value val = (cur_tuple.GetValue(column_itr));
-          tuple->SetValue(column_ids_[column_itr], val, executor_pool);
-        }
-
-        ItemPointer location(tile->GetBaseTile(0)->GetTileGroup()->GetTileGroupId(),
-                             tuple_id);
-
-        // insert tuple into the index.
-        ItemPointer *index_entry_ptr = nullptr;
-        target_table_->InsertInIndexes(tuple.get(), location, current_txn,
-                                       &index_entry_ptr);
+    std::shared_ptr<index::Index> target_index;
+    for (oid_t index_itr = 0; index_itr < target_table_->GetIndexCount();
+         index_itr++) {
+      auto index = target_table_->GetIndex(index_itr);
+      if (index != nullptr && index->GetName() == index_name_) {
+        target_index = index;
+        break;
       }
     }
+    if (target_index == nullptr) {
+      LOG_TRACE("PopulateIndex Executor : false -- index not found ");
+      return false;
+    }
 
-    done_ = true;
+    // Scan the table in parallel and bulk load the index
+    index::IndexBuilder builder(target_table_, target_index.get());
+    if (builder.Build() == false) {
+      LOG_TRACE("PopulateIndex Executor : duplicate key in unique index");
+      auto &transaction_manager =
+          concurrency::TransactionManagerFactory::GetInstance();
+      transaction_manager.SetTransactionResult(current_txn,
+                                               ResultType::FAILURE);
+    }
   }
   LOG_TRACE("Populate Index Executor : false -- done ");
   return false;
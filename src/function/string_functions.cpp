@@ -16,6 +16,7 @@
 #include "executor/executor_context.h"
 #include "type/type_util.h"
 #include "type/abstract_pool.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace function {
@@ -229,20 +230,8 @@ int32_t StringFunctions::CompareStrings(const char *str1, uint32_t len1,
 
 void StringFunctions::WriteString(const char *data, uint32_t len, char *buf,
                                   peloton::type::AbstractPool &pool) {
-  struct Varlen {
-    uint32_t len;
-    char data[0];
-  };
-
-  // Allocate memory for the Varlen object
-  auto *area = static_cast<Varlen *>(pool.Allocate(sizeof(uint32_t) + len));
-
-  // Populate it
-  area->len = len;
-  PELOTON_MEMCPY(area->data, data, len);
-
-  // Store a pointer to the Varlen object into the target memory space
-  *reinterpret_cast<Varlen **>(buf) = area;
+  // Short strings are inlined into the slot, only long ones touch the pool
+  peloton::type::VarlenSlot::Store(buf, data, len, &pool);
 }
 
 // TODO(pmenon): UTF8 checking, string checking, lots of error handling here
@@ -53,6 +53,7 @@ bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
 void TransactionLevelGCManager::Running(const int &thread_id) {
   PELOTON_ASSERT(is_running_ == true);
   uint32_t backoff_shifts = 0;
+  eid_t index_gc_eid = 0;
   while (true) {
     auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
 
@@ -67,6 +68,13 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
     int reclaimed_count = Reclaim(thread_id, expired_eid);
     int unlinked_count = Unlink(thread_id, expired_eid);
 
+    // Once the epoch has moved on, index nodes retired before it can be
+    // freed as well, as soon as no index operation can still see them
+    if (expired_eid != index_gc_eid) {
+      index::Index::PerformRegisteredGC();
+      index_gc_eid = expired_eid;
+    }
+
     if (is_running_ == false) {
       return;
     }
@@ -240,10 +248,29 @@ void TransactionLevelGCManager::AddToRecycleMap(
       // versions.
       ItemPointer location(entry.first, element.first);
 
+      // the indirection of a tuple that no longer exists has been unlinked
+      // from all indexes, so it can be handed out again. this happens one
+      // epoch after the unlinking, just like the recycling of the tuple slot,
+      // so no reader that found it through an index can still be using it.
+      // a secondary entry of an aborted update may still be left behind;
+      // readers check the key of the tuple they find, and unique checks
+      // ignore entries whose tuple does not have the key (see
+      // DataTable::TupleMayHaveKey).
+      ItemPointer *indirection = nullptr;
+      if (IsTupleDead(element.second) == true) {
+        indirection = tile_group_header->GetIndirection(location.offset);
+      }
+      if (element.second == GCVersionType::COMMIT_DELETE) {
+        ClearTombstoneIndirection(tile_group_header, location.offset);
+      }
+
       // If the tuple being reset no longer exists, just skip it
       if (ResetTuple(location) == false) {
         continue;
       }
+      if (indirection != nullptr) {
+        table->FreeIndirection(indirection);
+      }
       // if immutable is false and the entry for table_id exists.
       if ((!immutable) &&
           recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
@@ -280,6 +307,29 @@ void TransactionLevelGCManager::AddToRecycleMap(
   delete txn_ctx;
 }
 
+bool TransactionLevelGCManager::IsTupleDead(const GCVersionType &type) {
+  return type == GCVersionType::COMMIT_DELETE ||
+         type == GCVersionType::ABORT_INSERT ||
+         type == GCVersionType::COMMIT_INS_DEL ||
+         type == GCVersionType::ABORT_INS_DEL;
+}
+
+void TransactionLevelGCManager::ClearTombstoneIndirection(
+    storage::TileGroupHeader *tile_group_header, const oid_t &tuple_id) {
+  // the empty version installed by the delete is the newer version
+  ItemPointer tombstone = tile_group_header->GetPrevItemPointer(tuple_id);
+  if (tombstone.IsNull()) {
+    return;
+  }
+
+  auto tombstone_tile_group =
+      storage::StorageManager::GetInstance()->GetTileGroup(tombstone.block);
+  if (tombstone_tile_group == nullptr) {
+    return;
+  }
+  tombstone_tile_group->GetHeader()->SetIndirection(tombstone.offset, nullptr);
+}
+
 // this function returns a free tuple slot, if one exists
 // called by data_table.
 ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
@@ -368,23 +418,28 @@ void TransactionLevelGCManager::UnlinkVersion(const ItemPointer location,
     // if the version differs from the previous one in some columns where
     // secondary indexes are built on, then we need to unlink the previous
     // version from the secondary index.
-  } else if (type == GCVersionType::COMMIT_DELETE) {
-    // the gc'd version is an old version.
-    // need to recycle this version as well as its newer (empty) version.
-    // we also need to delete the tuple from the primary and secondary
-    // indexes.
+    ItemPointer newer_location =
+        tile_group_header->GetPrevItemPointer(location.offset);
+    UnlinkStaleSecondaryKeys(table, current_tuple, indirection,
+                             newer_location);
   } else if (type == GCVersionType::ABORT_UPDATE) {
     // the gc'd version is a newly created version.
     // if the version differs from the previous one in some columns where
     // secondary indexes are built on, then we need to unlink this version
     // from the secondary index.
-
+    UnlinkStaleSecondaryKeys(table, current_tuple, indirection,
+                             INVALID_ITEMPOINTER);
   } else if (type == GCVersionType::ABORT_DELETE) {
     // the gc'd version is a newly created empty version.
     // need to recycle this version.
     // no index manipulation needs to be made.
   } else {
-    PELOTON_ASSERT(type == GCVersionType::ABORT_INSERT ||
+    // COMMIT_DELETE: the gc'd version is an old version.
+    // need to recycle this version as well as its newer (empty) version.
+    // we also need to delete the tuple from the primary and secondary
+    // indexes, so that its indirection can be recycled.
+    PELOTON_ASSERT(type == GCVersionType::COMMIT_DELETE ||
+                   type == GCVersionType::ABORT_INSERT ||
                    type == GCVersionType::COMMIT_INS_DEL ||
                    type == GCVersionType::ABORT_INS_DEL);
 
@@ -403,8 +458,118 @@ void TransactionLevelGCManager::UnlinkVersion(const ItemPointer location,
 
       index->DeleteEntry(current_key.get(), indirection);
     }
+
+    // the keys that older versions had before an update are only unlinked
+    // when that update is gc'd, which may happen after this. unlink them now
+    // so that they do not outlive the indirection.
+    UnlinkOlderVersionKeys(table, tile_group_header, location.offset,
+                           indirection);
   }
 }
 
+void TransactionLevelGCManager::UnlinkOlderVersionKeys(
+    storage::DataTable *table, storage::TileGroupHeader *tile_group_header,
+    const oid_t &tuple_id, ItemPointer *indirection) {
+  auto storage_manager = storage::StorageManager::GetInstance();
+  ItemPointer older_location = tile_group_header->GetNextItemPointer(tuple_id);
+
+  // a version that has already been recycled no longer has the indirection
+  while (older_location.IsNull() == false) {
+    auto older_tile_group = storage_manager->GetTileGroup(older_location.block);
+    if (older_tile_group == nullptr) {
+      return;
+    }
+    auto older_header = older_tile_group->GetHeader();
+    if (older_header->GetIndirection(older_location.offset) != indirection) {
+      return;
+    }
+
+    ContainerTuple<storage::TileGroup> older_tuple(older_tile_group.get(),
+                                                   older_location.offset);
+    for (size_t idx = 0; idx < table->GetIndexCount(); ++idx) {
+      auto index = table->GetIndex(idx);
+      if (index == nullptr ||
+          index->GetIndexType() == IndexConstraintType::PRIMARY_KEY ||
+          index->GetMetadata()->IndexesTuple(&older_tuple) == false) {
+        continue;
+      }
+      auto index_schema = index->GetKeySchema();
+      std::unique_ptr<storage::Tuple> older_key(
+          new storage::Tuple(index_schema, true));
+      older_key->SetFromTuple(&older_tuple, index_schema->GetIndexedColumns(),
+                              index->GetPool());
+
+      index->DeleteEntry(older_key.get(), indirection);
+    }
+
+    older_location = older_header->GetNextItemPointer(older_location.offset);
+  }
+}
+
+void TransactionLevelGCManager::UnlinkStaleSecondaryKeys(
+    storage::DataTable *table, const AbstractTuple &version,
+    ItemPointer *indirection, const ItemPointer &newer_location) {
+  for (size_t idx = 0; idx < table->GetIndexCount(); ++idx) {
+    auto index = table->GetIndex(idx);
+    if (index == nullptr ||
+        index->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
+      continue;
+    }
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+
+    // a version that fails the predicate of a partial index has no entry
+    if (index->GetMetadata()->IndexesTuple(&version) == false) {
+      continue;
+    }
+
+    // build key.
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    key->SetFromTuple(&version, indexed_columns, index->GetPool());
+
+    // the entry is shared with the newer versions that have the same key
+    if (VersionHasKey(newer_location, index.get(), *key) ||
+        VersionHasKey(*indirection, index.get(), *key)) {
+      continue;
+    }
+
+    index->DeleteEntry(key.get(), indirection);
+
+    // an update may have installed a version with this key in the meantime,
+    // and found the entry still in place
+    if (VersionHasKey(*indirection, index.get(), *key)) {
+      index->InsertEntry(key.get(), indirection);
+    }
+  }
+}
+
+bool TransactionLevelGCManager::VersionHasKey(const ItemPointer &location,
+                                              index::Index *index,
+                                              const storage::Tuple &key) {
+  if (location.IsNull()) {
+    return false;
+  }
+  auto tile_group =
+      storage::StorageManager::GetInstance()->GetTileGroup(location.block);
+  if (tile_group == nullptr) {
+    return false;
+  }
+
+  ContainerTuple<storage::TileGroup> version(tile_group.get(),
+                                             location.offset);
+
+  // a version that fails the predicate of a partial index has no entry in it
+  if (index->GetMetadata()->IndexesTuple(&version) == false) {
+    return false;
+  }
+
+  auto index_schema = index->GetKeySchema();
+  std::unique_ptr<storage::Tuple> version_key(
+      new storage::Tuple(index_schema, true));
+  version_key->SetFromTuple(&version, index_schema->GetIndexedColumns(),
+                            index->GetPool());
+  return version_key->EqualsNoSchemaCheck(key);
+}
+
 }  // namespace gc
 }  // namespace peloton
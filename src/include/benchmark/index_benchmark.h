@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_benchmark.h
+//
+// Identification: src/include/benchmark/index_benchmark.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+namespace benchmark {
+
+//===--------------------------------------------------------------------===//
+// Index Benchmark
+//===--------------------------------------------------------------------===//
+
+/// The operation mix run against the index. The mixes follow YCSB, with the
+/// index side of each operation: a read is a point lookup, a scan is a short
+/// forward range scan, and an insert adds a key that is not in the index yet.
+enum class IndexWorkloadType {
+  READ_ONLY = 0,    // 100% reads (YCSB C)
+  BALANCED = 1,     // 50% reads, 50% inserts
+  SCAN_HEAVY = 2,   // 95% scans, 5% inserts (YCSB E)
+  INSERT_ONLY = 3,  // 100% inserts
+};
+std::string IndexWorkloadTypeToString(IndexWorkloadType type);
+IndexWorkloadType StringToIndexWorkloadType(const std::string &str);
+
+/// How keys are picked for reads and scans, and how keys are laid out. With
+/// the uniform and Zipfian distributions the key numbers are scrambled into
+/// the key space, so that inserts land all over the index and the hot keys of
+/// the Zipfian distribution are not clustered. With the sequential
+/// distribution keys are inserted in order and read in order.
+enum class KeyDistributionType {
+  UNIFORM = 0,
+  ZIPFIAN = 1,
+  SEQUENTIAL = 2,
+};
+std::string KeyDistributionTypeToString(KeyDistributionType type);
+KeyDistributionType StringToKeyDistributionType(const std::string &str);
+
+/// The type of the single key column
+enum class BenchmarkKeyType {
+  INTEGER = 0,  // BIGINT
+  STRING = 1,   // VARCHAR, YCSB-style "user0000000000012345678"
+};
+std::string BenchmarkKeyTypeToString(BenchmarkKeyType type);
+BenchmarkKeyType StringToBenchmarkKeyType(const std::string &str);
+
+struct IndexBenchmarkConfiguration {
+  IndexType index_type = IndexType::BWTREE;
+
+  IndexWorkloadType workload_type = IndexWorkloadType::READ_ONLY;
+
+  KeyDistributionType distribution_type = KeyDistributionType::UNIFORM;
+
+  BenchmarkKeyType key_type = BenchmarkKeyType::INTEGER;
+
+  // Number of worker threads
+  size_t thread_count = 1;
+
+  // Number of keys loaded before the measured run
+  size_t key_count = 1000000;
+
+  // Number of operations each thread runs
+  size_t operation_count = 1000000;
+
+  // Scans return between 1 and this many entries
+  size_t max_scan_length = 100;
+
+  // Skew of the Zipfian distribution
+  double zipf_theta = 0.99;
+
+  // Seed of all random choices, so that runs can be repeated
+  uint64_t random_seed = 0;
+};
+
+struct IndexBenchmarkResult {
+  // Operations per second over all threads
+  double throughput = 0;
+
+  // Operation latency percentiles, in microseconds
+  double latency_p50 = 0;
+  double latency_p90 = 0;
+  double latency_p99 = 0;
+  double latency_p999 = 0;
+  double latency_max = 0;
+
+  // Number of entries in the index after the run
+  size_t entry_count = 0;
+
+  // Bytes held by the index after the run
+  size_t memory_footprint = 0;
+};
+
+/**
+ * @brief Runs one configuration: builds an empty index, loads it and runs the
+ * workload on the configured number of threads. Only the run is measured.
+ *
+ * Scans are not run against hash indexes, which have no key order; such a
+ * configuration is rejected with an exception.
+ */
+IndexBenchmarkResult RunIndexBenchmark(
+    const IndexBenchmarkConfiguration &config);
+
+/**
+ * @brief Draws Zipfian distributed numbers in [0, item_count), where 0 is the
+ * most popular item. This is the generator of Gray et al., "Quickly
+ * Generating Billion-Record Synthetic Databases", as used by YCSB.
+ *
+ * The normalization constant takes O(item_count) time to compute, so it is
+ * computed once and shared by the generators of all threads.
+ */
+class ZipfianGenerator {
+ public:
+  ZipfianGenerator(uint64_t item_count, double theta, double zetan,
+                   uint64_t seed);
+
+  uint64_t GetSample();
+
+  static double Zeta(uint64_t item_count, double theta);
+
+ private:
+  uint64_t item_count_;
+  double theta_;
+  double zetan_;
+  double alpha_;
+  double eta_;
+
+  std::mt19937_64 rng_;
+  std::uniform_real_distribution<double> unif_;
+};
+
+}  // namespace benchmark
+}  // namespace peloton
@@ -35,6 +35,10 @@ namespace concurrency {
 class TransactionContext;
 }  // namespace concurrency
 
+namespace expression {
+class AbstractExpression;
+}  // namespace expression
+
 namespace index {
 class Index;
 }  // namespace index
@@ -109,7 +113,9 @@ class Catalog {
                          uint32_t tuples_per_tilegroup = DEFAULT_TUPLES_PER_TILEGROUP,
                          LayoutType layout_type = LayoutType::ROW);
 
-  // Create index for a table
+  // Create index for a table. The columns in include_attrs are covered by
+  // the index without being part of its key. Given a predicate, only the
+  // tuples satisfying it are indexed (partial index)
   ResultType CreateIndex(concurrency::TransactionContext *txn,
                          const std::string &database_name,
                          const std::string &schema_name,
@@ -117,7 +123,10 @@ class Catalog {
                          const std::string &index_name,
                          const std::vector<oid_t> &key_attrs,
                          bool unique_keys,
-                         IndexType index_type);
+                         IndexType index_type,
+                         const std::vector<oid_t> &include_attrs = {},
+                         const expression::AbstractExpression *predicate =
+                             nullptr);
 
   ResultType CreateIndex(concurrency::TransactionContext *txn,
                          oid_t database_oid,
@@ -128,7 +137,10 @@ class Catalog {
                          const std::vector<oid_t> &key_attrs,
                          bool unique_keys,
                          IndexType index_type,
-                         IndexConstraintType index_constraint);
+                         IndexConstraintType index_constraint,
+                         const std::vector<oid_t> &include_attrs = {},
+                         const expression::AbstractExpression *predicate =
+                             nullptr);
 
   /**
    * @brief   create a new layout for a table
@@ -132,7 +132,7 @@ class Column : public Printable {
   // value type of column
   type::TypeId column_type_;  //  = type::TypeId::INVALID;
 
-  // if the column is not inlined, this is set to pointer size
+  // if the column is not inlined, this is set to the size of a varlen slot
   // else, it is set to length of the fixed length column
   size_t fixed_length_;  //  = INVALID_OID;
 
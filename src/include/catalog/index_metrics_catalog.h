@@ -20,6 +20,7 @@
 // 4: deletes
 // 5: inserts
 // 6: time_stamp
+// 7: memory_bytes
 //
 // Indexes: (index offset: indexed columns)
 // 0: index_oid (unique & primary key)
@@ -52,6 +53,7 @@ class IndexMetricsCatalog : public AbstractCatalog {
                           int64_t deletes,
                           int64_t inserts,
                           int64_t time_stamp,
+                          int64_t memory_bytes,
                           type::AbstractPool *pool);
 
   bool DeleteIndexMetrics(concurrency::TransactionContext *txn, oid_t index_oid);
@@ -69,6 +71,7 @@ class IndexMetricsCatalog : public AbstractCatalog {
     DELETES = 3,
     INSERTS = 4,
     TIME_STAMP = 5,
+    MEMORY_BYTES = 6,
     // Add new columns here in creation order
   };
 
@@ -20,6 +20,11 @@
 // 4: deletes
 // 5: inserts
 // 6: time_stamp
+// 7: tile_bytes
+// 8: header_bytes
+// 9: varlen_bytes
+// 10: indirection_bytes
+// 11: version_bytes
 //
 // Indexes: (index offset: indexed columns)
 // 0: index_oid (unique & primary key)
@@ -30,6 +35,7 @@
 
 #include "catalog/abstract_catalog.h"
 #include "statistics/index_metric.h"
+#include "statistics/memory_metric.h"
 
 #define TABLE_METRICS_CATALOG_NAME "pg_table_metrics"
 
@@ -52,6 +58,7 @@ class TableMetricsCatalog : public AbstractCatalog {
                           int64_t deletes,
                           int64_t inserts,
                           int64_t time_stamp,
+                          const stats::MemoryMetric &memory,
                           type::AbstractPool *pool);
 
   bool DeleteTableMetrics(concurrency::TransactionContext *txn, oid_t table_oid);
@@ -69,6 +76,11 @@ class TableMetricsCatalog : public AbstractCatalog {
     DELETES = 3,
     INSERTS = 4,
     TIME_STAMP = 5,
+    TILE_BYTES = 6,
+    HEADER_BYTES = 7,
+    VARLEN_BYTES = 8,
+    INDIRECTION_BYTES = 9,
+    VERSION_BYTES = 10,
     // Add new columns here in creation order
   };
 
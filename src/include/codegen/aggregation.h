@@ -78,6 +78,11 @@ class Aggregation {
   void AdvanceValues(CodeGen &codegen, llvm::Value *space,
                      const std::vector<codegen::Value> &next) const;
 
+  // Merge the (partial) aggregates stored in the other storage space into the
+  // aggregates stored in the provided storage space
+  void MergeValues(CodeGen &codegen, llvm::Value *space,
+                   llvm::Value *other_space) const;
+
   // Compute the final values of all the aggregates stored in the provided
   // storage space, inserting them into the provided output vector.
   void FinalizeValues(CodeGen &codegen, llvm::Value *space,
@@ -92,6 +97,11 @@ class Aggregation {
   // Get the storage format of the aggregates this class is configured to handle
   const UpdateableStorage &GetAggregateStorage() const { return storage_; }
 
+  // Can partial aggregates of the provided terms be merged? Distinct aggregates
+  // can't, since the values they have seen are tracked in shared hash tables.
+  static bool IsMergeable(
+      const std::vector<planner::AggregatePlan::AggTerm> &agg_terms);
+
  private:
   bool IsGlobal() const { return is_global_; }
 
@@ -157,6 +167,13 @@ class Aggregation {
                     const Aggregation::AggregateInfo &agg,
                     UpdateableStorage::NullBitmap &null_bitmap) const;
 
+  // Merge a specific aggregate component stored in the other storage space into
+  // the same component in the provided storage space
+  void MergeValue(CodeGen &codegen, llvm::Value *space, ExpressionType type,
+                  uint32_t storage_index, llvm::Value *other_space,
+                  UpdateableStorage::NullBitmap &null_bitmap,
+                  UpdateableStorage::NullBitmap &other_null_bitmap) const;
+
  private:
   // Is this a global aggregation?
   bool is_global_;
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -21,8 +22,10 @@
 
 namespace llvm {
 class ExecutionEngine;
+class GlobalVariable;
 class LLVMContext;
 class Module;
+class ObjectCache;
 
 namespace legacy {
 class FunctionPassManager;
@@ -70,6 +73,14 @@ class CodeContext {
   /// Lookup a builtin function that has been registered in this context
   std::pair<llvm::Function *, FuncPtr> LookupBuiltin(const std::string &name) const;
 
+  /// Register a pointer to an object of this process, returning an external
+  /// global whose address resolves to the pointer when the code is loaded
+  llvm::GlobalVariable *RegisterExternalPointer(const void *ptr);
+
+  /// Lookup the pointer an external global registered in this context
+  /// resolves to, or nullptr if there is no such global
+  void *LookupExternalPointer(const std::string &name) const;
+
   /// Return the LLVM function for UDF that has been registered in this context
   llvm::Function *GetUDF() const { return udf_func_ptr_; }
 
@@ -85,6 +96,19 @@ class CodeContext {
   /// Compile all the code contained in this context
   void Compile();
 
+  /**
+   * @brief Looks up the object code of this context in the persistent object
+   * cache, if one is configured. Entries are keyed on the unoptimized IR and
+   * the target, so this must be called before Optimize().
+   *
+   * Compile() loads the cached code if there is one, or else adds the code
+   * it compiles to the cache.
+   *
+   * @return true if the code was found, in which case Optimize() can be
+   * skipped
+   */
+  bool FindCachedObject();
+
   /// Retrieve the raw function pointer to the provided compiled LLVM function
   FuncPtr GetRawFunctionPointer(llvm::Function *fn) const;
 
@@ -128,6 +152,11 @@ class CodeContext {
   // Get the raw IR in text form
   std::string GetIR() const;
 
+  // Strip the ID of this context from the names of the module and of the
+  // functions defined in it, so that the same code gets the same IR and
+  // symbols in every context
+  void NormalizeNames();
+
   // Get the IR Builder
   llvm::IRBuilder<> &GetBuilder() { return *builder_; }
 
@@ -162,6 +191,10 @@ class CodeContext {
   // The optimization pass manager
   std::unique_ptr<llvm::legacy::FunctionPassManager> pass_manager_;
 
+  // The persistent cache of the compiled code, if any. It has to outlive the
+  // engine, which refers to it.
+  std::unique_ptr<llvm::ObjectCache> object_cache_;
+
   // The JIT compilation engine
   std::string err_str_;
   std::unique_ptr<llvm::ExecutionEngine> engine_;
@@ -182,6 +215,13 @@ class CodeContext {
   std::unordered_map<std::string, std::pair<llvm::Function *, FuncPtr>>
       builtins_;
 
+  // The pointers to objects of this process that the code refers to, by the
+  // name of the external global standing in for them
+  std::unordered_map<std::string, void *> external_pointers_;
+
+  // The external globals standing in for pointers, by pointer
+  std::unordered_map<const void *, llvm::GlobalVariable *> pointer_globals_;
+
   // The functions needed in this module, and their implementations. If the
   // function has not been compiled yet, the function pointer will be NULL. The
   // function pointers are populated in Compile()
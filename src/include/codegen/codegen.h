@@ -105,6 +105,11 @@ class CodeGen {
   llvm::Constant *Null(llvm::Type *type) const;
   llvm::Constant *NullPtr(llvm::PointerType *type) const;
 
+  /// Return a constant pointer to an object of this process. The address is
+  /// resolved when the code is loaded rather than baked into the code, which
+  /// keeps the code the same across runs (see CodeContext::FindCachedObject).
+  llvm::Constant *ConstPointer(const void *ptr, llvm::PointerType *type) const;
+
   llvm::Value *AllocateVariable(llvm::Type *type, const std::string &name);
   llvm::Value *AllocateBuffer(llvm::Type *element_type, uint32_t num_elems,
                               const std::string &name);
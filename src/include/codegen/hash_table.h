@@ -216,9 +216,25 @@ class HashTable {
   void MergeLazyUnfinished(CodeGen &codegen, llvm::Value *global_ht,
                            llvm::Value *local_ht) const;
 
+  void PartitionLazyUnfinished(CodeGen &codegen, llvm::Value *ht_ptr,
+                               llvm::Value *partitions,
+                               llvm::Value *num_partitions) const;
+
   virtual void Iterate(CodeGen &codegen, llvm::Value *ht_ptr,
                        IterateCallback &callback) const;
 
+  // Iterate over the entries in every stride-th bucket of the directory,
+  // starting at the given bucket. Threads that use distinct starting buckets
+  // and a stride equal to the number of threads visit disjoint entries.
+  void IterateStrided(CodeGen &codegen, llvm::Value *ht_ptr,
+                      llvm::Value *start_bucket, llvm::Value *stride,
+                      IterateCallback &callback) const;
+
+  // Iterate over the entries that were inserted lazily into a table that was
+  // never built, e.g., a partition filled by PartitionLazyUnfinished()
+  void IterateLazy(CodeGen &codegen, llvm::Value *ht_ptr,
+                   IterateCallback &callback) const;
+
   virtual void VectorizedIterate(CodeGen &codegen, llvm::Value *ht_ptr,
                                  Vector &selection_vector,
                                  VectorizedIterateCallback &callback) const;
@@ -229,6 +245,11 @@ class HashTable {
 
   virtual void Destroy(CodeGen &codegen, llvm::Value *ht_ptr) const;
 
+ private:
+  // Iterate over the chain of entries starting at the given one
+  void IterateChain(CodeGen &codegen, llvm::Value *head,
+                    IterateCallback &callback) const;
+
  private:
   uint32_t value_size_;
 
@@ -48,6 +48,9 @@ class VectorizedLoop {
   // Get the loop variable at the given index
   llvm::Value *GetLoopVar(uint32_t index) const;
 
+  // Break out of the loop
+  void Break() { loop_.Break(); }
+
   // Complete the loop
   void LoopEnd(CodeGen &codegen, const std::vector<llvm::Value *> &loop_vars);
 
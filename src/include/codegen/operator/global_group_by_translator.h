@@ -38,6 +38,11 @@ class GlobalGroupByTranslator : public OperatorTranslator {
   // Nothing to initialize
   void InitializeQueryState() override;
 
+  // Thread-local partial aggregates for parallel child pipelines
+  void RegisterPipelineState(PipelineContext &pipeline_ctx) override;
+  void InitializePipelineState(PipelineContext &pipeline_ctx) override;
+  void FinishPipeline(PipelineContext &pipeline_ctx) override;
+
   // No helper functions
   void DefineAuxiliaryFunctions() override {}
 
@@ -73,6 +78,13 @@ class GlobalGroupByTranslator : public OperatorTranslator {
     uint32_t agg_index_;
   };
 
+ private:
+  // Is the provided pipeline our child pipeline, and is it parallel?
+  bool IsParallelChildPipeline(PipelineContext &pipeline_ctx) const {
+    return pipeline_ctx.IsParallel() &&
+           pipeline_ctx.GetPipeline() == child_pipeline_;
+  }
+
  private:
   // The pipeline the child operator of this aggregation belongs to
   Pipeline child_pipeline_;
@@ -82,6 +94,10 @@ class GlobalGroupByTranslator : public OperatorTranslator {
 
   // The ID of our materialization buffer in the runtime state
   QueryState::Id mat_buffer_id_;
+
+  // The ID of the thread-local materialization buffer, if the child pipeline
+  // is parallel
+  PipelineContext::Id local_buffer_id_;
 };
 
 }  // namespace codegen
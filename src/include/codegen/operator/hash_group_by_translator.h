@@ -33,6 +33,10 @@ class HashGroupByTranslator : public OperatorTranslator {
   // Global/configurable variable controlling whether hash aggregations prefetch
   static std::atomic<bool> kUsePrefetch;
 
+  // The number of hash-table partitions thread-local aggregates are merged into
+  // when the child pipeline is parallel
+  static uint32_t kNumMergePartitions;
+
   // Constructor
   HashGroupByTranslator(const planner::AggregatePlan &group_by,
                         CompilationContext &context, Pipeline &pipeline);
@@ -40,6 +44,12 @@ class HashGroupByTranslator : public OperatorTranslator {
   // Codegen any initialization work for this operator
   void InitializeQueryState() override;
 
+  // Thread-local pre-aggregation for parallel child pipelines
+  void RegisterPipelineState(PipelineContext &pipeline_ctx) override;
+  void InitializePipelineState(PipelineContext &pipeline_ctx) override;
+  void FinishPipeline(PipelineContext &pipeline_ctx) override;
+  void TearDownPipelineState(PipelineContext &pipeline_ctx) override;
+
   // Define any helper functions this translator needs
   void DefineAuxiliaryFunctions() override {}
 
@@ -126,6 +136,32 @@ class HashGroupByTranslator : public OperatorTranslator {
     const std::vector<codegen::Value> grouping_keys_;
   };
 
+  //===--------------------------------------------------------------------===//
+  // The callback used when merging a thread-local hash table into a partition
+  // of the final aggregation. Only entries belonging to the partition are
+  // merged, either into an existing group or into a new one.
+  //===--------------------------------------------------------------------===//
+  class MergePartition : public HashTable::IterateCallback {
+   public:
+    // Constructor
+    MergePartition(const OAHashTable &hash_table,
+                   const Aggregation &aggregation, llvm::Value *partition_ht,
+                   llvm::Value *partition_idx);
+
+    // The callback
+    void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &keys,
+                      llvm::Value *values) const override;
+
+   private:
+    // The hash table format of both the local and partition tables
+    const OAHashTable &hash_table_;
+    // The guy that handles the computation of the aggregates
+    const Aggregation &aggregation_;
+    // The partition's hash table and its index
+    llvm::Value *partition_ht_;
+    llvm::Value *partition_idx_;
+  };
+
   //===--------------------------------------------------------------------===//
   // An aggregate finalizer allows aggregations to delay the finalization of an
   // aggregate in the hash-table to a later time. This is needed when we do
@@ -175,13 +211,35 @@ class HashGroupByTranslator : public OperatorTranslator {
   // Should this operator employ prefetching?
   bool UsePrefetching() const;
 
+  // Is the provided pipeline our child pipeline, and is it parallel?
+  bool IsParallelChildPipeline(PipelineContext &pipeline_ctx) const {
+    return pipeline_ctx.IsParallel() &&
+           pipeline_ctx.GetPipeline() == child_pipeline_;
+  }
+
+  // Load a pointer to the hash table rows consumed in the given context are
+  // aggregated into
+  llvm::Value *LoadHashTablePtr(ConsumerContext &context) const;
+
+  // Load a pointer to the hash table of the partition with the given index
+  llvm::Value *LoadPartitionPtr(llvm::Value *partition_idx) const;
+
+  // Generate a loop over all partitions, invoking the body with each one's
+  // hash table
+  void ForEachPartition(
+      const std::function<void(llvm::Value *partition_ht)> &body) const;
+
  private:
   // The pipeline forming all child operators of this aggregation
   Pipeline child_pipeline_;
 
-  // The ID of the hash-table in the runtime state
+  // The ID of the hash-table in the runtime state. If the child pipeline is
+  // parallel, this is an array of kNumMergePartitions hash tables instead.
   QueryState::Id hash_table_id_;
 
+  // The ID of the thread-local hash-table, if the child pipeline is parallel
+  PipelineContext::Id local_hash_table_id_;
+
   // The hash table
   OAHashTable hash_table_;
 
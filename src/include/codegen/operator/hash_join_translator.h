@@ -28,13 +28,33 @@ class HashJoinPlan;
 namespace codegen {
 
 //===----------------------------------------------------------------------===//
-// The translator for a hash-join operator
+// The translator for a hash-join operator. Besides inner joins, this supports
+// left, right and full outer joins, and (left) semi and anti joins.
+//
+// Joins that need to know which build-side tuples found a join partner keep a
+// one-byte match flag after the values of each hash table entry, which the
+// probe sets. Once the probe-side pipeline has consumed all of its input, the
+// join produces the build-side tuples whose flag qualifies in an epilogue of
+// that pipeline. In parallel pipelines, every thread produces the tuples of a
+// disjoint set of buckets in the hash table.
+//
+// Inner joins with a large build side are radix-partitioned. Whether a join is
+// large is decided at runtime, once its build side is materialized. If it is,
+// the build side and the materialized probe side are scattered into partitions
+// on the high bits of their hash values, such that the hash table built over
+// each build-side partition fits into the cache. The probe-side pipeline joins
+// the partitions pairwise in an epilogue. In parallel pipelines, every thread
+// joins a disjoint set of partitions.
 //===----------------------------------------------------------------------===//
 class HashJoinTranslator : public OperatorTranslator {
  public:
   // Global/configurable variable controlling whether hash aggregations prefetch
   static std::atomic<bool> kUsePrefetch;
 
+  // Global/configurable variable controlling the number of materialized
+  // build-side tuples from which inner joins are radix-partitioned
+  static std::atomic<uint64_t> kRadixPartitionThreshold;
+
   HashJoinTranslator(const planner::HashJoinPlan &join,
                      CompilationContext &context, Pipeline &pipeline);
 
@@ -47,6 +67,14 @@ class HashJoinTranslator : public OperatorTranslator {
   void Consume(ConsumerContext &context, RowBatch &batch) const override;
   void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
 
+  // Partition the probe-side tuples of radix-partitioned joins
+  void PrepareEpilogue(PipelineContext &pipeline_ctx) const override;
+
+  // Produce the build-side tuples of outer, semi and anti joins, or join the
+  // partitions of radix-partitioned joins
+  void ProduceEpilogue(ConsumerContext &context, llvm::Value *thread_idx,
+                       llvm::Value *num_threads) const override;
+
   void RegisterPipelineState(PipelineContext &pipeline_ctx) override;
   void InitializePipelineState(PipelineContext &pipeline_ctx) override;
   void TearDownPipelineState(PipelineContext &pipeline_ctx) override;
@@ -80,6 +108,72 @@ class HashJoinTranslator : public OperatorTranslator {
   void CodegenHashProbe(ConsumerContext &context, RowBatch::Row &row,
                         std::vector<codegen::Value> &key) const;
 
+  // Build the hash table over the build-side tuples inserted lazily into the
+  // global table, or into the thread-local tables if the pipeline is parallel
+  void BuildHashTable(PipelineContext &pipeline_ctx) const;
+
+  // Materialize the given probe-side row for a radix-partitioned join
+  void BufferRight(ConsumerContext &context, RowBatch::Row &row,
+                   std::vector<codegen::Value> &key) const;
+
+  // Scatter the tuples lazily inserted into the global table with the given ID,
+  // or into the thread-local tables with the given ID if the pipeline is
+  // parallel, into the partitions with the given ID
+  void PartitionTuples(PipelineContext &pipeline_ctx, const HashTable &table,
+                       QueryState::Id ht_id, PipelineContext::Id ht_tl_id,
+                       QueryState::Id partitions_id) const;
+
+  // Return a pointer to the partition with the given index
+  llvm::Value *LoadPartitionPtr(QueryState::Id partitions_id,
+                                llvm::Value *partition_idx) const;
+
+  // Generate a loop over all partitions with the given ID
+  void ForEachPartition(
+      QueryState::Id partitions_id,
+      const std::function<void(llvm::Value *partition_ht)> &body) const;
+
+  // Put the build-side attributes of a hash table entry into the given row
+  void RegisterBuildValues(CodeGen &codegen, RowBatch::Row &row,
+                           const std::vector<codegen::Value> &key,
+                           llvm::Value *data_area) const;
+
+  // Put the probe-side attributes of a probe buffer entry into the given row
+  void RegisterProbeValues(CodeGen &codegen, RowBatch::Row &row,
+                           const std::vector<codegen::Value> &key,
+                           llvm::Value *data_area) const;
+
+  // Put NULLs for the given attributes into the given row
+  void RegisterNulls(CodeGen &codegen, RowBatch::Row &row,
+                     const std::vector<const planner::AttributeInfo *> &ais)
+      const;
+
+  /// Does the join emit the joined rows of matching pairs of tuples?
+  bool EmitsMatches() const;
+
+  /// Does the join track which build-side tuples found a join partner?
+  bool TracksBuildMatches() const;
+
+  /// Does the join emit the probe-side tuples without a join partner?
+  bool EmitsUnmatchedProbes() const;
+
+  /// Can both inputs of the join be radix-partitioned? Whether they are is
+  /// only decided at runtime.
+  bool CanRadixPartition() const { return can_radix_partition_; }
+
+  /// Decide how many partitions to use from the number of materialized
+  /// build-side tuples, and set up the partitions if there are any
+  void ChooseNumPartitions(PipelineContext &pipeline_ctx) const;
+
+  /// Load the number of partitions chosen at runtime, zero if the join isn't
+  /// radix-partitioned
+  llvm::Value *LoadNumPartitions() const;
+
+  /// Is the join radix-partitioned at runtime?
+  llvm::Value *IsRadixPartitioned() const;
+
+  /// Return a pointer to the match flag of the entry with the given value area
+  llvm::Value *MatchFlagPtr(CodeGen &codegen, llvm::Value *data_area) const;
+
   /// Estimate the size of the constructed hash table
   uint64_t EstimateHashTableSize() const;
 
@@ -100,6 +194,23 @@ class HashJoinTranslator : public OperatorTranslator {
   /// Callback used when inserting a tuple in the hash table during build
   class InsertLeft;
 
+  /// Callback used to produce build-side tuples after the probe
+  class ProduceLeft;
+
+  /// Callback used when materializing probe-side tuples of radix-partitioned
+  /// joins
+  class InsertRight;
+
+  /// Callback used to probe a build-side partition with the tuples of the
+  /// matching probe-side partition
+  class ProbePartition;
+
+ private:
+  // The largest number of partitions of radix-partitioned joins, and the
+  // number of build-side tuples we aim for in each
+  static const uint32_t kMaxRadixPartitions;
+  static const uint64_t kRadixPartitionSize;
+
  private:
   // The build-side pipeline
   Pipeline left_pipeline_;
@@ -127,8 +238,35 @@ class HashJoinTranslator : public OperatorTranslator {
   // The storage format used to store build-attributes in hash-table
   CompactStorage left_value_storage_;
 
+  // The size of the values in the hash-table, including the match flag
+  uint32_t hash_table_value_size_;
+
   // Does this join need an output vector
   bool needs_output_vector_;
+
+  // Whether the join can be radix-partitioned, and the ID of the number of
+  // partitions it uses at runtime
+  bool can_radix_partition_;
+  QueryState::Id num_partitions_id_;
+
+  // The IDs of the arrays of build-side and probe-side partitions, with room
+  // for the largest number of partitions
+  QueryState::Id build_partitions_id_;
+  QueryState::Id probe_partitions_id_;
+
+  // The IDs of the table materializing the probe-side tuples in serial probe
+  // pipelines, and of the thread-local tables in parallel ones
+  QueryState::Id probe_buffer_id_;
+  PipelineContext::Id probe_buffer_tl_id_;
+
+  // The (unique) set of probe-side attributes that are materialized
+  std::vector<const planner::AttributeInfo *> right_val_ais_;
+
+  // The storage format used to store probe-side attributes
+  CompactStorage right_value_storage_;
+
+  // The table materializing probe-side tuples, keyed by the probe-side keys
+  HashTable probe_buffer_;
 };
 
 }  // namespace codegen
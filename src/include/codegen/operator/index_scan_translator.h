@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_translator.h
+//
+// Identification: src/include/codegen/operator/index_scan_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/compilation_context.h"
+#include "codegen/consumer_context.h"
+#include "codegen/operator/operator_translator.h"
+#include "codegen/tile_group.h"
+
+namespace peloton {
+
+namespace planner {
+class IndexScanPlan;
+}  // namespace planner
+
+namespace codegen {
+
+class Vector;
+
+//===----------------------------------------------------------------------===//
+// A translator for index scans. The index lookup happens at runtime in a
+// util::IndexScanner, which hands out the visible tuples in batches that each
+// fall into a single tile group. Every batch is filtered by the scan's
+// predicate and pushed into the pipeline as a row batch.
+//===----------------------------------------------------------------------===//
+class IndexScanTranslator : public OperatorTranslator {
+ public:
+  // Constructor
+  IndexScanTranslator(const planner::IndexScanPlan &scan,
+                      CompilationContext &context, Pipeline &pipeline);
+
+  // Set up the index scanner
+  void InitializeQueryState() override;
+
+  // Index scans don't rely on any auxiliary functions
+  void DefineAuxiliaryFunctions() override {}
+
+  // The method that produces new tuples
+  void Produce() const override;
+
+  // Scans are leaves in the query plan and, hence, do not consume tuples
+  void Consume(ConsumerContext &, RowBatch &) const override {}
+  void Consume(ConsumerContext &, RowBatch::Row &) const override {}
+
+  // Destroy the index scanner
+  void TearDownQueryState() override;
+
+ private:
+  // Filter, read and push one batch of tuples from the given tile group into
+  // the pipeline
+  void ProduceBatch(ConsumerContext &ctx, llvm::Value *tile_group_id,
+                    llvm::Value *tile_group_ptr,
+                    TileGroup::TileGroupAccess &tile_group_access,
+                    Vector &selection_vector) const;
+
+  // Plan accessor
+  const planner::IndexScanPlan &GetScanPlan() const;
+
+ private:
+  // Helper class declarations (defined in implementation)
+  class AttributeAccess;
+
+ private:
+  // The code-generating tile group instance, for the table's schema
+  codegen::TileGroup tile_group_;
+
+  // The index scanner state ID
+  QueryState::Id scanner_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// limit_translator.h
+//
+// Identification: src/include/codegen/operator/limit_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/operator/operator_translator.h"
+#include "codegen/pipeline.h"
+
+namespace peloton {
+
+namespace planner {
+class LimitPlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// A translator for limits (with offsets). The translator counts the rows that
+// reach it in the query state, and only passes on those after the offset, up
+// to the limit. Once the limit is reached, it terminates the pipeline, so that
+// its source stops producing rows nobody will look at.
+//===----------------------------------------------------------------------===//
+class LimitTranslator : public OperatorTranslator {
+ public:
+  // Constructor
+  LimitTranslator(const planner::LimitPlan &plan, CompilationContext &context,
+                  Pipeline &pipeline);
+
+  // Reset the row counter
+  void InitializeQueryState() override;
+
+  // No helper functions
+  void DefineAuxiliaryFunctions() override {}
+
+  // Produce!
+  void Produce() const override;
+
+  // Consume!
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+  // No state to tear down
+  void TearDownQueryState() override {}
+
+ private:
+  // The ID of the row counter in the query state
+  QueryState::Id counter_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -89,6 +89,19 @@ class OperatorTranslator {
   virtual void Consume(ConsumerContext &context, RowBatch &batch) const;
   virtual void Consume(ConsumerContext &context, RowBatch::Row &row) const = 0;
 
+  /// Produce the rows that are only known once the source of the pipeline has
+  /// produced all of its input. This is only invoked for operators that
+  /// installed an epilogue in their pipeline. In parallel pipelines, each
+  /// thread state invokes it once with its index out of the number of states.
+  virtual void ProduceEpilogue(ConsumerContext &, llvm::Value *,
+                               llvm::Value *) const {}
+
+  /// Prepare for producing the epilogue, once the source of the pipeline and
+  /// the epilogues of all operators below this one have produced all of their
+  /// rows. This is invoked once, not per thread state, for operators that
+  /// installed an epilogue.
+  virtual void PrepareEpilogue(PipelineContext &) const {}
+
   //////////////////////////////////////////////////////////////////////////////
   ///
   /// Accessors
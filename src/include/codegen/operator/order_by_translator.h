@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "codegen/compilation_context.h"
 #include "codegen/operator/operator_translator.h"
 #include "codegen/sorter.h"
@@ -26,10 +28,15 @@ class OrderByPlan;
 namespace codegen {
 
 /**
- * Translator for sorting/order-by operators.
+ * Translator for sorting/order-by operators. If the plan carries a limit, the
+ * sorter only retains the top (limit + offset) tuples.
  */
 class OrderByTranslator : public OperatorTranslator {
  public:
+  // Global/configurable variable controlling whether sorts with a limit only
+  // retain the top-k tuples
+  static std::atomic<bool> kUseTopK;
+
   OrderByTranslator(const planner::OrderByPlan &plan,
                     CompilationContext &context, Pipeline &pipeline);
 
@@ -48,6 +55,10 @@ class OrderByTranslator : public OperatorTranslator {
 
   void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
 
+ private:
+  // Load the number of tuples the sorter retains, or zero if it retains all
+  llvm::Value *LoadTopK(CodeGen &codegen) const;
+
  private:
   // Helper class declarations (defined in implementation)
   class ProduceResults;
@@ -67,6 +78,9 @@ class OrderByTranslator : public OperatorTranslator {
   // The (generated) comparison function
   llvm::Function *compare_func_;
 
+  // Whether the sorter only retains the first (limit + offset) tuples
+  bool use_top_k_;
+
   struct SortKeyInfo {
     // The sort key
     const planner::AttributeInfo *sort_key;
@@ -0,0 +1,144 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// set_op_translator.h
+//
+// Identification: src/include/codegen/operator/set_op_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+
+#include "codegen/compilation_context.h"
+#include "codegen/consumer_context.h"
+#include "codegen/hash_table.h"
+#include "codegen/operator/operator_translator.h"
+#include "codegen/pipeline.h"
+
+namespace peloton {
+
+namespace planner {
+class AppendPlan;
+class SetOpPlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// The translator for set operations: INTERSECT [ALL] and EXCEPT [ALL] (SetOp
+// plans), and UNION ALL (Append plans). A UNION without ALL is an append below
+// a hash aggregation, and needs nothing more from us.
+//
+// Inputs are materialized into a hash table that is keyed on all columns and
+// keeps a 64-bit count of the occurrences of each row in every input. Each
+// input runs in its own pipeline. If that pipeline is parallel, every thread
+// counts into a local table, and the local tables are added up into the global
+// table once the input is exhausted.
+//
+// Intersections and differences produce the rows of the global table, each as
+// many times as their counts demand. Appends stream the rows of their first
+// input straight through, and produce the rows counted for the other inputs in
+// an epilogue of that pipeline.
+//===----------------------------------------------------------------------===//
+class SetOpTranslator : public OperatorTranslator {
+ public:
+  // Constructors for both kinds of plans
+  SetOpTranslator(const planner::SetOpPlan &set_op,
+                  CompilationContext &context, Pipeline &pipeline);
+  SetOpTranslator(const planner::AppendPlan &append,
+                  CompilationContext &context, Pipeline &pipeline);
+
+  void InitializeQueryState() override;
+
+  void DefineAuxiliaryFunctions() override {}
+
+  void Produce() const override;
+
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+  // Produce the rows counted for the inputs of an append
+  void ProduceEpilogue(ConsumerContext &context, llvm::Value *thread_idx,
+                       llvm::Value *num_threads) const override;
+
+  void RegisterPipelineState(PipelineContext &pipeline_ctx) override;
+  void InitializePipelineState(PipelineContext &pipeline_ctx) override;
+  void FinishPipeline(PipelineContext &pipeline_ctx) override;
+  void TearDownPipelineState(PipelineContext &pipeline_ctx) override;
+
+  void TearDownQueryState() override;
+
+ private:
+  // Set up the input pipelines and the hash table. Appends stream their first
+  // input through our own pipeline, so they count one input less.
+  void Setup(CompilationContext &context, uint32_t first_counted_input);
+
+  /// Is this translator for an append (i.e., UNION ALL)?
+  bool IsAppend() const {
+    return GetPlan().GetPlanNodeType() == PlanNodeType::APPEND;
+  }
+
+  /// Return the index of the input the given pipeline reads. Only appends
+  /// read an input, their first, in our own pipeline.
+  uint32_t InputIndex(const Pipeline &pipeline) const;
+
+  /// Is the given pipeline one of our inputs, and is it parallel?
+  bool IsParallelInputPipeline(PipelineContext &pipeline_ctx) const {
+    return pipeline_ctx.IsParallel() &&
+           pipeline_ctx.GetPipeline() != GetPipeline();
+  }
+
+  /// Return the counter the rows of the given input are counted in
+  uint32_t CounterIndex(uint32_t input_idx) const {
+    return IsAppend() ? 0 : input_idx;
+  }
+
+  /// Compute the number of times the entry with the given counts is produced
+  llvm::Value *NumCopies(CodeGen &codegen,
+                         const std::vector<llvm::Value *> &counts) const;
+
+  /// Load the counts in the given value area of a hash table entry
+  void LoadCounts(CodeGen &codegen, llvm::Value *data_area,
+                  std::vector<llvm::Value *> &counts) const;
+
+  const std::vector<std::vector<const planner::AttributeInfo *>>
+      &GetInputAttributes() const;
+
+ private:
+  /// Handy classes
+
+  /// Callback adding counts to an entry of the hash table, inserting it if
+  /// it's not there yet
+  class AddCounts;
+
+  /// Callback adding the entries of a thread-local table to the global table
+  class MergeCounts;
+
+  /// Callback producing the rows of the entries of the hash table
+  class ProduceRows;
+
+ private:
+  // The pipelines of the inputs that are counted in the hash table. Pipelines
+  // must not move, because the compilation context refers to them.
+  std::vector<std::unique_ptr<Pipeline>> input_pipelines_;
+
+  // The index of the input that the first input pipeline reads
+  uint32_t first_counted_input_;
+
+  // The number of counters in every entry
+  uint32_t num_counters_;
+
+  // The IDs of the global hash table and the thread-local ones
+  QueryState::Id hash_table_id_;
+  PipelineContext::Id local_hash_table_id_;
+
+  // The hash table, keyed on all columns, with the counts as values
+  HashTable hash_table_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -16,7 +16,9 @@
 #include "codegen/consumer_context.h"
 #include "codegen/operator/operator_translator.h"
 #include "codegen/scan_callback.h"
+#include "codegen/simd_predicate.h"
 #include "codegen/table.h"
+#include "storage/bitmap_index.h"
 
 namespace peloton {
 
@@ -35,12 +37,16 @@ namespace codegen {
 //===----------------------------------------------------------------------===//
 class TableScanTranslator : public OperatorTranslator {
  public:
+  // Global/configurable variable controlling whether scans evaluate simple
+  // predicates with SIMD instructions
+  static std::atomic<bool> kUseSimdPredicates;
+
   // Constructor
   TableScanTranslator(const planner::SeqScanPlan &scan,
                       CompilationContext &context, Pipeline &pipeline);
 
-  // Nothing to do here
-  void InitializeQueryState() override {}
+  // Set up the bitmap predicate (if any)
+  void InitializeQueryState() override;
 
   // Table scans don't rely on any auxiliary functions
   void DefineAuxiliaryFunctions() override {}
@@ -52,13 +58,24 @@ class TableScanTranslator : public OperatorTranslator {
   void Consume(ConsumerContext &, RowBatch &) const override {}
   void Consume(ConsumerContext &, RowBatch::Row &) const override {}
 
-  // Similar to InitializeQueryState(), table scans don't have any state
-  void TearDownQueryState() override {}
+  // Destroy the bitmap predicate (if any)
+  void TearDownQueryState() override;
 
  private:
   // Load the table pointer
   llvm::Value *LoadTablePtr(CodeGen &codegen) const;
 
+  // Load the scan predicate as a constant pointer
+  llvm::Value *LoadPredicatePtr(CodeGen &codegen) const;
+
+  // Return the predicate to evaluate with SIMD instructions, or null if the
+  // scan's predicate must be evaluated row by row
+  const SimdPredicate *GetSimdPredicate() const;
+
+  // Load a pointer to the bitmap predicate, or null if the scan can't use
+  // bitmap indexes
+  llvm::Value *LoadBitmapPredicatePtr() const;
+
   // Functions to produce tuples serially or in parallel
   void ProduceSerial() const;
   void ProduceParallel() const;
@@ -74,6 +91,18 @@ class TableScanTranslator : public OperatorTranslator {
  private:
   // The code-generating table instance
   codegen::Table table_;
+
+  // Whether (some of) the predicate can be answered by tile group bitmap
+  // indexes, the query state slot holding the storage::BitmapPredicate and
+  // the terms it is built from
+  bool use_bitmap_index_;
+  QueryState::Id bitmap_predicate_id_;
+  std::vector<storage::BitmapPredicate::TermExpression> bitmap_terms_;
+
+  // Whether the predicate is evaluated with SIMD instructions over tile groups
+  // whose columns are contiguous, and its SIMD form
+  bool use_simd_predicate_;
+  SimdPredicate simd_predicate_;
 };
 
 }  // namespace codegen
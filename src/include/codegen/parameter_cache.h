@@ -42,6 +42,9 @@ class ParameterCache {
   codegen::Value GetValue(uint32_t index) const;
   codegen::Value GetValue(const expression::AbstractExpression *expr) const;
 
+  // Get the index of the parameter registered for the given plan value
+  uint32_t GetIndex(const void *value) const;
+
   // Clear all cache parameter values
   void Reset();
 
@@ -17,6 +17,8 @@
 #include <string>
 #include <vector>
 
+#include "codegen/query_state.h"
+
 namespace llvm {
 class Function;
 class Type;
@@ -67,6 +69,11 @@ class PipelineContext {
   uint32_t GetEntryOffset(CodeGen &codegen, Id state_id) const;
   bool HasState() const;
 
+  /// The number of thread states, and the index of the current thread state
+  /// among them
+  llvm::Value *LoadNumThreads(CodeGen &codegen) const;
+  llvm::Value *LoadThreadIndex(CodeGen &codegen) const;
+
   /// Is the pipeline associated with this context parallel?
   bool IsParallel() const;
 
@@ -165,6 +172,10 @@ class Pipeline {
 
   const OperatorTranslator *NextStep();
 
+  /// Move back to the given translator, so that it can push another row
+  /// through the rest of the pipeline
+  void MoveTo(const OperatorTranslator *translator);
+
   //////////////////////////////////////////////////////////////////////////////
   ///
   /// Stages
@@ -194,6 +205,46 @@ class Pipeline {
       const std::function<void(ConsumerContext &,
                                const std::vector<llvm::Value *> &)> &body);
 
+  //////////////////////////////////////////////////////////////////////////////
+  ///
+  /// Early termination
+  ///
+  //////////////////////////////////////////////////////////////////////////////
+
+  /**
+   * Allow operators in this pipeline to stop the pipeline before its source
+   * has produced all of its input (e.g., a limit that has seen enough rows).
+   * This registers a flag in the query state that sources check as they go.
+   */
+  void AllowEarlyTermination();
+
+  /// Can this pipeline be terminated early?
+  bool IsTerminable() const { return terminable_; }
+
+  /**
+   * Load the flag indicating whether the pipeline was terminated. Returns null
+   * if the pipeline can't be terminated early, so sources need no check.
+   */
+  llvm::Value *IsTerminated(CodeGen &codegen) const;
+
+  /// Signal the source of this pipeline to stop producing input
+  void Terminate(CodeGen &codegen) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  ///
+  /// Epilogues
+  ///
+  //////////////////////////////////////////////////////////////////////////////
+
+  /**
+   * Let the given translator produce more rows into the rest of the pipeline
+   * after the source has produced all of its input (e.g., the unmatched
+   * build-side rows of an outer join). The translator's ProduceEpilogue() is
+   * invoked before the pipeline completes. Like stage boundaries, this must be
+   * called while the translator is the current operator of the pipeline.
+   */
+  void InstallEpilogue(const OperatorTranslator *translator);
+
   //////////////////////////////////////////////////////////////////////////////
   ///
   /// Utilities
@@ -225,6 +276,9 @@ class Pipeline {
            const std::vector<llvm::Type *> &pipeline_arg_types,
            const std::function<void(ConsumerContext &,
                                     const std::vector<llvm::Value *> &)> &body);
+  void ProduceEpilogues(PipelineContext &pipeline_ctx);
+  void ProduceEpilogue(PipelineContext &pipeline_ctx, uint32_t epilogue_index,
+                       llvm::Value *thread_idx, llvm::Value *num_threads);
   void DoRun(PipelineContext &pipeline_ctx, llvm::Function *dispatch_func,
              const std::vector<llvm::Value *> &dispatch_args,
              const std::vector<llvm::Type *> &pipeline_args_types,
@@ -252,8 +306,16 @@ class Pipeline {
   // i-1 and i in the pipeline.
   std::vector<uint32_t> stage_boundaries_;
 
+  // Positions in the pipeline of the operators that produce an epilogue
+  std::vector<uint32_t> epilogues_;
+
   // Level of parallelism
   Parallelism parallelism_;
+
+  // Whether the pipeline can be terminated early, and the ID of the query
+  // state flag that signals termination
+  bool terminable_;
+  QueryState::Id terminated_flag_id_;
 };
 
 }  // namespace codegen
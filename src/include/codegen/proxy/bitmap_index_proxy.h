@@ -0,0 +1,34 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bitmap_index_proxy.h
+//
+// Identification: src/include/codegen/proxy/bitmap_index_proxy.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/proxy/proxy.h"
+#include "storage/bitmap_index.h"
+
+namespace peloton {
+namespace codegen {
+
+PROXY(BitmapPredicate) {
+  DECLARE_MEMBER(0, char[sizeof(storage::BitmapPredicate)], opaque);
+  DECLARE_TYPE;
+
+  DECLARE_METHOD(Init);
+  DECLARE_METHOD(AddTerm);
+  DECLARE_METHOD(AddValue);
+  DECLARE_METHOD(Destroy);
+};
+
+TYPE_BUILDER(BitmapPredicate, storage::BitmapPredicate);
+
+}  // namespace codegen
+}  // namespace peloton
@@ -44,6 +44,8 @@ PROXY(HashTable) {
   DECLARE_METHOD(BuildLazy);
   DECLARE_METHOD(ReserveLazy);
   DECLARE_METHOD(MergeLazyUnfinished);
+  DECLARE_METHOD(PartitionLazyUnfinished);
+  DECLARE_METHOD(NumPartitions);
   DECLARE_METHOD(Destroy);
 };
 
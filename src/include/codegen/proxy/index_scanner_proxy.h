@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scanner_proxy.h
+//
+// Identification: src/include/codegen/proxy/index_scanner_proxy.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/proxy/proxy.h"
+#include "codegen/util/index_scanner.h"
+#include "planner/index_scan_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+PROXY(IndexScanPlan) {
+  /// We don't need access to internal fields, so use an opaque byte array
+  DECLARE_MEMBER(0, char[sizeof(planner::IndexScanPlan)], opaque);
+  DECLARE_TYPE;
+};
+
+PROXY(IndexScanner) {
+  /// We don't need access to internal fields, so use an opaque byte array
+  DECLARE_MEMBER(0, char[sizeof(util::IndexScanner)], opaque);
+  DECLARE_TYPE;
+
+  DECLARE_METHOD(Init);
+  DECLARE_METHOD(Destroy);
+  DECLARE_METHOD(Scan);
+  DECLARE_METHOD(GetNumBatches);
+  DECLARE_METHOD(GetTileGroup);
+  DECLARE_METHOD(FillSelectionVector);
+};
+
+TYPE_BUILDER(IndexScanPlan, planner::IndexScanPlan);
+TYPE_BUILDER(IndexScanner, util::IndexScanner);
+
+}  // namespace codegen
+}  // namespace peloton
@@ -46,6 +46,7 @@ PROXY(RuntimeFunctions) {
   DECLARE_METHOD(FillPredicateArray);
   DECLARE_METHOD(ExecuteTableScan);
   DECLARE_METHOD(ExecutePerState);
+  DECLARE_METHOD(IncrementCounter);
   DECLARE_METHOD(ThrowDivideByZeroException);
   DECLARE_METHOD(ThrowOverflowException);
 };
@@ -27,6 +27,7 @@ PROXY(Sorter) {
                       sizeof(char *) +              // buffer start
                       sizeof(char *) +              // buffer end
                       sizeof(uint64_t) +            // next allocation size
+                      sizeof(uint64_t) +            // top-k
                       sizeof(std::vector<char *>)], // tuple reference vector
                  opaque1);
   DECLARE_MEMBER(1, char **, tuples_start);
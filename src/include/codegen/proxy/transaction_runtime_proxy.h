@@ -20,6 +20,7 @@ namespace codegen {
 PROXY(TransactionRuntime) {
   DECLARE_METHOD(PerformVectorizedRead);
   DECLARE_METHOD(PerformVisibilityCheck);
+  DECLARE_METHOD(PerformBitmapVisibilityCheck);
 };
 
 }  // namespace codegen
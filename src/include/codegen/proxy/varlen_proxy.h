@@ -13,14 +13,18 @@
 #pragma once
 
 #include "codegen/proxy/proxy.h"
-#include "type/varlen_type.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace codegen {
 
+// Mirrors type::VarlenSlot. The data pointer is only valid for values longer
+// than type::VarlenSlot::kInlineSize, shorter values occupy the prefix and the
+// pointer bytes.
 PROXY(Varlen) {
   DECLARE_MEMBER(0, uint32_t, length);
-  DECLARE_MEMBER(1, const char, ptr);
+  DECLARE_MEMBER(1, char[::peloton::type::VarlenSlot::kPrefixSize], prefix);
+  DECLARE_MEMBER(2, const char *, data);
   DECLARE_TYPE;
 };
 
@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 #include "codegen/code_context.h"
 #include "codegen/parameter_cache.h"
 #include "codegen/query_parameters.h"
@@ -32,6 +35,10 @@ namespace codegen {
 
 class ExecutionConsumer;
 
+namespace interpreter {
+class BytecodeFunction;
+}  // namespace interpreter
+
 //===----------------------------------------------------------------------===//
 // A compiled query. An instance of this class can be created either by
 // providing a plan and its compiled function components through the constructor
@@ -77,16 +84,35 @@ class Query {
   /// This class cannot be copy or move-constructed
   DISALLOW_COPY_AND_MOVE(Query);
 
+  /// Destructor. Waits for a running background compilation to finish.
+  ~Query();
+
   /**
    * @brief Setup this query with the given JITed function components
    *
    * @param funcs The compiled functions that implement the logic of the query
+   *
+   * @return True if the code was found in the persistent object cache, in
+   * which case optimization was skipped
    */
-  void Prepare(const LLVMFunctions &funcs);
+  bool Prepare(const LLVMFunctions &funcs);
 
   // Compiles the function in this query to native code
   void Compile(CompileStats *stats = nullptr);
 
+  /**
+   * @brief Compiles the query to native code on a background worker. Until
+   * the native code is ready, Execute() runs the query in the interpreter.
+   * A running execution switches over to native code at the next function
+   * boundary (between init, plan and tear down) once it is ready.
+   *
+   * Queries the interpreter does not support are compiled synchronously.
+   */
+  void CompileInBackground();
+
+  /// Whether the query has been compiled to native code
+  bool IsCompiled() const { return is_compiled_.load(); }
+
   /**
    * @brief Executes the compiled query.
    *
@@ -118,13 +144,31 @@ class Query {
   /// Constructor. Private so callers use the QueryCompiler class.
   explicit Query(const planner::AbstractPlan &query_plan);
 
+  // Compile(), with the compilation lock already held
+  void CompileLocked(CompileStats *stats);
+
   // Execute the query as native code (must already be compiled)
   void ExecuteNative(FunctionArguments *function_arguments,
                      RuntimeStats *stats);
 
-  // Execute the query using the interpreter
+  // Execute the query using the interpreter. Unless allow_native is false,
+  // execution switches to native code as soon as it has been compiled.
   void ExecuteInterpreter(FunctionArguments *function_arguments,
-                          RuntimeStats *stats);
+                          RuntimeStats *stats, bool allow_native);
+
+  // Calls one of the query functions, natively if that is allowed and the
+  // query has been compiled, otherwise in the interpreter
+  void CallFunction(const compiled_function_t &native_func,
+                    const interpreter::BytecodeFunction &bytecode_func,
+                    FunctionArguments *function_arguments, bool allow_native);
+
+  // Translate the query functions to bytecode, once. Must not run
+  // concurrently with compilation, which may modify the LLVM module.
+  void PrepareInterpreter(RuntimeStats *stats);
+
+ private:
+  struct BytecodeFunctions;
+  struct CompilationState;
 
  private:
   // The query plan
@@ -139,11 +183,22 @@ class Query {
   // LLVM IR of the query functions
   LLVMFunctions llvm_functions_;
 
+  // The size of the function arguments, computed up front since the LLVM
+  // module may be compiled concurrently with executions
+  size_t parameter_size_;
+
   // Pointers to the compiled query functions
   CompiledFunctions compiled_functions_;
 
   // Shows if the query has been compiled to native code
-  bool is_compiled_;
+  std::atomic<bool> is_compiled_;
+
+  // The query functions translated for the interpreter, built on first use
+  std::atomic<BytecodeFunctions *> bytecode_functions_;
+
+  // Serializes compilation and bytecode translation. It is shared with the
+  // background worker, which may run after this query has been evicted.
+  std::shared_ptr<CompilationState> compilation_state_;
 };
 
 }  // namespace codegen
@@ -45,6 +45,13 @@ class QueryCompiler {
 
     // Time consumed by LLVM Optimizer
     double optimize_ms = 0.0;
+
+    // Whether the code was found in the persistent object cache, in which
+    // case it was not optimized again
+    bool object_cache_hit = false;
+
+    // The number of pipelines that were generated for parallel execution
+    uint32_t num_parallel_pipelines = 0;
   };
 
   // Constructor
@@ -39,19 +39,33 @@ class QueryParametersMap {
     map_[expression] = parameters_.size() - 1;
   }
 
+  // Values that aren't expressions (e.g., the keys of an index scan or the
+  // bounds of a limit) are registered under the address of the value in the
+  // plan
+  void Insert(expression::Parameter parameter, const void *value) {
+    parameters_.push_back(parameter);
+    map_[value] = parameters_.size() - 1;
+  }
+
   uint32_t GetIndex(const expression::AbstractExpression *expression) const {
     auto param = map_.find(expression);
     PELOTON_ASSERT(param != map_.end());
     return param->second;
   }
 
+  uint32_t GetIndex(const void *value) const {
+    auto param = map_.find(value);
+    PELOTON_ASSERT(param != map_.end());
+    return param->second;
+  }
+
   const std::vector<expression::Parameter> &GetParameters() const {
     return parameters_;
   }
 
  private:
-  // Parameter map
-  std::unordered_map<const expression::AbstractExpression *, uint32_t> map_;
+  // Parameter map, keyed by the expression or value the parameter belongs to
+  std::unordered_map<const void *, uint32_t> map_;
 
   // Parameter meta information
   std::vector<expression::Parameter> parameters_;
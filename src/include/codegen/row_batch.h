@@ -246,6 +246,11 @@ class RowBatch {
 
   void UpdateWritePosition(llvm::Value *sz);
 
+  // Invoke the callback with a row of a single-row batch that is not backed by
+  // a tile group. The callback registers the values of all attributes.
+  static void WithSingleRow(CompilationContext &ctx,
+                            const std::function<void(RowBatch::Row &)> &cb);
+
  private:
   // Get all the attributes of a row in this batch
   const AttributeMap &GetAttributes() const { return attributes_; }
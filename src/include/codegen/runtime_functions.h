@@ -106,6 +106,15 @@ class RuntimeFunctions {
       void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
       void (*work_func)(void *, void *));
 
+  /**
+   * Atomically increment the given counter. Generated code uses this for
+   * counters that all threads of a parallel pipeline share.
+   *
+   * @param counter The counter to increment.
+   * @return The value of the counter after the increment.
+   */
+  static uint64_t IncrementCounter(uint64_t *counter);
+
   //////////////////////////////////////////////////////////////////////////////
   ///
   /// Exception related functions
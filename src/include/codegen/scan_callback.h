@@ -44,6 +44,10 @@ class ScanCallback {
   // Callback for when iteration over the given tile group has completed
   virtual void TileGroupFinish(CodeGen &codegen,
                                llvm::Value *tile_group_ptr) = 0;
+
+  // Return a boolean value indicating whether the scan should stop before
+  // visiting the remaining tuples, or null if the scan always runs to the end
+  virtual llvm::Value *ShouldStop(CodeGen &) { return nullptr; }
 };
 
 }  // namespace codegen
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// simd_predicate.h
+//
+// Identification: src/include/codegen/simd_predicate.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "codegen/codegen.h"
+#include "codegen/tile_group.h"
+
+namespace peloton {
+
+namespace expression {
+class AbstractExpression;
+}  // namespace expression
+
+namespace codegen {
+
+class ParameterCache;
+class RowBatch;
+
+//===----------------------------------------------------------------------===//
+// A scan predicate that is evaluated with SIMD instructions. This supports
+// conjunctions of comparisons between fixed-width integer columns and constants
+// (or parameters) of the same type.
+//
+// The comparisons are evaluated over kNumLanes consecutive tuples at a time,
+// loading the values of every column with a single vector load. This requires
+// the columns to be stored contiguously, which is only known at run time for
+// each tile group. The resulting bitmask then filters the selection vector of
+// the batch without branches. LLVM lowers the vector operations to the widest
+// SIMD instructions of the host (e.g., AVX2 or AVX-512).
+//===----------------------------------------------------------------------===//
+class SimdPredicate {
+ public:
+  // The number of tuples a single vector operation evaluates
+  static constexpr uint32_t kNumLanes = 16;
+
+  // Collect the comparisons of the given predicate. Return false if the
+  // predicate can't be evaluated with SIMD instructions.
+  bool Setup(const expression::AbstractExpression &predicate);
+
+  // Generate code that checks if all columns the predicate reads are stored
+  // contiguously in the tile group
+  llvm::Value *IsApplicable(CodeGen &codegen,
+                            const TileGroup::TileGroupAccess &access) const;
+
+  // Generate code that filters the rows of the given batch, whose TIDs are in
+  // the range [tid_start, tid_end)
+  void Filter(CodeGen &codegen, const ParameterCache &parameter_cache,
+              const TileGroup::TileGroupAccess &access, RowBatch &batch,
+              llvm::Value *tid_start, llvm::Value *tid_end) const;
+
+ private:
+  // A comparison between a column and a constant
+  struct Comparison {
+    // The column and its type
+    uint32_t col_id;
+    peloton::type::TypeId type_id;
+    bool nullable;
+
+    // The (signed) comparison of the column's value against the constant
+    llvm::CmpInst::Predicate cmp;
+
+    // The constant, or parameter, we compare against
+    const expression::AbstractExpression *constant;
+  };
+
+  // Collect the comparisons of the given (part of the) predicate
+  bool CollectComparisons(const expression::AbstractExpression &expr);
+
+  // Evaluate all comparisons for the num_lanes tuples starting at the given
+  // TID. This returns a vector of num_lanes booleans, or a single boolean if
+  // num_lanes is one.
+  llvm::Value *Evaluate(CodeGen &codegen,
+                        const std::vector<llvm::Value *> &col_ptrs,
+                        const std::vector<llvm::Value *> &constants,
+                        llvm::Value *tid, uint32_t num_lanes) const;
+
+ private:
+  // The comparisons that all have to hold
+  std::vector<Comparison> comparisons_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
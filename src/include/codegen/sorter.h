@@ -32,10 +32,12 @@ class Sorter {
   Sorter(CodeGen &codegen, const std::vector<type::Type> &row_desc);
 
   /**
-   * @brief Initialize the given sorter instance with the comparison function
+   * @brief Initialize the given sorter instance with the comparison function.
+   * If top_k is non-zero, the sorter only retains the top_k smallest tuples.
    */
   void Init(CodeGen &codegen, llvm::Value *sorter_ptr,
-            llvm::Value *executor_ctx, llvm::Value *comparison_func) const;
+            llvm::Value *executor_ctx, llvm::Value *comparison_func,
+            llvm::Value *top_k = nullptr) const;
 
   /**
    * @brief Append the given tuple into the sorter instance
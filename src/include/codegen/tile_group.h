@@ -49,7 +49,6 @@ class TileGroup {
 
   llvm::Value *GetTileGroupId(CodeGen &codegen, llvm::Value *tile_group) const;
 
- private:
   // A struct to capture enough information to perform strided accesses
   struct ColumnLayout {
     uint32_t col_id;
@@ -58,6 +57,13 @@ class TileGroup {
     llvm::Value *is_columnar;
   };
 
+  // Discover the layout of all columns in the provided tile group, using the
+  // ColumnLayoutInfo space in the third argument
+  std::vector<TileGroup::ColumnLayout> GetColumnLayouts(
+      CodeGen &codegen, llvm::Value *tile_group_ptr,
+      llvm::Value *column_layout_infos) const;
+
+ private:
   /*
   //===--------------------------------------------------------------------===//
   // A convenience class to access to a column
@@ -89,10 +95,6 @@ class TileGroup {
   };
   */
 
-  std::vector<TileGroup::ColumnLayout> GetColumnLayouts(
-      CodeGen &codegen, llvm::Value *tile_group_ptr,
-      llvm::Value *column_layout_infos) const;
-
   // Access a given column for the row with the given tid
   codegen::Value LoadColumn(CodeGen &codegen, llvm::Value *tid,
                             const TileGroup::ColumnLayout &layout) const;
@@ -25,6 +25,7 @@ class ExecutorContext;
 }  // namespace executor
 
 namespace storage {
+class BitmapPredicate;
 class DataTable;
 class TileGroup;
 class TileGroupHeader;
@@ -49,6 +50,15 @@ class TransactionRuntime {
                                          uint32_t tid_start, uint32_t tid_end,
                                          uint32_t *selection_vector);
 
+  // Perform a visibility check for the tuples in the range [tid_start, tid_end)
+  // that may satisfy the given predicate according to the bitmap indexes of
+  // the tile group. Tile groups without usable bitmap indexes fall back to
+  // checking every tuple in the range.
+  static uint32_t PerformBitmapVisibilityCheck(
+      concurrency::TransactionContext &txn, storage::TileGroup &tile_group,
+      const storage::BitmapPredicate &predicate, uint32_t tid_start,
+      uint32_t tid_end, uint32_t *selection_vector);
+
   // Perform a read operation for all tuples in the given tile group with IDs
   // in the range [tid_start, tid_end) in the context of the given transaction
   static uint32_t PerformVectorizedRead(concurrency::TransactionContext &txn,
@@ -135,6 +135,39 @@ class HashTable {
    */
   void MergeLazyUnfinished(HashTable &other);
 
+  /**
+   * This function is called to distribute the contents of this lazily built,
+   * unfinished table over the provided partitions. The high bits of an entry's
+   * hash choose its partition, leaving the low bits to choose its bucket once
+   * BuildLazy() is called on the partition. Partitions accept no insertions
+   * after this.
+   *
+   * This is used for radix-partitioned hash joins, where each partition is
+   * small enough to build and probe within the cache.
+   *
+   * This function is called from different threads!
+   *
+   * @param partitions The partitions, sharing our memory pool
+   * @param num_partitions The number of partitions, a power of two
+   */
+  void PartitionLazyUnfinished(HashTable *partitions, uint32_t num_partitions);
+
+  /**
+   * Determine how many partitions PartitionLazyUnfinished() should distribute
+   * the given number of entries over, such that each partition receives about
+   * the given number of entries.
+   *
+   * @param num_elems The total number of entries to partition
+   * @param min_elems The fewest entries worth partitioning
+   * @param partition_size The number of entries to aim for in each partition
+   * @param max_partitions The largest number of partitions, a power of two
+   * @return The number of partitions, a power of two, or zero if there are
+   * fewer than min_elems entries
+   */
+  static uint32_t NumPartitions(uint64_t num_elems, uint64_t min_elems,
+                                uint64_t partition_size,
+                                uint32_t max_partitions);
+
   //////////////////////////////////////////////////////////////////////////////
   ///
   /// Accessors
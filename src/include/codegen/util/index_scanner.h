@@ -0,0 +1,153 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scanner.h
+//
+// Identification: src/include/codegen/util/index_scanner.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/item_pointer.h"
+#include "common/macros.h"
+
+namespace peloton {
+
+namespace concurrency {
+class TransactionContext;
+}  // namespace concurrency
+
+namespace executor {
+class ExecutorContext;
+}  // namespace executor
+
+namespace planner {
+class IndexScanPlan;
+}  // namespace planner
+
+namespace storage {
+class TileGroup;
+}  // namespace storage
+
+namespace codegen {
+namespace util {
+
+/**
+ * This class performs the index lookup of an index scan on behalf of
+ * generated code. Scan() probes the index with the scan's key values, follows
+ * the version chain of every match to the version visible to the transaction,
+ * and splits the visible tuples into batches. Every batch holds at most a
+ * configured number of tuples, all from a single tile group. The batches keep
+ * the order in which the index returned the tuples, so that a scan providing
+ * a sort order still does after batching.
+ *
+ * Generated code then visits one batch at a time, copying the batch's tuple
+ * offsets into its selection vector.
+ */
+class IndexScanner {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param plan The index scan plan
+   * @param executor_context The context of the running query, which has the
+   * transaction and the query parameters
+   * @param key_param_idx The index of the first key value in the query
+   * parameters. The key values of the plan are consecutive parameters.
+   * @param batch_size The maximum number of tuples in a batch
+   */
+  IndexScanner(const planner::IndexScanPlan &plan,
+               executor::ExecutorContext &executor_context,
+               uint32_t key_param_idx, uint32_t batch_size);
+
+  /**
+   * Initialize the given scanner instance. This is called from generated code
+   * to invoke the constructor on the scanner in the query state.
+   */
+  static void Init(IndexScanner &scanner, const planner::IndexScanPlan &plan,
+                   executor::ExecutorContext &executor_context,
+                   uint32_t key_param_idx, uint32_t batch_size);
+
+  /**
+   * Destroy the given scanner instance, releasing all its memory
+   */
+  static void Destroy(IndexScanner &scanner);
+
+  /**
+   * Look up the index and collect the visible tuples into batches
+   */
+  void Scan();
+
+  /**
+   * Return the number of batches the last call to Scan() produced
+   */
+  uint32_t GetNumBatches() const {
+    return static_cast<uint32_t>(batches_.size());
+  }
+
+  /**
+   * Return the tile group all the tuples in the given batch belong to
+   */
+  storage::TileGroup *GetTileGroup(uint32_t batch_idx) const {
+    return tile_groups_[batches_[batch_idx].tile_group_idx].get();
+  }
+
+  /**
+   * Copy the offsets of the tuples in the given batch into the provided
+   * selection vector, and return the number of tuples in the batch
+   */
+  uint32_t FillSelectionVector(uint32_t batch_idx,
+                               uint32_t *selection_vector) const;
+
+ private:
+  // Find the version of the tuple at the given location that is visible to
+  // the transaction, returning false if there is none
+  bool FindVisibleVersion(concurrency::TransactionContext &txn,
+                          ItemPointer &location) const;
+
+ private:
+  // A run of tuples from the same tile group, as the range [start, end) of the
+  // offsets
+  struct Batch {
+    uint32_t tile_group_idx;
+    uint32_t start;
+    uint32_t end;
+  };
+
+  // The scan plan
+  const planner::IndexScanPlan &plan_;
+
+  // The context of the running query
+  executor::ExecutorContext &executor_context_;
+
+  // The index of the first key value in the query parameters
+  uint32_t key_param_idx_;
+
+  // The maximum number of tuples in a batch
+  uint32_t batch_size_;
+
+  // The tile groups of all batches. We hold on to them so that they stay alive
+  // while generated code reads from them.
+  std::vector<std::shared_ptr<storage::TileGroup>> tile_groups_;
+
+  // The offsets of all visible tuples, in index order
+  std::vector<uint32_t> offsets_;
+
+  // The batches
+  std::vector<Batch> batches_;
+
+ private:
+  DISALLOW_COPY_AND_MOVE(IndexScanner);
+};
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
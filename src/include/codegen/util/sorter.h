@@ -33,6 +33,11 @@ namespace util {
  * Additionally, Sorter does not serialize elements into its memory space.
  * Instead, it allocates space for incoming tuples on demand and returns a
  * pointer to the call, relying on her to serialize into the space.
+ *
+ * Sorters can also operate in top-k mode, where they only retain the k smallest
+ * tuples in sort order (e.g., for ORDER BY ... LIMIT k). These tuples are kept
+ * in a max-heap, so that memory is bounded by k tuples and each input tuple
+ * costs at most O(log k) comparisons.
  */
 class Sorter {
  private:
@@ -55,9 +60,11 @@ class Sorter {
    * @param func The comparison function used to compare two tuples stored in
    * this sorter
    * @param tuple_size The size of the tuples stored in this sorter
+   * @param top_k If non-zero, the sorter only retains the top_k smallest tuples
+   * in sort order
    */
   Sorter(::peloton::type::AbstractPool &memory, ComparisonFunction func,
-         uint32_t tuple_size);
+         uint32_t tuple_size, uint64_t top_k = 0);
 
   /**
    * Destructor. This destructor cleans up returns all memory it has allocated
@@ -74,9 +81,12 @@ class Sorter {
    * @param sorter The sorter instance we are initializing
    * @param func The comparison function used during sort
    * @param tuple_size The size of the tuple in bytes
+   * @param top_k The number of (smallest) tuples the sorter retains, or zero to
+   * retain all of them
    */
   static void Init(Sorter &sorter, executor::ExecutorContext &ctx,
-                   ComparisonFunction func, uint32_t tuple_size);
+                   ComparisonFunction func, uint32_t tuple_size,
+                   uint64_t top_k);
 
   /**
    * Cleans up all resources maintained by the given sorter instance. This
@@ -91,6 +101,10 @@ class Sorter {
    * size of the tuple is equivalent to the tuple size provided when this sorter
    * was initialized.
    *
+   * In top-k mode, the tuple written into the returned space is only added to
+   * the heap of retained tuples on the next call (or when sorting). If the
+   * heap is full, the space of the tuple that was evicted from it is reused.
+   *
    * @return A pointer to a memory space large enough to store one tuple
    */
   char *StoreInputTuple();
@@ -135,6 +149,25 @@ class Sorter {
    */
   void MakeRoomForNewTuple();
 
+  /**
+   * Allocate space for a new input tuple in top-k mode. The last tuple that
+   * was stored is first added to the heap.
+   */
+  char *StoreTopKInputTuple();
+
+  /**
+   * Add the last tuple that was stored to the heap of top-k tuples, evicting
+   * the largest tuple if the heap is full. The evicted tuple (if any) is left
+   * at the end of the tuple vector, outside of the heap.
+   */
+  void AddLastTupleToHeap();
+
+  /**
+   * Merge the (top-k) tuples of the given thread-local sorters, retaining only
+   * the top-k tuples overall
+   */
+  void SortParallelTopK(const std::vector<Sorter *> &sorters);
+
   /**
    * Transfer ownership of all allocated memory to the provided sorter instance.
    *
@@ -162,6 +195,9 @@ class Sorter {
   // Sorters double-expand
   uint64_t next_alloc_size_;
 
+  // The number of tuples we retain, or zero if we retain all of them
+  uint64_t top_k_;
+
   // The tuples
   std::vector<char *> tuples_;
   char **tuples_start_;
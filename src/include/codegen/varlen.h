@@ -22,48 +22,43 @@ namespace codegen {
 
 class Varlen {
  public:
-  // Get the length and the pointer to the variable length object
-  static void SafeGetPtrAndLength(CodeGen &codegen, llvm::Value *varlen_ptr,
+  // Get the length and the pointer to the data of the (non-NULL) value stored
+  // in the varlen slot at the given address
+  static void SafeGetPtrAndLength(CodeGen &codegen, llvm::Value *slot_ptr,
                                   llvm::Value *&data_ptr, llvm::Value *&len) {
-    auto *varlen_type = VarlenProxy::GetType(codegen);
+    auto *slot_type = VarlenProxy::GetType(codegen);
 
-    // The first four bytes are the length, load it here
+    // The first four bytes are the length (biased by one), load it here
     auto *len_ptr =
-        codegen->CreateConstInBoundsGEP2_32(varlen_type, varlen_ptr, 0, 0);
-    len = codegen->CreateLoad(codegen.Int32Type(), len_ptr);
+        codegen->CreateConstInBoundsGEP2_32(slot_type, slot_ptr, 0, 0);
+    auto *raw_len = codegen->CreateLoad(codegen.Int32Type(), len_ptr);
+    len = codegen->CreateSub(raw_len, codegen.Const32(1));
 
-    // The four bytes after the start is where the (contiguous) data is
-    data_ptr =
-        codegen->CreateConstInBoundsGEP2_32(varlen_type, varlen_ptr, 0, 1);
+    // Short values start right after the length, long ones live out-of-line.
+    // Loading the pointer of an inlined value is harmless, we never use it.
+    auto *inline_ptr = codegen->CreateBitCast(
+        codegen->CreateConstInBoundsGEP2_32(slot_type, slot_ptr, 0, 1),
+        codegen.CharPtrType());
+    auto *out_of_line_ptr = codegen->CreateLoad(
+        codegen.CharPtrType(),
+        codegen->CreateConstInBoundsGEP2_32(slot_type, slot_ptr, 0, 2));
+    auto *is_inlined = codegen->CreateICmpULE(
+        len, codegen.Const32(::peloton::type::VarlenSlot::kInlineSize));
+    data_ptr = codegen->CreateSelect(is_inlined, inline_ptr, out_of_line_ptr);
   }
 
-  // Get the length and the pointer to the variable length object
-  static void GetPtrAndLength(CodeGen &codegen, llvm::Value *varlen_ptr,
+  // Get the length and the pointer to the data of the value stored in the
+  // varlen slot at the given address, along with its NULL-ness
+  static void GetPtrAndLength(CodeGen &codegen, llvm::Value *slot_ptr,
                               llvm::Value *&data_ptr, llvm::Value *&len,
                               llvm::Value *&is_null) {
-    // First check if varlen_ptr (i.e., the Varlen *) is NULL
-    auto *null_varlen =
-        codegen.NullPtr(VarlenProxy::GetType(codegen)->getPointerTo());
-    is_null = codegen->CreateICmpEQ(varlen_ptr, null_varlen);
+    SafeGetPtrAndLength(codegen, slot_ptr, data_ptr, len);
 
-    // Depending on NULL-ness, perform load
-    llvm::Value *null_data = nullptr, *null_len = nullptr;
-    lang::If varlen_is_null{codegen, is_null};
-    {
-      // The pointer is null
-      null_data = codegen.Null(codegen.CharPtrType());
-      null_len = codegen.Const32(0);
-    }
-    varlen_is_null.ElseBlock();
-    {
-      // The pointer is not null, safely load the data and length values
-      SafeGetPtrAndLength(codegen, varlen_ptr, data_ptr, len);
-    }
-    varlen_is_null.EndIf();
-
-    // Build PHI nodes for the data pointer and length
-    data_ptr = varlen_is_null.BuildPHI(null_data, data_ptr);
-    len = varlen_is_null.BuildPHI(null_len, len);
+    // A NULL slot has a zero length word, i.e., an unbiased length of -1
+    is_null = codegen->CreateICmpEQ(len, codegen.Const32(-1));
+    data_ptr = codegen->CreateSelect(is_null, codegen.Null(codegen.CharPtrType()),
+                                     data_ptr);
+    len = codegen->CreateSelect(is_null, codegen.Const32(0), len);
   }
 };
 
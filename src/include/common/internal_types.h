@@ -742,7 +742,9 @@ enum class JoinType {
   RIGHT = 2,                  // right
   INNER = 3,                  // inner
   OUTER = 4,                  // outer
-  SEMI = 5                    // IN+Subquery is SEMI
+  SEMI = 5,                   // IN+Subquery is SEMI
+  ANTI = 6                    // NOT EXISTS+Subquery is ANTI (NOT IN differs
+                              // when the subquery returns NULLs)
 };
 std::string JoinTypeToString(JoinType type);
 JoinType StringToJoinType(const std::string &str);
@@ -1068,6 +1070,8 @@ enum class MetricType {
   QUERY = 9,
   // Statistics for CPU
   PROCESSOR = 10,
+  // Memory held by a table or an index
+  MEMORY = 11,
 };
 
 // All builtin operators we currently support
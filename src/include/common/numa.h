@@ -0,0 +1,83 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa.h
+//
+// Identification: src/include/common/numa.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/macros.h"
+
+namespace peloton {
+
+/**
+ * @brief Helpers for NUMA-aware memory placement and thread scheduling.
+ *
+ * The topology is discovered once from sysfs (/sys/devices/system/node). We
+ * talk to the kernel directly through mbind() and sched_setaffinity() so that
+ * we do not need to link against libnuma. On single-node machines (or on
+ * platforms without NUMA support) every function degrades to a cheap no-op
+ * and memory comes from regular anonymous mappings.
+ */
+class NumaUtil {
+ public:
+  /// Marker for "no particular node"
+  static constexpr int kInvalidNode = -1;
+
+  /// Return the number of NUMA nodes in the machine (always at least one)
+  static uint32_t GetNumNodes();
+
+  /// Return true if the machine has more than one node and NUMA-aware
+  /// placement has been enabled through the 'numa_aware_placement' setting
+  static bool IsNumaAware();
+
+  /// Return the node the calling thread is currently running on
+  static int GetCurrentNode();
+
+  /// Allocate 'size' zeroed bytes whose pages are preferably placed on the
+  /// given node. Memory must be released through Free() with the same size.
+  static void *Allocate(std::size_t size, int node);
+
+  /// Release memory obtained through Allocate()
+  static void Free(void *ptr, std::size_t size);
+
+  /// Restrict the calling thread to the CPUs of the given node. Returns true
+  /// if the binding was applied.
+  static bool BindCurrentThreadToNode(int node);
+
+  /// Restore the calling thread's CPU mask to the mask of the process
+  static void UnbindCurrentThread();
+};
+
+/**
+ * @brief Scoped binding of the calling thread to a NUMA node. The thread's
+ * original CPU mask is restored when the guard goes out of scope.
+ */
+class NumaNodeGuard {
+ public:
+  explicit NumaNodeGuard(int node)
+      : bound_(node != NumaUtil::kInvalidNode &&
+               NumaUtil::BindCurrentThreadToNode(node)) {}
+
+  ~NumaNodeGuard() {
+    if (bound_) {
+      NumaUtil::UnbindCurrentThread();
+    }
+  }
+
+  DISALLOW_COPY_AND_MOVE(NumaNodeGuard);
+
+ private:
+  bool bound_;
+};
+
+}  // namespace peloton
@@ -21,10 +21,12 @@ namespace peloton {
 
 namespace index {
 class Index;
+class CoveringPayloadStore;
 }
 
 namespace storage {
 class AbstractTable;
+class TileGroup;
 }
 
 namespace executor {
@@ -61,6 +63,34 @@ class IndexScanExecutor : public AbstractScanExecutor {
   bool ExecPrimaryIndexLookup();
   bool ExecSecondaryIndexLookup();
 
+  // Scan the index for the entries to look up. With a limit, only the first
+  // limit_fetch_count_ entries in the scan direction are fetched.
+  void ScanIndex(std::vector<ItemPointer *> &tuple_location_ptrs);
+
+  // The range [begin, end) of the limit window among count tuples
+  void GetLimitWindow(size_t count, size_t &begin, size_t &end) const;
+
+  // Whether count tuples that passed all checks cannot fill the limit window
+  // although the index has entries beyond the fetched ones
+  bool LimitWindowIsShort(size_t count) const;
+
+  // Apply the limit and offset to the tuples that passed the visibility and
+  // predicate checks. Returns false if more entries have to be fetched, in
+  // which case the lookup has to be done again.
+  bool ApplyLimit(std::vector<ItemPointer> &tuple_locations);
+
+  // Answer the scan from the payloads of a covering index. 'served' is left
+  // false if some entry has no payload for the version the transaction
+  // sees, in which case the scan has to read the table instead.
+  bool ExecIndexOnlyLookup(
+      const std::vector<ItemPointer *> &tuple_location_ptrs, bool &served);
+
+  // Record the payload of a visible version for index-only scans, if it is
+  // the committed head version of the index entry
+  void RecordPayload(const ItemPointer *tuple_location_ptr,
+                     const ItemPointer &tuple_location,
+                     storage::TileGroup *tile_group);
+
   // When the required scan range has open boundaries, the tuples found by the
   // index might not be exact since the index can only give back tuples in a
   // close range. This function prune the head and the tail of the returned
@@ -134,6 +164,20 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   // whether order by is descending
   bool descend_ = false;
+
+  // how many index entries a limited scan fetches. grows while the entries
+  // that pass the checks cannot fill the limit window.
+  uint64_t limit_fetch_count_ = 0;
+
+  // whether the last limited scan returned fewer entries than it fetches,
+  // so that the index has no entries beyond them
+  bool scan_exhausted_ = false;
+
+  // whether the scan is answered from the payloads of a covering index
+  bool index_only_ = false;
+
+  // the payloads of the index, if it is a covering index
+  index::CoveringPayloadStore *payload_store_ = nullptr;
 };
 
 }  // namespace executor
@@ -24,8 +24,8 @@ namespace executor {
 /**
  * The executor class that populates a newly created index
  *
- * It should have a SeqScanExecutor as a child, for retrieving data
- * to be inputted the index.
+ * Its child creates the index. The executor then scans the table in parallel
+ * and bulk loads the index using index::IndexBuilder.
  *
  * 2018-01-07: This is <b>deprecated</b>. Do not modify these classes.
  * The old interpreted engine will be removed.
@@ -48,9 +48,6 @@ class PopulateIndexExecutor : public AbstractExecutor {
   bool DExecute();
 
  private:
-  /** @brief Input tiles from child node */
-  std::vector<std::unique_ptr<LogicalTile>> child_tiles_;
-
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
@@ -58,6 +55,7 @@ class PopulateIndexExecutor : public AbstractExecutor {
   /** @brief Pointer to table to scan from. */
   storage::DataTable *target_table_ = nullptr;
   std::vector<oid_t> column_ids_;
+  std::string index_name_;
   bool done_ = false;
 };
 
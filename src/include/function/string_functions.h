@@ -101,7 +101,8 @@ class StringFunctions {
                                 const char *str2, uint32_t len2);
 
   /**
-   * Write the provided variable length object into the target buffer.
+   * Write the provided variable length object into the varlen slot at the
+   * target buffer.
    *
    * @param data The bytes we wish to serialize
    * @param len The length of the byte array
@@ -28,6 +28,19 @@
 #include "common/container/lock_free_queue.h"
 
 namespace peloton {
+
+class AbstractTuple;
+
+namespace index {
+class Index;
+}  // namespace index
+
+namespace storage {
+class DataTable;
+class TileGroupHeader;
+class Tuple;
+}  // namespace storage
+
 namespace gc {
 
 #define MAX_QUEUE_LENGTH 100000
@@ -148,6 +161,15 @@ class TransactionLevelGCManager : public GCManager {
 
   bool ResetTuple(const ItemPointer &);
 
+  // whether a gc'd version of the given type means that the whole tuple is
+  // gone, in which case its indirection is recycled.
+  static bool IsTupleDead(const GCVersionType &type);
+
+  // detach the empty version installed by a committed delete from the
+  // indirection of the tuple, as the indirection is about to be recycled.
+  static void ClearTombstoneIndirection(
+      storage::TileGroupHeader *tile_group_header, const oid_t &tuple_id);
+
   // this function iterates the gc context and unlinks every version
   // from the indexes.
   // this function will call the UnlinkVersion() function.
@@ -156,6 +178,25 @@ class TransactionLevelGCManager : public GCManager {
   // this function unlinks a specified version from the index.
   void UnlinkVersion(const ItemPointer location, const GCVersionType type);
 
+  // unlink the secondary index keys of the versions older than the given
+  // one that still share its indirection.
+  static void UnlinkOlderVersionKeys(
+      storage::DataTable *table, storage::TileGroupHeader *tile_group_header,
+      const oid_t &tuple_id, ItemPointer *indirection);
+
+  // unlink the secondary index keys of an old (or aborted) version that
+  // neither the given newer version nor the current version of the tuple
+  // has anymore.
+  static void UnlinkStaleSecondaryKeys(storage::DataTable *table,
+                                       const AbstractTuple &version,
+                                       ItemPointer *indirection,
+                                       const ItemPointer &newer_location);
+
+  // whether the version at the given location, if any, has the given key in
+  // the given index.
+  static bool VersionHasKey(const ItemPointer &location, index::Index *index,
+                            const storage::Tuple &key);
+
  private:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <limits>
+
 #include "adaptive_radix_tree/Tree.h"
 #include "index/index.h"
 
@@ -66,10 +68,13 @@ class ArtIndex : public Index {
 
   /**
    * ArtIndex throws away the first three arguments and only uses the conjuncts
-   * from the scan predicate.
+   * from the scan predicate and the scan direction. The tree only iterates in
+   * ascending key order, so forward scans stop after offset + limit entries,
+   * while backward scans collect the whole range and return its tail.
    *
-   * @param scan_predicate The only parameter that's used
+   * @param scan_direction The order in which entries are returned
    * @param[out] result Where the results of the scan are stored
+   * @param scan_predicate The conjuncts bounding the scan
    * @param limit How many results to actually return
    * @param offset How many items to exclude from the results
    */
@@ -86,13 +91,18 @@ class ArtIndex : public Index {
   void ScanKey(const storage::Tuple *key,
                std::vector<ItemPointer *> &result) override;
 
+  void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                    std::vector<std::vector<ItemPointer *>> &results) override;
+
   /// Return the index type
   std::string GetTypeName() const override {
     return IndexTypeToString(GetIndexMethodType());
   }
 
-  // TODO(pmenon): Implement me
-  size_t GetMemoryFootprint() override { return 0; }
+  size_t GetMemoryFootprint() override {
+    auto thread_info = container_.getThreadInfo();
+    return container_.getMemoryUsage(thread_info);
+  }
 
   // TODO(pmenon): Implement me
   bool NeedGC() override { return false; }
@@ -123,8 +133,11 @@ class ArtIndex : public Index {
   }
 
  private:
-  void ScanRange(const art::Key &start, const art::Key &end,
-                 std::vector<ItemPointer *> &result);
+  // Scan the keys in [start,end], stopping after max_results entries
+  void ScanRange(
+      const art::Key &start, const art::Key &end,
+      std::vector<ItemPointer *> &result,
+      uint64_t max_results = std::numeric_limits<uint64_t>::max());
 
   //===--------------------------------------------------------------------===//
   //
@@ -141,8 +154,12 @@ class ArtIndex : public Index {
      *
      * @param input_key The input (i.e., Peloton key)
      * @param[out] tree_key Where the tree-compatible key is written
+     * @param upper_bound Whether the key is the upper bound of a range scan,
+     * in which case NULL columns stand for a value above all others, just as
+     * they sort below all others otherwise
      */
-    void ConstructKey(const AbstractTuple &input_key, art::Key &tree_key) const;
+    void ConstructKey(const AbstractTuple &input_key, art::Key &tree_key,
+                      bool upper_bound = false) const;
 
     /**
      * Generate the minimum and maximum key, storing the results in the provided
@@ -161,8 +178,15 @@ class ArtIndex : public Index {
     template <typename NativeType>
     static void WriteValue(uint8_t *data, NativeType val);
 
-    // Write a specified number of ASCII characters into the output buffer
-    static void WriteAsciiString(uint8_t *data, const char *val, uint32_t len);
+    // Write a double such that the bytes compare like the values
+    static void WriteDouble(uint8_t *data, double val);
+
+    // The number of bytes WriteString() needs for the given string
+    static uint32_t GetStringLength(const char *val, uint32_t len);
+
+    // Write a string with its NUL bytes escaped and a terminator appended,
+    // returning the number of bytes written
+    static uint32_t WriteString(uint8_t *data, const char *val, uint32_t len);
 
    private:
     // The index's key schema
@@ -29,7 +29,9 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <mutex>
 #include <thread>
+#include <type_traits>
 #include <unordered_set>
 // offsetof() is defined here
 #include <cstddef>
@@ -134,6 +136,9 @@ extern bool print_flag;
 
 #define PREALLOCATE_THREAD_NUM ((size_t)1024)
 
+// The number of point lookups whose traversals are interleaved in a batch
+#define LOOKUP_BATCH_GROUP_SIZE ((size_t)8)
+
 /*
  * InnerInlineAllocateOfType() - allocates a chunk of memory from base node and
  *                               initialize it using placement new and then
@@ -1897,6 +1902,22 @@ class BwTree : public BwTreeBase {
 
       return;
     }
+
+    /*
+     * GetChunkCount() - Returns the number of chunks in the linked list
+     *
+     * The first chunk is the one embedded in front of the base node; the
+     * rest were added by GrowChunk() as the delta chain grew
+     */
+    size_t GetChunkCount() const {
+      size_t count = 0;
+      for (const AllocationMeta *meta_p = this; meta_p != nullptr;
+           meta_p = meta_p->next.load()) {
+        count++;
+      }
+
+      return count;
+    }
   };
 
   /*
@@ -7092,6 +7113,139 @@ class BwTree : public BwTreeBase {
     return true;
   }
 
+  /*
+   * BulkLoad() - Build the tree bottom-up from key-value pairs sorted by key
+   *
+   * Leaves are filled to 3/4 of the split threshold without spreading the
+   * values of a key over two leaves, and levels of inner nodes are stacked
+   * on top of them until a single node remains, which replaces the root.
+   * The first leaf keeps its NodeID since iterators start from there.
+   *
+   * This only works on an empty tree that no other thread modifies. If the
+   * tree is not empty then nothing is changed and false is returned
+   */
+  bool BulkLoad(const std::vector<KeyValuePair> &items) {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    // An empty tree is a root with a single separator pointing to the
+    // first leaf, which has no items and no delta chain
+    NodeID root_node_id = root_id.load();
+    const BaseNode *root_node_p = GetNode(root_node_id);
+    const BaseNode *leaf_node_p = GetNode(first_leaf_id);
+    if (root_node_p->GetType() != NodeType::InnerType ||
+        static_cast<const InnerNode *>(root_node_p)->GetSize() != 1 ||
+        static_cast<const InnerNode *>(root_node_p)->At(0).second !=
+            first_leaf_id ||
+        leaf_node_p->GetType() != NodeType::LeafType ||
+        static_cast<const LeafNode *>(leaf_node_p)->GetSize() != 0) {
+      epoch_manager.LeaveEpoch(epoch_node_p);
+
+      return false;
+    }
+
+    if (items.empty() == true) {
+      epoch_manager.LeaveEpoch(epoch_node_p);
+
+      return true;
+    }
+
+    const KeyNodeIDPair inf_key{KeyType(), INVALID_NODE_ID};
+
+    // Find where the leaves start; the values of a key stay in one leaf
+    const size_t leaf_fill = LEAF_NODE_SIZE_UPPER_THRESHOLD * 3 / 4;
+    std::vector<size_t> leaf_starts{0};
+    for (size_t i = 1; i < items.size(); i++) {
+      if (i - leaf_starts.back() >= leaf_fill &&
+          KeyCmpEqual(items[i].first, items[i - 1].first) == false) {
+        leaf_starts.push_back(i);
+      }
+    }
+    leaf_starts.push_back(items.size());
+
+    // The low key and NodeID of every node on the current level, which is
+    // what the level above holds as separators
+    std::vector<KeyNodeIDPair> level;
+    for (size_t l = 0; l + 1 < leaf_starts.size(); l++) {
+      if (l == 0) {
+        level.emplace_back(KeyType(), first_leaf_id);
+      } else {
+        level.emplace_back(items[leaf_starts[l]].first, GetNextNodeID());
+      }
+    }
+
+    const LeafNode *first_leaf_p = nullptr;
+    for (size_t l = 0; l < level.size(); l++) {
+      int size = static_cast<int>(leaf_starts[l + 1] - leaf_starts[l]);
+      KeyNodeIDPair low_key =
+          (l == 0 ? inf_key : KeyNodeIDPair{level[l].first, ~INVALID_NODE_ID});
+      const KeyNodeIDPair &high_key =
+          (l + 1 < level.size() ? level[l + 1] : inf_key);
+
+      LeafNode *leaf_p =
+          reinterpret_cast<LeafNode *>(ElasticNode<KeyValuePair>::Get(
+              size, NodeType::LeafType, 0, size, low_key, high_key));
+      leaf_p->PushBack(items.data() + leaf_starts[l],
+                       items.data() + leaf_starts[l + 1]);
+
+      if (l == 0) {
+        first_leaf_p = leaf_p;
+      } else {
+        InstallNewNode(level[l].second, leaf_p);
+      }
+    }
+
+    // Stack levels of evenly filled inner nodes until one node is left
+    const size_t inner_fill = INNER_NODE_SIZE_UPPER_THRESHOLD * 3 / 4;
+    const InnerNode *new_root_p = nullptr;
+    while (new_root_p == nullptr) {
+      size_t node_count = (level.size() + inner_fill - 1) / inner_fill;
+
+      std::vector<KeyNodeIDPair> upper_level;
+      for (size_t n = 0; n < node_count; n++) {
+        upper_level.emplace_back(
+            level[n * level.size() / node_count].first,
+            (node_count == 1 ? root_node_id : GetNextNodeID()));
+      }
+
+      for (size_t n = 0; n < node_count; n++) {
+        size_t begin = n * level.size() / node_count;
+        size_t end = (n + 1) * level.size() / node_count;
+        int size = static_cast<int>(end - begin);
+        const KeyNodeIDPair &high_key =
+            (n + 1 < node_count ? upper_level[n + 1] : inf_key);
+
+        InnerNode *inner_p =
+            reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::Get(
+                size, NodeType::InnerType, 0, size, level[begin], high_key));
+        inner_p->PushBack(level.data() + begin, level.data() + end);
+
+        if (node_count == 1) {
+          new_root_p = inner_p;
+        } else {
+          InstallNewNode(upper_level[n].second, inner_p);
+        }
+      }
+
+      level.swap(upper_level);
+    }
+
+    // All other nodes are in place, so the tree becomes visible at once when
+    // the first leaf and the root are replaced. No one else modifies the
+    // tree, so this does not fail
+    UNUSED_ATTRIBUTE bool ret =
+        InstallNodeToReplace(first_leaf_id, first_leaf_p, leaf_node_p);
+    PELOTON_ASSERT(ret == true);
+    ret = InstallNodeToReplace(root_node_id, new_root_p, root_node_p);
+    PELOTON_ASSERT(ret == true);
+
+    epoch_manager.AddGarbageNode(leaf_node_p);
+    epoch_manager.AddGarbageNode(root_node_p);
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return true;
+  }
+
 #ifdef BWTREE_PELOTON
 
   /*
@@ -7289,6 +7443,106 @@ class BwTree : public BwTreeBase {
     return;
   }
 
+  /*
+   * GetValueBatch() - Fill one value list per search key
+   *
+   * This is equivalent to calling GetValue() on every key, but the
+   * traversals of up to LOOKUP_BATCH_GROUP_SIZE keys are interleaved: all
+   * keys of a group descend one level per round, and before any of them
+   * loads its next node we prefetch the mapping table entries and then the
+   * nodes of the whole group. The cache misses of different keys thus
+   * overlap instead of being served one after another.
+   *
+   * A key whose traversal aborts restarts from the root without holding
+   * back the rest of its group
+   */
+  void GetValueBatch(const KeyType *search_key_list, size_t key_count,
+                     std::vector<ValueType> *value_list_p) {
+    LOG_TRACE("GetValueBatch()");
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    // Context is neither copyable nor movable, so we construct the contexts
+    // of a group in place
+    typename std::aligned_storage<sizeof(Context), alignof(Context)>::type
+        context_storage[LOOKUP_BATCH_GROUP_SIZE];
+    Context *context_list[LOOKUP_BATCH_GROUP_SIZE];
+    NodeID next_node_id_list[LOOKUP_BATCH_GROUP_SIZE];
+    bool finished_list[LOOKUP_BATCH_GROUP_SIZE];
+
+    for (size_t group_start = 0; group_start < key_count;
+         group_start += LOOKUP_BATCH_GROUP_SIZE) {
+      size_t group_size =
+          std::min(LOOKUP_BATCH_GROUP_SIZE, key_count - group_start);
+
+      for (size_t i = 0; i < group_size; i++) {
+        context_list[i] = new (&context_storage[i])
+            Context{search_key_list[group_start + i]};
+        next_node_id_list[i] = root_id.load();
+        finished_list[i] = false;
+      }
+
+      size_t unfinished_count = group_size;
+      while (unfinished_count > 0) {
+        for (size_t i = 0; i < group_size; i++) {
+          if (finished_list[i] == false) {
+            __builtin_prefetch(&mapping_table[next_node_id_list[i]]);
+          }
+        }
+
+        for (size_t i = 0; i < group_size; i++) {
+          if (finished_list[i] == false) {
+            __builtin_prefetch(GetNode(next_node_id_list[i]));
+          }
+        }
+
+        for (size_t i = 0; i < group_size; i++) {
+          if (finished_list[i] == true) {
+            continue;
+          }
+
+          Context *context_p = context_list[i];
+          LoadNodeIDReadOptimized(next_node_id_list[i], context_p);
+
+          if (context_p->abort_flag == false) {
+            NodeSnapshot *snapshot_p = GetLatestNodeSnapshot(context_p);
+
+            if (snapshot_p->IsLeaf() == true) {
+              NavigateLeafNode(context_p, value_list_p[group_start + i]);
+
+              if (context_p->abort_flag == false) {
+                finished_list[i] = true;
+                unfinished_count--;
+                continue;
+              }
+            } else {
+              next_node_id_list[i] = NavigateInnerNode(context_p);
+            }
+          }
+
+          // Same as the abort path of TraverseReadOptimized()
+          if (context_p->abort_flag == true) {
+#ifdef BWTREE_DEBUG
+            context_p->current_level = -1;
+            context_p->abort_counter++;
+#endif
+            context_p->current_snapshot.node_id = INVALID_NODE_ID;
+            context_p->abort_flag = false;
+            next_node_id_list[i] = root_id.load();
+          }
+        }
+      }
+
+      for (size_t i = 0; i < group_size; i++) {
+        context_list[i]->~Context();
+      }
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return;
+  }
+
   /*
    * GetValue() - Return value in a ValueSet object
    *
@@ -7313,6 +7567,84 @@ class BwTree : public BwTreeBase {
     return value_set;
   }
 
+  /*
+   * GetMemoryFootprint() - Returns the approximate number of bytes held by
+   *                        the tree
+   *
+   * This includes every base node together with the chunks its delta chain
+   * has been allocated from, and the used part of the mapping table. Nodes
+   * that have been unlinked but not yet reclaimed by the epoch manager are
+   * not counted.
+   *
+   * The result is only a snapshot since other threads may be modifying the
+   * tree concurrently. We join the epoch to keep the nodes we inspect alive.
+   */
+  size_t GetMemoryFootprint() {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    NodeID node_id_limit = next_unused_node_id.load();
+    size_t size = node_id_limit * sizeof(std::atomic<const BaseNode *>);
+
+    for (NodeID node_id = 0; node_id < node_id_limit; node_id++) {
+      const BaseNode *node_p = mapping_table[node_id].load();
+      if (node_p != nullptr) {
+        size += GetDeltaChainFootprint(node_p);
+      }
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return size;
+  }
+
+ private:
+  /*
+   * GetDeltaChainFootprint() - Returns the number of bytes held by the base
+   *                            node(s) of a delta chain
+   *
+   * Delta records are allocated from the chunks of the base node they sit
+   * on, so we only need to find the base node. Merge deltas have two base
+   * nodes below them, and both are still owned by this chain.
+   */
+  size_t GetDeltaChainFootprint(const BaseNode *node_p) const {
+    while (node_p->IsDeltaNode() == true) {
+      if (node_p->GetType() == NodeType::LeafMergeType) {
+        auto merge_node_p = static_cast<const LeafMergeNode *>(node_p);
+        return GetDeltaChainFootprint(merge_node_p->child_node_p) +
+               GetDeltaChainFootprint(merge_node_p->right_merge_p);
+      } else if (node_p->GetType() == NodeType::InnerMergeType) {
+        auto merge_node_p = static_cast<const InnerMergeNode *>(node_p);
+        return GetDeltaChainFootprint(merge_node_p->child_node_p) +
+               GetDeltaChainFootprint(merge_node_p->right_merge_p);
+      }
+
+      node_p = static_cast<const DeltaNode *>(node_p)->child_node_p;
+    }
+
+    if (node_p->IsInnerNode() == true) {
+      return GetElasticNodeFootprint(static_cast<const InnerNode *>(node_p));
+    }
+
+    return GetElasticNodeFootprint(static_cast<const LeafNode *>(node_p));
+  }
+
+  /*
+   * GetElasticNodeFootprint() - Returns the size of the allocation made by
+   *                             ElasticNode::Get() plus any chunk appended
+   *                             to it afterwards
+   */
+  template <typename ElementType>
+  static size_t GetElasticNodeFootprint(
+      const ElasticNode<ElementType> *node_p) {
+    size_t chunk_count =
+        ElasticNode<ElementType>::GetAllocationHeader(node_p)->GetChunkCount();
+
+    return sizeof(ElasticNode<ElementType>) +
+           node_p->GetItemCount() * sizeof(ElementType) +
+           chunk_count * AllocationMeta::CHUNK_SIZE();
+  }
+
+ public:
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection Interface
   ///////////////////////////////////////////////////////////////////
@@ -7320,15 +7652,14 @@ class BwTree : public BwTreeBase {
   /*
    * NeedGarbageCollection() - Whether the tree needs garbage collection
    *
-   * Ideally, if there is no modification workload on BwTree from the last
-   * time GC was called, then GC is unnecessary since read operation does not
-   * modify any data structure
-   *
-   * Currently we just leave the interface as a placeholder, which returns true
-   * everytime to force GC thred to at least take a look into the epoch
-   * counter.
+   * If there is no modification workload on BwTree since the last time GC
+   * was called, then GC is unnecessary since read operation does not
+   * modify any data structure. This lets an external GC thread skip idle
+   * trees.
    */
-  bool NeedGarbageCollection() { return true; }
+  bool NeedGarbageCollection() {
+    return epoch_manager.NeedGarbageCollection();
+  }
 
   /*
    * PerformGarbageCollection() - Interface function for external users to
@@ -7481,6 +7812,14 @@ class BwTree : public BwTreeBase {
     // Otherwise it points to a thread created by EpochManager internally
     std::thread *thread_p;
 
+    // Number of garbage nodes that have not been freed yet
+    std::atomic<size_t> garbage_count;
+
+    // GC may be driven by more than one thread (e.g. Peloton's GC manager
+    // and a manual PerformGarbageCollection()), but only one of them may
+    // create and clear epochs at a time
+    std::mutex cleaner_lock;
+
 // The counter that counts how many free is called
 // inside the epoch manager
 // NOTE: We cannot precisely count the size of memory freed
@@ -7523,6 +7862,8 @@ class BwTree : public BwTreeBase {
       // We allocate and run this later
       thread_p = nullptr;
 
+      garbage_count.store(0UL);
+
       // This is used to notify the cleaner thread that it has ended
       exited_flag.store(false);
 
@@ -7697,6 +8038,9 @@ class BwTree : public BwTreeBase {
 
       garbage_node_p->next_p = epoch_p->garbage_list_p.load();
 
+      // Count the node before it becomes visible to the cleaner
+      garbage_count.fetch_add(1);
+
       while (1) {
         // Then CAS previous node with new garbage node
         // If this fails, then garbage_node_p->next_p is the actual value
@@ -7784,12 +8128,21 @@ class BwTree : public BwTreeBase {
      * its own GC thread using the loop
      */
     void PerformGarbageCollection() {
+      std::lock_guard<std::mutex> guard{cleaner_lock};
+
       ClearEpoch();
       CreateNewEpoch();
 
       return;
     }
 
+    /*
+     * NeedGarbageCollection() - Whether there are garbage nodes to free
+     */
+    inline bool NeedGarbageCollection() const {
+      return garbage_count.load() > 0;
+    }
+
 #else  // #ifdef USE_OLD_EPOCH
 
     /*
@@ -7820,6 +8173,8 @@ class BwTree : public BwTreeBase {
       return;
     }
 
+    inline bool NeedGarbageCollection() const { return true; }
+
 #endif  // #ifdef USE_OLD_EPOCH
 
     /*
@@ -8077,6 +8432,8 @@ class BwTree : public BwTreeBase {
           // This invalidates any further reference to its
           // members (so we saved next pointer above)
           delete garbage_node_p;
+
+          garbage_count.fetch_sub(1);
         }  // for
 
         // First need to save this in order to delete current node
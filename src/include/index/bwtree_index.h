@@ -96,19 +96,27 @@ class BWTreeIndex : public Index {
   void ScanKey(const storage::Tuple *key,
                std::vector<ValueType> &result) override;
 
+  void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                    std::vector<std::vector<ValueType>> &results) override;
+
+  bool BulkLoad(
+      const std::vector<std::pair<const storage::Tuple *, ValueType>> &entries)
+      override;
+
   std::string GetTypeName() const override;
 
-  // TODO: Implement this
-  size_t GetMemoryFootprint() override { return 0; }
+  size_t GetMemoryFootprint() override {
+    return container.GetMemoryFootprint();
+  }
   
   bool NeedGC() override {
     return container.NeedGarbageCollection();
   }
 
   void PerformGC() override {
-    LOG_INFO("Bw-Tree Garbage Collection!");
+    LOG_TRACE("Bw-Tree Garbage Collection!");
     container.PerformGarbageCollection();
-    
+
     return;
   }
 
@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// covering_payload_store.h
+//
+// Identification: src/include/index/covering_payload_store.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/abstract_tuple.h"
+#include "common/container/cuckoo_map.h"
+#include "common/internal_types.h"
+#include "common/item_pointer.h"
+#include "common/macros.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace index {
+
+class IndexMetadata;
+
+/**
+ * @brief The values of the key and INCLUDE columns of one tuple version
+ */
+struct CoveringPayload {
+  // The version the values were read from, and the commit that created it
+  ItemPointer location;
+  cid_t begin_cid;
+
+  // One value per column of the payload store, key columns first
+  std::vector<type::Value> values;
+};
+
+/**
+ * @brief The payloads of a covering index, i.e. the values of its key and
+ * INCLUDE columns for the tuples it indexes.
+ *
+ * Payloads are keyed by indirection, the value of the index entries, and hold
+ * the values of the committed version the indirection pointed to when they were
+ * recorded. Committed versions never change, so a payload is exact as long as
+ * its version is still the head of the chain. Readers therefore only use a
+ * payload whose location and begin commit id match the current head version,
+ * which also rules out a head slot that got recycled for another version.
+ *
+ * Payloads are recorded by index scans that had to read the table, and are
+ * dropped when the indirection is freed.
+ */
+class CoveringPayloadStore {
+ public:
+  explicit CoveringPayloadStore(const IndexMetadata *metadata);
+
+  DISALLOW_COPY_AND_MOVE(CoveringPayloadStore);
+
+  // Table column ids of the payload values, key columns first
+  const std::vector<oid_t> &GetColumnIds() const { return column_ids_; }
+
+  // Position of a table column in the payload values, INVALID_OID if it is
+  // not covered
+  oid_t GetPosition(oid_t column_id) const {
+    return column_id < positions_.size() ? positions_[column_id] : INVALID_OID;
+  }
+
+  // Whether all of the given table columns are covered
+  bool CoversColumns(const std::vector<oid_t> &column_ids) const;
+
+  // Record the payload of the version at 'location', the head version of
+  // 'indirection', from the given tuple of that version
+  void Put(const ItemPointer *indirection, const ItemPointer &location,
+           cid_t begin_cid, const AbstractTuple &tuple);
+
+  // Return the payload of 'indirection' if it was recorded from the given
+  // version, nullptr otherwise
+  std::shared_ptr<const CoveringPayload> Get(const ItemPointer *indirection,
+                                             const ItemPointer &location,
+                                             cid_t begin_cid) const;
+
+  void Erase(const ItemPointer *indirection);
+
+  size_t GetSize() const { return payloads_.GetSize(); }
+
+ private:
+  static uint64_t GetKey(const ItemPointer *indirection) {
+    return reinterpret_cast<uint64_t>(indirection);
+  }
+
+ private:
+  std::vector<oid_t> column_ids_;
+
+  // Table column id -> position in the payload values
+  std::vector<oid_t> positions_;
+
+  CuckooMap<uint64_t, std::shared_ptr<const CoveringPayload>> payloads_;
+};
+
+/**
+ * @brief Presents a payload as a tuple of the base table. Only the columns
+ * covered by the payload store can be read.
+ */
+class CoveringTuple : public AbstractTuple {
+ public:
+  CoveringTuple(const CoveringPayloadStore &store,
+                const CoveringPayload &payload)
+      : store_(store), payload_(&payload) {}
+
+  void SetPayload(const CoveringPayload &payload) { payload_ = &payload; }
+
+  type::Value GetValue(oid_t column_id) const override;
+
+  void SetValue(oid_t column_id, const type::Value &value) override;
+
+  char *GetData() const override { return nullptr; }
+
+  const std::string GetInfo() const override;
+
+ private:
+  const CoveringPayloadStore &store_;
+  const CoveringPayload *payload_;
+};
+
+}  // namespace index
+}  // namespace peloton
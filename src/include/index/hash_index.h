@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.h
+//
+// Identification: src/include/index/hash_index.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "index/hash_table.h"
+#include "index/index.h"
+
+#define HASH_INDEX_TYPE                                        \
+  HashIndex<KeyType, ValueType, KeyHashFunc, KeyEqualityChecker, \
+            ValueEqualityChecker>
+
+namespace peloton {
+namespace index {
+
+/**
+ * Hash-based index implementation.
+ *
+ * Only answers point queries efficiently. Any other scan visits every entry
+ * and relies on the caller re-checking the predicate, as it does for all
+ * index scans.
+ *
+ * @see Index
+ */
+template <typename KeyType, typename ValueType, typename KeyHashFunc,
+          typename KeyEqualityChecker, typename ValueEqualityChecker>
+class HashIndex : public Index {
+  friend class IndexFactory;
+
+  using MapType = HashTable<KeyType, ValueType, KeyHashFunc,
+                            KeyEqualityChecker, ValueEqualityChecker>;
+
+ public:
+  HashIndex(IndexMetadata *metadata);
+
+  ~HashIndex();
+
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value) override;
+
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value) override;
+
+  bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                       std::function<bool(const void *)> predicate) override;
+
+  void Scan(const std::vector<type::Value> &values,
+            const std::vector<oid_t> &key_column_ids,
+            const std::vector<ExpressionType> &expr_types,
+            ScanDirectionType scan_direction, std::vector<ValueType> &result,
+            const ConjunctionScanPredicate *csp_p) override;
+
+  void ScanLimit(const std::vector<type::Value> &values,
+                 const std::vector<oid_t> &key_column_ids,
+                 const std::vector<ExpressionType> &expr_types,
+                 ScanDirectionType scan_direction,
+                 std::vector<ValueType> &result,
+                 const ConjunctionScanPredicate *csp_p, uint64_t limit,
+                 uint64_t offset) override;
+
+  void ScanAllKeys(std::vector<ValueType> &result) override;
+
+  void ScanKey(const storage::Tuple *key,
+               std::vector<ValueType> &result) override;
+
+  std::string GetTypeName() const override;
+
+  size_t GetMemoryFootprint() override {
+    return container.GetMemoryFootprint();
+  }
+
+  // Entries are freed as soon as they are deleted
+  bool NeedGC() override { return false; }
+
+  void PerformGC() override {}
+
+ protected:
+  // container
+  MapType container;
+};
+
+}  // namespace index
+}  // namespace peloton
@@ -0,0 +1,301 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_table.h
+//
+// Identification: src/include/index/hash_table.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/platform.h"
+#include "common/synchronization/spin_latch.h"
+
+namespace peloton {
+namespace index {
+
+/*
+ * HASH_TABLE_TEMPLATE_ARGUMENTS - Save some key strokes
+ */
+#define HASH_TABLE_TEMPLATE_ARGUMENTS                                   \
+  template <typename KeyType, typename ValueType, typename KeyHashFunc, \
+            typename KeyEqualityChecker, typename ValueEqualityChecker>
+
+/*
+ * class HashTable - Concurrent chained hash table (multimap)
+ *
+ * Every key-value pair is an entry in the chain of its bucket. Entries keep
+ * their full hash, so chains are walked on integer compares and keys are
+ * only compared on a hash match. Key hashes are put through a finalizer
+ * first: some key hashers (e.g. over big-endian integer keys) leave the low
+ * bits we pick buckets with nearly constant.
+ *
+ * Buckets are protected by a fixed set of latches, bucket b being guarded
+ * by latch (b % kNumLatches). The bucket count is always a multiple of the
+ * latch count, so an entry is guarded by the same latch no matter how often
+ * the table grows. Growing takes all latches.
+ */
+template <typename KeyType, typename ValueType, typename KeyHashFunc,
+          typename KeyEqualityChecker, typename ValueEqualityChecker>
+class HashTable {
+ public:
+  // Number of latches, and the initial number of buckets
+  static constexpr size_t kNumLatches = 64;
+
+  // Average chain length at which the table doubles its buckets
+  static constexpr size_t kMaxLoadFactor = 1;
+
+ private:
+  struct Entry {
+    Entry(const KeyType &p_key, const ValueType &p_value, size_t p_hash,
+          Entry *p_next)
+        : key(p_key), value(p_value), hash(p_hash), next(p_next) {}
+
+    KeyType key;
+    ValueType value;
+    size_t hash;
+    Entry *next;
+  };
+
+  // Keep latches on separate cache lines
+  struct PaddedLatch {
+    common::synchronization::SpinLatch latch;
+    char padding[CACHELINE_SIZE - sizeof(common::synchronization::SpinLatch)];
+  };
+
+  class LatchGuard {
+   public:
+    explicit LatchGuard(common::synchronization::SpinLatch &p_latch)
+        : latch(p_latch) {
+      latch.Lock();
+    }
+    ~LatchGuard() { latch.Unlock(); }
+
+   private:
+    common::synchronization::SpinLatch &latch;
+  };
+
+ public:
+  HashTable(KeyHashFunc p_key_hash_obj = KeyHashFunc{},
+            KeyEqualityChecker p_key_eq_obj = KeyEqualityChecker{},
+            ValueEqualityChecker p_value_eq_obj = ValueEqualityChecker{})
+      : key_hash_obj{p_key_hash_obj},
+        key_eq_obj{p_key_eq_obj},
+        value_eq_obj{p_value_eq_obj},
+        buckets{new Entry *[kNumLatches]()},
+        num_buckets{kNumLatches},
+        num_entries{0} {}
+
+  ~HashTable() {
+    for (size_t b = 0; b < num_buckets; b++) {
+      Entry *entry_p = buckets[b];
+      while (entry_p != nullptr) {
+        Entry *next_p = entry_p->next;
+        delete entry_p;
+        entry_p = next_p;
+      }
+    }
+    delete[] buckets;
+  }
+
+  DISALLOW_COPY_AND_MOVE(HashTable);
+
+  /*
+   * Insert() - Insert a key-value pair
+   *
+   * Fails if the pair already exists, or, if 'unique_key' is set, if the key
+   * already exists with any value
+   */
+  bool Insert(const KeyType &key, const ValueType &value, bool unique_key) {
+    return InsertInternal(key, value, [this, &value, unique_key](
+                                          const ValueType &existing) {
+      return unique_key || value_eq_obj(existing, value);
+    });
+  }
+
+  /*
+   * ConditionalInsert() - Insert a key-value pair only if a given predicate
+   *                       fails for all values of the key
+   *
+   * Returns false without inserting if the predicate holds for some value
+   * (setting 'predicate_satisfied') or if the pair already exists
+   */
+  bool ConditionalInsert(const KeyType &key, const ValueType &value,
+                         std::function<bool(const void *)> predicate,
+                         bool *predicate_satisfied) {
+    *predicate_satisfied = false;
+    return InsertInternal(key, value, [this, &value, &predicate,
+                                       predicate_satisfied](
+                                          const ValueType &existing) {
+      if (predicate(existing)) {
+        *predicate_satisfied = true;
+        return true;
+      }
+      return value_eq_obj(existing, value);
+    });
+  }
+
+  /*
+   * Delete() - Remove a key-value pair, returning false if it doesn't exist
+   */
+  bool Delete(const KeyType &key, const ValueType &value) {
+    size_t hash = HashKey(key);
+    LatchGuard guard{GetLatch(hash)};
+
+    for (Entry **link_p = &buckets[hash & (num_buckets - 1)];
+         *link_p != nullptr; link_p = &(*link_p)->next) {
+      Entry *entry_p = *link_p;
+      if (entry_p->hash == hash && key_eq_obj(entry_p->key, key) &&
+          value_eq_obj(entry_p->value, value)) {
+        *link_p = entry_p->next;
+        delete entry_p;
+        num_entries.fetch_sub(1);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*
+   * GetValue() - Append all values of the key to the given vector
+   */
+  void GetValue(const KeyType &key, std::vector<ValueType> &value_list) {
+    size_t hash = HashKey(key);
+    LatchGuard guard{GetLatch(hash)};
+
+    for (Entry *entry_p = buckets[hash & (num_buckets - 1)]; entry_p != nullptr;
+         entry_p = entry_p->next) {
+      if (entry_p->hash == hash && key_eq_obj(entry_p->key, key)) {
+        value_list.push_back(entry_p->value);
+      }
+    }
+  }
+
+  /*
+   * ForEach() - Invoke callback(key, value) on every entry, in no particular
+   *             order
+   *
+   * Only one latch is held at a time. Entries never move to another latch,
+   * so every entry present during the whole scan is visited exactly once.
+   */
+  template <typename Callback>
+  void ForEach(Callback callback) {
+    for (size_t l = 0; l < kNumLatches; l++) {
+      LatchGuard guard{latches[l].latch};
+      for (size_t b = l; b < num_buckets; b += kNumLatches) {
+        for (Entry *entry_p = buckets[b]; entry_p != nullptr;
+             entry_p = entry_p->next) {
+          callback(entry_p->key, entry_p->value);
+        }
+      }
+    }
+  }
+
+  size_t GetSize() const { return num_entries.load(); }
+
+  size_t GetMemoryFootprint() const {
+    return sizeof(HashTable) + num_buckets.load() * sizeof(Entry *) +
+           num_entries.load() * sizeof(Entry);
+  }
+
+ private:
+  // The 64-bit finalizer of MurmurHash3
+  inline size_t HashKey(const KeyType &key) const {
+    uint64_t hash = key_hash_obj(key);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return static_cast<size_t>(hash);
+  }
+
+  common::synchronization::SpinLatch &GetLatch(size_t hash) {
+    return latches[hash % kNumLatches].latch;
+  }
+
+  template <typename ConflictFunc>
+  bool InsertInternal(const KeyType &key, const ValueType &value,
+                      ConflictFunc conflict) {
+    size_t hash = HashKey(key);
+    {
+      LatchGuard guard{GetLatch(hash)};
+
+      Entry *&bucket = buckets[hash & (num_buckets - 1)];
+      for (Entry *entry_p = bucket; entry_p != nullptr;
+           entry_p = entry_p->next) {
+        if (entry_p->hash == hash && key_eq_obj(entry_p->key, key) &&
+            conflict(entry_p->value)) {
+          return false;
+        }
+      }
+      bucket = new Entry(key, value, hash, bucket);
+    }
+
+    if (num_entries.fetch_add(1) + 1 > num_buckets.load() * kMaxLoadFactor) {
+      Grow();
+    }
+    return true;
+  }
+
+  /*
+   * Grow() - Double the number of buckets
+   *
+   * Entries are redistributed using their stored hash
+   */
+  void Grow() {
+    for (size_t l = 0; l < kNumLatches; l++) {
+      latches[l].latch.Lock();
+    }
+
+    // Someone else may have grown the table already
+    size_t old_num_buckets = num_buckets.load();
+    if (num_entries.load() > old_num_buckets * kMaxLoadFactor) {
+      size_t new_num_buckets = old_num_buckets * 2;
+      Entry **new_buckets = new Entry *[new_num_buckets]();
+      for (size_t b = 0; b < old_num_buckets; b++) {
+        Entry *entry_p = buckets[b];
+        while (entry_p != nullptr) {
+          Entry *next_p = entry_p->next;
+          Entry *&new_bucket = new_buckets[entry_p->hash & (new_num_buckets - 1)];
+          entry_p->next = new_bucket;
+          new_bucket = entry_p;
+          entry_p = next_p;
+        }
+      }
+      delete[] buckets;
+      buckets = new_buckets;
+      num_buckets.store(new_num_buckets);
+    }
+
+    for (size_t l = 0; l < kNumLatches; l++) {
+      latches[l].latch.Unlock();
+    }
+  }
+
+ private:
+  KeyHashFunc key_hash_obj;
+  KeyEqualityChecker key_eq_obj;
+  ValueEqualityChecker value_eq_obj;
+
+  PaddedLatch latches[kNumLatches];
+
+  // Only replaced while holding all latches
+  Entry **buckets;
+  std::atomic<size_t> num_buckets;
+
+  std::atomic<size_t> num_entries;
+};
+
+}  // namespace index
+}  // namespace peloton
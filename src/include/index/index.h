@@ -22,6 +22,7 @@
 #include "common/item_pointer.h"
 #include "common/logger.h"
 #include "common/printable.h"
+#include "common/synchronization/spin_latch.h"
 #include "type/value.h"
 
 namespace peloton {
@@ -32,6 +33,10 @@ namespace catalog {
 class Schema;
 }  // namespace catalog
 
+namespace expression {
+class AbstractExpression;
+}  // namespace expression
+
 namespace storage {
 class Tuple;
 }  // namespace storage
@@ -43,6 +48,7 @@ class AbstractPool;
 namespace index {
 
 class ConjunctionScanPredicate;
+class CoveringPayloadStore;
 
 /////////////////////////////////////////////////////////////////////
 // IndexMetadata class definition
@@ -63,7 +69,9 @@ class IndexMetadata : public Printable {
                 IndexConstraintType index_constraint_type,
                 const catalog::Schema *tuple_schema,
                 const catalog::Schema *key_schema,
-                const std::vector<oid_t> &key_attrs, bool unique_keys);
+                const std::vector<oid_t> &key_attrs, bool unique_keys,
+                const std::vector<oid_t> &include_attrs = {},
+                const expression::AbstractExpression *predicate = nullptr);
 
   ~IndexMetadata();
 
@@ -98,6 +106,25 @@ class IndexMetadata : public Printable {
   // mapped to the j-th column in the base table tuple
   const std::vector<oid_t> &GetKeyAttrs() const { return key_attrs; }
 
+  // Returns the base table columns that are not part of the key but are
+  // carried along with every entry of a covering index
+  const std::vector<oid_t> &GetIncludeAttrs() const { return include_attrs; }
+
+  // Returns the predicate of a partial index over the base table columns, or
+  // nullptr if the index covers every tuple
+  const expression::AbstractExpression *GetPredicate() const {
+    return predicate.get();
+  }
+
+  // Returns the base table columns read by the predicate of a partial index
+  const std::vector<oid_t> &GetPredicateAttrs() const {
+    return predicate_attrs;
+  }
+
+  // Whether the given base table tuple has entries in the index, i.e. whether
+  // it satisfies the predicate of a partial index
+  bool IndexesTuple(const AbstractTuple *tuple) const;
+
   // Returns the mapping relation between tuple key column and index key columns
   const std::vector<oid_t> &GetTupleToIndexMapping() const {
     return tuple_attrs;
@@ -157,6 +184,15 @@ class IndexMetadata : public Printable {
   // This vector has the same length as the tuple schema.columns
   std::vector<oid_t> tuple_attrs;
 
+  // The non-key base table columns covered by the index (INCLUDE columns)
+  const std::vector<oid_t> include_attrs;
+
+  // Only tuples satisfying this predicate are indexed (partial index)
+  std::unique_ptr<expression::AbstractExpression> predicate;
+
+  // The columns the predicate reads
+  std::vector<oid_t> predicate_attrs;
+
   // Whether keys are unique (e.g. primary key)
   const bool unique_keys;
 
@@ -334,6 +370,68 @@ class Index : public Printable {
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
+  /**
+   * Finds the values of many keys at once. After the call, results[i] holds
+   * the values of keys[i], just as if ScanKey() had been called on it.
+   *
+   * The default implementation looks the keys up one after another. Indexes
+   * whose lookups are bound by cache misses override this to interleave the
+   * lookups, so that the misses of different keys overlap.
+   *
+   * @param keys
+   * @param[out] results Where the results of every key are stored
+   */
+  virtual void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                            std::vector<std::vector<ItemPointer *>> &results);
+
+  /**
+   * Builds the index bottom-up from key-value pairs sorted by key, as when
+   * building an index over an existing table. This only works on an empty
+   * index, and only indexes that can build themselves from sorted input
+   * support it.
+   *
+   * @param entries The key-value pairs, sorted by key, without duplicates
+   * @return True if the index was built, false if the pairs have to be
+   * inserted with InsertEntries() instead
+   */
+  virtual bool BulkLoad(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entries);
+
+  /**
+   * Inserts key-value pairs one after another. A pair that is already in the
+   * index is not a failure.
+   *
+   * @return True if all pairs are in the index
+   */
+  bool InsertEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entries);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// Online Build
+  //////////////////////////////////////////////////////////////////////////////
+
+  /**
+   * @brief Insert a key-value pair on behalf of a DML statement. While the
+   * index is being built, the pair is appended to the side log of the build
+   * instead, and inserted when the build finishes.
+   *
+   * @return True on successful insertion
+   */
+  bool InsertOrLogEntry(const storage::Tuple *key, ItemPointer *value);
+
+  /**
+   * @brief Start sending inserts made through InsertOrLogEntry() to the side
+   * log. Returns once no insert that missed the start is still running.
+   */
+  void StartBuild();
+
+  /**
+   * @brief Insert the pairs of the side log and stop logging
+   */
+  void FinishBuild();
+
   //////////////////////////////////////////////////////////////////////////////
   /// Garbage Collection
   //////////////////////////////////////////////////////////////////////////////
@@ -352,6 +450,14 @@ class Index : public Printable {
    */
   virtual void PerformGC() = 0;
 
+  /**
+   * @brief Performs one round of GC on every index registered through
+   * RegisterForGC(). The GC manager calls this as the global epoch advances,
+   * so that these indexes need no cleaner thread of their own. If another
+   * thread is already doing a round, this returns right away.
+   */
+  static void PerformRegisteredGC();
+
   //////////////////////////////////////////////////////////////////////////////
   /// Stats
   //////////////////////////////////////////////////////////////////////////////
@@ -426,6 +532,16 @@ class Index : public Printable {
 
   type::AbstractPool *GetPool() const { return pool; }
 
+  /**
+   * @brief Return the payloads of the key and INCLUDE columns that
+   * index-only scans are answered from
+   *
+   * @return The payload store, or nullptr if the index has no INCLUDE columns
+   */
+  CoveringPayloadStore *GetPayloadStore() const {
+    return payload_store.get();
+  }
+
   /**
    * @brief Calculate the total number of bytes used by this index
    *
@@ -445,6 +561,16 @@ class Index : public Printable {
  protected:
   explicit Index(IndexMetadata *schema);
 
+  /**
+   * @brief Have PerformRegisteredGC() collect this index. Indexes that do not
+   * reclaim memory by themselves call this from their constructor, and must
+   * call DeregisterFromGC() in their destructor, before their data structure
+   * is torn down.
+   */
+  void RegisterForGC();
+
+  void DeregisterFromGC();
+
   //===--------------------------------------------------------------------===//
   //  Data members
   //===--------------------------------------------------------------------===//
@@ -468,6 +594,18 @@ class Index : public Printable {
   // pool
   type::AbstractPool *pool = nullptr;
 
+  // payloads of covering indexes
+  std::unique_ptr<CoveringPayloadStore> payload_store;
+
+  // Online builds. While 'building' is set, inserts made through
+  // InsertOrLogEntry() are appended to the build log, which is protected by
+  // the latch. 'active_inserts' counts the calls that are in progress.
+  std::atomic<bool> building{false};
+  std::atomic<size_t> active_inserts{0};
+  common::synchronization::SpinLatch build_log_latch;
+  std::vector<std::pair<std::unique_ptr<storage::Tuple>, ItemPointer *>>
+      build_log;
+
   // This is used by index tuner
   std::atomic<size_t> indexed_tile_group_offset;
 };
@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_builder.h
+//
+// Identification: src/include/index/index_builder.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/item_pointer.h"
+#include "common/macros.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+class TileGroupHeader;
+class Tuple;
+}  // namespace storage
+
+namespace type {
+class EphemeralPool;
+}  // namespace type
+
+namespace index {
+
+class Index;
+
+/**
+ * @brief Populates a new index with the tuples of its table
+ *
+ * The tile groups of the table are split among scan tasks that run on the
+ * execution pool. Every task extracts the keys of the latest committed and
+ * the uncommitted version of every tuple and sorts them. The sorted runs are
+ * merged pairwise in parallel, and the result is handed to Index::BulkLoad()
+ * in one go, which lets indexes such as the BwTree build themselves
+ * bottom-up. Indexes that can't fall back to Index::InsertEntries().
+ *
+ * Indexes without unique keys are built online: inserts of concurrent
+ * transactions go to the side log of the index and are applied once the bulk
+ * load is done. Indexes with unique keys must check new keys against the
+ * index, so concurrent inserts keep going to the index directly.
+ *
+ * Transactions that started before the index existed may have written
+ * tuples without an index entry, and commit at any time. The scan doesn't
+ * use a snapshot so that it finds those tuples. Entries of versions that end
+ * up aborted or replaced are unlinked by the garbage collector, which can't
+ * get to them before the building transaction finishes.
+ */
+class IndexBuilder {
+ public:
+  IndexBuilder(storage::DataTable *table, Index *index);
+
+  ~IndexBuilder();
+
+  DISALLOW_COPY_AND_MOVE(IndexBuilder);
+
+  /**
+   * @brief Insert the latest versions of the table's tuples into the index
+   *
+   * @return False if the index has unique keys and two of the tuples have
+   * the same key. The index is left partially built in that case.
+   */
+  bool Build();
+
+ private:
+  // A key of the index and the indirection of its tuple
+  using Entry = std::pair<const storage::Tuple *, ItemPointer *>;
+
+  // What one scan task found, sorted by key
+  struct Run {
+    std::unique_ptr<type::EphemeralPool> pool;
+    std::vector<std::unique_ptr<storage::Tuple>> keys;
+    std::vector<Entry> entries;
+  };
+
+  // Scan the tile groups in parallel, producing one run per task
+  void ScanTable();
+
+  void ScanTileGroups(oid_t begin, oid_t end, Run &run) const;
+
+  // Whether the version is the latest committed or an uncommitted version of
+  // its tuple, and not a deleted one
+  static bool IsLatestVersion(const storage::TileGroupHeader *tile_group_header,
+                              oid_t tuple_id);
+
+  // Merge the runs into a single sorted list of entries
+  std::vector<Entry> MergeRuns();
+
+ private:
+  storage::DataTable *table_;
+  Index *index_;
+
+  // Owns the key tuples until the index is loaded
+  std::vector<Run> runs_;
+};
+
+}  // namespace index
+}  // namespace peloton
@@ -40,6 +40,10 @@ class IndexFactory {
   /// SkipList factory methods
   static Index *GetSkipListIntsKeyIndex(IndexMetadata *metadata);
   static Index *GetSkipListGenericKeyIndex(IndexMetadata *metadata);
+
+  /// Hash factory methods
+  static Index *GetHashIntsKeyIndex(IndexMetadata *metadata);
+  static Index *GetHashGenericKeyIndex(IndexMetadata *metadata);
 };
 
 }  // namespace index
@@ -12,6 +12,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "common/logger.h"
+#include "common/macros.h"
+
 namespace peloton {
 namespace index {
 
@@ -21,10 +31,725 @@ namespace index {
 #define SKIPLIST_TEMPLATE_ARGUMENTS                                       \
   template <typename KeyType, typename ValueType, typename KeyComparator, \
             typename KeyEqualityChecker, typename ValueEqualityChecker>
+
+/*
+ * class SkipList - Lock-free concurrent skip list (multimap)
+ *
+ * Every key-value pair lives in its own node. Nodes are ordered by key on
+ * every level; nodes sharing a key form a run whose order is irrelevant.
+ *
+ * Deletion follows Harris: a node is logically deleted by setting the low
+ * ("mark") bit of its next pointers, top level first and level 0 last. The
+ * thread that marks level 0 owns the deletion. Marked nodes are unlinked by
+ * whichever traversal meets them, and their next pointers never change
+ * again, so readers may still step over them.
+ *
+ * Unlinked nodes are handed to an epoch manager and freed only once every
+ * thread that could still hold a pointer to them has left its epoch.
+ *
+ * Towers are built with p = 1/4, which averages 1.33 pointers per node.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator,
           typename KeyEqualityChecker, typename ValueEqualityChecker>
 class SkipList {
-  // TODO: Add your declarations here
+ public:
+  // Maximum tower height. With p = 1/4 this comfortably covers 4^16 entries.
+  static constexpr uint32_t kMaxHeight = 16;
+
+  // Retired nodes after which a deleting thread tries to reclaim memory
+  static constexpr size_t kGarbageThreshold = 1024;
+
+ private:
+  /*
+   * struct Node - A key-value pair and its tower of next pointers
+   *
+   * Nodes are allocated with room for exactly 'height' next pointers
+   */
+  struct Node {
+    Node(const KeyType &p_key, const ValueType &p_value, uint32_t p_height)
+        : key(p_key), value(p_value), height(p_height), ref_count(2) {}
+
+    KeyType key;
+    ValueType value;
+    uint32_t height;
+
+    // The inserting thread and the deleting thread each hold a reference,
+    // the node is retired when both have let go of it. This ensures a node
+    // is never retired while an insert may still link it on a higher level.
+    std::atomic<uint32_t> ref_count;
+
+    std::atomic<Node *> next[1];
+  };
+
+  /*
+   * class EpochManager - Defers freeing of unlinked nodes
+   *
+   * This is a three-epoch scheme. Threads join the current global epoch
+   * before touching the list. Nodes retired in epoch e are freed when the
+   * global epoch moves to e + 2, which only happens after no thread is
+   * left in epoch e or e + 1 that could have seen them.
+   */
+  class EpochManager {
+   public:
+    struct GarbageNode {
+      Node *node_p;
+      GarbageNode *next_p;
+    };
+
+    explicit EpochManager(SkipList *p_list_p)
+        : list_p{p_list_p}, global_epoch{2}, garbage_count{0} {
+      for (uint32_t i = 0; i < 3; i++) {
+        active_thread_count[i] = 0;
+        garbage_list_p[i] = nullptr;
+      }
+    }
+
+    ~EpochManager() {
+      // No thread may be inside the list anymore
+      for (uint32_t i = 0; i < 3; i++) {
+        FreeGarbage(i);
+      }
+    }
+
+    /*
+     * JoinEpoch() - Enter the current epoch
+     *
+     * The epoch is re-checked after registering, in case the global epoch
+     * moved on in between and the registration came too late
+     */
+    uint64_t JoinEpoch() {
+      while (true) {
+        uint64_t epoch = global_epoch.load();
+        active_thread_count[epoch % 3].fetch_add(1);
+        if (global_epoch.load() == epoch) {
+          return epoch;
+        }
+        active_thread_count[epoch % 3].fetch_sub(1);
+      }
+    }
+
+    void LeaveEpoch(uint64_t epoch) {
+      active_thread_count[epoch % 3].fetch_sub(1);
+    }
+
+    /*
+     * AddGarbageNode() - Retire a node that is no longer reachable
+     */
+    void AddGarbageNode(Node *node_p) {
+      GarbageNode *garbage_node_p = new GarbageNode{node_p, nullptr};
+      auto &list = garbage_list_p[global_epoch.load() % 3];
+      garbage_node_p->next_p = list.load();
+      while (!list.compare_exchange_weak(garbage_node_p->next_p,
+                                         garbage_node_p)) {
+      }
+      garbage_count.fetch_add(1);
+    }
+
+    bool NeedGarbageCollection() const { return garbage_count.load() > 0; }
+
+    /*
+     * PerformGarbageCollection() - Advance the epoch as far as possible and
+     *                              free what has become unreachable
+     *
+     * Only one thread collects at a time, others simply return
+     */
+    void PerformGarbageCollection() {
+      std::unique_lock<std::mutex> lock{gc_lock, std::try_to_lock};
+      if (!lock.owns_lock()) {
+        return;
+      }
+
+      // Two steps are needed for garbage of the current epoch to expire
+      for (uint32_t step = 0; step < 2; step++) {
+        uint64_t epoch = global_epoch.load();
+        if (active_thread_count[(epoch - 1) % 3].load() != 0) {
+          break;
+        }
+        global_epoch.store(epoch + 1);
+
+        // Nobody is in epoch - 1 anymore and nobody can join it again
+        FreeGarbage((epoch - 1) % 3);
+      }
+    }
+
+   private:
+    void FreeGarbage(uint32_t slot) {
+      GarbageNode *garbage_node_p = garbage_list_p[slot].exchange(nullptr);
+      size_t freed = 0;
+      while (garbage_node_p != nullptr) {
+        GarbageNode *next_p = garbage_node_p->next_p;
+        list_p->FreeNode(garbage_node_p->node_p);
+        delete garbage_node_p;
+        garbage_node_p = next_p;
+        freed++;
+      }
+      garbage_count.fetch_sub(freed);
+    }
+
+   private:
+    SkipList *list_p;
+
+    std::atomic<uint64_t> global_epoch;
+
+    // Number of threads in the epoch, indexed by epoch % 3
+    std::atomic<int64_t> active_thread_count[3];
+
+    // Nodes retired in the epoch, indexed by epoch % 3
+    std::atomic<GarbageNode *> garbage_list_p[3];
+
+    // Number of retired nodes not yet freed
+    std::atomic<size_t> garbage_count;
+
+    // Serializes garbage collection
+    std::mutex gc_lock;
+  };
+
+  /*
+   * class EpochGuard - Scoped membership of an epoch
+   */
+  class EpochGuard {
+   public:
+    explicit EpochGuard(EpochManager &p_epoch_manager)
+        : epoch_manager(p_epoch_manager),
+          epoch(p_epoch_manager.JoinEpoch()) {}
+
+    ~EpochGuard() { epoch_manager.LeaveEpoch(epoch); }
+
+   private:
+    EpochManager &epoch_manager;
+    uint64_t epoch;
+  };
+
+ public:
+  SkipList(KeyComparator p_key_cmp_obj = KeyComparator{},
+           KeyEqualityChecker p_key_eq_obj = KeyEqualityChecker{},
+           ValueEqualityChecker p_value_eq_obj = ValueEqualityChecker{})
+      : key_cmp_obj{p_key_cmp_obj},
+        key_eq_obj{p_key_eq_obj},
+        value_eq_obj{p_value_eq_obj},
+        memory_footprint{0},
+        epoch_manager{this} {
+    // The head tower is a sentinel whose key is never looked at
+    size_t size = NodeSize(kMaxHeight);
+    head_p = reinterpret_cast<Node *>(::operator new(size));
+    head_p->height = kMaxHeight;
+    for (uint32_t level = 0; level < kMaxHeight; level++) {
+      new (&head_p->next[level]) std::atomic<Node *>(nullptr);
+    }
+    memory_footprint.fetch_add(size);
+  }
+
+  ~SkipList() {
+    // Nodes still in the list were never retired
+    Node *node_p = Unmark(head_p->next[0].load());
+    while (node_p != nullptr) {
+      Node *next_p = Unmark(node_p->next[0].load());
+      FreeNode(node_p);
+      node_p = next_p;
+    }
+    ::operator delete(head_p);
+  }
+
+  DISALLOW_COPY_AND_MOVE(SkipList);
+
+  //===--------------------------------------------------------------------===//
+  // Modification
+  //===--------------------------------------------------------------------===//
+
+  /*
+   * Insert() - Insert a key-value pair
+   *
+   * Fails if the pair already exists, or, if 'unique_key' is set, if the key
+   * already exists with any value
+   */
+  bool Insert(const KeyType &key, const ValueType &value, bool unique_key) {
+    return InsertInternal(key, value, [this, &value, unique_key](
+                                          const ValueType &existing) {
+      return unique_key || value_eq_obj(existing, value);
+    });
+  }
+
+  /*
+   * ConditionalInsert() - Insert a key-value pair only if a given predicate
+   *                       fails for all values of the key
+   *
+   * Returns false without inserting if the predicate holds for some value
+   * (setting 'predicate_satisfied') or if the pair already exists
+   */
+  bool ConditionalInsert(const KeyType &key, const ValueType &value,
+                         std::function<bool(const void *)> predicate,
+                         bool *predicate_satisfied) {
+    *predicate_satisfied = false;
+    return InsertInternal(key, value, [this, &value, &predicate,
+                                       predicate_satisfied](
+                                          const ValueType &existing) {
+      if (predicate(existing)) {
+        *predicate_satisfied = true;
+        return true;
+      }
+      return value_eq_obj(existing, value);
+    });
+  }
+
+  /*
+   * Delete() - Remove a key-value pair, returning false if it doesn't exist
+   */
+  bool Delete(const KeyType &key, const ValueType &value) {
+    bool deleted = false;
+    {
+      EpochGuard guard{epoch_manager};
+
+      Node *preds[kMaxHeight];
+      Node *succs[kMaxHeight];
+      Find(key, false, false, preds, succs);
+
+      for (Node *node_p = succs[0];
+           node_p != nullptr && key_eq_obj(node_p->key, key);
+           node_p = Unmark(node_p->next[0].load())) {
+        if (IsMarked(node_p->next[0].load()) ||
+            !value_eq_obj(node_p->value, value)) {
+          continue;
+        }
+        if (MarkNode(node_p)) {
+          // Unlink the node on every level before retiring it
+          Find(key, false, true, preds, succs);
+          ReleaseNode(node_p);
+          deleted = true;
+          break;
+        }
+      }
+    }
+
+    if (deleted && epoch_manager.NeedGarbageCollection() &&
+        garbage_since_gc.fetch_add(1) + 1 >= kGarbageThreshold) {
+      garbage_since_gc.store(0);
+      epoch_manager.PerformGarbageCollection();
+    }
+    return deleted;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Lookup
+  //===--------------------------------------------------------------------===//
+
+  /*
+   * GetValue() - Append all values of the key to the given vector
+   */
+  void GetValue(const KeyType &key, std::vector<ValueType> &value_list) {
+    EpochGuard guard{epoch_manager};
+
+    Node *pred_p = FindLowerBound(key);
+    for (Node *node_p = Unmark(pred_p->next[0].load());
+         node_p != nullptr && !key_cmp_obj(key, node_p->key);
+         node_p = Unmark(node_p->next[0].load())) {
+      if (!IsMarked(node_p->next[0].load())) {
+        value_list.push_back(node_p->value);
+      }
+    }
+  }
+
+  /*
+   * ScanForward() - Visit entries in ascending key order
+   *
+   * Starts at the first key not less than 'low_key_p' (or at the smallest
+   * key if it is nullptr) and continues as long as the callback, invoked as
+   * callback(key, value), returns true
+   */
+  template <typename Callback>
+  void ScanForward(const KeyType *low_key_p, Callback callback) {
+    EpochGuard guard{epoch_manager};
+
+    Node *pred_p = (low_key_p == nullptr) ? head_p : FindLowerBound(*low_key_p);
+    for (Node *node_p = Unmark(pred_p->next[0].load()); node_p != nullptr;
+         node_p = Unmark(node_p->next[0].load())) {
+      if (IsMarked(node_p->next[0].load())) {
+        continue;
+      }
+      if (!callback(node_p->key, node_p->value)) {
+        return;
+      }
+    }
+  }
+
+  /*
+   * ScanReverse() - Visit entries in descending key order
+   *
+   * Starts at the last key not greater than 'high_key_p' (or at the largest
+   * key if it is nullptr) and continues as long as the callback returns
+   * true. Nodes have no back pointers, so we look up the predecessor run of
+   * every key. Each step costs a search, but a scan that stops early never
+   * touches the rest of the range.
+   */
+  template <typename Callback>
+  void ScanReverse(const KeyType *high_key_p, Callback callback) {
+    EpochGuard guard{epoch_manager};
+
+    Node *preds[kMaxHeight];
+    Node *succs[kMaxHeight];
+    std::vector<ValueType> run;
+
+    // The last live node at or below the upper bound
+    Node *last_p = FindLastLive(high_key_p, true, preds, succs);
+    while (last_p != head_p) {
+      KeyType run_key = last_p->key;
+
+      // Collect the run of the key, it is reported back to front
+      run.clear();
+      Node *pred_p = FindLowerBound(run_key);
+      for (Node *node_p = Unmark(pred_p->next[0].load());
+           node_p != nullptr && !key_cmp_obj(run_key, node_p->key);
+           node_p = Unmark(node_p->next[0].load())) {
+        if (!IsMarked(node_p->next[0].load())) {
+          run.push_back(node_p->value);
+        }
+      }
+      for (auto it = run.rbegin(); it != run.rend(); ++it) {
+        if (!callback(run_key, *it)) {
+          return;
+        }
+      }
+
+      last_p = FindLastLive(&run_key, false, preds, succs);
+    }
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Key comparison helpers
+  //===--------------------------------------------------------------------===//
+
+  inline bool KeyCmpLess(const KeyType &key1, const KeyType &key2) const {
+    return key_cmp_obj(key1, key2);
+  }
+
+  inline bool KeyCmpLessEqual(const KeyType &key1,
+                              const KeyType &key2) const {
+    return !key_cmp_obj(key2, key1);
+  }
+
+  inline bool KeyCmpEqual(const KeyType &key1, const KeyType &key2) const {
+    return key_eq_obj(key1, key2);
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Memory
+  //===--------------------------------------------------------------------===//
+
+  /*
+   * GetMemoryFootprint() - Bytes held by nodes, including retired ones
+   */
+  size_t GetMemoryFootprint() const { return memory_footprint.load(); }
+
+  bool NeedGarbageCollection() const {
+    return epoch_manager.NeedGarbageCollection();
+  }
+
+  void PerformGarbageCollection() { epoch_manager.PerformGarbageCollection(); }
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // Marked pointers
+  //===--------------------------------------------------------------------===//
+
+  static inline bool IsMarked(Node *node_p) {
+    return (reinterpret_cast<uintptr_t>(node_p) & 0x1) != 0;
+  }
+
+  static inline Node *Mark(Node *node_p) {
+    return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(node_p) | 0x1);
+  }
+
+  static inline Node *Unmark(Node *node_p) {
+    return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(node_p) &
+                                    ~static_cast<uintptr_t>(0x1));
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Node management
+  //===--------------------------------------------------------------------===//
+
+  static inline size_t NodeSize(uint32_t height) {
+    return sizeof(Node) + (height - 1) * sizeof(std::atomic<Node *>);
+  }
+
+  Node *AllocateNode(const KeyType &key, const ValueType &value,
+                     uint32_t height) {
+    size_t size = NodeSize(height);
+    Node *node_p = new (::operator new(size)) Node(key, value, height);
+    for (uint32_t level = 1; level < height; level++) {
+      new (&node_p->next[level]) std::atomic<Node *>(nullptr);
+    }
+    memory_footprint.fetch_add(size);
+    return node_p;
+  }
+
+  void FreeNode(Node *node_p) {
+    memory_footprint.fetch_sub(NodeSize(node_p->height));
+    node_p->~Node();
+    ::operator delete(node_p);
+  }
+
+  // Drop one of the two references to the node, retiring it on the last
+  void ReleaseNode(Node *node_p) {
+    if (node_p->ref_count.fetch_sub(1) == 1) {
+      epoch_manager.AddGarbageNode(node_p);
+    }
+  }
+
+  // Pick a tower height with P(height > h) = 4^-h
+  static uint32_t RandomHeight() {
+    // xorshift64, seeded differently for every thread
+    static thread_local uint64_t state =
+        0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(&state);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    uint32_t height = 1;
+    uint64_t bits = state;
+    while (height < kMaxHeight && (bits & 0x3) == 0) {
+      height++;
+      bits >>= 2;
+    }
+    return height;
+  }
+
+  // Mark every level of the node, returning true if this thread marked
+  // level 0 and thus owns the deletion
+  bool MarkNode(Node *node_p) {
+    for (uint32_t level = node_p->height - 1; level >= 1; level--) {
+      Node *next_p = node_p->next[level].load();
+      while (!IsMarked(next_p) &&
+             !node_p->next[level].compare_exchange_weak(next_p,
+                                                        Mark(next_p))) {
+      }
+    }
+
+    Node *next_p = node_p->next[0].load();
+    while (!IsMarked(next_p)) {
+      if (node_p->next[0].compare_exchange_weak(next_p, Mark(next_p))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Search
+  //===--------------------------------------------------------------------===//
+
+  // Is the node positioned before the search key?
+  inline bool IsBefore(const Node *node_p, const KeyType &key,
+                       bool inclusive) const {
+    return inclusive ? !key_cmp_obj(key, node_p->key)
+                     : key_cmp_obj(node_p->key, key);
+  }
+
+  /*
+   * Find() - Find, on every level, the last node before the key and its
+   *          successor
+   *
+   * "Before" means less than the key, or not greater than it if 'inclusive'
+   * is set. Marked nodes met along the way are unlinked. If 'clean_run' is
+   * set, every marked node with the search key is unlinked as well, which is
+   * how a deleted node is removed from all of its levels.
+   */
+  void Find(const KeyType &key, bool inclusive, bool clean_run, Node **preds,
+            Node **succs) {
+  retry:
+    Node *pred_p = head_p;
+    for (int level = kMaxHeight - 1; level >= 0; level--) {
+      Node *curr_p = Unmark(pred_p->next[level].load());
+      while (curr_p != nullptr) {
+        Node *succ_p = curr_p->next[level].load();
+        if (IsMarked(succ_p)) {
+          if (!pred_p->next[level].compare_exchange_strong(curr_p,
+                                                           Unmark(succ_p))) {
+            goto retry;
+          }
+          curr_p = Unmark(succ_p);
+        } else if (IsBefore(curr_p, key, inclusive)) {
+          pred_p = curr_p;
+          curr_p = succ_p;
+        } else {
+          break;
+        }
+      }
+      preds[level] = pred_p;
+      succs[level] = curr_p;
+
+      if (clean_run) {
+        // The order of equal keys differs between levels, so the run is
+        // swept on every level without affecting where we descend
+        Node *run_pred_p = pred_p;
+        Node *run_curr_p = curr_p;
+        while (run_curr_p != nullptr && key_eq_obj(run_curr_p->key, key)) {
+          Node *succ_p = run_curr_p->next[level].load();
+          if (IsMarked(succ_p)) {
+            if (!run_pred_p->next[level].compare_exchange_strong(
+                    run_curr_p, Unmark(succ_p))) {
+              goto retry;
+            }
+            run_curr_p = Unmark(succ_p);
+          } else {
+            run_pred_p = run_curr_p;
+            run_curr_p = succ_p;
+          }
+        }
+        // The successor may have just been unlinked
+        succs[level] = Unmark(pred_p->next[level].load());
+      }
+    }
+  }
+
+  /*
+   * FindLowerBound() - Return a node from which a level 0 walk reaches the
+   *                    first node not less than the key
+   *
+   * Read-only: marked nodes are stepped over rather than unlinked
+   */
+  Node *FindLowerBound(const KeyType &key) const {
+    Node *pred_p = head_p;
+    for (int level = kMaxHeight - 1; level >= 0; level--) {
+      Node *curr_p = Unmark(pred_p->next[level].load());
+      while (curr_p != nullptr && key_cmp_obj(curr_p->key, key)) {
+        pred_p = curr_p;
+        curr_p = Unmark(curr_p->next[level].load());
+      }
+    }
+    return pred_p;
+  }
+
+  /*
+   * FindLastLive() - Return the last live node before the key (see Find()),
+   *                  or the head if there is none
+   *
+   * If 'key_p' is nullptr the last node of the list is returned
+   */
+  Node *FindLastLive(const KeyType *key_p, bool inclusive, Node **preds,
+                     Node **succs) {
+    while (true) {
+      Node *pred_p;
+      if (key_p != nullptr) {
+        Find(*key_p, inclusive, false, preds, succs);
+        pred_p = preds[0];
+      } else {
+        pred_p = FindLast();
+      }
+
+      // A marked predecessor hides the live nodes before it, retry once it
+      // has been unlinked
+      if (pred_p == head_p || !IsMarked(pred_p->next[0].load())) {
+        return pred_p;
+      }
+      if (key_p == nullptr) {
+        Node *preds_tmp[kMaxHeight];
+        Node *succs_tmp[kMaxHeight];
+        Find(pred_p->key, false, true, preds_tmp, succs_tmp);
+      }
+    }
+  }
+
+  // Return the last node of the list (possibly marked), or the head
+  Node *FindLast() const {
+    Node *pred_p = head_p;
+    for (int level = kMaxHeight - 1; level >= 0; level--) {
+      Node *curr_p = Unmark(pred_p->next[level].load());
+      while (curr_p != nullptr) {
+        pred_p = curr_p;
+        curr_p = Unmark(curr_p->next[level].load());
+      }
+    }
+    return pred_p;
+  }
+
+  /*
+   * InsertInternal() - Insert a key-value pair unless 'conflict' returns
+   *                    true for a live value of the key
+   *
+   * New nodes go to the front of their key's run on level 0. All inserts of
+   * a key hence race on the same pointer, which makes the conflict check and
+   * the insertion atomic with respect to each other.
+   */
+  template <typename ConflictFunc>
+  bool InsertInternal(const KeyType &key, const ValueType &value,
+                      ConflictFunc conflict) {
+    EpochGuard guard{epoch_manager};
+
+    Node *preds[kMaxHeight];
+    Node *succs[kMaxHeight];
+    Node *node_p = nullptr;
+
+    while (true) {
+      Find(key, false, false, preds, succs);
+
+      for (Node *curr_p = succs[0];
+           curr_p != nullptr && key_eq_obj(curr_p->key, key);
+           curr_p = Unmark(curr_p->next[0].load())) {
+        if (!IsMarked(curr_p->next[0].load()) && conflict(curr_p->value)) {
+          if (node_p != nullptr) {
+            FreeNode(node_p);
+          }
+          return false;
+        }
+      }
+
+      if (node_p == nullptr) {
+        node_p = AllocateNode(key, value, RandomHeight());
+      }
+      for (uint32_t level = 0; level < node_p->height; level++) {
+        node_p->next[level].store(succs[level]);
+      }
+
+      Node *expected_p = succs[0];
+      if (preds[0]->next[0].compare_exchange_strong(expected_p, node_p)) {
+        break;
+      }
+    }
+
+    // The node is in the list now, link the rest of the tower
+    for (uint32_t level = 1; level < node_p->height; level++) {
+      while (true) {
+        Node *next_p = node_p->next[level].load();
+        if (IsMarked(next_p) ||
+            (next_p != succs[level] &&
+             !node_p->next[level].compare_exchange_strong(next_p,
+                                                          succs[level]))) {
+          // Deleted in the meantime, stop building
+          goto linked;
+        }
+        Node *expected_p = succs[level];
+        if (preds[level]->next[level].compare_exchange_strong(expected_p,
+                                                              node_p)) {
+          break;
+        }
+        Find(key, false, false, preds, succs);
+      }
+    }
+
+  linked:
+    // If the node was deleted while we were linking it, the deleting thread
+    // may have missed levels we linked afterwards
+    if (IsMarked(node_p->next[0].load())) {
+      Find(key, false, true, preds, succs);
+    }
+    ReleaseNode(node_p);
+    return true;
+  }
+
+ private:
+  KeyComparator key_cmp_obj;
+  KeyEqualityChecker key_eq_obj;
+  ValueEqualityChecker value_eq_obj;
+
+  // Sentinel tower in front of all nodes
+  Node *head_p;
+
+  std::atomic<size_t> memory_footprint;
+
+  // Deletes since the last attempt to reclaim memory
+  std::atomic<size_t> garbage_since_gc{0};
+
+  EpochManager epoch_manager;
 };
 
 }  // namespace index
@@ -40,9 +40,6 @@ template <typename KeyType, typename ValueType, typename KeyComparator,
 class SkipListIndex : public Index {
   friend class IndexFactory;
 
-  // typedef SkipList<KeyType, ValueType, KeyComparator, KeyEqualityChecker,
-  // ValueEqualityChecker> MapType;
-
   using MapType = SkipList<KeyType, ValueType, KeyComparator,
                            KeyEqualityChecker, ValueEqualityChecker>;
 
@@ -51,18 +48,18 @@ class SkipListIndex : public Index {
 
   ~SkipListIndex();
 
-  bool InsertEntry(const storage::Tuple *key, ItemPointer *value);
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value) override;
 
-  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value);
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value) override;
 
   bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
-                       std::function<bool(const void *)> predicate);
+                       std::function<bool(const void *)> predicate) override;
 
   void Scan(const std::vector<type::Value> &values,
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
             ScanDirectionType scan_direction, std::vector<ValueType> &result,
-            const ConjunctionScanPredicate *csp_p);
+            const ConjunctionScanPredicate *csp_p) override;
 
   void ScanLimit(const std::vector<type::Value> &values,
                  const std::vector<oid_t> &key_column_ids,
@@ -70,22 +67,30 @@ class SkipListIndex : public Index {
                  ScanDirectionType scan_direction,
                  std::vector<ValueType> &result,
                  const ConjunctionScanPredicate *csp_p, uint64_t limit,
-                 uint64_t offset);
+                 uint64_t offset) override;
+
+  void ScanAllKeys(std::vector<ValueType> &result) override;
 
-  void ScanAllKeys(std::vector<ValueType> &result);
+  void ScanKey(const storage::Tuple *key,
+               std::vector<ValueType> &result) override;
 
-  void ScanKey(const storage::Tuple *key, std::vector<ValueType> &result);
+  std::string GetTypeName() const override;
 
-  std::string GetTypeName() const;
+  size_t GetMemoryFootprint() override {
+    return container.GetMemoryFootprint();
+  }
 
-  // TODO: Implement this
-  size_t GetMemoryFootprint() { return 0; }
+  bool NeedGC() override { return container.NeedGarbageCollection(); }
 
-  // TODO: Implement this
-  bool NeedGC() { return false; }
+  void PerformGC() override { container.PerformGarbageCollection(); }
 
-  // TODO: Implement this
-  void PerformGC() { return; }
+ private:
+  // Skip 'offset' entries within the predicate's key bounds in the given
+  // direction and collect up to 'limit' after that
+  void ScanRange(ScanDirectionType scan_direction,
+                 std::vector<ValueType> &result,
+                 const ConjunctionScanPredicate *csp_p, uint64_t limit,
+                 uint64_t offset);
 
  protected:
   // equality checker and comparator
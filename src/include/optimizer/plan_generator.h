@@ -118,6 +118,14 @@ class PlanGenerator : public OperatorVisitor {
    */
   std::vector<oid_t> GenerateColumnsForScan();
 
+  /**
+   * @brief Let an index scan below an order by + limit stop after the tuples
+   *  the limit returns, if the index already returns them in the sort order
+   *
+   * @param op The limit operator, whose child is the current output plan
+   */
+  void PushLimitIntoIndexScan(const PhysicalLimit *op);
+
   /**
    * @brief Generate a predicate expression for scan plans
    *
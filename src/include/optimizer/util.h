@@ -149,6 +149,21 @@ expression::AbstractExpression *TransformQueryDerivedTablePredicates(
         &alias_to_expr_map,
     expression::AbstractExpression *expr);
 
+/**
+ * @brief Check whether a set of single table predicates implies a predicate on
+ *  the same table, such as the predicate of a partial index. The check is
+ *  conservative: each conjunct of the predicate must either appear among the
+ *  given predicates, or follow from a comparison of the same column with a
+ *  constant.
+ *
+ * @param predicates The conjuncts known to hold
+ * @param expr The predicate to check
+ *
+ * @return True if every tuple satisfying the predicates satisfies expr
+ */
+bool PredicatesImply(const std::vector<AnnotatedExpression> &predicates,
+                     const expression::AbstractExpression *expr);
+
 /**
  * @brief Walk through a set of join predicates, generate join keys base on the
  *  left/right table aliases set
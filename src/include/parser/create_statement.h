@@ -239,6 +239,8 @@ class CreateStatement : public TableRefStatement {
   std::vector<std::string> index_attrs;
   IndexType index_type;
   std::string index_name;
+  // Only rows satisfying the predicate are indexed (partial index)
+  std::unique_ptr<expression::AbstractExpression> index_predicate;
 
   std::string view_name;
   std::unique_ptr<SelectStatement> view_query;
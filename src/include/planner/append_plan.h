@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "abstract_plan.h"
 #include "common/internal_types.h"
 
@@ -33,6 +35,30 @@ class AppendPlan : public AbstractPlan {
     return std::unique_ptr<AbstractPlan>(new AppendPlan());
   }
 
+  /**
+   * @brief The output of an append are the attributes of its first child. The
+   * attributes of the other children are bound separately and paired up with
+   * those of the first child by column position.
+   */
+  void PerformBinding(BindingContext &binding_context) override;
+
+  /** @brief The attributes of each child, in column order */
+  const std::vector<std::vector<const AttributeInfo *>> &GetInputAttributes()
+      const {
+    return input_ais_;
+  }
+
+  hash_t Hash() const override;
+
+  bool operator==(const AbstractPlan &rhs) const override;
+  bool operator!=(const AbstractPlan &rhs) const override {
+    return !(*this == rhs);
+  }
+
+ private:
+  /** @brief The attributes of each child, in column order */
+  std::vector<std::vector<const AttributeInfo *>> input_ais_;
+
  private:
   DISALLOW_COPY_AND_MOVE(AppendPlan);
 };
@@ -97,6 +97,11 @@ class CreatePlan : public AbstractPlan {
 
   void SetKeyAttrs(std::vector<oid_t> p_key_attrs) { key_attrs = p_key_attrs; }
 
+  // The predicate of a partial index, evaluated on the table's tuples
+  const expression::AbstractExpression *GetIndexPredicate() const {
+    return index_predicate.get();
+  }
+
   // interfaces for triggers
 
   std::string GetTriggerName() const { return trigger_name; }
@@ -149,6 +154,9 @@ class CreatePlan : public AbstractPlan {
   // UNIQUE INDEX flag
   bool unique;
 
+  // Only tuples satisfying this are indexed, if set
+  std::unique_ptr<expression::AbstractExpression> index_predicate;
+
   // ColumnDefinition for multi-column constraints (including foreign key)
   std::vector<ForeignKeyInfo> foreign_keys;
   std::string trigger_name;
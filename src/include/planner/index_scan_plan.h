@@ -125,6 +125,12 @@ class IndexScanPlan : public AbstractScan {
 
   const std::vector<type::Value> &GetValues() const { return values_; }
 
+  // The key values as given to the constructor, where parameters that are
+  // bound later are PARAMETER_OFFSET placeholders
+  const std::vector<type::Value> &GetValuesWithParams() const {
+    return values_with_params_;
+  }
+
   const std::vector<expression::AbstractExpression *> &GetRunTimeKeys() const {
     return runtime_keys_;
   }
@@ -145,6 +151,8 @@ class IndexScanPlan : public AbstractScan {
 
   inline bool GetDescend() const { return descend_; }
 
+  inline bool GetIndexOnly() const { return index_only_; }
+
   const std::string GetInfo() const { return "IndexScan"; }
 
   void SetLimit(bool limit) { limit_ = limit; }
@@ -155,6 +163,8 @@ class IndexScanPlan : public AbstractScan {
 
   void SetDescend(bool descend) { descend_ = descend; }
 
+  void SetIndexOnly(bool index_only) { index_only_ = index_only; }
+
   void SetParameterValues(std::vector<type::Value> *values);
 
   std::unique_ptr<AbstractPlan> Copy() const {
@@ -167,9 +177,26 @@ class IndexScanPlan : public AbstractScan {
                        new_runtime_keys);
     IndexScanPlan *new_plan = new IndexScanPlan(
         GetTable(), GetPredicate()->Copy(), GetColumnIds(), desc, false);
+    new_plan->SetIndexOnly(index_only_);
+    new_plan->SetLimit(limit_);
+    new_plan->SetLimitNumber(limit_number_);
+    new_plan->SetLimitOffset(limit_offset_);
+    new_plan->SetDescend(descend_);
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
+  hash_t Hash() const override;
+
+  bool operator==(const AbstractPlan &rhs) const override;
+  bool operator!=(const AbstractPlan &rhs) const override {
+    return !(*this == rhs);
+  }
+
+  void VisitParameters(
+      codegen::QueryParametersMap &map,
+      std::vector<peloton::type::Value> &values,
+      const std::vector<peloton::type::Value> &values_from_user) override;
+
  private:
   /** @brief index associated with index scan. */
   oid_t index_id_;
@@ -218,6 +245,10 @@ class IndexScanPlan : public AbstractScan {
   // whether order by is descending
   bool descend_ = false;
 
+  // whether all columns read by the scan are covered by the index, so that
+  // the scan can be answered from the index payloads
+  bool index_only_ = false;
+
  private:
   DISALLOW_COPY_AND_MOVE(IndexScanPlan);
 };
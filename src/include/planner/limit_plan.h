@@ -31,10 +31,11 @@ class LimitPlan : public AbstractPlan {
  public:
   LimitPlan(size_t limit, size_t offset) : limit_(limit), offset_(offset) {}
 
-  // Accessors
-  size_t GetLimit() const { return limit_; }
+  // Accessors. Compiled queries look up the parameters for the limit and the
+  // offset by their address, hence the references.
+  const size_t &GetLimit() const { return limit_; }
 
-  size_t GetOffset() const { return offset_; }
+  const size_t &GetOffset() const { return offset_; }
 
   inline PlanNodeType GetPlanNodeType() const { return PlanNodeType::LIMIT; }
 
@@ -44,6 +45,18 @@ class LimitPlan : public AbstractPlan {
     return std::unique_ptr<AbstractPlan>(new LimitPlan(limit_, offset_));
   }
 
+  hash_t Hash() const override;
+
+  bool operator==(const AbstractPlan &rhs) const override;
+  bool operator!=(const AbstractPlan &rhs) const override {
+    return !(*this == rhs);
+  }
+
+  void VisitParameters(
+      codegen::QueryParametersMap &map,
+      std::vector<peloton::type::Value> &values,
+      const std::vector<peloton::type::Value> &values_from_user) override;
+
  private:
   const size_t limit_;   // as LIMIT in SQL standard
   const size_t offset_;  // as OFFSET in SQL standard
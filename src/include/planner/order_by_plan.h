@@ -84,11 +84,18 @@ class OrderByPlan : public AbstractPlan {
 
   bool GetLimit() const { return limit_; }
 
-  uint64_t GetLimitNumber() const { return limit_number_; }
+  // Compiled queries look up the parameters for the limit and the offset by
+  // their address, hence the references
+  const uint64_t &GetLimitNumber() const { return limit_number_; }
 
-  uint64_t GetLimitOffset() const { return limit_offset_; }
+  const uint64_t &GetLimitOffset() const { return limit_offset_; }
 
   std::unique_ptr<AbstractPlan> Copy() const override {
+    if (limit_) {
+      return std::unique_ptr<AbstractPlan>(
+          new OrderByPlan(sort_keys_, descend_flags_, output_column_ids_,
+                          limit_number_, limit_offset_));
+    }
     return std::unique_ptr<AbstractPlan>(
         new OrderByPlan(sort_keys_, descend_flags_, output_column_ids_));
   }
@@ -100,6 +107,11 @@ class OrderByPlan : public AbstractPlan {
     return !(*this == rhs);
   }
 
+  void VisitParameters(
+      codegen::QueryParametersMap &map,
+      std::vector<peloton::type::Value> &values,
+      const std::vector<peloton::type::Value> &values_from_user) override;
+
  private:
   /** @brief Column Ids to sort keys w.r.t input tiles.
    *  Primary sort key comes first, secondary comes next, etc.
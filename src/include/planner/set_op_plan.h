@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "abstract_plan.h"
 #include "common/internal_types.h"
 
@@ -39,10 +41,33 @@ class SetOpPlan : public AbstractPlan {
     return std::unique_ptr<AbstractPlan>(new SetOpPlan(set_op_));
   }
 
+  /**
+   * @brief The output of a set operation are the attributes of its left
+   * child. The attributes of the right child are bound separately and paired
+   * up with those of the left child by column position.
+   */
+  void PerformBinding(BindingContext &binding_context) override;
+
+  /** @brief The attributes of each child, in column order */
+  const std::vector<std::vector<const AttributeInfo *>> &GetInputAttributes()
+      const {
+    return input_ais_;
+  }
+
+  hash_t Hash() const override;
+
+  bool operator==(const AbstractPlan &rhs) const override;
+  bool operator!=(const AbstractPlan &rhs) const override {
+    return !(*this == rhs);
+  }
+
  private:
   /** @brief Set Operation of this node */
   SetOpType set_op_;
 
+  /** @brief The attributes of each child, in column order */
+  std::vector<std::vector<const AttributeInfo *>> input_ais_;
+
  private:
   DISALLOW_COPY_AND_MOVE(SetOpPlan);
 };
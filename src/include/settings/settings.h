@@ -121,6 +121,21 @@ SETTING_bool(parallel_execution,
              true,
              true, true)
 
+// Place tile groups on the NUMA node of the inserting thread and route
+// parallel scan tasks to workers on the node holding the data
+SETTING_bool(numa_aware_placement,
+             "Enable NUMA-aware tile group placement and scan scheduling (default: true)",
+             true,
+             false, false)
+
+// Build bitmap indexes over the low-cardinality columns of tile groups when
+// they are frozen
+SETTING_int(bitmap_index_max_cardinality,
+            "Maximum number of distinct values of a column to build a bitmap index on when a tile group is frozen, 0 disables them (default: 32)",
+            32,
+            0, 1024,
+            true, true)
+
 SETTING_int(min_parallel_table_scan_size,
             "Minimum number of tuples a table must have before we consider performing parallel scans (default: 10K)",
             10 * 1000,
@@ -204,6 +219,17 @@ SETTING_bool(codegen_interpreter,
              "Force interpretation of generated llvm code (default: false)",
              false, true, true)
 
+SETTING_bool(codegen_tiered_execution,
+             "Start new queries in the interpreter while they are compiled "
+             "in the background (default: false)",
+             false, true, true)
+
+SETTING_string(codegen_object_cache_directory,
+               "Directory to keep compiled query code in across restarts. "
+               "Caching is disabled if empty (default: empty)",
+               "",
+               true, true)
+
 SETTING_bool(print_ir_stats,
              "Print statistics on generated IR (default: false)",
              false,
@@ -19,6 +19,7 @@
 #include "common/internal_types.h"
 #include "statistics/abstract_metric.h"
 #include "statistics/access_metric.h"
+#include "statistics/memory_metric.h"
 #include "util/string_util.h"
 
 namespace peloton {
@@ -42,6 +43,8 @@ class IndexMetric : public AbstractMetric {
   // accesses to this index
   inline AccessMetric &GetIndexAccess() { return index_access_; }
 
+  inline MemoryMetric &GetIndexMemory() { return index_memory_; }
+
   inline std::string GetName() { return index_name_; }
 
   inline oid_t GetDatabaseId() { return database_id_; }
@@ -54,7 +57,10 @@ class IndexMetric : public AbstractMetric {
   // HELPER METHODS
   //===--------------------------------------------------------------------===//
 
-  inline void Reset() { index_access_.Reset(); }
+  inline void Reset() {
+    index_access_.Reset();
+    index_memory_.Reset();
+  }
 
   inline bool operator==(const IndexMetric &other) {
     return database_id_ == other.database_id_ && table_id_ == other.table_id_ &&
@@ -71,6 +77,7 @@ class IndexMetric : public AbstractMetric {
     ss << "INDEXES: " << std::endl;
     ss << index_name_ << "(OID=" << index_id_ << "): ";
     ss << index_access_.GetInfo();
+    ss << index_memory_.GetInfo();
     return ss.str();
   }
 
@@ -93,6 +100,9 @@ class IndexMetric : public AbstractMetric {
 
   // Counts the number of index entries accessed
   AccessMetric index_access_{MetricType::ACCESS};
+
+  // The number of bytes held by the index, sampled by the aggregator
+  MemoryMetric index_memory_{MetricType::MEMORY};
 };
 
 }  // namespace stats
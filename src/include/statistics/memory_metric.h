@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// memory_metric.h
+//
+// Identification: src/statistics/memory_metric.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <sstream>
+
+#include "common/internal_types.h"
+#include "statistics/abstract_metric.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Metric for the number of bytes held by a table or an index, broken down by
+ * the structure that holds them. Unlike the access metrics this is a gauge:
+ * it is sampled by the aggregator rather than accumulated by the backends.
+ */
+class MemoryMetric : public AbstractMetric {
+ public:
+  MemoryMetric(MetricType type);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  // Inlined tuple storage of all tiles
+  inline void IncrementTileBytes(int64_t bytes) { tile_bytes_ += bytes; }
+  inline int64_t GetTileBytes() const { return tile_bytes_; }
+
+  // MVCC tuple headers of all tile groups
+  inline void IncrementHeaderBytes(int64_t bytes) { header_bytes_ += bytes; }
+  inline int64_t GetHeaderBytes() const { return header_bytes_; }
+
+  // Out-of-line (varlen) data in the tile pools
+  inline void IncrementVarlenBytes(int64_t bytes) { varlen_bytes_ += bytes; }
+  inline int64_t GetVarlenBytes() const { return varlen_bytes_; }
+
+  // Indirection arrays
+  inline void IncrementIndirectionBytes(int64_t bytes) {
+    indirection_bytes_ += bytes;
+  }
+  inline int64_t GetIndirectionBytes() const { return indirection_bytes_; }
+
+  // Tuple slots holding old versions that have not been garbage collected.
+  // These bytes are a subset of the tile bytes.
+  inline void IncrementVersionBytes(int64_t bytes) { version_bytes_ += bytes; }
+  inline int64_t GetVersionBytes() const { return version_bytes_; }
+
+  // Index structures (nodes, delta records, mapping tables)
+  inline void IncrementIndexBytes(int64_t bytes) { index_bytes_ += bytes; }
+  inline int64_t GetIndexBytes() const { return index_bytes_; }
+
+  // Total number of bytes accounted for by this metric
+  inline int64_t GetTotalBytes() const {
+    return tile_bytes_ + header_bytes_ + varlen_bytes_ + indirection_bytes_ +
+           index_bytes_;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  inline void Reset() {
+    tile_bytes_ = 0;
+    header_bytes_ = 0;
+    varlen_bytes_ = 0;
+    indirection_bytes_ = 0;
+    version_bytes_ = 0;
+    index_bytes_ = 0;
+  }
+
+  inline bool operator==(const MemoryMetric &other) {
+    return tile_bytes_ == other.tile_bytes_ &&
+           header_bytes_ == other.header_bytes_ &&
+           varlen_bytes_ == other.varlen_bytes_ &&
+           indirection_bytes_ == other.indirection_bytes_ &&
+           version_bytes_ == other.version_bytes_ &&
+           index_bytes_ == other.index_bytes_;
+  }
+
+  inline bool operator!=(const MemoryMetric &other) {
+    return !(*this == other);
+  }
+
+  // Adds the source's bytes to this metric
+  void Aggregate(AbstractMetric &source);
+
+  inline const std::string GetInfo() const {
+    std::stringstream ss;
+    ss << "[memory] total=" << GetTotalBytes() << ", tiles=" << tile_bytes_
+       << ", headers=" << header_bytes_ << ", varlen=" << varlen_bytes_
+       << ", indirection=" << indirection_bytes_
+       << ", versions=" << version_bytes_ << ", indexes=" << index_bytes_;
+    return ss.str();
+  }
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  int64_t tile_bytes_;
+  int64_t header_bytes_;
+  int64_t varlen_bytes_;
+  int64_t indirection_bytes_;
+  int64_t version_bytes_;
+  int64_t index_bytes_;
+};
+
+}  // namespace stats
+}  // namespace peloton
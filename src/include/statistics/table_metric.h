@@ -18,6 +18,7 @@
 #include "common/internal_types.h"
 #include "statistics/abstract_metric.h"
 #include "statistics/access_metric.h"
+#include "statistics/memory_metric.h"
 #include "util/string_util.h"
 
 namespace peloton {
@@ -38,6 +39,8 @@ class TableMetric : public AbstractMetric {
 
   inline AccessMetric &GetTableAccess() { return table_access_; }
 
+  inline MemoryMetric &GetTableMemory() { return table_memory_; }
+
   inline std::string GetName() { return table_name_; }
 
   inline oid_t GetDatabaseId() { return database_id_; }
@@ -48,7 +51,10 @@ class TableMetric : public AbstractMetric {
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
 
-  inline void Reset() { table_access_.Reset(); }
+  inline void Reset() {
+    table_access_.Reset();
+    table_memory_.Reset();
+  }
 
   inline bool operator==(const TableMetric &other) {
     return database_id_ == other.database_id_ && table_id_ == other.table_id_ &&
@@ -68,6 +74,7 @@ class TableMetric : public AbstractMetric {
     ;
     ss << peloton::GETINFO_SINGLE_LINE << std::endl;
     ss << table_access_.GetInfo();
+    ss << table_memory_.GetInfo();
     return ss.str();
   }
 
@@ -87,6 +94,9 @@ class TableMetric : public AbstractMetric {
 
   // The number of tuple accesses
   AccessMetric table_access_{MetricType::ACCESS};
+
+  // The number of bytes held by the table, sampled by the aggregator
+  MemoryMetric table_memory_{MetricType::MEMORY};
 };
 
 }  // namespace stats
@@ -0,0 +1,166 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bitmap_index.h
+//
+// Identification: src/include/storage/bitmap_index.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/macros.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace executor {
+class ExecutorContext;
+}  // namespace executor
+
+namespace expression {
+class AbstractExpression;
+}  // namespace expression
+
+namespace storage {
+
+class TileGroup;
+
+/**
+ * @brief A conjunction of IN-lists (col IN (v1, v2, ...)) that can be answered
+ * from tile group bitmap indexes. Equality predicates are single-element lists
+ * and disjunctions of equalities on one column are merged into one list.
+ */
+class BitmapPredicate {
+ public:
+  struct Term {
+    oid_t col_id;
+    std::vector<type::Value> values;
+  };
+
+  /// The shape of a term before its values are known: the column and the
+  /// constant or parameter expressions it is compared with
+  struct TermExpression {
+    oid_t col_id;
+    std::vector<const expression::AbstractExpression *> values;
+  };
+
+  BitmapPredicate() = default;
+
+  /// Collect the bitmap-indexable conjuncts of the given predicate. Returns
+  /// true if at least one conjunct was found.
+  static bool CollectTerms(const expression::AbstractExpression *predicate,
+                           std::vector<TermExpression> &terms);
+
+  /// Add the bitmap-indexable conjuncts of the given predicate whose values
+  /// are all constants. Returns true if at least one conjunct was added.
+  bool AddPredicate(const expression::AbstractExpression *predicate);
+
+  const std::vector<Term> &GetTerms() const { return terms_; }
+
+  bool IsEmpty() const { return terms_.empty(); }
+
+  //===--------------------------------------------------------------------===//
+  // Runtime functions used by the codegen table scan, which keeps a
+  // BitmapPredicate in its query state. The values of the terms are taken
+  // from the query parameters, so that a cached query sees the values of
+  // every execution.
+  //===--------------------------------------------------------------------===//
+
+  static void Init(BitmapPredicate &bitmap_predicate);
+
+  /// Start a new term on the given column
+  static void AddTerm(BitmapPredicate &bitmap_predicate, uint32_t col_id);
+
+  /// Add the value of the given query parameter to the last term
+  static void AddValue(BitmapPredicate &bitmap_predicate,
+                       executor::ExecutorContext &ctx, uint32_t param_idx);
+
+  static void Destroy(BitmapPredicate &bitmap_predicate);
+
+ private:
+  // Extract the IN-list of a single equality or a disjunction of equalities
+  // on one column
+  static bool GetTerm(const expression::AbstractExpression *expr,
+                      TermExpression &term);
+
+ private:
+  std::vector<Term> terms_;
+};
+
+/**
+ * @brief Bitmap indexes over the low-cardinality columns of a single, frozen
+ * tile group.
+ *
+ * For every column with at most 'max_cardinality' distinct (non-NULL) values we
+ * keep one bitmap per value, with one bit per tuple slot. Bitmaps are built
+ * once when the tile group is made immutable and are never updated afterwards.
+ * They are exact for the slots that existed at build time, slots beyond that
+ * are always reported as candidates.
+ */
+class BitmapIndex {
+ public:
+  /// Build bitmap indexes over all columns of the tile group with at most
+  /// 'max_cardinality' distinct values. Returns nullptr if no column
+  /// qualifies.
+  static std::unique_ptr<BitmapIndex> Build(TileGroup &tile_group,
+                                            uint32_t max_cardinality);
+
+  DISALLOW_COPY_AND_MOVE(BitmapIndex);
+
+  /// Is there a bitmap index on the given column?
+  bool HasColumn(oid_t col_id) const {
+    return columns_.find(col_id) != columns_.end();
+  }
+
+  /// Return the number of distinct values of an indexed column
+  size_t GetCardinality(oid_t col_id) const;
+
+  /// Return the number of tuple slots covered by the bitmaps
+  uint32_t GetTupleCount() const { return tuple_count_; }
+
+  /// Write the IDs of all tuples in [tid_start, tid_end) that may satisfy the
+  /// given predicate into the selection vector, returning how many were
+  /// written. Terms on columns without a bitmap are ignored. Returns false
+  /// (and writes nothing) if none of the predicate's columns is indexed.
+  bool Select(const BitmapPredicate &predicate, uint32_t tid_start,
+              uint32_t tid_end, uint32_t *selection_vector,
+              uint32_t &num_selected) const;
+
+  /// Return the number of bytes used by the bitmaps
+  size_t GetMemoryFootprint() const;
+
+ private:
+  using Bitmap = std::vector<uint64_t>;
+
+  struct ColumnBitmaps {
+    // The distinct values and, at the same position, their bitmaps
+    std::vector<type::Value> values;
+    std::vector<Bitmap> bitmaps;
+  };
+
+  explicit BitmapIndex(uint32_t tuple_count)
+      : tuple_count_(tuple_count), num_words_((tuple_count + 63) / 64) {}
+
+ private:
+  // The number of tuple slots covered
+  uint32_t tuple_count_;
+
+  // The number of 64-bit words in every bitmap
+  uint32_t num_words_;
+
+  // Column ID => bitmaps of the column
+  std::unordered_map<oid_t, ColumnBitmaps> columns_;
+};
+
+}  // namespace storage
+}  // namespace peloton
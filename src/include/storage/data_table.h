@@ -61,6 +61,10 @@ namespace concurrency {
 class TransactionContext;
 }  // namespace concurrency
 
+namespace stats {
+class MemoryMetric;
+}  // namespace stats
+
 namespace storage {
 
 class Tuple;
@@ -137,6 +141,11 @@ class DataTable : public AbstractTable {
       concurrency::TransactionContext *transaction, ItemPointer **index_entry_ptr,
       bool check_fk = true);
 
+  // Return an indirection whose tuple is dead to the table so that it can be
+  // handed out again. Called by the GC once no index entry references it and
+  // no transaction can still be reading it.
+  void FreeIndirection(ItemPointer *indirection);
+
   //===--------------------------------------------------------------------===//
   // TILE GROUP
   //===--------------------------------------------------------------------===//
@@ -323,6 +332,11 @@ class DataTable : public AbstractTable {
   // Claim a tuple slot in a tile group
   ItemPointer GetEmptyTupleSlot(const storage::Tuple *tuple);
 
+  // Add the bytes held by this table's tiles, tuple headers, varlen pools,
+  // indirection arrays and unreclaimed versions to the given metric. Indexes
+  // are accounted for separately.
+  void GetMemoryFootprint(stats::MemoryMetric &memory) const;
+
   hash_t Hash() const;
 
   bool Equals(const storage::DataTable &other) const;
@@ -352,8 +366,22 @@ class DataTable : public AbstractTable {
   // tile group.
   oid_t AddDefaultTileGroup(const size_t &active_tile_group_id);
 
+  // add an indirection array to the table. replace the
+  // active_indirection_array_id-th active indirection array. the caller must
+  // hold indirection_array_mutex_.
   oid_t AddDefaultIndirectionArray(const size_t &active_indirection_array_id);
 
+  // replace the active_indirection_array_id-th active indirection array if it
+  // is still the given exhausted one.
+  void ReplaceIndirectionArray(
+      const size_t &active_indirection_array_id,
+      const std::shared_ptr<IndirectionArray> &indirection_array);
+
+  // drop an indirection array whose indirections are all free. the caller
+  // must hold indirection_array_mutex_.
+  void ReleaseIndirectionArray(
+      const std::shared_ptr<IndirectionArray> &indirection_array);
+
   // Drop all tile groups of the table. Used by recovery
   void DropTileGroups();
 
@@ -366,6 +394,18 @@ class DataTable : public AbstractTable {
                                 concurrency::TransactionContext *transaction,
                                 ItemPointer *index_entry_ptr);
 
+  // insert the entry into a primary key or unique index, unless a tuple that
+  // may have the key and is occupied by the given function already has one
+  static bool CondInsertUniqueEntry(
+      index::Index *index, const storage::Tuple &key,
+      ItemPointer *index_entry_ptr,
+      const std::function<bool(const void *)> &is_occupied);
+
+  // whether a version of the tuple behind the indirection may have the key.
+  // entries can outlive their tuple and point at a recycled indirection.
+  static bool TupleMayHaveKey(ItemPointer *index_entry_ptr,
+                              index::Index *index, const storage::Tuple &key);
+
   // check the foreign key constraints
   bool CheckForeignKeyConstraints(const AbstractTuple *tuple,
                                   concurrency::TransactionContext *transaction);
@@ -416,6 +456,17 @@ class DataTable : public AbstractTable {
   std::vector<std::shared_ptr<storage::IndirectionArray>>
       active_indirection_arrays_;
 
+  // all indirection arrays of this table that have not been released yet,
+  // keyed by the address of their first indirection
+  std::map<const ItemPointer *, std::shared_ptr<storage::IndirectionArray>>
+      indirection_arrays_;
+
+  // protects indirection_arrays_ and the retirement of active arrays
+  std::mutex indirection_array_mutex_;
+
+  // number of indirection arrays allocated for this table
+  std::atomic<size_t> indirection_array_count_ = ATOMIC_VAR_INIT(0);
+
   // data table mutex
   std::mutex data_table_mutex_;
 
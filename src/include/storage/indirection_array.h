@@ -10,42 +10,105 @@
 //
 //===----------------------------------------------------------------------===//
 
+#pragma once
+
 #include <array>
 
+#include "common/container/lock_free_queue.h"
+#include "common/item_pointer.h"
+
 namespace peloton {
 namespace storage {
 
 const size_t INDIRECTION_ARRAY_MAX_SIZE = 1000;
 const size_t INVALID_INDIRECTION_OFFSET = std::numeric_limits<size_t>::max();
 
+/**
+ * A fixed-size array of indirections (the slots index entries point to).
+ *
+ * Offsets are handed out by bumping a counter. Once the GC returns an offset
+ * whose tuple is dead, it is handed out again as long as the array is still
+ * active. Offsets returned after the array has been retired are only counted,
+ * so that the whole array can be released once every offset is free.
+ */
 class IndirectionArray {
  public:
-  IndirectionArray(oid_t oid) : oid_(oid) {
+  IndirectionArray(oid_t oid)
+      : free_indirections_(INDIRECTION_ARRAY_MAX_SIZE), oid_(oid) {
     indirections_.reset(new indirection_array_t());
   }
 
   ~IndirectionArray() {}
 
   size_t AllocateIndirection() {
-    if (indirection_counter_ >= INDIRECTION_ARRAY_MAX_SIZE) {
-      return INVALID_INDIRECTION_OFFSET;
-    }
+    if (indirection_counter_ < INDIRECTION_ARRAY_MAX_SIZE) {
+      size_t indirection_id =
+          indirection_counter_.fetch_add(1, std::memory_order_relaxed);
 
-    size_t indirection_id =
-        indirection_counter_.fetch_add(1, std::memory_order_relaxed);
+      if (indirection_id < INDIRECTION_ARRAY_MAX_SIZE) {
+        return indirection_id;
+      }
+    }
 
-    if (indirection_id >= INDIRECTION_ARRAY_MAX_SIZE) {
-      return INVALID_INDIRECTION_OFFSET;
+    // Fall back to the offsets recycled by the GC. Claim one by decrementing
+    // the free count, which fails once the array is retired, so that an array
+    // is never released while one of its offsets is being handed out.
+    size_t free_state = free_state_.load();
+    while (free_state != 0 && (free_state & RETIRED_FLAG) == 0) {
+      if (free_state_.compare_exchange_weak(free_state, free_state - 1)) {
+        // Offsets are enqueued before they are counted, so ours is there
+        size_t indirection_id;
+        while (free_indirections_.Dequeue(indirection_id) == false) {
+        }
+        return indirection_id;
+      }
     }
-    return indirection_id;
+    return INVALID_INDIRECTION_OFFSET;
   }
 
   ItemPointer *GetIndirectionByOffset(const size_t &offset) {
     return &(indirections_->at(offset));
   }
 
+  // Return true if the given indirection lives in this array
+  bool ContainsIndirection(const ItemPointer *indirection) const {
+    return indirection >= indirections_->data() &&
+           indirection < indirections_->data() + INDIRECTION_ARRAY_MAX_SIZE;
+  }
+
+  // Return an indirection to the array. The caller must guarantee that no
+  // index entry references it and that no reader can still be holding it.
+  // Returns true if the array is retired and every offset is now free.
+  bool FreeIndirection(ItemPointer *indirection) {
+    PELOTON_ASSERT(ContainsIndirection(indirection));
+    *indirection = INVALID_ITEMPOINTER;
+
+    size_t offset = indirection - indirections_->data();
+    if ((free_state_.load() & RETIRED_FLAG) == 0) {
+      free_indirections_.Enqueue(offset);
+    }
+    return free_state_.fetch_add(1) + 1 ==
+           (RETIRED_FLAG | INDIRECTION_ARRAY_MAX_SIZE);
+  }
+
+  // Stop handing out offsets from this array. Returns true if every offset
+  // is already free.
+  bool Retire() {
+    size_t free_state = free_state_.fetch_or(RETIRED_FLAG);
+    return (free_state & ~RETIRED_FLAG) == INDIRECTION_ARRAY_MAX_SIZE;
+  }
+
+  inline const ItemPointer *GetBaseIndirection() const {
+    return indirections_->data();
+  }
+
   inline oid_t GetOid() { return oid_; }
 
+  // Number of bytes occupied by an indirection array
+  static constexpr size_t GetMemoryFootprint() {
+    return sizeof(IndirectionArray) + sizeof(indirection_array_t);
+  }
+
  private:
   typedef std::array<ItemPointer, INDIRECTION_ARRAY_MAX_SIZE>
       indirection_array_t;
@@ -54,6 +117,18 @@ class IndirectionArray {
 
   std::atomic<size_t> indirection_counter_ = ATOMIC_VAR_INIT(0);
 
+  // Offsets returned by the GC that can be handed out again
+  LockFreeQueue<size_t> free_indirections_;
+
+  // Set in free_state_ once the table has replaced this array with a new one
+  static constexpr size_t RETIRED_FLAG =
+      ~(std::numeric_limits<size_t>::max() >> 1);
+
+  // Number of offsets returned by the GC and not handed out again, along with
+  // RETIRED_FLAG. Both live in one word so that claiming a free offset and
+  // retiring the array can't interleave.
+  std::atomic<size_t> free_state_ = ATOMIC_VAR_INIT(0);
+
   oid_t oid_;
 };
 }
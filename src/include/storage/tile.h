@@ -16,6 +16,7 @@
 
 #include "catalog/manager.h"
 #include "catalog/schema.h"
+#include "common/numa.h"
 #include "common/item_pointer.h"
 #include "common/printable.h"
 #include "type/abstract_pool.h"
@@ -59,7 +60,7 @@ class Tile : public Printable {
   // Tile creator
   Tile(BackendType backend_type, TileGroupHeader *tile_header,
        const catalog::Schema &tuple_schema, TileGroup *tile_group,
-       int tuple_count);
+       int tuple_count, int numa_node = NumaUtil::kInvalidNode);
 
   virtual ~Tile();
 
@@ -147,6 +148,9 @@ class Tile : public Printable {
 
   oid_t GetTileId() const { return tile_id; }
 
+  // The NUMA node the tile's inlined data was placed on
+  int GetNumaNode() const { return numa_node; }
+
   // Compare two tiles
   bool operator==(const Tile &other) const;
   bool operator!=(const Tile &other) const;
@@ -197,6 +201,10 @@ class Tile : public Printable {
   // set of fixed-length tuple slots
   char *data;
 
+  // NUMA node the tuple slots were allocated on (kInvalidNode if the data
+  // was allocated without any placement preference)
+  int numa_node;
+
   // relevant tile group
   TileGroup *tile_group;
 
@@ -282,9 +290,10 @@ class TileFactory {
                        oid_t table_id, oid_t tile_group_id, oid_t tile_id,
                        TileGroupHeader *tile_header,
                        const catalog::Schema &schema, TileGroup *tile_group,
-                       int tuple_count) {
-    Tile *tile =
-        new Tile(backend_type, tile_header, schema, tile_group, tuple_count);
+                       int tuple_count,
+                       int numa_node = NumaUtil::kInvalidNode) {
+    Tile *tile = new Tile(backend_type, tile_header, schema, tile_group,
+                          tuple_count, numa_node);
 
     TileFactory::InitCommon(tile, database_id, table_id, tile_group_id, tile_id,
                             schema);
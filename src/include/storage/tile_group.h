@@ -20,6 +20,7 @@
 
 #include "common/internal_types.h"
 #include "common/item_pointer.h"
+#include "common/numa.h"
 #include "common/printable.h"
 #include "planner/project_info.h"
 #include "storage/layout.h"
@@ -50,6 +51,7 @@ namespace storage {
 class Tuple;
 class Tile;
 class TileGroupHeader;
+class BitmapIndex;
 class AbstractTable;
 class TileGroupIterator;
 class RollbackSegment;
@@ -75,7 +77,8 @@ class TileGroup : public Printable {
   // Tile group constructor
   TileGroup(BackendType backend_type, TileGroupHeader *tile_group_header,
             AbstractTable *table, const std::vector<catalog::Schema> &schemas,
-            std::shared_ptr<const Layout> layout, int tuple_count);
+            std::shared_ptr<const Layout> layout, int tuple_count,
+            int numa_node = NumaUtil::kInvalidNode);
 
   ~TileGroup();
 
@@ -161,6 +164,26 @@ class TileGroup : public Printable {
   // Sync the contents
   void Sync();
 
+  // Freeze the tile group by marking it immutable. If enabled through the
+  // 'bitmap_index_max_cardinality' setting, bitmap indexes are built over the
+  // tile group's low-cardinality columns. Returns false if the tile group was
+  // already immutable.
+  //
+  // Nothing freezes tile groups on its own yet (like zone maps, this is up to
+  // the caller), so scans only use bitmap indexes of tile groups frozen here.
+  bool SetImmutability();
+
+  // Make the tile group mutable again, dropping its bitmap indexes
+  bool ResetImmutability();
+
+  // Get the bitmap indexes of the tile group (nullptr if there are none)
+  std::shared_ptr<const BitmapIndex> GetBitmapIndex() const {
+    return std::atomic_load(&bitmap_index_);
+  }
+
+  // Get the NUMA node the tiles of this tile group were placed on
+  int GetNumaNode() const { return numa_node_; }
+
   // Get the layout of the TileGroup. Used to locate columns.
   const storage::Layout &GetLayout() const { return *tile_group_layout_; }
 
@@ -196,6 +219,12 @@ class TileGroup : public Printable {
 
   // Refernce to the layout of the TileGroup
   std::shared_ptr<const Layout> tile_group_layout_;
+
+  // NUMA node holding the tiles (kInvalidNode if placement was not requested)
+  int numa_node_;
+
+  // Bitmap indexes built when the tile group was frozen
+  std::shared_ptr<const BitmapIndex> bitmap_index_;
 };
 
 }  // namespace storage
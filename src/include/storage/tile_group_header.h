@@ -154,6 +154,15 @@ class TileGroupHeader : public Printable {
 
   oid_t GetActiveTupleCount() const;
 
+  // Count the slots holding versions that were superseded or deleted by a
+  // committed transaction but have not been reclaimed by the GC yet
+  oid_t GetObsoleteVersionCount() const;
+
+  // Number of bytes occupied by this header and its tuple headers
+  size_t GetMemoryFootprint() const {
+    return sizeof(TileGroupHeader) + num_tuple_slots * sizeof(TupleHeader);
+  }
+
   //===--------------------------------------------------------------------===//
   // MVCC utilities
   //===--------------------------------------------------------------------===//
@@ -37,6 +37,11 @@ class AbstractPool {
    * @brief Returns the provided chunk of memory back into the pool
    */
   virtual void Free(void *ptr) = 0;
+
+  /**
+   * @brief Returns the number of bytes currently allocated from this pool
+   */
+  virtual size_t GetMemoryFootprint() = 0;
 };
 
 }  // namespace type
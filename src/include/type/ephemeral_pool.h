@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "common/macros.h"
@@ -38,9 +39,14 @@ class EphemeralPool : public AbstractPool {
 
   void Free(void *ptr) override;
 
+  size_t GetMemoryFootprint() override;
+
  public:
-  // Location list
-  std::unordered_set<char *> locations_;
+  // Location list, along with the size of each allocation
+  std::unordered_map<char *, size_t> locations_;
+
+  // Total number of bytes handed out by this pool
+  size_t allocated_bytes_ = 0;
 
   // Spin lock protecting location list
   common::synchronization::SpinLatch pool_lock_;
@@ -55,7 +61,7 @@ class EphemeralPool : public AbstractPool {
 inline EphemeralPool::~EphemeralPool() {
   pool_lock_.Lock();
   for (auto location : locations_) {
-    delete[] location;
+    delete[] location.first;
   }
   pool_lock_.Unlock();
 }
@@ -64,7 +70,8 @@ inline void *EphemeralPool::Allocate(size_t size) {
   auto location = new char[size];
 
   pool_lock_.Lock();
-  locations_.insert(location);
+  locations_.emplace(location, size);
+  allocated_bytes_ += size;
   pool_lock_.Unlock();
 
   return location;
@@ -73,10 +80,21 @@ inline void *EphemeralPool::Allocate(size_t size) {
 inline void EphemeralPool::Free(void *ptr) {
   auto *cptr = (char *)ptr;
   pool_lock_.Lock();
-  locations_.erase(cptr);
+  auto iter = locations_.find(cptr);
+  if (iter != locations_.end()) {
+    allocated_bytes_ -= iter->second;
+    locations_.erase(iter);
+  }
   pool_lock_.Unlock();
   delete[] cptr;
 }
 
+inline size_t EphemeralPool::GetMemoryFootprint() {
+  pool_lock_.Lock();
+  size_t bytes = allocated_bytes_;
+  pool_lock_.Unlock();
+  return bytes;
+}
+
 }  // namespace type
 }  // namespace peloton
@@ -0,0 +1,168 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// varlen_slot.h
+//
+// Identification: src/include/type/varlen_slot.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "common/macros.h"
+#include "type/abstract_pool.h"
+#include "type/limits.h"
+
+namespace peloton {
+namespace type {
+
+/**
+ * @brief The fixed-size slot a variable-length value occupies in tuple
+ * storage.
+ *
+ * The slot is 16 bytes: a 4-byte length followed by 12 bytes of payload.
+ * Values of at most 12 bytes live entirely in the payload and never touch the
+ * varlen pool. Longer values keep their first four bytes in the payload as a
+ * prefix, followed by a pointer to the full value in the pool. Most
+ * comparisons are decided by the length and the prefix alone, without
+ * chasing the pointer.
+ *
+ * The stored length is biased by one so that an all-zero slot (e.g. freshly
+ * allocated tile memory) reads as NULL.
+ *
+ * Codegen mirrors this layout through VarlenProxy and codegen::Varlen.
+ */
+class VarlenSlot {
+ public:
+  /// Number of leading bytes kept inline for out-of-line values
+  static constexpr uint32_t kPrefixSize = 4;
+
+  /// Values up to this many bytes are stored fully inline
+  static constexpr uint32_t kInlineSize = 12;
+
+  /// Store the given value into the slot at 'storage'. Out-of-line values are
+  /// allocated from 'pool', or from the heap if no pool is given.
+  static void Store(char *storage, const char *data, uint32_t len,
+                    AbstractPool *pool) {
+    if (data == nullptr || len == PELOTON_VALUE_NULL) {
+      StoreNull(storage);
+      return;
+    }
+    auto *slot = reinterpret_cast<VarlenSlot *>(storage);
+    slot->length_ = len + 1;
+    if (len <= kInlineSize) {
+      // The source may be this very slot (e.g. when re-storing a value that
+      // was deserialized from it), so the ranges can overlap
+      memmove(slot->payload_.inlined, data, len);
+      PELOTON_MEMSET(slot->payload_.inlined + len, 0, kInlineSize - len);
+    } else {
+      char *area = (pool == nullptr) ? new char[len]
+                                     : static_cast<char *>(pool->Allocate(len));
+      PELOTON_MEMCPY(area, data, len);
+      PELOTON_MEMCPY(slot->payload_.out_of_line.prefix, data, kPrefixSize);
+      slot->payload_.out_of_line.data = area;
+    }
+  }
+
+  /// Mark the slot at 'storage' as NULL
+  static void StoreNull(char *storage) {
+    PELOTON_MEMSET(storage, 0, sizeof(VarlenSlot));
+  }
+
+  /// Return true if the slot at 'storage' holds NULL
+  static bool IsNull(const char *storage) {
+    return reinterpret_cast<const VarlenSlot *>(storage)->length_ == 0;
+  }
+
+  /// Return the length of the value, or PELOTON_VALUE_NULL if it is NULL
+  static uint32_t GetLength(const char *storage) {
+    uint32_t length = reinterpret_cast<const VarlenSlot *>(storage)->length_;
+    return length == 0 ? PELOTON_VALUE_NULL : length - 1;
+  }
+
+  /// Return a pointer to the bytes of the value, or nullptr if it is NULL
+  static const char *GetData(const char *storage) {
+    auto *slot = reinterpret_cast<const VarlenSlot *>(storage);
+    if (slot->length_ == 0) {
+      return nullptr;
+    }
+    return IsInlined(slot->length_ - 1) ? slot->payload_.inlined
+                                        : slot->payload_.out_of_line.data;
+  }
+
+  /// Return the pool allocation backing the value, or nullptr if the value is
+  /// NULL or stored inline
+  static char *GetOutOfLineData(char *storage) {
+    auto *slot = reinterpret_cast<VarlenSlot *>(storage);
+    if (slot->length_ == 0 || IsInlined(slot->length_ - 1)) {
+      return nullptr;
+    }
+    return const_cast<char *>(slot->payload_.out_of_line.data);
+  }
+
+  /// Compare the non-NULL values stored in the two slots, memcmp-style. The
+  /// comparison is decided on the inline bytes whenever possible.
+  static int Compare(const char *left, const char *right) {
+    auto *l = reinterpret_cast<const VarlenSlot *>(left);
+    auto *r = reinterpret_cast<const VarlenSlot *>(right);
+    PELOTON_ASSERT(l->length_ != 0 && r->length_ != 0);
+    uint32_t len1 = l->length_ - 1;
+    uint32_t len2 = r->length_ - 1;
+    uint32_t min_len = std::min(len1, len2);
+
+    // Inline and out-of-line values both start with (at least) the prefix
+    uint32_t prefix_len = min_len < kPrefixSize ? min_len : kPrefixSize;
+    int ret = memcmp(l->payload_.inlined, r->payload_.inlined, prefix_len);
+    if (ret != 0) {
+      return ret;
+    }
+    if (prefix_len == min_len) {
+      return static_cast<int>(len1) - static_cast<int>(len2);
+    }
+
+    ret = memcmp(GetData(left) + prefix_len, GetData(right) + prefix_len,
+                 min_len - prefix_len);
+    if (ret == 0 && len1 != len2) {
+      ret = static_cast<int>(len1) - static_cast<int>(len2);
+    }
+    return ret;
+  }
+
+  /// Return true if the non-NULL values stored in the two slots are equal
+  static bool Equals(const char *left, const char *right) {
+    auto *l = reinterpret_cast<const VarlenSlot *>(left);
+    auto *r = reinterpret_cast<const VarlenSlot *>(right);
+    if (l->length_ != r->length_) {
+      return false;
+    }
+    return Compare(left, right) == 0;
+  }
+
+ private:
+  static bool IsInlined(uint32_t len) { return len <= kInlineSize; }
+
+  // The length of the value plus one; zero means NULL
+  uint32_t length_;
+
+  union {
+    // Short values
+    char inlined[kInlineSize];
+    // Long values
+    struct __attribute__((packed)) {
+      char prefix[kPrefixSize];
+      const char *data;
+    } out_of_line;
+  } payload_;
+};
+
+static_assert(sizeof(VarlenSlot) == 16, "VarlenSlot must be 16 bytes");
+
+}  // namespace type
+}  // namespace peloton
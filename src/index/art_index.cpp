@@ -12,6 +12,9 @@
 
 #include "index/art_index.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "common/container_tuple.h"
 #include "index/scan_optimizer.h"
 #include "settings/settings_manager.h"
@@ -124,12 +127,33 @@ bool ArtIndex::CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
   return inserted;
 }
 
+void ArtIndex::ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                            std::vector<std::vector<ItemPointer *>> &results) {
+  std::vector<art::Key> tree_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    ConstructArtKey(*keys[i], tree_keys[i]);
+  }
+
+  std::vector<std::vector<TID>> tmp_results(keys.size());
+  auto thread_info = container_.getThreadInfo();
+  container_.lookupBatch(tree_keys.data(),
+                         static_cast<uint32_t>(tree_keys.size()),
+                         tmp_results.data(), thread_info);
+
+  results.resize(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    for (const auto &tid : tmp_results[i]) {
+      results[i].push_back(reinterpret_cast<ItemPointer *>(tid));
+    }
+  }
+}
+
 void ArtIndex::ScanRange(const storage::Tuple *start, const storage::Tuple *end,
                          std::vector<ItemPointer *> &result) {
   // Build boundary keys
   art::Key start_key, end_key;
-  ConstructArtKey(*start, start_key);
-  ConstructArtKey(*end, end_key);
+  key_constructor_.ConstructKey(*start, start_key);
+  key_constructor_.ConstructKey(*end, end_key, true);
 
   // Perform scan
   ScanRange(start_key, end_key, result);
@@ -160,22 +184,54 @@ void ArtIndex::Scan(
   }
 }
 
-void ArtIndex::ScanLimit(const std::vector<type::Value> &values,
-                         const std::vector<oid_t> &key_column_ids,
-                         const std::vector<ExpressionType> &expr_types,
-                         ScanDirectionType scan_direction,
-                         std::vector<ItemPointer *> &result,
-                         const ConjunctionScanPredicate *scan_predicate,
-                         uint64_t limit, uint64_t offset) {
-  (void)values;
-  (void)key_column_ids;
-  (void)expr_types;
-  (void)scan_direction;
-  (void)result;
-  (void)scan_predicate;
-  (void)limit;
-  (void)offset;
-  // This fucking function takes seven fucking arguments ... The fuck?
+void ArtIndex::ScanLimit(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &values,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &key_column_ids,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_types,
+    ScanDirectionType scan_direction, std::vector<ItemPointer *> &result,
+    const ConjunctionScanPredicate *scan_predicate, uint64_t limit,
+    uint64_t offset) {
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw IndexException("Invalid scan direction");
+  }
+
+  if (limit == 0) {
+    return;
+  }
+
+  // The tree only iterates in ascending key order. A forward scan can stop
+  // once it has seen offset + limit entries, a backward scan needs them all.
+  bool forward = (scan_direction == ScanDirectionType::FORWARD);
+  uint64_t max_results = std::numeric_limits<uint64_t>::max();
+  if (forward && limit <= max_results - offset) {
+    max_results = offset + limit;
+  }
+
+  std::vector<ItemPointer *> matches;
+  if (scan_predicate->IsPointQuery()) {
+    ScanKey(scan_predicate->GetPointQueryKey(), matches);
+  } else {
+    art::Key start_key, end_key;
+    if (scan_predicate->IsFullIndexScan()) {
+      key_constructor_.ConstructMinMaxKey(start_key, end_key);
+    } else {
+      key_constructor_.ConstructKey(*scan_predicate->GetLowKey(), start_key);
+      key_constructor_.ConstructKey(*scan_predicate->GetHighKey(), end_key,
+                                    true);
+    }
+    ScanRange(start_key, end_key, matches, max_results);
+  }
+
+  if (!forward) {
+    std::reverse(matches.begin(), matches.end());
+  }
+
+  if (offset < matches.size()) {
+    auto end = matches.size() - offset > limit ? offset + limit
+                                               : matches.size();
+    result.insert(result.end(), matches.begin() + offset,
+                  matches.begin() + end);
+  }
 }
 
 void ArtIndex::ScanAllKeys(std::vector<ItemPointer *> &result) {
@@ -201,23 +257,34 @@ void ArtIndex::ScanKey(const storage::Tuple *key,
 }
 
 void ArtIndex::ScanRange(const art::Key &start, const art::Key &end,
-                         std::vector<ItemPointer *> &result) {
+                         std::vector<ItemPointer *> &result,
+                         uint64_t max_results) {
   const uint32_t batch_size = 1000;
   std::vector<TID> tmp_result;
 
   art::Key start_key;
   start_key.setFrom(start);
 
+  uint64_t num_results = 0;
   bool has_more = true;
-  while (has_more) {
+  while (has_more && num_results < max_results) {
+    // Don't fetch many more entries than we were asked for
+    auto batch = static_cast<uint32_t>(
+        std::min<uint64_t>(batch_size, max_results - num_results));
+
     art::Key next_start_key;
     auto thread_info = container_.getThreadInfo();
     has_more = container_.lookupRange(start_key, end, next_start_key,
-                                      tmp_result, batch_size, thread_info);
+                                      tmp_result, batch, thread_info);
 
-    // Copy the results to the vector
+    // Copy the results to the vector. The batch size is a soft limit, leaves
+    // with many values may overshoot it.
     for (const auto &tid : tmp_result) {
+      if (num_results == max_results) {
+        break;
+      }
       result.push_back(reinterpret_cast<ItemPointer *>(tid));
+      num_results++;
     }
 
     // Set the next key
@@ -276,39 +343,127 @@ void ArtIndex::KeyConstructor::WriteValue(uint8_t *data, NativeType val) {
   *casted_data = ToBigEndian(FlipSign(val));
 }
 
-// This is specialized for ASCII strings ...
-void ArtIndex::KeyConstructor::WriteAsciiString(uint8_t *data, const char *val,
-                                                uint32_t len) {
-  // Write out the main payload, then tack on the NULL byte terminator
-  PELOTON_MEMCPY(data, val, len);
-  data[len] = '\0';
+void ArtIndex::KeyConstructor::WriteDouble(uint8_t *data, double val) {
+  // -0.0 and 0.0 are equal, so they must have the same bytes
+  if (val == 0) {
+    val = 0;
+  }
+
+  // Positive numbers get the sign bit set, so they sort after negative ones.
+  // Negative numbers get all bits flipped, so larger magnitudes sort first.
+  uint64_t bits;
+  PELOTON_MEMCPY(&bits, &val, sizeof(bits));
+  auto sign_mask = static_cast<uint64_t>(1) << 63;
+  bits = (bits & sign_mask) ? ~bits : (bits | sign_mask);
+
+  auto *casted_data = reinterpret_cast<uint64_t *>(data);
+  *casted_data = htobe64(bits);
+}
+
+uint32_t ArtIndex::KeyConstructor::GetStringLength(const char *val,
+                                                   uint32_t len) {
+  auto num_nuls = static_cast<uint32_t>(std::count(val, val + len, '\0'));
+  return len + num_nuls + 2;
+}
+
+// A NUL byte in the string is written as 0x00 0xFF, and the string ends with
+// 0x00 0x00. Since the terminator sorts below any escaped or regular byte, a
+// string sorts before all strings it is a prefix of, and no key is a prefix
+// of another key. The latter matters to the tree, which can't store a key
+// that ends inside another key's path.
+uint32_t ArtIndex::KeyConstructor::WriteString(uint8_t *data, const char *val,
+                                               uint32_t len) {
+  uint32_t offset = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    data[offset++] = static_cast<uint8_t>(val[i]);
+    if (val[i] == '\0') {
+      data[offset++] = 0xFF;
+    }
+  }
+  data[offset++] = 0x00;
+  data[offset++] = 0x00;
+  return offset;
+}
+
+namespace {
+
+// The byte preceding each column of a key. NULLs sort before all values.
+const uint8_t kNullColumn = 0x00;
+const uint8_t kValueColumn = 0x01;
+// Only used by upper bounds of range scans, sorts after all values
+const uint8_t kMaxColumn = 0x02;
+
+// Get the bytes of a VARCHAR or VARBINARY value. Varchars usually carry a NUL
+// terminator, which is not part of the string.
+void GetStringData(const type::Value &value, const char *&data,
+                   uint32_t &len) {
+  data = value.GetData();
+  len = value.GetLength();
+  if (len > 0 && data[len - 1] == '\0') {
+    len--;
+  }
 }
 
+}  // namespace
+
 // Constructing an ART tree key from a Peloton input key involves converting it
-// to a binary-comparable format. This method handles the conversion process.
-//   1. For fixed-width integral types, we need to flip the sign and convert to
+// to a binary-comparable format, i.e., one where comparing the bytes of two
+// keys with memcmp() orders them the same way as comparing their values column
+// by column. Every column starts with a byte telling whether it is NULL, which
+// sorts NULLs first. Non-NULL values follow it:
+//   1. For fixed-width integral types, we flip the sign and convert to
 //      big-endian format. If the host system is big-endian, the conversion is
-//      elided entirely.
-//   2. For variable length strings, we write out the string and append a NULL
-//      byte indicating the end of the string. The assumption is that NULL
-//      cannot appear in normal strings. True for ASCII, not so for UTF-8.
-//      TODO(pmenon): For UTF-8 strings, we need a third-party library to
-//      generate sort-able text from UTF-8 string.
-//   3. Floats/doubles are more complicated, not done here.
-//   4. NULL is handled using special values.
+//      elided entirely. Timestamps are unsigned, so they are only converted.
+//   2. For decimals, we order the IEEE-754 bits as described in WriteDouble().
+//   3. For variable length strings, we write out the string with its NUL
+//      bytes escaped, followed by a terminator (see WriteString()). Every
+//      column thus knows where it ends, so multi-column keys compare column by
+//      column. Strings compare as bytes, like VARCHAR values do.
 void ArtIndex::KeyConstructor::ConstructKey(const AbstractTuple &input_key,
-                                            art::Key &tree_key) const {
+                                            art::Key &tree_key,
+                                            bool upper_bound) const {
   // First calculate length of this key
   uint32_t key_len = 0;
   for (uint32_t i = 0; i < key_schema_.GetColumnCount(); i++) {
-    auto col_info = key_schema_.GetColumn(i);
-    if (col_info.IsInlined()) {
-      key_len += col_info.GetFixedLength();
-    } else {
-      key_len += input_key.GetValue(i).GetLength();
-      if (col_info.GetType() == type::TypeId::VARCHAR) {
-        // Need to append NULL character
-        key_len++;
+    // The NULL indicator
+    key_len++;
+
+    auto value = input_key.GetValue(i);
+    if (value.IsNull()) {
+      continue;
+    }
+    auto column_type = key_schema_.GetColumn(i).GetType();
+    switch (column_type) {
+      case type::TypeId::BOOLEAN:
+      case type::TypeId::TINYINT:
+        key_len += sizeof(int8_t);
+        break;
+      case type::TypeId::SMALLINT:
+        key_len += sizeof(int16_t);
+        break;
+      case type::TypeId::DATE:
+      case type::TypeId::INTEGER:
+        key_len += sizeof(int32_t);
+        break;
+      case type::TypeId::TIMESTAMP:
+      case type::TypeId::BIGINT:
+      case type::TypeId::DECIMAL:
+        key_len += sizeof(int64_t);
+        break;
+      case type::TypeId::VARCHAR:
+      case type::TypeId::VARBINARY: {
+        const char *raw;
+        uint32_t raw_len;
+        GetStringData(value, raw, raw_len);
+        key_len += GetStringLength(raw, raw_len);
+        break;
+      }
+      default: {
+        auto error =
+            StringUtil::Format("Column type '%s' not supported in ART index",
+                               TypeIdToString(column_type).c_str());
+        LOG_ERROR("%s", error.c_str());
+        throw IndexException{error};
       }
     }
   }
@@ -319,59 +474,84 @@ void ArtIndex::KeyConstructor::ConstructKey(const AbstractTuple &input_key,
 
   uint32_t offset = 0;
   for (uint32_t i = 0; i < key_schema_.GetColumnCount(); i++) {
-    auto column = key_schema_.GetColumn(i);
-    switch (column.GetType()) {
-      case type::TypeId::BOOLEAN:
+    auto value = input_key.GetValue(i);
+    if (value.IsNull()) {
+      data[offset++] = (upper_bound ? kMaxColumn : kNullColumn);
+      continue;
+    }
+    data[offset++] = kValueColumn;
+
+    switch (key_schema_.GetColumn(i).GetType()) {
+      case type::TypeId::BOOLEAN: {
+        data[offset] = type::ValuePeeker::PeekBoolean(value) ? 1 : 0;
+        offset += sizeof(int8_t);
+        break;
+      }
       case type::TypeId::TINYINT: {
-        auto raw = type::ValuePeeker::PeekTinyInt(input_key.GetValue(i));
+        auto raw = type::ValuePeeker::PeekTinyInt(value);
         WriteValue<int8_t>(data + offset, raw);
         offset += sizeof(int8_t);
         break;
       }
       case type::TypeId::SMALLINT: {
-        auto raw = type::ValuePeeker::PeekSmallInt(input_key.GetValue(i));
+        auto raw = type::ValuePeeker::PeekSmallInt(value);
         WriteValue<int16_t>(data + offset, raw);
         offset += sizeof(int16_t);
         break;
       }
-      case type::TypeId::DATE:
+      case type::TypeId::DATE: {
+        auto raw = type::ValuePeeker::PeekDate(value);
+        WriteValue<int32_t>(data + offset, raw);
+        offset += sizeof(int32_t);
+        break;
+      }
       case type::TypeId::INTEGER: {
-        auto raw = type::ValuePeeker::PeekInteger(input_key.GetValue(i));
+        auto raw = type::ValuePeeker::PeekInteger(value);
         WriteValue<int32_t>(data + offset, raw);
         offset += sizeof(int32_t);
         break;
       }
-      case type::TypeId::TIMESTAMP:
+      case type::TypeId::TIMESTAMP: {
+        auto raw = type::ValuePeeker::PeekTimestamp(value);
+        auto *casted_data = reinterpret_cast<uint64_t *>(data + offset);
+        *casted_data = htobe64(raw);
+        offset += sizeof(uint64_t);
+        break;
+      }
       case type::TypeId::BIGINT: {
-        auto raw = type::ValuePeeker::PeekBigInt(input_key.GetValue(i));
+        auto raw = type::ValuePeeker::PeekBigInt(value);
         WriteValue<int64_t>(data + offset, raw);
         offset += sizeof(int64_t);
         break;
       }
-      case type::TypeId::VARCHAR: {
-        auto varchar_val = input_key.GetValue(i);
-        auto raw = type::ValuePeeker::PeekVarchar(varchar_val);
-        auto raw_len = varchar_val.GetLength();
-        WriteAsciiString(data + offset, raw, raw_len);
-        offset += raw_len;
+      case type::TypeId::DECIMAL: {
+        WriteDouble(data + offset, type::ValuePeeker::PeekDouble(value));
+        offset += sizeof(double);
         break;
       }
-      default: {
-        auto error =
-            StringUtil::Format("Column type '%s' not supported in ART index",
-                               TypeIdToString(column.GetType()).c_str());
-        LOG_ERROR("%s", error.c_str());
-        throw IndexException{error};
+      case type::TypeId::VARCHAR:
+      case type::TypeId::VARBINARY: {
+        const char *raw;
+        uint32_t raw_len;
+        GetStringData(value, raw, raw_len);
+        offset += WriteString(data + offset, raw, raw_len);
+        break;
       }
+      default:
+        // Rejected when computing the length
+        break;
     }
   }
+  PELOTON_ASSERT(offset == key_len);
 }
 
+// Every key starts with the NULL indicator of its first column, which is
+// never larger than kMaxColumn
 void ArtIndex::KeyConstructor::ConstructMinMaxKey(art::Key &min_key,
                                                   art::Key &max_key) const {
   min_key.setKeyLen(1);
   max_key.setKeyLen(1);
-  min_key[0] = 0u;
+  min_key[0] = kNullColumn;
   max_key[0] = 255u;
 }
 
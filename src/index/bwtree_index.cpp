@@ -12,6 +12,10 @@
 
 #include "index/bwtree_index.h"
 
+#include <algorithm>
+#include <deque>
+#include <limits>
+
 #include "index/index_key.h"
 #include "index/scan_optimizer.h"
 #include "statistics/stats_aggregator.h"
@@ -33,14 +37,20 @@ BWTREE_INDEX_TYPE::BWTreeIndex(IndexMetadata *metadata)
       // NOTE: These two arguments need to be constructed in advance
       // and do not have trivial constructor
       //
-      // NOTE 2: We set the first parameter to false to disable automatic GC
+      // NOTE 2: We set the first parameter to false to disable the GC
+      // thread of the tree. Retired nodes are freed by the GC manager
+      // instead, which collects registered indexes as the epoch advances
       //
       container{false, comparator, equals, hash_func} {
+  RegisterForGC();
   return;
 }
-        
+
 BWTREE_TEMPLATE_ARGUMENTS
-BWTREE_INDEX_TYPE::~BWTreeIndex() {}
+BWTREE_INDEX_TYPE::~BWTreeIndex() {
+  // The GC manager must be done with the tree before it goes away
+  DeregisterFromGC();
+}
 
 /*
  * InsertEntry() - insert a key-value pair into the map
@@ -213,45 +223,120 @@ void BWTREE_INDEX_TYPE::Scan(
  *
  * This function scans the index using the given index optimizer's low key and
  * high key. In addition to merely doing the scan, it checks scan direction
- * and uses either begin() or end() iterator to scan the index, and stops
- * after offset + limit elements are scanned, and limit elements are finally
- * returned
+ * and either iterates forward from the low key or backward from the high key,
+ * and stops after offset + limit elements are scanned, and limit elements are
+ * finally returned. Backward scans return elements in descending key order.
+ *
+ * Like Scan(), elements are only checked against the closed scan interval,
+ * so open boundaries and non-optimizable predicates are left to the caller
  */
 BWTREE_TEMPLATE_ARGUMENTS
 void BWTREE_INDEX_TYPE::ScanLimit(
-    const std::vector<type::Value> &value_list,
-    const std::vector<oid_t> &tuple_column_id_list,
-    const std::vector<ExpressionType> &expr_list,
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
     ScanDirectionType scan_direction, std::vector<ValueType> &result,
     const ConjunctionScanPredicate *csp_p, uint64_t limit, uint64_t offset) {
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
 
-  // Only work with limit == 1 and offset == 0
-  // Because that gets translated to "min"
-  // But still since we could not access tuples in the table
-  // the index just fetches the first qualified key without further checking
-  // including checking for non-exact bounds!!!
-  if (csp_p->IsPointQuery() == false && limit == 1 && offset == 0 &&
-      scan_direction == ScanDirectionType::FORWARD) {
-    const storage::Tuple *low_key_p = csp_p->GetLowKey();
-    const storage::Tuple *high_key_p = csp_p->GetHighKey();
+  if (limit == 0) {
+    return;
+  }
 
-    LOG_TRACE("ScanLimit() special case (limit = 1; offset = 0; ASCENDING): %s",
-              low_key_p->GetInfo().c_str());
+  bool forward = (scan_direction == ScanDirectionType::FORWARD);
 
-    KeyType index_low_key;
-    KeyType index_high_key;
-    index_low_key.SetFromKey(low_key_p);
-    index_high_key.SetFromKey(high_key_p);
+  // Number of elements to scan before stopping
+  uint64_t scan_count = offset + limit;
+  if (scan_count < offset) {
+    scan_count = std::numeric_limits<uint64_t>::max();
+  }
 
-    auto scan_itr = container.Begin(index_low_key);
-    if ((scan_itr.IsEnd() == false) &&
-        (container.KeyCmpLessEqual(scan_itr->first, index_high_key))) {
+  // Skips the first offset elements, and returns false once the last
+  // element to scan has been seen
+  uint64_t scanned = 0;
+  auto collect = [&result, &scanned, offset, scan_count](
+      const ValueType &value) {
+    if (scanned++ >= offset) {
+      result.push_back(value);
+    }
+    return scanned < scan_count;
+  };
 
-      result.push_back(scan_itr->second);
+  LOG_TRACE("ScanLimit() Point Query = %d; Full Scan = %d; Forward = %d",
+            csp_p->IsPointQuery(), csp_p->IsFullIndexScan(), forward);
+
+  if (csp_p->IsPointQuery() == true) {
+    KeyType point_query_key;
+    point_query_key.SetFromKey(csp_p->GetPointQueryKey());
+
+    std::vector<ValueType> values;
+    container.GetValue(point_query_key, values);
+    if (forward == false) {
+      std::reverse(values.begin(), values.end());
+    }
+    for (const auto &value : values) {
+      if (collect(value) == false) {
+        break;
+      }
+    }
+  } else if (csp_p->IsFullIndexScan() == true) {
+    if (forward == true) {
+      auto scan_itr = container.Begin();
+      while ((scan_itr.IsEnd() == false) && collect(scan_itr->second)) {
+        scan_itr++;
+      }
+    } else {
+      // Without a high key there is nothing to position an iterator on the
+      // last element with, so we only keep the window of the last
+      // offset + limit elements
+      std::deque<ValueType> window;
+      for (auto scan_itr = container.Begin(); scan_itr.IsEnd() == false;
+           scan_itr++) {
+        window.push_back(scan_itr->second);
+        if (window.size() > scan_count) {
+          window.pop_front();
+        }
+      }
+      auto window_itr = window.rbegin();
+      while ((window_itr != window.rend()) && collect(*window_itr)) {
+        window_itr++;
+      }
     }
   } else {
-    Scan(value_list, tuple_column_id_list, expr_list, scan_direction, result,
-         csp_p);
+    KeyType index_low_key;
+    KeyType index_high_key;
+    index_low_key.SetFromKey(csp_p->GetLowKey());
+    index_high_key.SetFromKey(csp_p->GetHighKey());
+
+    if (forward == true) {
+      auto scan_itr = container.Begin(index_low_key);
+      while ((scan_itr.IsEnd() == false) &&
+             container.KeyCmpLessEqual(scan_itr->first, index_high_key) &&
+             collect(scan_itr->second)) {
+        scan_itr++;
+      }
+    } else {
+      // Step over the elements equal to the high key, then walk back from
+      // the last element that is not greater than it
+      auto scan_itr = container.Begin(index_high_key);
+      while ((scan_itr.IsEnd() == false) &&
+             container.KeyCmpLessEqual(scan_itr->first, index_high_key)) {
+        scan_itr++;
+      }
+      scan_itr--;
+      while ((scan_itr.IsREnd() == false) &&
+             container.KeyCmpGreaterEqual(scan_itr->first, index_low_key) &&
+             collect(scan_itr->second)) {
+        scan_itr--;
+      }
+    }
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
   }
 
   return;
@@ -291,6 +376,67 @@ void BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
   return;
 }
 
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::ScanKeyBatch(
+    const std::vector<const storage::Tuple *> &keys,
+    std::vector<std::vector<ValueType>> &results) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+  }
+
+  results.resize(keys.size());
+  container.GetValueBatch(index_keys.data(), index_keys.size(),
+                          results.data());
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    size_t result_count = 0;
+    for (const auto &result : results) {
+      result_count += result.size();
+    }
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result_count, metadata);
+  }
+
+  return;
+}
+
+/*
+ * BulkLoad() - Build the tree bottom-up if it is still empty
+ *
+ * Entries come sorted by the values of their key tuples, which should agree
+ * with the order of the index keys. We verify this, since the tree relies on
+ * it, and sort again with the key comparator if it does not hold.
+ *
+ * Returns false without changing the tree if it is not empty
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::BulkLoad(
+    const std::vector<std::pair<const storage::Tuple *, ValueType>> &entries) {
+  std::vector<std::pair<KeyType, ValueType>> items(entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    items[i].first.SetFromKey(entries[i].first);
+    items[i].second = entries[i].second;
+  }
+
+  auto key_less = [this](const std::pair<KeyType, ValueType> &lhs,
+                         const std::pair<KeyType, ValueType> &rhs) {
+    return container.KeyCmpLess(lhs.first, rhs.first);
+  };
+  if (std::is_sorted(items.begin(), items.end(), key_less) == false) {
+    std::stable_sort(items.begin(), items.end(), key_less);
+  }
+
+  if (container.BulkLoad(items) == false) {
+    // Someone got to insert first
+    return false;
+  }
+
+  LOG_TRACE("BulkLoad(%lu entries) [SUCCESS]", items.size());
+
+  return true;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
 
@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// covering_payload_store.cpp
+//
+// Identification: src/index/covering_payload_store.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "index/covering_payload_store.h"
+
+#include <sstream>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "index/index.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace index {
+
+namespace {
+
+// Values read from a tile point into tile storage, so we take a private copy
+// of variable-length data before holding on to it
+type::Value CopyValue(const type::Value &value) {
+  if (value.IsNull()) {
+    return value;
+  }
+  switch (value.GetTypeId()) {
+    case type::TypeId::VARCHAR:
+      return type::ValueFactory::GetVarcharValue(value.GetData(),
+                                                 value.GetLength(), true);
+    case type::TypeId::VARBINARY:
+      return type::ValueFactory::GetVarbinaryValue(
+          reinterpret_cast<const unsigned char *>(value.GetData()),
+          value.GetLength(), true);
+    default:
+      return value;
+  }
+}
+
+}  // namespace
+
+//===----------------------------------------------------------------------===//
+// CoveringPayloadStore
+//===----------------------------------------------------------------------===//
+
+CoveringPayloadStore::CoveringPayloadStore(const IndexMetadata *metadata)
+    : column_ids_(metadata->GetKeyAttrs()),
+      positions_(metadata->GetTupleSchema()->GetColumnCount(), INVALID_OID) {
+  for (oid_t column_id : metadata->GetIncludeAttrs()) {
+    column_ids_.push_back(column_id);
+  }
+  for (oid_t i = 0; i < column_ids_.size(); i++) {
+    PELOTON_ASSERT(column_ids_[i] < positions_.size());
+    // A column listed twice is read from its first position
+    if (positions_[column_ids_[i]] == INVALID_OID) {
+      positions_[column_ids_[i]] = i;
+    }
+  }
+}
+
+bool CoveringPayloadStore::CoversColumns(
+    const std::vector<oid_t> &column_ids) const {
+  for (oid_t column_id : column_ids) {
+    if (GetPosition(column_id) == INVALID_OID) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CoveringPayloadStore::Put(const ItemPointer *indirection,
+                               const ItemPointer &location, cid_t begin_cid,
+                               const AbstractTuple &tuple) {
+  std::shared_ptr<CoveringPayload> payload(new CoveringPayload());
+  payload->location = location;
+  payload->begin_cid = begin_cid;
+  payload->values.reserve(column_ids_.size());
+  for (oid_t column_id : column_ids_) {
+    payload->values.push_back(CopyValue(tuple.GetValue(column_id)));
+  }
+  payloads_.Upsert(GetKey(indirection), std::move(payload));
+}
+
+std::shared_ptr<const CoveringPayload> CoveringPayloadStore::Get(
+    const ItemPointer *indirection, const ItemPointer &location,
+    cid_t begin_cid) const {
+  std::shared_ptr<const CoveringPayload> payload;
+  if (payloads_.Find(GetKey(indirection), payload) == false ||
+      !(payload->location == location) || payload->begin_cid != begin_cid) {
+    return nullptr;
+  }
+  return payload;
+}
+
+void CoveringPayloadStore::Erase(const ItemPointer *indirection) {
+  payloads_.Erase(GetKey(indirection));
+}
+
+//===----------------------------------------------------------------------===//
+// CoveringTuple
+//===----------------------------------------------------------------------===//
+
+type::Value CoveringTuple::GetValue(oid_t column_id) const {
+  oid_t position = store_.GetPosition(column_id);
+  PELOTON_ASSERT(position != INVALID_OID);
+  return payload_->values[position];
+}
+
+void CoveringTuple::SetValue(UNUSED_ATTRIBUTE oid_t column_id,
+                             UNUSED_ATTRIBUTE const type::Value &value) {
+  throw NotImplementedException("Covering index payloads are read-only");
+}
+
+const std::string CoveringTuple::GetInfo() const {
+  std::stringstream os;
+  os << "CoveringTuple(" << payload_->location.block << ", "
+     << payload_->location.offset << ") (";
+  for (oid_t i = 0; i < payload_->values.size(); i++) {
+    os << (i > 0 ? ", " : "") << payload_->values[i].GetInfo();
+  }
+  os << ")";
+  return os.str();
+}
+
+}  // namespace index
+}  // namespace peloton
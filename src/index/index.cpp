@@ -11,12 +11,19 @@
 
 #include "index/index.h"
 
+#include <algorithm>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
 
 #include "catalog/manager.h"
 #include "catalog/schema.h"
+#include "expression/abstract_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "index/covering_payload_store.h"
 #include "index/scan_optimizer.h"
 #include "settings/settings_manager.h"
+#include "storage/tuple.h"
 #include "type/ephemeral_pool.h"
 
 namespace peloton {
@@ -24,6 +31,38 @@ namespace index {
 
 bool IndexMetadata::index_default_visibility = true;
 
+namespace {
+
+// Indexes collected by Index::PerformRegisteredGC()
+struct GCRegistry {
+  common::synchronization::SpinLatch latch;
+  std::unordered_set<Index *> indexes;
+};
+
+GCRegistry &GetGCRegistry() {
+  static GCRegistry registry;
+  return registry;
+}
+
+// Collects the base table columns read by the given expression
+void GetColumnIds(const expression::AbstractExpression *expr,
+                  std::vector<oid_t> &column_ids) {
+  for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+    GetColumnIds(expr->GetChild(i), column_ids);
+  }
+  if (expr->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    auto column_id = static_cast<oid_t>(
+        static_cast<const expression::TupleValueExpression *>(expr)
+            ->GetColumnId());
+    if (std::find(column_ids.begin(), column_ids.end(), column_id) ==
+        column_ids.end()) {
+      column_ids.push_back(column_id);
+    }
+  }
+}
+
+}  // namespace
+
 // Returns the number of indexed columns. Please note that this returns the
 // column count of columns in the base table that are indexed, i.e. not the
 // column count of the base table
@@ -45,7 +84,9 @@ IndexMetadata::IndexMetadata(std::string index_name, oid_t index_oid,
                              const catalog::Schema *tuple_schema,
                              const catalog::Schema *key_schema,
                              const std::vector<oid_t> &key_attrs,
-                             bool unique_keys)
+                             bool unique_keys,
+                             const std::vector<oid_t> &include_attrs,
+                             const expression::AbstractExpression *predicate)
     : name_(index_name),
       index_oid(index_oid),
       table_oid(table_oid),
@@ -56,6 +97,8 @@ IndexMetadata::IndexMetadata(std::string index_name, oid_t index_oid,
       key_schema(key_schema),
       key_attrs(key_attrs),
       tuple_attrs(),
+      include_attrs(include_attrs),
+      predicate(predicate == nullptr ? nullptr : predicate->Copy()),
       unique_keys(unique_keys),
       visible_(IndexMetadata::index_default_visibility) {
   // Push the reverse mapping relation into tuple_attrs which maps
@@ -75,6 +118,10 @@ IndexMetadata::IndexMetadata(std::string index_name, oid_t index_oid,
     tuple_attrs[tuple_column_id] = i;
   }
 
+  if (predicate != nullptr) {
+    GetColumnIds(this->predicate.get(), predicate_attrs);
+  }
+
   // Just in case somebody forgets they set our flag to default and
   // was wondering why there indexes weren't working...
   if (visible_ == false) {
@@ -95,6 +142,15 @@ IndexMetadata::~IndexMetadata() {
   return;
 }
 
+// A tuple for which the predicate is NULL is not indexed, as in a WHERE clause
+bool IndexMetadata::IndexesTuple(const AbstractTuple *tuple) const {
+  if (predicate == nullptr) {
+    return true;
+  }
+  type::Value result = predicate->Evaluate(tuple, nullptr, nullptr);
+  return result.IsNull() == false && result.IsTrue();
+}
+
 const std::string IndexMetadata::GetInfo() const {
   std::stringstream os;
 
@@ -105,7 +161,18 @@ const std::string IndexMetadata::GetInfo() const {
      << "ConstraintType=" << IndexConstraintTypeToString(index_constraint_type_)
      << ", "
      << "UtilityRatio=" << utility_ratio << ", "
-     << "Visible=" << visible_ << "]";
+     << "Visible=" << visible_;
+  if (include_attrs.empty() == false) {
+    os << ", Include=(";
+    for (oid_t i = 0; i < include_attrs.size(); i++) {
+      os << (i > 0 ? "," : "") << include_attrs[i];
+    }
+    os << ")";
+  }
+  if (predicate != nullptr) {
+    os << ", Predicate=" << predicate->GetInfo();
+  }
+  os << "]";
 
   os << " -> " << key_schema->GetInfo();
 
@@ -130,9 +197,42 @@ Index::Index(IndexMetadata *metadata)
   // initialize pool
   pool = new type::EphemeralPool();
 
+  // Covering indexes keep the key and INCLUDE columns of the entries
+  if (metadata->GetIncludeAttrs().empty() == false) {
+    payload_store.reset(new CoveringPayloadStore(metadata));
+  }
+
   return;
 }
 
+void Index::PerformRegisteredGC() {
+  auto &registry = GetGCRegistry();
+  if (registry.latch.TryLock() == false) {
+    return;
+  }
+  for (auto *index : registry.indexes) {
+    if (index->NeedGC() == true) {
+      index->PerformGC();
+    }
+  }
+  registry.latch.Unlock();
+}
+
+void Index::RegisterForGC() {
+  auto &registry = GetGCRegistry();
+  registry.latch.Lock();
+  registry.indexes.insert(this);
+  registry.latch.Unlock();
+}
+
+// This waits for a round that is running, which may still use this index
+void Index::DeregisterFromGC() {
+  auto &registry = GetGCRegistry();
+  registry.latch.Lock();
+  registry.indexes.erase(this);
+  registry.latch.Unlock();
+}
+
 Index::~Index() {
   // Free metadata which frees the key schema but not tuple schema
   // This is passed in as construction argument but Index object is
@@ -187,6 +287,100 @@ void Index::ScanTest(const std::vector<type::Value> &value_list,
   return;
 }
 
+void Index::ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                         std::vector<std::vector<ItemPointer *>> &results) {
+  results.resize(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    ScanKey(keys[i], results[i]);
+  }
+}
+
+bool Index::BulkLoad(
+    UNUSED_ATTRIBUTE const std::vector<
+        std::pair<const storage::Tuple *, ItemPointer *>> &entries) {
+  return false;
+}
+
+bool Index::InsertEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+        &entries) {
+  bool ret = true;
+  for (const auto &entry : entries) {
+    if (InsertEntry(entry.first, entry.second) == true) {
+      continue;
+    }
+
+    // A concurrent insert may have added the pair already
+    std::vector<ItemPointer *> values;
+    ScanKey(entry.first, values);
+    if (std::find(values.begin(), values.end(), entry.second) ==
+        values.end()) {
+      ret = false;
+    }
+  }
+  return ret;
+}
+
+bool Index::InsertOrLogEntry(const storage::Tuple *key, ItemPointer *value) {
+  // This pairs with StartBuild(): either the build sees this insert running,
+  // or this insert sees the build
+  active_inserts.fetch_add(1);
+
+  bool logged = false;
+  if (building.load() == true) {
+    // The key may live in a temporary tuple, so the log keeps a copy whose
+    // varlen data goes to the pool of the index
+    std::unique_ptr<storage::Tuple> log_key(
+        new storage::Tuple(GetKeySchema(), true));
+    log_key->Copy(key->GetData(), pool);
+
+    // The build may have drained the log for the last time in the meantime
+    build_log_latch.Lock();
+    if (building.load() == true) {
+      build_log.emplace_back(std::move(log_key), value);
+      logged = true;
+    }
+    build_log_latch.Unlock();
+  }
+
+  bool ret = logged || InsertEntry(key, value);
+
+  active_inserts.fetch_sub(1);
+  return ret;
+}
+
+void Index::StartBuild() {
+  building.store(true);
+
+  // Inserts that started before the flag was set may still be writing to the
+  // index directly
+  while (active_inserts.load() != 0) {
+    std::this_thread::yield();
+  }
+}
+
+void Index::FinishBuild() {
+  // Drain the log in batches, so that concurrent inserts only wait for the
+  // latch while a batch is taken out. Logging stops once the log is empty.
+  while (true) {
+    std::vector<std::pair<std::unique_ptr<storage::Tuple>, ItemPointer *>>
+        batch;
+
+    build_log_latch.Lock();
+    if (build_log.empty()) {
+      building.store(false);
+      build_log_latch.Unlock();
+      break;
+    }
+    batch.swap(build_log);
+    build_log_latch.Unlock();
+
+    for (const auto &entry : batch) {
+      InsertEntry(entry.first.get(), entry.second);
+    }
+  }
+}
+
 // Check whether a given index key satisfies a predicate. The predicate has the
 // same specification as those in Scan()
 bool Index::Compare(const AbstractTuple &index_key,
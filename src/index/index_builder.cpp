@@ -0,0 +1,261 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_builder.cpp
+//
+// Identification: src/index/index_builder.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "index/index_builder.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "catalog/schema.h"
+#include "common/container_tuple.h"
+#include "common/logger.h"
+#include "common/synchronization/count_down_latch.h"
+#include "common/timer.h"
+#include "index/index.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "threadpool/mono_queue_pool.h"
+#include "type/ephemeral_pool.h"
+
+namespace peloton {
+namespace index {
+
+namespace {
+
+// Orders key tuples column by column. Value comparisons involving NULL are
+// neither true nor false, so NULLs are ordered first explicitly.
+int CompareKeys(const storage::Tuple &lhs, const storage::Tuple &rhs) {
+  for (oid_t column_id = 0; column_id < lhs.GetColumnCount(); column_id++) {
+    type::Value lhs_value = lhs.GetValue(column_id);
+    type::Value rhs_value = rhs.GetValue(column_id);
+    if (lhs_value.IsNull() || rhs_value.IsNull()) {
+      if (lhs_value.IsNull() != rhs_value.IsNull()) {
+        return lhs_value.IsNull() ? -1 : 1;
+      }
+      continue;
+    }
+    if (lhs_value.CompareLessThan(rhs_value) == CmpBool::CmpTrue) {
+      return -1;
+    }
+    if (lhs_value.CompareGreaterThan(rhs_value) == CmpBool::CmpTrue) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+bool HasNull(const storage::Tuple &key) {
+  for (oid_t column_id = 0; column_id < key.GetColumnCount(); column_id++) {
+    if (key.IsNull(column_id)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Entries with equal keys are ordered by their values, to make the build
+// deterministic
+bool EntryLess(const std::pair<const storage::Tuple *, ItemPointer *> &lhs,
+               const std::pair<const storage::Tuple *, ItemPointer *> &rhs) {
+  int cmp = CompareKeys(*lhs.first, *rhs.first);
+  return cmp < 0 ||
+         (cmp == 0 && std::less<ItemPointer *>()(lhs.second, rhs.second));
+}
+
+}  // namespace
+
+IndexBuilder::IndexBuilder(storage::DataTable *table, Index *index)
+    : table_(table), index_(index) {}
+
+IndexBuilder::~IndexBuilder() {}
+
+bool IndexBuilder::Build() {
+  bool online = (index_->HasUniqueKeys() == false);
+  if (online) {
+    index_->StartBuild();
+  }
+
+  Timer<std::milli> timer;
+  timer.Start();
+
+  ScanTable();
+  std::vector<Entry> entries = MergeRuns();
+
+  // Two versions of a tuple with the same key make the same entry
+  entries.erase(std::unique(entries.begin(), entries.end(),
+                            [](const Entry &lhs, const Entry &rhs) {
+                              return lhs.second == rhs.second &&
+                                     CompareKeys(*lhs.first, *rhs.first) == 0;
+                            }),
+                entries.end());
+
+  timer.Stop();
+  LOG_DEBUG("Index %s: scanned and sorted %lu keys (%.2lf ms)",
+            index_->GetName().c_str(), entries.size(), timer.GetDuration());
+
+  // Equal keys next to each other now belong to different tuples. SQL allows
+  // those if a key is NULL.
+  bool ret = true;
+  if (index_->HasUniqueKeys()) {
+    for (size_t i = 1; i < entries.size(); i++) {
+      if (CompareKeys(*entries[i - 1].first, *entries[i].first) == 0 &&
+          HasNull(*entries[i].first) == false) {
+        LOG_TRACE("Index %s: duplicate key %s", index_->GetName().c_str(),
+                  entries[i].first->GetInfo().c_str());
+        ret = false;
+        break;
+      }
+    }
+  }
+
+  // Inserts that reached the index before the build started keep it from
+  // being built bottom-up
+  if (ret == true && index_->BulkLoad(entries) == false) {
+    ret = index_->InsertEntries(entries);
+  }
+
+  if (online) {
+    index_->FinishBuild();
+  }
+
+  runs_.clear();
+  return ret;
+}
+
+void IndexBuilder::ScanTable() {
+  auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+
+  auto tile_group_count = static_cast<oid_t>(table_->GetTileGroupCount());
+  size_t num_tasks = std::max<size_t>(
+      1, std::min<size_t>(work_pool.NumWorkers(), tile_group_count));
+
+  runs_.clear();
+  runs_.resize(num_tasks);
+
+  common::synchronization::CountDownLatch latch{num_tasks};
+  for (size_t task_id = 0; task_id < num_tasks; task_id++) {
+    auto begin = static_cast<oid_t>(task_id * tile_group_count / num_tasks);
+    auto end = static_cast<oid_t>((task_id + 1) * tile_group_count / num_tasks);
+    work_pool.SubmitTask([this, &latch, task_id, begin, end] {
+      ScanTileGroups(begin, end, runs_[task_id]);
+      latch.CountDown();
+    });
+  }
+  latch.Await(0);
+}
+
+bool IndexBuilder::IsLatestVersion(
+    const storage::TileGroupHeader *tile_group_header, oid_t tuple_id) {
+  txn_id_t txn_id = tile_group_header->GetTransactionId(tuple_id);
+  cid_t begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+  cid_t end_cid = tile_group_header->GetEndCommitId(tuple_id);
+
+  // A free slot, an aborted version, or the empty version of a delete
+  if (txn_id == INVALID_TXN_ID) {
+    return false;
+  }
+  // An uncommitted insert or update, unless it is the empty version of an
+  // uncommitted delete
+  if (begin_cid == MAX_CID) {
+    return end_cid != INVALID_CID;
+  }
+  // A committed version that no committed update or delete replaced
+  return end_cid == MAX_CID;
+}
+
+void IndexBuilder::ScanTileGroups(oid_t begin, oid_t end, Run &run) const {
+  const catalog::Schema *key_schema = index_->GetKeySchema();
+  const std::vector<oid_t> &indexed_columns = key_schema->GetIndexedColumns();
+  const IndexMetadata *metadata = index_->GetMetadata();
+
+  // A pool per task, so that tasks do not contend for its latch
+  run.pool.reset(new type::EphemeralPool());
+
+  for (oid_t offset = begin; offset < end; offset++) {
+    auto tile_group = table_->GetTileGroup(offset);
+    if (tile_group == nullptr) {
+      continue;
+    }
+    auto tile_group_header = tile_group->GetHeader();
+
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (IsLatestVersion(tile_group_header, tuple_id) == false) {
+        continue;
+      }
+
+      // A partial index skips the tuples failing its predicate
+      ContainerTuple<storage::TileGroup> tuple(tile_group.get(), tuple_id);
+      if (metadata->IndexesTuple(&tuple) == false) {
+        continue;
+      }
+
+      std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+      key->SetFromTuple(&tuple, indexed_columns, run.pool.get());
+
+      run.entries.emplace_back(key.get(),
+                               tile_group_header->GetIndirection(tuple_id));
+      run.keys.push_back(std::move(key));
+    }
+  }
+
+  std::sort(run.entries.begin(), run.entries.end(), EntryLess);
+}
+
+std::vector<IndexBuilder::Entry> IndexBuilder::MergeRuns() {
+  auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+
+  std::vector<std::vector<Entry>> lists;
+  for (auto &run : runs_) {
+    lists.push_back(std::move(run.entries));
+  }
+
+  // Merge neighbouring lists in parallel until a single one is left
+  while (lists.size() > 1) {
+    size_t num_merges = lists.size() / 2;
+    std::vector<std::vector<Entry>> merged(lists.size() - num_merges);
+
+    common::synchronization::CountDownLatch latch{num_merges};
+    for (size_t i = 0; i < num_merges; i++) {
+      work_pool.SubmitTask([&lists, &merged, &latch, i] {
+        auto &lhs = lists[2 * i];
+        auto &rhs = lists[2 * i + 1];
+        merged[i].resize(lhs.size() + rhs.size());
+        std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                   merged[i].begin(), EntryLess);
+
+        // Free the inputs right away
+        std::vector<Entry>().swap(lhs);
+        std::vector<Entry>().swap(rhs);
+        latch.CountDown();
+      });
+    }
+
+    // An odd list out moves up unchanged
+    if (lists.size() % 2 == 1) {
+      merged.back() = std::move(lists.back());
+    }
+    latch.Await(0);
+
+    lists.swap(merged);
+  }
+
+  if (lists.empty()) {
+    return {};
+  }
+  return std::move(lists[0]);
+}
+
+}  // namespace index
+}  // namespace peloton
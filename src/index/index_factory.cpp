@@ -18,6 +18,7 @@
 #include "common/macros.h"
 #include "index/art_index.h"
 #include "index/bwtree_index.h"
+#include "index/hash_index.h"
 #include "index/index_key.h"
 #include "index/skiplist_index.h"
 
@@ -77,6 +78,16 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
       index = IndexFactory::GetSkipListGenericKeyIndex(metadata);
     }
 
+    // -----------------------
+    // HASH
+    // -----------------------
+  } else if (index_type == IndexType::HASH) {
+    if (ints_only) {
+      index = IndexFactory::GetHashIntsKeyIndex(metadata);
+    } else {
+      index = IndexFactory::GetHashGenericKeyIndex(metadata);
+    }
+
     // -----------------------
     // Art
     // -----------------------
@@ -353,6 +364,120 @@ Index *IndexFactory::GetSkipListGenericKeyIndex(IndexMetadata *metadata) {
   return index;
 }
 
+Index *IndexFactory::GetHashIntsKeyIndex(IndexMetadata *metadata) {
+  // Our new Index!
+  Index *index = nullptr;
+
+  // The size of the key in bytes
+  const auto key_size = metadata->key_schema->GetLength();
+
+// Debug Output
+#ifdef LOG_TRACE_ENABLED
+  std::string comparatorType;
+#endif
+
+  if (key_size <= sizeof(uint64_t)) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<1>";
+#endif
+    index = new HashIndex<CompactIntsKey<1>, ItemPointer *,
+                          CompactIntsHasher<1>, CompactIntsEqualityChecker<1>,
+                          ItemPointerComparator>(metadata);
+  } else if (key_size <= sizeof(uint64_t) * 2) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<2>";
+#endif
+    index = new HashIndex<CompactIntsKey<2>, ItemPointer *,
+                          CompactIntsHasher<2>, CompactIntsEqualityChecker<2>,
+                          ItemPointerComparator>(metadata);
+  } else if (key_size <= sizeof(uint64_t) * 3) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<3>";
+#endif
+    index = new HashIndex<CompactIntsKey<3>, ItemPointer *,
+                          CompactIntsHasher<3>, CompactIntsEqualityChecker<3>,
+                          ItemPointerComparator>(metadata);
+  } else if (key_size <= sizeof(uint64_t) * 4) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<4>";
+#endif
+    index = new HashIndex<CompactIntsKey<4>, ItemPointer *,
+                          CompactIntsHasher<4>, CompactIntsEqualityChecker<4>,
+                          ItemPointerComparator>(metadata);
+  } else {
+    throw IndexException("Unsupported IntsKey scheme");
+  }
+
+#ifdef LOG_TRACE_ENABLED
+  LOG_TRACE("%s", IndexFactory::GetInfo(metadata, comparatorType).c_str());
+#endif
+
+  return index;
+}
+
+Index *IndexFactory::GetHashGenericKeyIndex(IndexMetadata *metadata) {
+  // Our new Index!
+  Index *index = nullptr;
+
+  // The size of the key in bytes
+  const auto key_size = metadata->key_schema->GetLength();
+
+// Debug Output
+#ifdef LOG_TRACE_ENABLED
+  std::string comparatorType;
+#endif
+
+  if (key_size <= 4) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "GenericKey<4>";
+#endif
+    index = new HashIndex<GenericKey<4>, ItemPointer *, GenericHasher<4>,
+                          GenericEqualityChecker<4>, ItemPointerComparator>(
+        metadata);
+  } else if (key_size <= 8) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "GenericKey<8>";
+#endif
+    index = new HashIndex<GenericKey<8>, ItemPointer *, GenericHasher<8>,
+                          GenericEqualityChecker<8>, ItemPointerComparator>(
+        metadata);
+  } else if (key_size <= 16) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "GenericKey<16>";
+#endif
+    index = new HashIndex<GenericKey<16>, ItemPointer *, GenericHasher<16>,
+                          GenericEqualityChecker<16>, ItemPointerComparator>(
+        metadata);
+  } else if (key_size <= 64) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "GenericKey<64>";
+#endif
+    index = new HashIndex<GenericKey<64>, ItemPointer *, GenericHasher<64>,
+                          GenericEqualityChecker<64>, ItemPointerComparator>(
+        metadata);
+  } else if (key_size <= 256) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "GenericKey<256>";
+#endif
+    index = new HashIndex<GenericKey<256>, ItemPointer *, GenericHasher<256>,
+                          GenericEqualityChecker<256>, ItemPointerComparator>(
+        metadata);
+  } else {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "TupleKey";
+#endif
+    index = new HashIndex<TupleKey, ItemPointer *, TupleKeyHasher,
+                          TupleKeyEqualityChecker, ItemPointerComparator>(
+        metadata);
+  }
+
+#ifdef LOG_TRACE_ENABLED
+  LOG_TRACE("%s", IndexFactory::GetInfo(metadata, comparatorType).c_str());
+#endif
+
+  return index;
+}
+
 std::string IndexFactory::GetInfo(IndexMetadata *metadata,
                                   const std::string &comparator_type) {
   std::ostringstream os;
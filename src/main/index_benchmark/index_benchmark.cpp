@@ -0,0 +1,153 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_benchmark.cpp
+//
+// Identification: src/main/index_benchmark/index_benchmark.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include "benchmark/index_benchmark.h"
+#include "common/exception.h"
+#include "util/string_util.h"
+
+DEFINE_string(index_types, "bwtree,art,skiplist,hash",
+              "Comma separated index types to run: bwtree, art, skiplist, "
+              "hash");
+DEFINE_string(workloads, "read_only,balanced,scan_heavy,insert_only",
+              "Comma separated workloads to run: read_only (100% reads), "
+              "balanced (50% reads, 50% inserts), scan_heavy (95% scans, 5% "
+              "inserts), insert_only");
+DEFINE_string(distributions, "uniform,zipfian,sequential",
+              "Comma separated key distributions to run: uniform, zipfian, "
+              "sequential");
+DEFINE_string(key_types, "integer,string",
+              "Comma separated key types to run: integer, string");
+DEFINE_uint64(max_threads, 1,
+              "Run with 1, 2, 4, ... threads, up to this many");
+DEFINE_uint64(key_count, 1000000, "Number of keys loaded before each run");
+DEFINE_uint64(operation_count, 1000000,
+              "Number of operations run by each thread");
+DEFINE_uint64(max_scan_length, 100, "Scans return 1 to this many entries");
+DEFINE_double(zipf_theta, 0.99, "Skew of the Zipfian distribution");
+DEFINE_uint64(random_seed, 0, "Seed of all random choices");
+DEFINE_string(output_file, "", "Also write the results to this CSV file");
+
+namespace peloton {
+namespace benchmark {
+namespace {
+
+const char *kResultHeader =
+    "index,workload,distribution,key_type,threads,throughput,p50_us,p90_us,"
+    "p99_us,p999_us,max_us,entries,memory_bytes";
+
+std::string FormatResult(const IndexBenchmarkConfiguration &config,
+                         const IndexBenchmarkResult &result) {
+  return StringUtil::Format(
+      "%s,%s,%s,%s,%zu,%.0f,%.2f,%.2f,%.2f,%.2f,%.2f,%zu,%zu",
+      IndexTypeToString(config.index_type).c_str(),
+      IndexWorkloadTypeToString(config.workload_type).c_str(),
+      KeyDistributionTypeToString(config.distribution_type).c_str(),
+      BenchmarkKeyTypeToString(config.key_type).c_str(), config.thread_count,
+      result.throughput, result.latency_p50, result.latency_p90,
+      result.latency_p99, result.latency_p999, result.latency_max,
+      result.entry_count, result.memory_footprint);
+}
+
+int RunIndexBenchmarks() {
+  std::vector<IndexType> index_types;
+  std::vector<IndexWorkloadType> workload_types;
+  std::vector<KeyDistributionType> distribution_types;
+  std::vector<BenchmarkKeyType> key_types;
+  try {
+    for (auto &str : StringUtil::Split(FLAGS_index_types, ',')) {
+      index_types.push_back(StringToIndexType(StringUtil::Strip(str, ' ')));
+    }
+    for (auto &str : StringUtil::Split(FLAGS_workloads, ',')) {
+      workload_types.push_back(
+          StringToIndexWorkloadType(StringUtil::Strip(str, ' ')));
+    }
+    for (auto &str : StringUtil::Split(FLAGS_distributions, ',')) {
+      distribution_types.push_back(
+          StringToKeyDistributionType(StringUtil::Strip(str, ' ')));
+    }
+    for (auto &str : StringUtil::Split(FLAGS_key_types, ',')) {
+      key_types.push_back(
+          StringToBenchmarkKeyType(StringUtil::Strip(str, ' ')));
+    }
+  } catch (ConversionException &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<size_t> thread_counts;
+  for (size_t threads = 1; threads < FLAGS_max_threads; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  thread_counts.push_back(std::max<size_t>(FLAGS_max_threads, 1));
+
+  std::ofstream output;
+  if (FLAGS_output_file.empty() == false) {
+    output.open(FLAGS_output_file);
+    output << kResultHeader << std::endl;
+  }
+  std::cout << kResultHeader << std::endl;
+
+  IndexBenchmarkConfiguration config;
+  config.key_count = FLAGS_key_count;
+  config.operation_count = FLAGS_operation_count;
+  config.max_scan_length = FLAGS_max_scan_length;
+  config.zipf_theta = FLAGS_zipf_theta;
+  config.random_seed = FLAGS_random_seed;
+
+  for (auto index_type : index_types) {
+    config.index_type = index_type;
+    for (auto workload_type : workload_types) {
+      // Hash indexes have no key order to scan in
+      if (index_type == IndexType::HASH &&
+          workload_type == IndexWorkloadType::SCAN_HEAVY) {
+        continue;
+      }
+      config.workload_type = workload_type;
+      for (auto distribution_type : distribution_types) {
+        config.distribution_type = distribution_type;
+        for (auto key_type : key_types) {
+          config.key_type = key_type;
+          for (auto thread_count : thread_counts) {
+            config.thread_count = thread_count;
+            auto result = RunIndexBenchmark(config);
+            auto line = FormatResult(config, result);
+            std::cout << line << std::endl;
+            if (output.is_open()) {
+              output << line << std::endl;
+            }
+          }
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace peloton
+
+int main(int argc, char **argv) {
+  ::google::SetUsageMessage(
+      "Runs YCSB-style workloads against every index type and reports "
+      "throughput, latency percentiles and memory, one CSV line per run");
+  ::google::ParseCommandLineFlags(&argc, &argv, true);
+  return peloton::benchmark::RunIndexBenchmarks();
+}
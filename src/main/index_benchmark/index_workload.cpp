@@ -0,0 +1,551 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_workload.cpp
+//
+// Identification: src/main/index_benchmark/index_workload.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/index_benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "common/item_pointer.h"
+#include "common/macros.h"
+#include "common/timer.h"
+#include "index/art_index.h"
+#include "index/index_factory.h"
+#include "index/scan_optimizer.h"
+#include "storage/tuple.h"
+#include "type/abstract_pool.h"
+#include "type/value_factory.h"
+#include "util/string_util.h"
+
+namespace peloton {
+namespace benchmark {
+
+//===--------------------------------------------------------------------===//
+// String conversions
+//===--------------------------------------------------------------------===//
+
+std::string IndexWorkloadTypeToString(IndexWorkloadType type) {
+  switch (type) {
+    case IndexWorkloadType::READ_ONLY:
+      return "READ_ONLY";
+    case IndexWorkloadType::BALANCED:
+      return "BALANCED";
+    case IndexWorkloadType::SCAN_HEAVY:
+      return "SCAN_HEAVY";
+    case IndexWorkloadType::INSERT_ONLY:
+      return "INSERT_ONLY";
+    default:
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for IndexWorkloadType value '%d'",
+          static_cast<int>(type)));
+  }
+}
+
+IndexWorkloadType StringToIndexWorkloadType(const std::string &str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "READ_ONLY") {
+    return IndexWorkloadType::READ_ONLY;
+  } else if (upper_str == "BALANCED") {
+    return IndexWorkloadType::BALANCED;
+  } else if (upper_str == "SCAN_HEAVY") {
+    return IndexWorkloadType::SCAN_HEAVY;
+  } else if (upper_str == "INSERT_ONLY") {
+    return IndexWorkloadType::INSERT_ONLY;
+  }
+  throw ConversionException(StringUtil::Format(
+      "No IndexWorkloadType conversion from string '%s'", upper_str.c_str()));
+}
+
+std::string KeyDistributionTypeToString(KeyDistributionType type) {
+  switch (type) {
+    case KeyDistributionType::UNIFORM:
+      return "UNIFORM";
+    case KeyDistributionType::ZIPFIAN:
+      return "ZIPFIAN";
+    case KeyDistributionType::SEQUENTIAL:
+      return "SEQUENTIAL";
+    default:
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for KeyDistributionType value '%d'",
+          static_cast<int>(type)));
+  }
+}
+
+KeyDistributionType StringToKeyDistributionType(const std::string &str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "UNIFORM") {
+    return KeyDistributionType::UNIFORM;
+  } else if (upper_str == "ZIPFIAN") {
+    return KeyDistributionType::ZIPFIAN;
+  } else if (upper_str == "SEQUENTIAL") {
+    return KeyDistributionType::SEQUENTIAL;
+  }
+  throw ConversionException(StringUtil::Format(
+      "No KeyDistributionType conversion from string '%s'",
+      upper_str.c_str()));
+}
+
+std::string BenchmarkKeyTypeToString(BenchmarkKeyType type) {
+  switch (type) {
+    case BenchmarkKeyType::INTEGER:
+      return "INTEGER";
+    case BenchmarkKeyType::STRING:
+      return "STRING";
+    default:
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for BenchmarkKeyType value '%d'",
+          static_cast<int>(type)));
+  }
+}
+
+BenchmarkKeyType StringToBenchmarkKeyType(const std::string &str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "INTEGER") {
+    return BenchmarkKeyType::INTEGER;
+  } else if (upper_str == "STRING") {
+    return BenchmarkKeyType::STRING;
+  }
+  throw ConversionException(StringUtil::Format(
+      "No BenchmarkKeyType conversion from string '%s'", upper_str.c_str()));
+}
+
+//===--------------------------------------------------------------------===//
+// Zipfian Generator
+//===--------------------------------------------------------------------===//
+
+ZipfianGenerator::ZipfianGenerator(uint64_t item_count, double theta,
+                                   double zetan, uint64_t seed)
+    : item_count_(item_count),
+      theta_(theta),
+      zetan_(zetan),
+      rng_(seed),
+      unif_(0, 1) {
+  alpha_ = 1.0 / (1.0 - theta_);
+  eta_ = (1.0 - std::pow(2.0 / item_count_, 1.0 - theta_)) /
+         (1.0 - Zeta(2, theta_) / zetan_);
+}
+
+uint64_t ZipfianGenerator::GetSample() {
+  double u = unif_(rng_);
+  double uz = u * zetan_;
+  if (uz < 1.0) {
+    return 0;
+  }
+  if (item_count_ > 1 && uz < 1.0 + std::pow(0.5, theta_)) {
+    return 1;
+  }
+  auto sample = static_cast<uint64_t>(item_count_ *
+                                      std::pow(eta_ * u - eta_ + 1, alpha_));
+  return std::min(sample, item_count_ - 1);
+}
+
+double ZipfianGenerator::Zeta(uint64_t item_count, double theta) {
+  double sum = 0;
+  for (uint64_t i = 1; i <= item_count; i++) {
+    sum += 1.0 / std::pow(static_cast<double>(i), theta);
+  }
+  return sum;
+}
+
+//===--------------------------------------------------------------------===//
+// Index Workload
+//===--------------------------------------------------------------------===//
+
+namespace {
+
+// Length of the VARCHAR key column, enough for "user" and 19 digits
+const size_t kStringKeyLength = 32;
+
+// The key tuple only ever holds one key, and the index copies it, so all
+// allocations for out-of-line strings can share one buffer
+class KeyPool : public type::AbstractPool {
+ public:
+  void *Allocate(size_t size) override {
+    PELOTON_ASSERT(size <= sizeof(buffer_));
+    (void)size;
+    return buffer_;
+  }
+
+  void Free(UNUSED_ATTRIBUTE void *ptr) override {}
+
+  size_t GetMemoryFootprint() override { return sizeof(buffer_); }
+
+ private:
+  char buffer_[kStringKeyLength + 1];
+};
+
+// Room for the largest key tuple, which lets keys be built on the stack
+const size_t kKeyTupleSize = 16;
+
+enum class OperationType { READ, SCAN, INSERT };
+
+// The finalizer of splitmix64, which is a bijection on 64-bit numbers
+uint64_t ScrambleKeyNumber(uint64_t key_number) {
+  key_number = (key_number ^ (key_number >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  key_number = (key_number ^ (key_number >> 27)) * 0x94d049bb133111ebULL;
+  return key_number ^ (key_number >> 31);
+}
+
+// The value of an entry encodes the key number it was inserted with, which
+// lets the ART index get back to the key
+ItemPointer KeyNumberToItemPointer(uint64_t key_number) {
+  return ItemPointer(static_cast<oid_t>(key_number >> 32),
+                     static_cast<oid_t>(key_number & 0xffffffff));
+}
+
+uint64_t ItemPointerToKeyNumber(const ItemPointer &item) {
+  return (static_cast<uint64_t>(item.block) << 32) | item.offset;
+}
+
+class IndexWorkload {
+ public:
+  explicit IndexWorkload(const IndexBenchmarkConfiguration &config);
+
+  IndexBenchmarkResult Run();
+
+ private:
+  struct ThreadState {
+    // Latency of every operation, in nanoseconds
+    std::vector<uint64_t> latencies;
+
+    // Values of the keys this thread inserted
+    std::deque<ItemPointer> inserted_items;
+
+    size_t insert_count = 0;
+  };
+
+  struct ArtLoadContext {
+    const IndexWorkload *workload;
+    index::ArtIndex *index;
+  };
+
+  static void LoadArtKey(void *ctx, TID tid, art::Key &key);
+
+  void BuildIndex();
+
+  void Load();
+
+  void RunThread(size_t thread_id, ThreadState &state);
+
+  OperationType PickOperation(std::mt19937_64 &rng) const;
+
+  // Write the key with the given number into the key tuple. Strings are
+  // formatted into the given buffer.
+  void SetKey(storage::Tuple &key, uint64_t key_number, KeyPool &pool) const;
+
+  type::Value GetKeyValue(uint64_t key_number, char *buffer) const;
+
+  const IndexBenchmarkConfiguration &config_;
+
+  std::unique_ptr<catalog::Schema> tuple_schema_;
+
+  std::unique_ptr<index::Index> index_;
+
+  ArtLoadContext art_context_;
+
+  // Values of the keys loaded before the run, by key number
+  std::vector<ItemPointer> loaded_items_;
+
+  // Number handed to the next inserted key
+  std::atomic<uint64_t> next_key_number_;
+
+  double zetan_ = 0;
+
+  std::atomic<size_t> ready_thread_count_;
+  std::atomic<bool> start_;
+};
+
+IndexWorkload::IndexWorkload(const IndexBenchmarkConfiguration &config)
+    : config_(config),
+      art_context_{this, nullptr},
+      next_key_number_(config.key_count),
+      ready_thread_count_(0),
+      start_(false) {}
+
+void IndexWorkload::LoadArtKey(void *ctx, TID tid, art::Key &key) {
+  auto *context = reinterpret_cast<ArtLoadContext *>(ctx);
+  auto *item = reinterpret_cast<const ItemPointer *>(tid);
+
+  alignas(8) char data[kKeyTupleSize];
+  KeyPool pool;
+  storage::Tuple tuple(context->index->GetKeySchema(), data);
+  context->workload->SetKey(tuple, ItemPointerToKeyNumber(*item), pool);
+  context->index->ConstructArtKey(tuple, key);
+}
+
+void IndexWorkload::BuildIndex() {
+  catalog::Column column =
+      (config_.key_type == BenchmarkKeyType::INTEGER)
+          ? catalog::Column(type::TypeId::BIGINT,
+                            type::Type::GetTypeSize(type::TypeId::BIGINT),
+                            "key", true)
+          : catalog::Column(type::TypeId::VARCHAR, kStringKeyLength, "key",
+                            false);
+
+  std::vector<oid_t> key_attrs = {0};
+  tuple_schema_.reset(new catalog::Schema({column}));
+  auto *key_schema = new catalog::Schema({column});
+  key_schema->SetIndexedColumns(key_attrs);
+  PELOTON_ASSERT(key_schema->GetLength() <= kKeyTupleSize);
+
+  auto *index_metadata = new index::IndexMetadata(
+      "benchmark_index", 1, INVALID_OID, INVALID_OID, config_.index_type,
+      IndexConstraintType::DEFAULT, tuple_schema_.get(), key_schema, key_attrs,
+      false);
+  index_.reset(index::IndexFactory::GetIndex(index_metadata));
+
+  // There is no table to load ART keys from
+  if (config_.index_type == IndexType::ART) {
+    art_context_.index = static_cast<index::ArtIndex *>(index_.get());
+    art_context_.index->SetLoadKeyFunc(LoadArtKey, &art_context_);
+  }
+}
+
+void IndexWorkload::Load() {
+  loaded_items_.reserve(config_.key_count);
+  for (uint64_t key_number = 0; key_number < config_.key_count;
+       key_number++) {
+    loaded_items_.push_back(KeyNumberToItemPointer(key_number));
+  }
+
+  // Every thread loads an interleaved share of the keys
+  auto load = [this](size_t thread_id) {
+    alignas(8) char data[kKeyTupleSize];
+    KeyPool pool;
+    storage::Tuple key(index_->GetKeySchema(), data);
+    for (uint64_t key_number = thread_id; key_number < config_.key_count;
+         key_number += config_.thread_count) {
+      SetKey(key, key_number, pool);
+      index_->InsertEntry(&key, &loaded_items_[key_number]);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t thread_id = 0; thread_id < config_.thread_count; thread_id++) {
+    threads.emplace_back(load, thread_id);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  if (index_->NeedGC()) {
+    index_->PerformGC();
+  }
+}
+
+OperationType IndexWorkload::PickOperation(std::mt19937_64 &rng) const {
+  uint32_t roll = std::uniform_int_distribution<uint32_t>(0, 99)(rng);
+  switch (config_.workload_type) {
+    case IndexWorkloadType::READ_ONLY:
+      return OperationType::READ;
+    case IndexWorkloadType::BALANCED:
+      return roll < 50 ? OperationType::READ : OperationType::INSERT;
+    case IndexWorkloadType::SCAN_HEAVY:
+      return roll < 95 ? OperationType::SCAN : OperationType::INSERT;
+    case IndexWorkloadType::INSERT_ONLY:
+      return OperationType::INSERT;
+  }
+  return OperationType::READ;
+}
+
+type::Value IndexWorkload::GetKeyValue(uint64_t key_number,
+                                       char *buffer) const {
+  uint64_t key = key_number;
+  if (config_.distribution_type != KeyDistributionType::SEQUENTIAL) {
+    // Keep the value positive, so that integer keys never hit NULL
+    key = ScrambleKeyNumber(key_number) >> 1;
+  }
+  if (config_.key_type == BenchmarkKeyType::INTEGER) {
+    return type::ValueFactory::GetBigIntValue(static_cast<int64_t>(key));
+  }
+  snprintf(buffer, kStringKeyLength + 1, "user%019llu",
+           static_cast<unsigned long long>(key));
+  return type::ValueFactory::GetVarcharValue(buffer, false);
+}
+
+void IndexWorkload::SetKey(storage::Tuple &key, uint64_t key_number,
+                           KeyPool &pool) const {
+  char buffer[kStringKeyLength + 1];
+  key.SetValue(0, GetKeyValue(key_number, buffer), &pool);
+}
+
+void IndexWorkload::RunThread(size_t thread_id, ThreadState &state) {
+  std::mt19937_64 rng(config_.random_seed * 1000003 + thread_id);
+  std::unique_ptr<ZipfianGenerator> zipf;
+  if (config_.distribution_type == KeyDistributionType::ZIPFIAN) {
+    zipf.reset(new ZipfianGenerator(config_.key_count, config_.zipf_theta,
+                                    zetan_, rng()));
+  }
+  std::uniform_int_distribution<uint64_t> uniform_key(0,
+                                                      config_.key_count - 1);
+  std::uniform_int_distribution<size_t> scan_length(1,
+                                                    config_.max_scan_length);
+  uint64_t sequential_key =
+      thread_id * (config_.key_count / config_.thread_count);
+
+  // Reads and scans go to the keys loaded before the run
+  auto pick_key = [&]() -> uint64_t {
+    switch (config_.distribution_type) {
+      case KeyDistributionType::UNIFORM:
+        return uniform_key(rng);
+      case KeyDistributionType::ZIPFIAN:
+        return zipf->GetSample();
+      case KeyDistributionType::SEQUENTIAL:
+        break;
+    }
+    uint64_t key_number = sequential_key;
+    sequential_key = (sequential_key + 1) % config_.key_count;
+    return key_number;
+  };
+
+  alignas(8) char data[kKeyTupleSize];
+  KeyPool pool;
+  storage::Tuple key(index_->GetKeySchema(), data);
+  std::vector<ItemPointer *> result;
+  std::vector<oid_t> scan_column_ids = {0};
+  std::vector<ExpressionType> scan_expr_types = {
+      ExpressionType::COMPARE_GREATERTHANOREQUALTO};
+  state.latencies.reserve(config_.operation_count);
+
+  ready_thread_count_++;
+  while (start_.load() == false) {
+    std::this_thread::yield();
+  }
+
+  for (size_t op = 0; op < config_.operation_count; op++) {
+    auto op_type = PickOperation(rng);
+    uint64_t key_number = 0;
+    size_t limit = 0;
+    if (op_type == OperationType::INSERT) {
+      key_number = next_key_number_.fetch_add(1);
+      state.inserted_items.push_back(KeyNumberToItemPointer(key_number));
+    } else {
+      key_number = pick_key();
+      if (op_type == OperationType::SCAN) {
+        limit = scan_length(rng);
+      }
+    }
+    result.clear();
+
+    auto begin = std::chrono::steady_clock::now();
+    switch (op_type) {
+      case OperationType::READ:
+        SetKey(key, key_number, pool);
+        index_->ScanKey(&key, result);
+        break;
+      case OperationType::SCAN: {
+        char buffer[kStringKeyLength + 1];
+        std::vector<type::Value> values = {GetKeyValue(key_number, buffer)};
+        index::ConjunctionScanPredicate csp(index_.get(), values,
+                                            scan_column_ids, scan_expr_types);
+        index_->ScanLimit(values, scan_column_ids, scan_expr_types,
+                          ScanDirectionType::FORWARD, result, &csp, limit, 0);
+        break;
+      }
+      case OperationType::INSERT:
+        SetKey(key, key_number, pool);
+        if (index_->InsertEntry(&key, &state.inserted_items.back())) {
+          state.insert_count++;
+        }
+        break;
+    }
+    auto end = std::chrono::steady_clock::now();
+    state.latencies.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+            .count());
+  }
+}
+
+IndexBenchmarkResult IndexWorkload::Run() {
+  if (config_.index_type == IndexType::HASH &&
+      config_.workload_type == IndexWorkloadType::SCAN_HEAVY) {
+    throw Exception("Hash indexes do not support range scans");
+  }
+  if (config_.thread_count == 0 || config_.key_count == 0 ||
+      config_.max_scan_length == 0) {
+    throw Exception("Thread count, key count and scan length must be positive");
+  }
+
+  BuildIndex();
+  Load();
+  if (config_.distribution_type == KeyDistributionType::ZIPFIAN) {
+    zetan_ = ZipfianGenerator::Zeta(config_.key_count, config_.zipf_theta);
+  }
+
+  std::vector<ThreadState> states(config_.thread_count);
+  std::vector<std::thread> threads;
+  for (size_t thread_id = 0; thread_id < config_.thread_count; thread_id++) {
+    threads.emplace_back(&IndexWorkload::RunThread, this, thread_id,
+                         std::ref(states[thread_id]));
+  }
+
+  // Start all threads at once, after they are done setting up
+  while (ready_thread_count_.load() < config_.thread_count) {
+    std::this_thread::yield();
+  }
+  Timer<> timer;
+  timer.Start();
+  start_.store(true);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  timer.Stop();
+
+  IndexBenchmarkResult result;
+  std::vector<uint64_t> latencies;
+  latencies.reserve(config_.thread_count * config_.operation_count);
+  result.entry_count = config_.key_count;
+  for (auto &state : states) {
+    latencies.insert(latencies.end(), state.latencies.begin(),
+                     state.latencies.end());
+    result.entry_count += state.insert_count;
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  result.throughput = latencies.size() / timer.GetDuration();
+  if (latencies.empty() == false) {
+    auto percentile = [&latencies](double fraction) {
+      size_t rank = static_cast<size_t>(fraction * (latencies.size() - 1));
+      return latencies[rank] / 1000.0;
+    };
+    result.latency_p50 = percentile(0.5);
+    result.latency_p90 = percentile(0.9);
+    result.latency_p99 = percentile(0.99);
+    result.latency_p999 = percentile(0.999);
+    result.latency_max = latencies.back() / 1000.0;
+  }
+
+  if (index_->NeedGC()) {
+    index_->PerformGC();
+  }
+  result.memory_footprint = index_->GetMemoryFootprint();
+  return result;
+}
+
+}  // namespace
+
+IndexBenchmarkResult RunIndexBenchmark(
+    const IndexBenchmarkConfiguration &config) {
+  IndexWorkload workload(config);
+  return workload.Run();
+}
+
+}  // namespace benchmark
+}  // namespace peloton
@@ -70,6 +70,12 @@ void ChildPropertyDeriver::Visit(const PhysicalIndexScan *op) {
       }
       if (!can_fulfill) break;
       for (auto &index : target_table->GetIndexCatalogEntries()) {
+        // Only the index being scanned determines the output order, and a
+        // hash index returns its entries in no particular order
+        if (index.first != op->index_id ||
+            index.second->GetIndexType() == IndexType::HASH) {
+          continue;
+        }
         auto key_oids = index.second->GetKeyAttrs();
         // If the sort column size is larger, then can't be fulfill by the index
         if (sort_col_size > key_oids.size()) {
@@ -40,7 +40,6 @@
 #include "planner/order_by_plan.h"
 #include "planner/populate_index_plan.h"
 #include "planner/projection_plan.h"
-#include "planner/seq_scan_plan.h"
 
 #include "storage/data_table.h"
 
@@ -186,15 +185,10 @@ unique_ptr<planner::AbstractPlan> Optimizer::HandleDDLStatement(
           oid_t col_pos = column_object->GetColumnId();
           column_ids.push_back(col_pos);
         }
-        // Create a plan to retrieve data
-        std::unique_ptr<planner::SeqScanPlan> child_SeqScanPlan(
-            new planner::SeqScanPlan(target_table, nullptr, column_ids, false));
-
-        child_SeqScanPlan->AddChild(std::move(ddl_plan));
-        ddl_plan = std::move(child_SeqScanPlan);
-        // Create a plan to add data to index
+        // Create a plan to add data to index. It scans the table itself.
         std::unique_ptr<planner::AbstractPlan> child_PopulateIndexPlan(
-            new planner::PopulateIndexPlan(target_table, column_ids));
+            new planner::PopulateIndexPlan(target_table, column_ids,
+                                           create_stmt->index_name));
         child_PopulateIndexPlan->AddChild(std::move(ddl_plan));
         create_plan->SetKeyAttrs(column_ids);
         ddl_plan = std::move(child_PopulateIndexPlan);
@@ -18,6 +18,9 @@
 #include "codegen/type/type.h"
 #include "concurrency/transaction_context.h"
 #include "expression/expression_util.h"
+#include "expression/tuple_value_expression.h"
+#include "index/covering_payload_store.h"
+#include "index/index.h"
 #include "optimizer/operator_expression.h"
 #include "optimizer/properties.h"
 #include "planner/aggregate_plan.h"
@@ -124,10 +127,31 @@ void PlanGenerator::Visit(const PhysicalIndexScan *op) {
   planner::IndexScanPlan::IndexScanDesc index_scan_desc(
       op->index_id, op->key_column_id_list, op->expr_type_list, op->value_list,
       runtime_keys);
-  output_plan_.reset(new planner::IndexScanPlan(
-      storage::StorageManager::GetInstance()->GetTableWithOid(
-          op->table_->GetDatabaseOid(), op->table_->GetTableOid()),
-      predicate.release(), column_ids, index_scan_desc, false));
+  auto *data_table = storage::StorageManager::GetInstance()->GetTableWithOid(
+      op->table_->GetDatabaseOid(), op->table_->GetTableOid());
+
+  // The scan never has to read the table if the index covers every column
+  // that is either returned or checked by the predicate. Updates need the
+  // table's tuples, so they always read it.
+  bool index_only = false;
+  auto index = data_table->GetIndexWithOid(op->index_id);
+  if (op->is_for_update == false && index->GetPayloadStore() != nullptr) {
+    vector<oid_t> read_column_ids = column_ids;
+    ExprSet predicate_columns;
+    expression::ExpressionUtil::GetTupleValueExprs(predicate_columns,
+                                                   predicate.get());
+    for (auto *expr : predicate_columns) {
+      read_column_ids.push_back(
+          static_cast<expression::TupleValueExpression *>(expr)
+              ->GetColumnId());
+    }
+    index_only = index->GetPayloadStore()->CoversColumns(read_column_ids);
+  }
+
+  auto *index_scan_plan = new planner::IndexScanPlan(
+      data_table, predicate.release(), column_ids, index_scan_desc, false);
+  index_scan_plan->SetIndexOnly(index_only);
+  output_plan_.reset(index_scan_plan);
 }
 
 void PlanGenerator::Visit(const ExternalFileScan *op) {
@@ -159,6 +183,8 @@ void PlanGenerator::Visit(const PhysicalLimit *op) {
   // Generate order by + limit plan when there's internal sort order
   output_plan_ = std::move(children_plans_[0]);
   if (!op->sort_exprs.empty()) {
+    PushLimitIntoIndexScan(op);
+
     vector<oid_t> column_ids;
     PELOTON_ASSERT(children_expr_map_.size() == 1);
     auto &child_cols_map = children_expr_map_[0];
@@ -187,6 +213,46 @@ void PlanGenerator::Visit(const PhysicalLimit *op) {
   output_plan_ = std::move(limit_plan);
 }
 
+void PlanGenerator::PushLimitIntoIndexScan(const PhysicalLimit *op) {
+  if (output_plan_->GetPlanNodeType() != PlanNodeType::INDEXSCAN) {
+    return;
+  }
+  auto index_scan_plan =
+      static_cast<planner::IndexScanPlan *>(output_plan_.get());
+  auto table = index_scan_plan->GetTable();
+  auto index = table->GetIndexWithOid(index_scan_plan->GetIndexId());
+  if (index == nullptr || index->GetIndexMethodType() != IndexType::BWTREE) {
+    return;
+  }
+
+  // The index returns the tuples in the sort order if the sort columns are a
+  // prefix of its key, all sorted in the same direction
+  auto &key_attrs = index->GetMetadata()->GetKeyAttrs();
+  if (op->sort_exprs.size() > key_attrs.size()) {
+    return;
+  }
+  for (size_t i = 0; i < op->sort_exprs.size(); ++i) {
+    auto *sort_expr = op->sort_exprs[i];
+    if (sort_expr->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+        op->sort_acsending[i] != op->sort_acsending[0]) {
+      return;
+    }
+    auto *tuple_value_expr =
+        static_cast<expression::TupleValueExpression *>(sort_expr);
+    if (std::get<1>(tuple_value_expr->GetBoundOid()) != table->GetOid() ||
+        std::get<2>(tuple_value_expr->GetBoundOid()) != key_attrs[i]) {
+      return;
+    }
+  }
+
+  // The scan stops once it has found the first offset + limit tuples. The
+  // order by and limit plans above it still skip the offset.
+  index_scan_plan->SetLimit(true);
+  index_scan_plan->SetLimitNumber(op->offset + op->limit);
+  index_scan_plan->SetLimitOffset(0);
+  index_scan_plan->SetDescend(!op->sort_acsending[0]);
+}
+
 void PlanGenerator::Visit(const PhysicalOrderBy *) {
   vector<oid_t> column_ids;
   PELOTON_ASSERT(children_expr_map_.size() == 1);
@@ -15,12 +15,14 @@
 #include "catalog/column_catalog.h"
 #include "catalog/index_catalog.h"
 #include "catalog/table_catalog.h"
+#include "index/index.h"
 #include "optimizer/operators.h"
 #include "optimizer/optimizer_metadata.h"
 #include "optimizer/properties.h"
 #include "optimizer/rule_impls.h"
 #include "optimizer/util.h"
 #include "storage/data_table.h"
+#include "storage/storage_manager.h"
 
 namespace peloton {
 namespace optimizer {
@@ -262,6 +264,17 @@ void GetToIndexScan::Transform(
 
   const LogicalGet *get = input->Op().As<LogicalGet>();
 
+  // A partial index only holds the tuples satisfying its predicate, so it can
+  // only be used when the scan predicates imply that predicate
+  auto index_covers_scan = [get](oid_t index_id) {
+    auto data_table = storage::StorageManager::GetInstance()->GetTableWithOid(
+        get->table->GetDatabaseOid(), get->table->GetTableOid());
+    auto index = data_table->GetIndexWithOid(index_id);
+    auto index_predicate = index->GetMetadata()->GetPredicate();
+    return index_predicate == nullptr ||
+           util::PredicatesImply(get->predicates, index_predicate);
+  };
+
   // Get sort columns if they are all base columns and all in asc order
   auto sort = context->required_prop->GetPropertyOfType(PropertyType::SORT);
   std::vector<oid_t> sort_col_ids;
@@ -285,6 +298,9 @@ void GetToIndexScan::Transform(
         auto &index_id = index_id_object_pair.first;
         auto &index = index_id_object_pair.second;
         auto &index_col_ids = index->GetKeyAttrs();
+        if (!index_covers_scan(index_id)) continue;
+        // A hash index returns its entries in no particular order
+        if (index->GetIndexType() == IndexType::HASH) continue;
         // We want to ensure that Sort(a, b, c, d, e) can fit Sort(a, b, c)
         size_t l_num_sort_columns = index_col_ids.size();
         size_t r_num_sort_columns = sort_col_ids.size();
@@ -378,6 +394,7 @@ void GetToIndexScan::Transform(
     for (auto &index_id_object_pair : index_objects) {
       auto &index_id = index_id_object_pair.first;
       auto &index_object = index_id_object_pair.second;
+      if (!index_covers_scan(index_id)) continue;
       std::vector<oid_t> index_key_column_id_list;
       std::vector<ExpressionType> index_expr_type_list;
       std::vector<type::Value> index_value_list;
@@ -392,6 +409,28 @@ void GetToIndexScan::Transform(
           index_value_list.push_back(value_list[offset]);
         }
       }
+      // A hash index can only answer lookups of a full key, for anything
+      // else it visits all of its entries
+      if (index_object->GetIndexType() == IndexType::HASH) {
+        bool full_key_lookup = true;
+        for (auto key_col_id : index_object->GetKeyAttrs()) {
+          bool has_equality = false;
+          for (size_t offset = 0; offset < index_key_column_id_list.size();
+               offset++) {
+            if (index_key_column_id_list[offset] == key_col_id &&
+                index_expr_type_list[offset] ==
+                    ExpressionType::COMPARE_EQUAL) {
+              has_equality = true;
+              break;
+            }
+          }
+          if (!has_equality) {
+            full_key_lookup = false;
+            break;
+          }
+        }
+        if (!full_key_lookup) continue;
+      }
       // Add transformed plan
       if (!index_key_column_id_list.empty()) {
         auto index_scan_op = PhysicalIndexScan::make(
@@ -14,12 +14,258 @@
 
 #include "catalog/query_metrics_catalog.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "expression/constant_value_expression.h"
 #include "expression/expression_util.h"
+#include "expression/function_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace optimizer {
 namespace util {
 
+namespace {
+
+// A predicate of the form (column op constant)
+struct ColumnComparison {
+  oid_t column_id;
+  ExpressionType type;
+  type::Value value;
+};
+
+oid_t GetBoundColumnId(const expression::AbstractExpression *expr) {
+  return std::get<2>(
+      static_cast<const expression::TupleValueExpression *>(expr)
+          ->GetBoundOid());
+}
+
+// Matches (column op constant) and (constant op column), turning the
+// comparison around in the latter case. A boolean column on its own is
+// matched as (column = true).
+bool GetColumnComparison(const expression::AbstractExpression *expr,
+                         ColumnComparison &comparison) {
+  if (expr->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    if (expr->GetValueType() != type::TypeId::BOOLEAN) {
+      return false;
+    }
+    comparison.column_id = GetBoundColumnId(expr);
+    comparison.type = ExpressionType::COMPARE_EQUAL;
+    comparison.value = type::ValueFactory::GetBooleanValue(true);
+    return true;
+  }
+
+  auto type = expr->GetExpressionType();
+  switch (type) {
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      break;
+    default:
+      return false;
+  }
+
+  auto *column = expr->GetChild(0);
+  auto *constant = expr->GetChild(1);
+  if (constant->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    std::swap(column, constant);
+    type = expression::ExpressionUtil::ReverseComparisonExpressionType(type);
+  }
+  if (column->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+      constant->GetExpressionType() != ExpressionType::VALUE_CONSTANT) {
+    return false;
+  }
+
+  comparison.column_id = GetBoundColumnId(column);
+  comparison.type = type;
+  comparison.value =
+      static_cast<const expression::ConstantValueExpression *>(constant)
+          ->GetValue();
+  return comparison.value.IsNull() == false;
+}
+
+// Evaluates (lhs op rhs), which is false for values that can't be compared
+bool CompareValues(const type::Value &lhs, ExpressionType type,
+                   const type::Value &rhs) {
+  if (lhs.CheckComparable(rhs) == false) {
+    return false;
+  }
+  CmpBool result;
+  switch (type) {
+    case ExpressionType::COMPARE_EQUAL:
+      result = lhs.CompareEquals(rhs);
+      break;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      result = lhs.CompareNotEquals(rhs);
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+      result = lhs.CompareLessThan(rhs);
+      break;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      result = lhs.CompareGreaterThan(rhs);
+      break;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      result = lhs.CompareLessThanEquals(rhs);
+      break;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      result = lhs.CompareGreaterThanEquals(rhs);
+      break;
+    default:
+      return false;
+  }
+  return result == CmpBool::CmpTrue;
+}
+
+// Whether every value of the column satisfying given also satisfies target
+bool ComparisonImplies(const ColumnComparison &given,
+                       const ColumnComparison &target) {
+  if (given.column_id != target.column_id) {
+    return false;
+  }
+
+  const type::Value &bound = given.value;
+  const type::Value &value = target.value;
+  switch (given.type) {
+    case ExpressionType::COMPARE_EQUAL:
+      // The column has exactly one value
+      return CompareValues(bound, target.type, value);
+    case ExpressionType::COMPARE_LESSTHAN:
+      switch (target.type) {
+        case ExpressionType::COMPARE_LESSTHAN:
+        case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        case ExpressionType::COMPARE_NOTEQUAL:
+          return CompareValues(bound, ExpressionType::COMPARE_LESSTHANOREQUALTO,
+                               value);
+        default:
+          return false;
+      }
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      switch (target.type) {
+        case ExpressionType::COMPARE_LESSTHAN:
+        case ExpressionType::COMPARE_NOTEQUAL:
+          return CompareValues(bound, ExpressionType::COMPARE_LESSTHAN, value);
+        case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+          return CompareValues(bound, ExpressionType::COMPARE_LESSTHANOREQUALTO,
+                               value);
+        default:
+          return false;
+      }
+    case ExpressionType::COMPARE_GREATERTHAN:
+      switch (target.type) {
+        case ExpressionType::COMPARE_GREATERTHAN:
+        case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        case ExpressionType::COMPARE_NOTEQUAL:
+          return CompareValues(
+              bound, ExpressionType::COMPARE_GREATERTHANOREQUALTO, value);
+        default:
+          return false;
+      }
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      switch (target.type) {
+        case ExpressionType::COMPARE_GREATERTHAN:
+        case ExpressionType::COMPARE_NOTEQUAL:
+          return CompareValues(bound, ExpressionType::COMPARE_GREATERTHAN,
+                               value);
+        case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+          return CompareValues(
+              bound, ExpressionType::COMPARE_GREATERTHANOREQUALTO, value);
+        default:
+          return false;
+      }
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return target.type == ExpressionType::COMPARE_NOTEQUAL &&
+             CompareValues(bound, ExpressionType::COMPARE_EQUAL, value);
+    default:
+      return false;
+  }
+}
+
+// Compares two expressions by structure. Columns are compared by the column
+// they are bound to, since the query and the index may name them differently.
+bool SameExpression(const expression::AbstractExpression *lhs,
+                    const expression::AbstractExpression *rhs) {
+  if (lhs->GetExpressionType() != rhs->GetExpressionType() ||
+      lhs->GetChildrenSize() != rhs->GetChildrenSize()) {
+    return false;
+  }
+
+  switch (lhs->GetExpressionType()) {
+    case ExpressionType::VALUE_TUPLE:
+      return static_cast<const expression::TupleValueExpression *>(lhs)
+                 ->GetBoundOid() ==
+             static_cast<const expression::TupleValueExpression *>(rhs)
+                 ->GetBoundOid();
+    case ExpressionType::VALUE_CONSTANT: {
+      type::Value lhs_value =
+          static_cast<const expression::ConstantValueExpression *>(lhs)
+              ->GetValue();
+      type::Value rhs_value =
+          static_cast<const expression::ConstantValueExpression *>(rhs)
+              ->GetValue();
+      if (lhs_value.IsNull() || rhs_value.IsNull()) {
+        return lhs_value.IsNull() && rhs_value.IsNull() &&
+               lhs_value.GetTypeId() == rhs_value.GetTypeId();
+      }
+      return CompareValues(lhs_value, ExpressionType::COMPARE_EQUAL,
+                           rhs_value);
+    }
+    case ExpressionType::FUNCTION:
+      if (static_cast<const expression::FunctionExpression *>(lhs)
+              ->GetFuncName() !=
+          static_cast<const expression::FunctionExpression *>(rhs)
+              ->GetFuncName()) {
+        return false;
+      }
+      break;
+    case ExpressionType::OPERATOR_PLUS:
+    case ExpressionType::OPERATOR_MINUS:
+    case ExpressionType::OPERATOR_MULTIPLY:
+    case ExpressionType::OPERATOR_DIVIDE:
+    case ExpressionType::OPERATOR_MOD:
+    case ExpressionType::OPERATOR_NOT:
+    case ExpressionType::OPERATOR_IS_NULL:
+    case ExpressionType::OPERATOR_IS_NOT_NULL:
+    case ExpressionType::OPERATOR_UNARY_MINUS:
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+    case ExpressionType::COMPARE_LIKE:
+    case ExpressionType::COMPARE_NOTLIKE:
+    case ExpressionType::CONJUNCTION_AND:
+    case ExpressionType::CONJUNCTION_OR:
+      break;
+    default:
+      // Other expressions may carry state besides their children
+      return false;
+  }
+
+  for (size_t i = 0; i < lhs->GetChildrenSize(); i++) {
+    if (SameExpression(lhs->GetChild(i), rhs->GetChild(i)) == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SplitConstPredicates(
+    const expression::AbstractExpression *expr,
+    std::vector<const expression::AbstractExpression *> &predicates) {
+  if (expr->GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+    for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+      SplitConstPredicates(expr->GetChild(i), predicates);
+    }
+  } else {
+    predicates.push_back(expr);
+  }
+}
+
+}  // namespace
+
 std::vector<AnnotatedExpression> ExtractPredicates(
     expression::AbstractExpression *expr,
     std::vector<AnnotatedExpression> annotated_predicates) {
@@ -39,6 +285,33 @@ std::vector<AnnotatedExpression> ExtractPredicates(
   return annotated_predicates;
 }
 
+bool PredicatesImply(const std::vector<AnnotatedExpression> &predicates,
+                     const expression::AbstractExpression *expr) {
+  std::vector<const expression::AbstractExpression *> conjuncts;
+  SplitConstPredicates(expr, conjuncts);
+
+  for (auto *conjunct : conjuncts) {
+    ColumnComparison target;
+    bool is_comparison = GetColumnComparison(conjunct, target);
+
+    bool implied = false;
+    for (auto &predicate : predicates) {
+      ColumnComparison given;
+      if (SameExpression(predicate.expr.get(), conjunct) ||
+          (is_comparison &&
+           GetColumnComparison(predicate.expr.get(), given) &&
+           ComparisonImplies(given, target))) {
+        implied = true;
+        break;
+      }
+    }
+    if (implied == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
 expression::AbstractExpression *ConstructJoinPredicate(
     std::unordered_set<std::string> &table_alias_set,
     MultiTablePredicates &join_predicates) {
@@ -49,6 +49,11 @@ const std::string CreateStatement::GetInfo(int num_indent) const {
       os << std::endl;
       os << StringUtil::Indent(num_indent + 1)
          << "Type : " << IndexTypeToString(index_type);
+      if (index_predicate != nullptr) {
+        os << std::endl
+           << StringUtil::Indent(num_indent + 1)
+           << "Predicate : " << index_predicate->GetInfo();
+      }
       break;
     }
     case CreateStatement::CreateType::kTrigger: {
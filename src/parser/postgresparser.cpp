@@ -1217,6 +1217,13 @@ parser::SQLStatement *PostgresParser::CreateIndexTransform(IndexStmt *root) {
   if (root->relation->schemaname)
     result->table_info_->schema_name = root->relation->schemaname;
   result->index_name = root->idxname;
+  // The predicate of a partial index
+  try {
+    result->index_predicate.reset(WhereTransform(root->whereClause));
+  } catch (NotImplementedException e) {
+    delete result;
+    throw e;
+  }
   return result;
 }
 
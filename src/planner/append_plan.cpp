@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// append_plan.cpp
+//
+// Identification: src/planner/append_plan.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "planner/append_plan.h"
+
+#include "util/hash_util.h"
+
+namespace peloton {
+namespace planner {
+
+void AppendPlan::PerformBinding(BindingContext &binding_context) {
+  const auto &children = GetChildren();
+  PELOTON_ASSERT(!children.empty());
+
+  // The first child binds into the output context, the others into their own
+  std::vector<BindingContext> input_contexts(children.size() - 1);
+  children[0]->PerformBinding(binding_context);
+  for (uint32_t i = 1; i < children.size(); i++) {
+    children[i]->PerformBinding(input_contexts[i - 1]);
+  }
+
+  // All children have the same physical schema, so their columns are numbered
+  // the same way
+  input_ais_.assign(children.size(), {});
+  for (oid_t col_id = 0; binding_context.Find(col_id) != nullptr; col_id++) {
+    input_ais_[0].push_back(binding_context.Find(col_id));
+    for (uint32_t i = 1; i < children.size(); i++) {
+      PELOTON_ASSERT(input_contexts[i - 1].Find(col_id) != nullptr);
+      input_ais_[i].push_back(input_contexts[i - 1].Find(col_id));
+    }
+  }
+}
+
+hash_t AppendPlan::Hash() const {
+  auto type = GetPlanNodeType();
+  hash_t hash = HashUtil::Hash(&type);
+  return HashUtil::CombineHashes(hash, AbstractPlan::Hash());
+}
+
+bool AppendPlan::operator==(const AbstractPlan &rhs) const {
+  if (GetPlanNodeType() != rhs.GetPlanNodeType()) return false;
+  return AbstractPlan::operator==(rhs);
+}
+
+}  // namespace planner
+}  // namespace peloton
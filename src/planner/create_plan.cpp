@@ -15,6 +15,8 @@
 #include "common/internal_types.h"
 #include "expression/abstract_expression.h"
 #include "expression/constant_value_expression.h"
+#include "expression/expression_util.h"
+#include "expression/tuple_value_expression.h"
 #include "storage/data_table.h"
 
 namespace peloton {
@@ -176,6 +178,23 @@ CreatePlan::CreatePlan(parser::CreateStatement *parse_tree) {
       index_type = parse_tree->index_type;
 
       unique = parse_tree->unique;
+
+      // The predicate is evaluated on tuples of the table, so every column
+      // reference reads its bound column
+      if (parse_tree->index_predicate != nullptr) {
+        index_predicate.reset(parse_tree->index_predicate->Copy());
+        ExprSet column_refs;
+        expression::ExpressionUtil::GetTupleValueExprs(column_refs,
+                                                       index_predicate.get());
+        ExprMap column_ids;
+        for (auto *expr : column_refs) {
+          auto *column_ref =
+              static_cast<expression::TupleValueExpression *>(expr);
+          column_ids[expr] = std::get<2>(column_ref->GetBoundOid());
+        }
+        expression::ExpressionUtil::EvaluateExpression({column_ids},
+                                                       index_predicate.get());
+      }
       break;
     }
 
@@ -11,10 +11,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "planner/index_scan_plan.h"
+#include "codegen/query_parameters_map.h"
 #include "common/internal_types.h"
 #include "expression/constant_value_expression.h"
 #include "expression/expression_util.h"
 #include "storage/data_table.h"
+#include "util/hash_util.h"
 
 namespace peloton {
 namespace planner {
@@ -94,5 +96,126 @@ void IndexScanPlan::SetParameterValues(std::vector<type::Value> *values) {
   }
 }
 
+/*
+ * Hash() - The key values themselves are parameters of the compiled query,
+ *          so only their types (and whether they are bound late) are hashed
+ */
+hash_t IndexScanPlan::Hash() const {
+  auto type = GetPlanNodeType();
+  hash_t hash = HashUtil::Hash(&type);
+
+  hash = HashUtil::CombineHashes(hash, GetTable()->Hash());
+  if (GetPredicate() != nullptr) {
+    hash = HashUtil::CombineHashes(hash, GetPredicate()->Hash());
+  }
+
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&index_id_));
+
+  for (auto &column_id : column_ids_) {
+    hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&column_id));
+  }
+
+  for (auto &key_column_id : key_column_ids_) {
+    hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&key_column_id));
+  }
+
+  for (auto &expr_type : expr_types_) {
+    hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&expr_type));
+  }
+
+  for (auto &value : values_with_params_) {
+    auto type_id = value.GetTypeId();
+    hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&type_id));
+  }
+
+  auto is_update = IsForUpdate();
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&is_update));
+
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&limit_));
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&limit_number_));
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&limit_offset_));
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&descend_));
+
+  return HashUtil::CombineHashes(hash, AbstractPlan::Hash());
+}
+
+bool IndexScanPlan::operator==(const AbstractPlan &rhs) const {
+  if (GetPlanNodeType() != rhs.GetPlanNodeType()) return false;
+
+  auto &other = static_cast<const planner::IndexScanPlan &>(rhs);
+  auto *table = GetTable();
+  auto *other_table = other.GetTable();
+  PELOTON_ASSERT(table && other_table);
+  if (*table != *other_table) return false;
+
+  // Predicate
+  auto *pred = GetPredicate();
+  auto *other_pred = other.GetPredicate();
+  if ((pred == nullptr && other_pred != nullptr) ||
+      (pred != nullptr && other_pred == nullptr))
+    return false;
+  if (pred && *pred != *other_pred) return false;
+
+  // Index and key
+  if (index_id_ != other.index_id_ || column_ids_ != other.column_ids_ ||
+      key_column_ids_ != other.key_column_ids_ ||
+      expr_types_ != other.expr_types_)
+    return false;
+
+  // Key value types
+  size_t value_count = values_with_params_.size();
+  if (value_count != other.values_with_params_.size()) return false;
+  for (size_t i = 0; i < value_count; i++) {
+    if (values_with_params_[i].GetTypeId() !=
+        other.values_with_params_[i].GetTypeId()) {
+      return false;
+    }
+  }
+
+  if (IsForUpdate() != other.IsForUpdate()) return false;
+
+  if (limit_ != other.limit_ || limit_number_ != other.limit_number_ ||
+      limit_offset_ != other.limit_offset_ || descend_ != other.descend_)
+    return false;
+
+  return AbstractPlan::operator==(rhs);
+}
+
+/*
+ * VisitParameters() - Registers the key values, in order, followed by the
+ *                     parameters of the predicate. Placeholders take the
+ *                     user's value cast to the type of their key column.
+ */
+void IndexScanPlan::VisitParameters(
+    codegen::QueryParametersMap &map, std::vector<peloton::type::Value> &values,
+    const std::vector<peloton::type::Value> &values_from_user) {
+  AbstractPlan::VisitParameters(map, values, values_from_user);
+
+  for (uint32_t i = 0; i < values_with_params_.size(); i++) {
+    const auto &value = values_with_params_[i];
+    if (value.GetTypeId() == type::TypeId::PARAMETER_OFFSET) {
+      auto &column = GetTable()->GetSchema()->GetColumn(key_column_ids_[i]);
+      auto column_type = column.GetType();
+      auto offset = value.GetAs<int32_t>();
+      auto bound_value = values_from_user.at(offset).CastAs(column_type);
+      map.Insert(expression::Parameter::CreateParamParameter(
+                     column_type, bound_value.IsNull()),
+                 &value);
+      values.push_back(bound_value);
+    } else {
+      map.Insert(expression::Parameter::CreateConstParameter(
+                     value.GetTypeId(), value.IsNull()),
+                 &value);
+      values.push_back(value);
+    }
+  }
+
+  auto *predicate =
+      const_cast<expression::AbstractExpression *>(GetPredicate());
+  if (predicate != nullptr) {
+    predicate->VisitParameters(map, values, values_from_user);
+  }
+}
+
 }  // namespace planner
 }  // namespace peloton
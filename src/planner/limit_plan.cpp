@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// limit_plan.cpp
+//
+// Identification: src/planner/limit_plan.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "planner/limit_plan.h"
+
+#include "codegen/query_parameters_map.h"
+#include "type/value_factory.h"
+#include "util/hash_util.h"
+
+namespace peloton {
+namespace planner {
+
+// The limit and offset are query parameters, so they don't take part in the
+// hash. Queries that only differ in them (e.g., pages of the same result)
+// share their compiled code.
+hash_t LimitPlan::Hash() const {
+  auto type = GetPlanNodeType();
+  hash_t hash = HashUtil::Hash(&type);
+  return HashUtil::CombineHashes(hash, AbstractPlan::Hash());
+}
+
+bool LimitPlan::operator==(const AbstractPlan &rhs) const {
+  if (GetPlanNodeType() != rhs.GetPlanNodeType()) return false;
+  return AbstractPlan::operator==(rhs);
+}
+
+void LimitPlan::VisitParameters(
+    codegen::QueryParametersMap &map, std::vector<peloton::type::Value> &values,
+    const std::vector<peloton::type::Value> &values_from_user) {
+  AbstractPlan::VisitParameters(map, values, values_from_user);
+
+  map.Insert(expression::Parameter::CreateConstParameter(
+                 type::TypeId::BIGINT, false),
+             &limit_);
+  values.push_back(
+      type::ValueFactory::GetBigIntValue(static_cast<int64_t>(limit_)));
+
+  map.Insert(expression::Parameter::CreateConstParameter(
+                 type::TypeId::BIGINT, false),
+             &offset_);
+  values.push_back(
+      type::ValueFactory::GetBigIntValue(static_cast<int64_t>(offset_)));
+}
+
+}  // namespace planner
+}  // namespace peloton
@@ -15,7 +15,10 @@
 
 #include "planner/order_by_plan.h"
 
+#include "codegen/query_parameters_map.h"
 #include "expression/abstract_expression.h"
+#include "type/value_factory.h"
+#include "util/hash_util.h"
 
 namespace peloton {
 namespace planner {
@@ -71,6 +74,10 @@ hash_t OrderByPlan::Hash() const {
     hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&col_id));
   }
 
+  // The limit and offset themselves are query parameters
+  bool limit = GetLimit();
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&limit));
+
   return HashUtil::CombineHashes(hash, AbstractPlan::Hash());
 }
 
@@ -103,8 +110,33 @@ bool OrderByPlan::operator==(const AbstractPlan &rhs) const {
     if (GetOutputColumnIds()[i] != other.GetOutputColumnIds()[i]) return false;
   }
 
+  // Limit
+  if (GetLimit() != other.GetLimit()) return false;
+
   return AbstractPlan::operator==(rhs);
 }
 
+void OrderByPlan::VisitParameters(
+    codegen::QueryParametersMap &map, std::vector<peloton::type::Value> &values,
+    const std::vector<peloton::type::Value> &values_from_user) {
+  AbstractPlan::VisitParameters(map, values, values_from_user);
+
+  if (!limit_) {
+    return;
+  }
+
+  map.Insert(expression::Parameter::CreateConstParameter(
+                 type::TypeId::BIGINT, false),
+             &limit_number_);
+  values.push_back(
+      type::ValueFactory::GetBigIntValue(static_cast<int64_t>(limit_number_)));
+
+  map.Insert(expression::Parameter::CreateConstParameter(
+                 type::TypeId::BIGINT, false),
+             &limit_offset_);
+  values.push_back(
+      type::ValueFactory::GetBigIntValue(static_cast<int64_t>(limit_offset_)));
+}
+
 }  // namespace planner
 }  // namespace peloton
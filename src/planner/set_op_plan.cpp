@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// set_op_plan.cpp
+//
+// Identification: src/planner/set_op_plan.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "planner/set_op_plan.h"
+
+#include "util/hash_util.h"
+
+namespace peloton {
+namespace planner {
+
+void SetOpPlan::PerformBinding(BindingContext &binding_context) {
+  const auto &children = GetChildren();
+  PELOTON_ASSERT(children.size() == 2);
+
+  // The left child binds into the output context, the right into its own
+  BindingContext right_context;
+  children[0]->PerformBinding(binding_context);
+  children[1]->PerformBinding(right_context);
+
+  // Both children have the same physical schema, so their columns are numbered
+  // the same way
+  input_ais_.assign(2, {});
+  for (oid_t col_id = 0; binding_context.Find(col_id) != nullptr; col_id++) {
+    PELOTON_ASSERT(right_context.Find(col_id) != nullptr);
+    input_ais_[0].push_back(binding_context.Find(col_id));
+    input_ais_[1].push_back(right_context.Find(col_id));
+  }
+}
+
+hash_t SetOpPlan::Hash() const {
+  auto type = GetPlanNodeType();
+  hash_t hash = HashUtil::Hash(&type);
+
+  auto set_op = GetSetOp();
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&set_op));
+
+  return HashUtil::CombineHashes(hash, AbstractPlan::Hash());
+}
+
+bool SetOpPlan::operator==(const AbstractPlan &rhs) const {
+  if (GetPlanNodeType() != rhs.GetPlanNodeType()) return false;
+
+  auto &other = static_cast<const planner::SetOpPlan &>(rhs);
+  if (GetSetOp() != other.GetSetOp()) return false;
+
+  return AbstractPlan::operator==(rhs);
+}
+
+}  // namespace planner
+}  // namespace peloton
@@ -0,0 +1,36 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// memory_metric.cpp
+//
+// Identification: src/statistics/memory_metric.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "statistics/memory_metric.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+MemoryMetric::MemoryMetric(MetricType type) : AbstractMetric(type) {
+  Reset();
+}
+
+void MemoryMetric::Aggregate(AbstractMetric &source) {
+  PELOTON_ASSERT(source.GetType() == MetricType::MEMORY);
+
+  auto &memory_metric = static_cast<MemoryMetric &>(source);
+  tile_bytes_ += memory_metric.GetTileBytes();
+  header_bytes_ += memory_metric.GetHeaderBytes();
+  varlen_bytes_ += memory_metric.GetVarlenBytes();
+  indirection_bytes_ += memory_metric.GetIndirectionBytes();
+  version_bytes_ += memory_metric.GetVersionBytes();
+  index_bytes_ += memory_metric.GetIndexBytes();
+}
+
+}  // namespace stats
+}  // namespace peloton
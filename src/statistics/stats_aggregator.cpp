@@ -256,6 +256,10 @@ void StatsAggregator::UpdateTableMetrics(storage::Database *database,
     auto updates = table_access.GetUpdates();
     auto deletes = table_access.GetDeletes();
     auto inserts = table_access.GetInserts();
+    // memory is a gauge, so take a fresh sample instead of accumulating
+    auto &table_memory = table_metrics->GetTableMemory();
+    table_memory.Reset();
+    table->GetMemoryFootprint(table_memory);
     // insert record into table metrics catalog
     auto table_metrics_catalog = catalog::Catalog::GetInstance()
                                      ->GetSystemCatalogs(database_oid)
@@ -267,6 +271,7 @@ void StatsAggregator::UpdateTableMetrics(storage::Database *database,
                                               deletes,
                                               inserts,
                                               time_stamp,
+                                              table_memory,
                                               pool_.get());
     LOG_TRACE("Table Metric Tuple inserted");
 
@@ -293,6 +298,9 @@ void StatsAggregator::UpdateIndexMetrics(storage::Database *database,
     auto reads = index_access.GetReads();
     auto deletes = index_access.GetDeletes();
     auto inserts = index_access.GetInserts();
+    auto &index_memory = index_metric->GetIndexMemory();
+    index_memory.Reset();
+    index_memory.IncrementIndexBytes(index->GetMemoryFootprint());
     // insert record into index metrics catalog
     auto index_metrics_catalog = catalog::Catalog::GetInstance()
                                      ->GetSystemCatalogs(database_oid)
@@ -304,6 +312,7 @@ void StatsAggregator::UpdateIndexMetrics(storage::Database *database,
                                               deletes,
                                               inserts,
                                               time_stamp,
+                                              index_memory.GetIndexBytes(),
                                               pool_.get());
   }
 }
@@ -0,0 +1,317 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bitmap_index.cpp
+//
+// Identification: src/storage/bitmap_index.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/bitmap_index.h"
+
+#include <algorithm>
+
+#include "catalog/schema.h"
+#include "executor/executor_context.h"
+#include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/abstract_table.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace storage {
+
+namespace {
+
+// Values read from a tile may point into tile storage, so we take a private
+// copy of variable-length data before holding on to it
+type::Value CopyValue(const type::Value &value) {
+  if (value.IsNull()) {
+    return value;
+  }
+  switch (value.GetTypeId()) {
+    case type::TypeId::VARCHAR:
+      return type::ValueFactory::GetVarcharValue(value.GetData(),
+                                                 value.GetLength(), true);
+    case type::TypeId::VARBINARY:
+      return type::ValueFactory::GetVarbinaryValue(
+          reinterpret_cast<const unsigned char *>(value.GetData()),
+          value.GetLength(), true);
+    default:
+      return value;
+  }
+}
+
+}  // namespace
+
+//===----------------------------------------------------------------------===//
+// BitmapPredicate
+//===----------------------------------------------------------------------===//
+
+bool BitmapPredicate::CollectTerms(
+    const expression::AbstractExpression *predicate,
+    std::vector<TermExpression> &terms) {
+  if (predicate == nullptr) {
+    return false;
+  }
+
+  // Every conjunct we can answer narrows the candidates, the rest is left to
+  // the regular predicate evaluation
+  if (predicate->GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+    bool left = CollectTerms(predicate->GetChild(0), terms);
+    bool right = CollectTerms(predicate->GetChild(1), terms);
+    return left || right;
+  }
+
+  TermExpression term;
+  if (!GetTerm(predicate, term)) {
+    return false;
+  }
+  terms.push_back(std::move(term));
+  return true;
+}
+
+bool BitmapPredicate::AddPredicate(
+    const expression::AbstractExpression *predicate) {
+  std::vector<TermExpression> term_exprs;
+  CollectTerms(predicate, term_exprs);
+
+  // Parameter values are only known when the query runs, so terms that
+  // reference them are skipped
+  bool added = false;
+  for (const auto &term_expr : term_exprs) {
+    Term term{term_expr.col_id, {}};
+    for (const auto *value : term_expr.values) {
+      if (value->GetExpressionType() != ExpressionType::VALUE_CONSTANT) {
+        break;
+      }
+      term.values.push_back(
+          static_cast<const expression::ConstantValueExpression *>(value)
+              ->GetValue());
+    }
+    if (term.values.size() == term_expr.values.size()) {
+      terms_.push_back(std::move(term));
+      added = true;
+    }
+  }
+  return added;
+}
+
+bool BitmapPredicate::GetTerm(const expression::AbstractExpression *expr,
+                              TermExpression &term) {
+  auto is_value = [](const expression::AbstractExpression *e) {
+    return e->GetExpressionType() == ExpressionType::VALUE_CONSTANT ||
+           e->GetExpressionType() == ExpressionType::VALUE_PARAMETER;
+  };
+
+  switch (expr->GetExpressionType()) {
+    case ExpressionType::COMPARE_EQUAL: {
+      // One side must be a column of the scanned table, the other a constant
+      // or a parameter
+      const auto *left = expr->GetChild(0);
+      const auto *right = expr->GetChild(1);
+      if (is_value(left)) {
+        std::swap(left, right);
+      }
+      if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+          !is_value(right)) {
+        return false;
+      }
+      auto *column =
+          static_cast<const expression::TupleValueExpression *>(left);
+      if (column->GetTupleId() != 0 || column->GetColumnId() < 0) {
+        return false;
+      }
+      term.col_id = static_cast<oid_t>(column->GetColumnId());
+      term.values = {right};
+      return true;
+    }
+    case ExpressionType::CONJUNCTION_OR: {
+      // An IN-list arrives as a disjunction of equalities on the same column
+      TermExpression left, right;
+      if (!GetTerm(expr->GetChild(0), left) ||
+          !GetTerm(expr->GetChild(1), right) || left.col_id != right.col_id) {
+        return false;
+      }
+      term.col_id = left.col_id;
+      term.values = std::move(left.values);
+      term.values.insert(term.values.end(), right.values.begin(),
+                         right.values.end());
+      return true;
+    }
+    default: { return false; }
+  }
+}
+
+void BitmapPredicate::Init(BitmapPredicate &bitmap_predicate) {
+  new (&bitmap_predicate) BitmapPredicate();
+}
+
+void BitmapPredicate::AddTerm(BitmapPredicate &bitmap_predicate,
+                              uint32_t col_id) {
+  bitmap_predicate.terms_.push_back(Term{col_id, {}});
+}
+
+void BitmapPredicate::AddValue(BitmapPredicate &bitmap_predicate,
+                               executor::ExecutorContext &ctx,
+                               uint32_t param_idx) {
+  PELOTON_ASSERT(!bitmap_predicate.terms_.empty());
+  const auto &values = ctx.GetParamValues();
+  PELOTON_ASSERT(param_idx < values.size());
+  bitmap_predicate.terms_.back().values.push_back(values[param_idx]);
+}
+
+void BitmapPredicate::Destroy(BitmapPredicate &bitmap_predicate) {
+  bitmap_predicate.~BitmapPredicate();
+}
+
+//===----------------------------------------------------------------------===//
+// BitmapIndex
+//===----------------------------------------------------------------------===//
+
+std::unique_ptr<BitmapIndex> BitmapIndex::Build(TileGroup &tile_group,
+                                                uint32_t max_cardinality) {
+  auto *table = tile_group.GetAbstractTable();
+  uint32_t tuple_count = tile_group.GetNextTupleSlot();
+  if (table == nullptr || tuple_count == 0 || max_cardinality == 0) {
+    return nullptr;
+  }
+
+  std::unique_ptr<BitmapIndex> index{new BitmapIndex(tuple_count)};
+
+  const auto *schema = table->GetSchema();
+  for (oid_t col_id = 0; col_id < schema->GetColumnCount(); col_id++) {
+    ColumnBitmaps column;
+    std::unordered_map<type::Value, uint32_t, type::Value::hash,
+                       type::Value::equal_to> positions;
+
+    bool low_cardinality = true;
+    for (uint32_t tid = 0; tid < tuple_count && low_cardinality; tid++) {
+      type::Value value = tile_group.GetValue(tid, col_id);
+
+      // NULLs never satisfy an equality, they don't need a bitmap
+      if (value.IsNull()) {
+        continue;
+      }
+
+      auto iter = positions.find(value);
+      if (iter == positions.end()) {
+        if (positions.size() == max_cardinality) {
+          low_cardinality = false;
+          break;
+        }
+        value = CopyValue(value);
+        iter = positions.emplace(value, column.values.size()).first;
+        column.values.push_back(value);
+        column.bitmaps.emplace_back(index->num_words_, 0);
+      }
+      column.bitmaps[iter->second][tid / 64] |= (1ull << (tid % 64));
+    }
+
+    if (low_cardinality && !column.values.empty()) {
+      index->columns_.emplace(col_id, std::move(column));
+    }
+  }
+
+  if (index->columns_.empty()) {
+    return nullptr;
+  }
+
+  LOG_DEBUG("Built bitmap indexes on %zu column(s) of tile group %u",
+            index->columns_.size(), tile_group.GetTileGroupId());
+  return index;
+}
+
+size_t BitmapIndex::GetCardinality(oid_t col_id) const {
+  auto iter = columns_.find(col_id);
+  return iter == columns_.end() ? 0 : iter->second.values.size();
+}
+
+bool BitmapIndex::Select(const BitmapPredicate &predicate, uint32_t tid_start,
+                         uint32_t tid_end, uint32_t *selection_vector,
+                         uint32_t &num_selected) const {
+  // Resolve every term on an indexed column into the bitmaps of its values.
+  // A term whose values never occur resolves to no bitmaps, and thus to no
+  // candidates at all.
+  std::vector<std::vector<const Bitmap *>> terms;
+  for (const auto &term : predicate.GetTerms()) {
+    auto iter = columns_.find(term.col_id);
+    if (iter == columns_.end()) {
+      continue;
+    }
+    const auto &column = iter->second;
+
+    std::vector<const Bitmap *> bitmaps;
+    for (const auto &value : term.values) {
+      if (value.IsNull()) {
+        continue;
+      }
+      for (uint32_t i = 0; i < column.values.size(); i++) {
+        if (value.CheckComparable(column.values[i]) &&
+            value.CompareEquals(column.values[i]) == CmpBool::CmpTrue) {
+          bitmaps.push_back(&column.bitmaps[i]);
+          break;
+        }
+      }
+    }
+    terms.push_back(std::move(bitmaps));
+  }
+
+  if (terms.empty()) {
+    return false;
+  }
+
+  num_selected = 0;
+
+  // AND the terms together, OR-ing the bitmaps of every term's values
+  uint32_t covered_end = std::min(tid_end, tuple_count_);
+  for (uint32_t tid = tid_start; tid < covered_end;) {
+    uint32_t word_idx = tid / 64;
+    uint64_t word = ~0ull;
+    for (const auto &bitmaps : terms) {
+      uint64_t term_word = 0;
+      for (const auto *bitmap : bitmaps) {
+        term_word |= (*bitmap)[word_idx];
+      }
+      word &= term_word;
+    }
+
+    // Mask out the bits outside of [tid, covered_end)
+    word &= ~0ull << (tid % 64);
+    uint32_t word_end = (word_idx + 1) * 64;
+    if (covered_end < word_end) {
+      word &= ~0ull >> (word_end - covered_end);
+    }
+
+    while (word != 0) {
+      selection_vector[num_selected++] =
+          word_idx * 64 + static_cast<uint32_t>(__builtin_ctzll(word));
+      word &= (word - 1);
+    }
+    tid = word_end;
+  }
+
+  // Slots that did not exist when the bitmaps were built are candidates
+  for (uint32_t tid = std::max(tid_start, covered_end); tid < tid_end; tid++) {
+    selection_vector[num_selected++] = tid;
+  }
+  return true;
+}
+
+size_t BitmapIndex::GetMemoryFootprint() const {
+  size_t bytes = sizeof(BitmapIndex);
+  for (const auto &entry : columns_) {
+    const auto &column = entry.second;
+    bytes += column.bitmaps.size() * num_words_ * sizeof(uint64_t);
+    bytes += column.values.size() * sizeof(type::Value);
+  }
+  return bytes;
+}
+
+}  // namespace storage
+}  // namespace peloton
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <mutex>
 #include <utility>
 
@@ -26,8 +27,10 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
 #include "gc/gc_manager_factory.h"
+#include "index/covering_payload_store.h"
 #include "index/index.h"
 #include "logging/log_manager.h"
+#include "statistics/memory_metric.h"
 #include "storage/abstract_table.h"
 #include "storage/data_table.h"
 #include "storage/database.h"
@@ -87,8 +90,11 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
   }
 
   // Create indirection layers.
-  for (size_t i = 0; i < active_indirection_array_count_; ++i) {
-    AddDefaultIndirectionArray(i);
+  {
+    std::lock_guard<std::mutex> lock(indirection_array_mutex_);
+    for (size_t i = 0; i < active_indirection_array_count_; ++i) {
+      AddDefaultIndirectionArray(i);
+    }
   }
 }
 
@@ -121,9 +127,9 @@ DataTable::~DataTable() {
   }
   foreign_key_sources_.clear();
 
-  // drop all indirection arrays
-  for (auto indirection_array : active_indirection_arrays_) {
-    auto oid = indirection_array->GetOid();
+  // drop all indirection arrays, including the retired ones
+  for (auto &entry : indirection_arrays_) {
+    auto oid = entry.second->GetOid();
     catalog_manager.DropIndirectionArray(oid);
   }
   // AbstractTable cleans up the schema
@@ -440,15 +446,15 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
           active_indirection_array->GetIndirectionByOffset(indirection_offset);
       break;
     }
+
+    // The array has neither fresh nor recycled indirections left
+    ReplaceIndirectionArray(active_indirection_array_id,
+                            active_indirection_array);
   }
 
   (*index_entry_ptr)->block = location.block;
   (*index_entry_ptr)->offset = location.offset;
 
-  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
-    AddDefaultIndirectionArray(active_indirection_array_id);
-  }
-
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
@@ -463,6 +469,8 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
   for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
     auto index = GetIndex(index_itr);
     if (index == nullptr) continue;
+    // A partial index only holds the tuples satisfying its predicate
+    if (index->GetMetadata()->IndexesTuple(tuple) == false) continue;
     auto index_schema = index->GetKeySchema();
     auto indexed_columns = index_schema->GetIndexedColumns();
     std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
@@ -474,12 +482,13 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
         // get unique tuple from primary/unique index.
         // if in this index there has been a visible or uncommitted
         // <key, location> pair, this constraint is violated
-        res = index->CondInsertEntry(key.get(), *index_entry_ptr, fn);
+        res = CondInsertUniqueEntry(index.get(), *key, *index_entry_ptr, fn);
       } break;
 
       case IndexConstraintType::DEFAULT:
       default:
-        index->InsertEntry(key.get(), *index_entry_ptr);
+        // Goes to the side log while the index is being built
+        index->InsertOrLogEntry(key.get(), *index_entry_ptr);
         break;
     }
 
@@ -543,8 +552,26 @@ bool DataTable::InsertInSecondaryIndexes(
       }
     }
 
+    // A partial index may gain the tuple when a column of its predicate is
+    // updated, even if the key stays the same
+    auto index_metadata = index->GetMetadata();
+    bool predicate_updated = false;
+    for (auto col : index_metadata->GetPredicateAttrs()) {
+      if (targets_set.find(col) != targets_set.end()) {
+        predicate_updated = true;
+        break;
+      }
+    }
+
     // If attributes on key are not updated, skip the index update
-    if (updated == false) {
+    if (updated == false && predicate_updated == false) {
+      continue;
+    }
+
+    // The new version no longer belongs in the partial index. The entry of
+    // the old version is still visible to older snapshots, so the garbage
+    // collector unlinks it along with the old version.
+    if (index_metadata->IndexesTuple(tuple) == false) {
       continue;
     }
 
@@ -553,14 +580,25 @@ bool DataTable::InsertInSecondaryIndexes(
 
     key->SetFromTuple(tuple, indexed_columns, index->GetPool());
 
+    // With the key unchanged, the old version may already have the entry
+    if (updated == false) {
+      std::vector<ItemPointer *> entries;
+      index->ScanKey(key.get(), entries);
+      if (std::find(entries.begin(), entries.end(), index_entry_ptr) !=
+          entries.end()) {
+        continue;
+      }
+    }
+
     switch (index->GetIndexType()) {
       case IndexConstraintType::PRIMARY_KEY:
       case IndexConstraintType::UNIQUE: {
-        res = index->CondInsertEntry(key.get(), index_entry_ptr, fn);
+        res = CondInsertUniqueEntry(index.get(), *key, index_entry_ptr, fn);
       } break;
       case IndexConstraintType::DEFAULT:
       default:
-        index->InsertEntry(key.get(), index_entry_ptr);
+        // Goes to the side log while the index is being built
+        index->InsertOrLogEntry(key.get(), index_entry_ptr);
         break;
     }
     LOG_TRACE("Index constraint check on %s passed.", index->GetName().c_str());
@@ -568,6 +606,82 @@ bool DataTable::InsertInSecondaryIndexes(
   return res;
 }
 
+bool DataTable::CondInsertUniqueEntry(
+    index::Index *index, const storage::Tuple &key,
+    ItemPointer *index_entry_ptr,
+    const std::function<bool(const void *)> &is_occupied) {
+  // The indirection may have been recycled, with an entry of its previous
+  // tuple still in place. Such entries neither conflict with the new tuple
+  // nor need to be inserted again.
+  bool has_own_entry = false;
+  bool conflict = false;
+  std::function<bool(const void *)> fn = [&](const void *position_ptr) {
+    auto entry = static_cast<ItemPointer *>(const_cast<void *>(position_ptr));
+    if (entry == index_entry_ptr) {
+      has_own_entry = true;
+      return false;
+    }
+    if (is_occupied(position_ptr) == false ||
+        TupleMayHaveKey(entry, index, key) == false) {
+      return false;
+    }
+    conflict = true;
+    return true;
+  };
+
+  if (index->CondInsertEntry(&key, index_entry_ptr, fn) == true) {
+    return true;
+  }
+  return has_own_entry == true && conflict == false;
+}
+
+bool DataTable::TupleMayHaveKey(ItemPointer *index_entry_ptr,
+                                index::Index *index,
+                                const storage::Tuple &key) {
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto index_schema = index->GetKeySchema();
+  ItemPointer location = *index_entry_ptr;
+
+  // The head version is checked even before its header points back at the
+  // indirection, as inserts fill in the index before the header
+  bool head = true;
+  while (location.IsNull() == false) {
+    auto tile_group = storage_manager->GetTileGroup(location.block);
+    if (tile_group == nullptr) {
+      break;
+    }
+    auto tile_group_header = tile_group->GetHeader();
+    if (head == true) {
+      // An update installs its index entries before linking its version in,
+      // so the key of a tuple being written cannot be known
+      if (tile_group_header->GetTransactionId(location.offset) !=
+          INITIAL_TXN_ID) {
+        return true;
+      }
+    } else if (tile_group_header->GetIndirection(location.offset) !=
+               index_entry_ptr) {
+      // An older version that has already been recycled
+      break;
+    }
+
+    ContainerTuple<storage::TileGroup> version(tile_group.get(),
+                                               location.offset);
+    if (index->GetMetadata()->IndexesTuple(&version) == true) {
+      std::unique_ptr<storage::Tuple> version_key(
+          new storage::Tuple(index_schema, true));
+      version_key->SetFromTuple(&version, index_schema->GetIndexedColumns(),
+                                index->GetPool());
+      if (version_key->EqualsNoSchemaCheck(key) == true) {
+        return true;
+      }
+    }
+
+    head = false;
+    location = tile_group_header->GetNextItemPointer(location.offset);
+  }
+  return false;
+}
+
 /**
  * @brief This function checks any other table which has a foreign key
  *constraint
@@ -888,6 +1002,9 @@ oid_t DataTable::AddDefaultIndirectionArray(
   std::shared_ptr<IndirectionArray> indirection_array(
       new IndirectionArray(indirection_array_id));
   manager.AddIndirectionArray(indirection_array_id, indirection_array);
+  indirection_arrays_[indirection_array->GetBaseIndirection()] =
+      indirection_array;
+  indirection_array_count_++;
 
   COMPILER_MEMORY_FENCE;
 
@@ -896,6 +1013,66 @@ oid_t DataTable::AddDefaultIndirectionArray(
   return indirection_array_id;
 }
 
+void DataTable::ReplaceIndirectionArray(
+    const size_t &active_indirection_array_id,
+    const std::shared_ptr<IndirectionArray> &indirection_array) {
+  std::lock_guard<std::mutex> lock(indirection_array_mutex_);
+
+  // Another thread has already replaced it
+  if (active_indirection_arrays_[active_indirection_array_id] !=
+      indirection_array) {
+    return;
+  }
+
+  AddDefaultIndirectionArray(active_indirection_array_id);
+
+  // The GC may have freed every indirection while we were racing for the lock
+  if (indirection_array->Retire() == true) {
+    ReleaseIndirectionArray(indirection_array);
+  }
+}
+
+void DataTable::ReleaseIndirectionArray(
+    const std::shared_ptr<IndirectionArray> &indirection_array) {
+  LOG_TRACE("Releasing indirection array %u of table %u",
+            indirection_array->GetOid(), table_oid);
+
+  auto &manager = catalog::Manager::GetInstance();
+  manager.DropIndirectionArray(indirection_array->GetOid());
+  indirection_arrays_.erase(indirection_array->GetBaseIndirection());
+  indirection_array_count_--;
+}
+
+void DataTable::FreeIndirection(ItemPointer *indirection) {
+  PELOTON_ASSERT(indirection != nullptr);
+
+  // Drop the payloads covering indexes recorded for the indirection
+  for (oid_t index_itr = 0; index_itr < GetIndexCount(); index_itr++) {
+    auto index = GetIndex(index_itr);
+    if (index != nullptr && index->GetPayloadStore() != nullptr) {
+      index->GetPayloadStore()->Erase(indirection);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(indirection_array_mutex_);
+
+  // Find the array with the greatest base address not above the indirection
+  auto itr = indirection_arrays_.upper_bound(indirection);
+  if (itr == indirection_arrays_.begin()) {
+    return;
+  }
+  --itr;
+
+  auto indirection_array = itr->second;
+  if (indirection_array->ContainsIndirection(indirection) == false) {
+    return;
+  }
+
+  if (indirection_array->FreeIndirection(indirection) == true) {
+    ReleaseIndirectionArray(indirection_array);
+  }
+}
+
 oid_t DataTable::AddDefaultTileGroup() {
   size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
   return AddDefaultTileGroup(active_tile_group_id);
@@ -1396,6 +1573,34 @@ void DataTable::UpdateTriggerListFromCatalog(
       ->GetTriggers(txn, table_oid);
 }
 
+void DataTable::GetMemoryFootprint(stats::MemoryMetric &memory) const {
+  auto tile_group_count = GetTileGroupCount();
+  for (std::size_t offset = 0; offset < tile_group_count; offset++) {
+    auto tile_group = GetTileGroup(offset);
+    // Tile groups that have been dropped are no longer resident
+    if (tile_group == nullptr) continue;
+
+    // Width of a full tuple across all tiles of the group, used to estimate
+    // the space pinned by versions that have not been reclaimed yet
+    std::size_t tuple_length = 0;
+    for (oid_t tile_itr = 0; tile_itr < tile_group->GetTileCount();
+         tile_itr++) {
+      auto tile = tile_group->GetTile(tile_itr);
+      memory.IncrementTileBytes(tile->GetInlinedSize());
+      memory.IncrementVarlenBytes(tile->GetPool()->GetMemoryFootprint());
+      tuple_length += tile->GetSchema()->GetLength();
+    }
+
+    auto header = tile_group->GetHeader();
+    memory.IncrementHeaderBytes(header->GetMemoryFootprint());
+    memory.IncrementVersionBytes(header->GetObsoleteVersionCount() *
+                                 tuple_length);
+  }
+
+  memory.IncrementIndirectionBytes(indirection_array_count_.load() *
+                                   IndirectionArray::GetMemoryFootprint());
+}
+
 hash_t DataTable::Hash() const {
   auto oid = GetOid();
   hash_t hash = HashUtil::Hash(&oid);
@@ -31,7 +31,7 @@ namespace storage {
 
 Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
            const catalog::Schema &tuple_schema, TileGroup *tile_group,
-           int tuple_count)
+           int tuple_count, int numa_node)
     : database_id(INVALID_OID),
       table_id(INVALID_OID),
       tile_group_id(INVALID_OID),
@@ -39,6 +39,7 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
       backend_type(backend_type),
       schema(tuple_schema),
       data(NULL),
+      numa_node(numa_node),
       tile_group(tile_group),
       pool(NULL),
       num_tuple_slots(tuple_count),
@@ -57,11 +58,17 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
   // data = reinterpret_cast<char *>(
   // storage_manager.Allocate(backend_type, tile_size));
 
-  data = new char[tile_size];
-  PELOTON_ASSERT(data != NULL);
+  if (numa_node != NumaUtil::kInvalidNode) {
+    // place the tuple slots on the requested node; the pages are zero-filled
+    data = reinterpret_cast<char *>(NumaUtil::Allocate(tile_size, numa_node));
+    PELOTON_ASSERT(data != NULL);
+  } else {
+    data = new char[tile_size];
+    PELOTON_ASSERT(data != NULL);
 
-  // zero out the data
-  PELOTON_MEMSET(data, 0, tile_size);
+    // zero out the data
+    PELOTON_MEMSET(data, 0, tile_size);
+  }
 
   // allocate pool for blob storage if schema not inlined
   // if (schema.IsInlined() == false) {
@@ -74,7 +81,11 @@ Tile::~Tile() {
   // auto &storage_manager = storage::StorageManager::GetInstance();
   // storage_manager.Release(backend_type, data);
 
-  delete[] data;
+  if (numa_node != NumaUtil::kInvalidNode) {
+    NumaUtil::Free(data, tile_size);
+  } else {
+    delete[] data;
+  }
   data = NULL;
 
   // reclaim the tile memory (UNINLINED data)
@@ -195,7 +206,7 @@ Tile *Tile::CopyTile(BackendType backend_type) {
   TileGroupHeader *new_header = GetHeader();
   Tile *new_tile = TileFactory::GetTile(
       backend_type, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
-      new_header, *schema, tile_group, allocated_tuple_count);
+      new_header, *schema, tile_group, allocated_tuple_count, numa_node);
 
   PELOTON_MEMCPY(static_cast<void *>(new_tile->data), static_cast<void *>(data),
             tile_size);
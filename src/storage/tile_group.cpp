@@ -19,7 +19,9 @@
 #include "common/internal_types.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "settings/settings_manager.h"
 #include "storage/abstract_table.h"
+#include "storage/bitmap_index.h"
 #include "storage/layout.h"
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
@@ -32,7 +34,8 @@ namespace storage {
 TileGroup::TileGroup(BackendType backend_type,
                      TileGroupHeader *tile_group_header, AbstractTable *table,
                      const std::vector<catalog::Schema> &schemas,
-                     std::shared_ptr<const Layout> layout, int tuple_count)
+                     std::shared_ptr<const Layout> layout, int tuple_count,
+                     int numa_node)
     : database_id(INVALID_OID),
       table_id(INVALID_OID),
       tile_group_id(INVALID_OID),
@@ -40,7 +43,8 @@ TileGroup::TileGroup(BackendType backend_type,
       tile_group_header(tile_group_header),
       table(table),
       num_tuple_slots_(tuple_count),
-      tile_group_layout_(layout) {
+      tile_group_layout_(layout),
+      numa_node_(numa_node) {
   tile_count_ = schemas.size();
   for (oid_t tile_itr = 0; tile_itr < tile_count_; tile_itr++) {
     StorageManager *storage_manager = storage::StorageManager::GetInstance();
@@ -48,7 +52,7 @@ TileGroup::TileGroup(BackendType backend_type,
 
     std::shared_ptr<Tile> tile(storage::TileFactory::GetTile(
         backend_type, database_id, table_id, tile_group_id, tile_id,
-        tile_group_header, schemas[tile_itr], this, tuple_count));
+        tile_group_header, schemas[tile_itr], this, tuple_count, numa_node));
 
     // Add a reference to the tile in the tile group
     tiles.push_back(tile);
@@ -346,6 +350,30 @@ void TileGroup::Sync() {
   }
 }
 
+bool TileGroup::SetImmutability() {
+  if (!tile_group_header->SetImmutability()) {
+    return false;
+  }
+
+  // The contents no longer change, so bitmaps built now stay exact
+  auto max_cardinality = settings::SettingsManager::GetInt(
+      settings::SettingId::bitmap_index_max_cardinality);
+  if (max_cardinality > 0) {
+    std::shared_ptr<const BitmapIndex> bitmap_index{
+        BitmapIndex::Build(*this, static_cast<uint32_t>(max_cardinality))};
+    std::atomic_store(&bitmap_index_, bitmap_index);
+  }
+  return true;
+}
+
+bool TileGroup::ResetImmutability() {
+  if (!tile_group_header->ResetImmutability()) {
+    return false;
+  }
+  std::atomic_store(&bitmap_index_, std::shared_ptr<const BitmapIndex>());
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
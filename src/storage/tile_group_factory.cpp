@@ -11,6 +11,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "storage/tile_group_factory.h"
+
+#include "common/numa.h"
 // #include "logging/logging_util.h"
 #include "storage/tile_group_header.h"
 
@@ -36,9 +38,17 @@ TileGroup *TileGroupFactory::GetTileGroup(
     throw NullPointerException("Layout of the TileGroup must be non-null.");
   }
 
+  // Place the tiles on the NUMA node of the thread that triggered the
+  // allocation, i.e., the thread that is about to insert into them
+  int numa_node = NumaUtil::kInvalidNode;
+  if (NumaUtil::IsNumaAware()) {
+    numa_node = NumaUtil::GetCurrentNode();
+  }
+
   TileGroupHeader *tile_header = new TileGroupHeader(backend_type, tuple_count);
-  TileGroup *tile_group = new TileGroup(backend_type, tile_header, table,
-                                        schemas, layout, tuple_count);
+  TileGroup *tile_group =
+      new TileGroup(backend_type, tile_header, table, schemas, layout,
+                    tuple_count, numa_node);
 
   tile_header->SetTileGroup(tile_group);
 
@@ -224,5 +224,20 @@ oid_t TileGroupHeader::GetActiveTupleCount() const {
   return active_tuple_slots;
 }
 
+oid_t TileGroupHeader::GetObsoleteVersionCount() const {
+  oid_t obsolete_tuple_slots = 0;
+
+  oid_t active_tuple_slots = GetCurrentNextTupleSlot();
+  for (oid_t tuple_slot_id = START_OID; tuple_slot_id < active_tuple_slots;
+       tuple_slot_id++) {
+    if (GetTransactionId(tuple_slot_id) != INVALID_TXN_ID &&
+        GetEndCommitId(tuple_slot_id) != MAX_CID) {
+      obsolete_tuple_slots++;
+    }
+  }
+
+  return obsolete_tuple_slots;
+}
+
 }  // namespace storage
 }  // namespace peloton
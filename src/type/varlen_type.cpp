@@ -17,6 +17,7 @@
 #include "type/type_util.h"
 #include "type/value_factory.h"
 #include "type/abstract_pool.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace type {
@@ -49,10 +50,11 @@ const char *VarlenType::GetData(const Value &val) const {
 // Get the length of the variable length data (including the length field)
 uint32_t VarlenType::GetLength(const Value &val) const { return val.size_.len; }
 
-// Access the raw varlen data stored from the tuple storage
+// Access the raw varlen data stored from the tuple storage. Only values that
+// spilled into the varlen pool have data to hand out, short values are inlined
+// into the slot itself.
 char *VarlenType::GetData(char *storage) {
-  char *ptr = *reinterpret_cast<char **>(storage);
-  return ptr;
+  return VarlenSlot::GetOutOfLineData(storage);
 }
 
 CmpBool VarlenType::CompareEquals(const Value &left, const Value &right) const {
@@ -172,30 +174,18 @@ void VarlenType::SerializeTo(const Value &val, SerializeOutput &out) const {
 void VarlenType::SerializeTo(const Value &val, char *storage,
                              bool inlined UNUSED_ATTRIBUTE,
                              AbstractPool *pool) const {
-  uint32_t len = GetLength(val);
-  char *data;
-  if (len == PELOTON_VALUE_NULL) {
-    data = nullptr;
-  } else {
-    uint32_t size = len + sizeof(uint32_t);
-    data = (pool == nullptr) ? new char[size] : (char *)pool->Allocate(size);
-    PELOTON_MEMCPY(data, &len, sizeof(uint32_t));
-    PELOTON_MEMCPY(data + sizeof(uint32_t), val.value_.varlen,
-              size - sizeof(uint32_t));
-  }
-  *reinterpret_cast<const char **>(storage) = data;
+  VarlenSlot::Store(storage, val.value_.varlen, GetLength(val), pool);
 }
 
 // Deserialize a value of the given type from the given storage space.
 Value VarlenType::DeserializeFrom(const char *storage,
                                   const bool inlined UNUSED_ATTRIBUTE,
                                   AbstractPool *pool UNUSED_ATTRIBUTE) const {
-  const char *ptr = *reinterpret_cast<const char *const *>(storage);
-  if (ptr == nullptr) {
+  if (VarlenSlot::IsNull(storage)) {
     return Value(type_id_, nullptr, 0, false);
   }
-  uint32_t len = *reinterpret_cast<const uint32_t *>(ptr);
-  return Value(type_id_, ptr + sizeof(uint32_t), len, false);
+  return Value(type_id_, VarlenSlot::GetData(storage),
+               VarlenSlot::GetLength(storage), false);
 }
 Value VarlenType::DeserializeFrom(SerializeInput &in UNUSED_ATTRIBUTE,
                                   AbstractPool *pool UNUSED_ATTRIBUTE) const {
@@ -14,6 +14,7 @@
 #include "codegen/proxy/runtime_functions_proxy.h"
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "expression/comparison_expression.h"
 #include "expression/conjunction_expression.h"
 #include "expression/tuple_value_expression.h"
@@ -455,5 +456,200 @@ TEST_F(GroupByTranslatorTest, MinAndMax) {
               CmpBool::CmpTrue);
 }
 
+//===----------------------------------------------------------------------===//
+// Aggregations over a table with many small tile groups, so that the table is
+// scanned in parallel and the partial aggregates of each thread are merged
+//===----------------------------------------------------------------------===//
+
+namespace {
+const uint32_t kTuplesPerTileGroup = 20;
+const uint32_t kNumRows = 2000;
+const uint32_t kNumGroups = 50;
+}  // namespace
+
+class ParallelGroupByTranslatorTest : public PelotonCodeGenTest {
+ public:
+  ParallelGroupByTranslatorTest() : PelotonCodeGenTest(kTuplesPerTileGroup) {
+    LoadGroupedRows();
+  }
+
+  oid_t TestTableId() const { return test_table_oids[0]; }
+
+  // Column 'a' cycles through kNumGroups values, so that each group appears in
+  // every tile group. Column 'b' is the row ID.
+  void LoadGroupedRows() {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto *txn = txn_manager.BeginTransaction();
+
+    auto &test_table = GetTestTable(TestTableId());
+    auto *table_schema = test_table.GetSchema();
+    auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+    for (uint32_t rowid = 0; rowid < kNumRows; rowid++) {
+      storage::Tuple tuple{table_schema, true};
+      auto group = static_cast<int32_t>(rowid % kNumGroups);
+      tuple.SetValue(0, type::ValueFactory::GetIntegerValue(group));
+      tuple.SetValue(1, type::ValueFactory::GetIntegerValue(rowid));
+      tuple.SetValue(2, type::ValueFactory::GetDecimalValue(rowid));
+      tuple.SetValue(3, type::ValueFactory::GetVarcharValue(
+                            std::to_string(rowid)), testing_pool);
+
+      ItemPointer *index_entry_ptr = nullptr;
+      ItemPointer tuple_slot_id =
+          test_table.InsertTuple(&tuple, txn, &index_entry_ptr);
+      txn_manager.PerformInsert(txn, tuple_slot_id, index_entry_ptr);
+    }
+
+    txn_manager.CommitTransaction(txn);
+  }
+};
+
+TEST_F(ParallelGroupByTranslatorTest, HashAggregation) {
+  //
+  // SELECT a, COUNT(*), SUM(b), MIN(b), MAX(b), AVG(b) FROM table GROUP BY a;
+  //
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}, {2, {1, 1}},
+                                   {3, {1, 2}}, {4, {1, 3}}, {5, {1, 4}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup the aggregations
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1)},
+      {ExpressionType::AGGREGATE_SUM,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1)},
+      {ExpressionType::AGGREGATE_MIN,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1)},
+      {ExpressionType::AGGREGATE_MAX,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1)},
+      {ExpressionType::AGGREGATE_AVG,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1)}};
+
+  // 3) The grouping column
+  std::vector<oid_t> gb_cols = {0};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::TypeId::INTEGER, 4, "COL_A"},
+                           {type::TypeId::BIGINT, 8, "COUNT_*"},
+                           {type::TypeId::INTEGER, 4, "SUM_B"},
+                           {type::TypeId::INTEGER, 4, "MIN_B"},
+                           {type::TypeId::INTEGER, 4, "MAX_B"},
+                           {type::TypeId::DECIMAL, 8, "AVG_B"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+
+  // 6) The scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(TestTableId()), nullptr, {0, 1}, false, true)};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3, 4, 5}, context};
+
+  // Compile and run, making sure the scan feeding the aggregation was
+  // actually run in parallel
+  auto stats = CompileAndExecute(*agg_plan, buffer);
+  EXPECT_LT(0, stats.compile_stats.num_parallel_pipelines);
+
+  // Each group must appear exactly once, with the aggregates over all its rows,
+  // no matter which threads saw them
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(kNumGroups, results.size());
+
+  const int32_t rows_per_group = kNumRows / kNumGroups;
+  const int32_t num_groups = kNumGroups;
+  for (const auto &tuple : results) {
+    int32_t group = tuple.GetValue(0).GetAs<int32_t>();
+    int32_t sum = 0;
+    for (int32_t i = 0; i < rows_per_group; i++) {
+      sum += group + i * num_groups;
+    }
+    EXPECT_EQ(rows_per_group, tuple.GetValue(1).GetAs<int64_t>());
+    EXPECT_EQ(sum, tuple.GetValue(2).GetAs<int32_t>());
+    EXPECT_EQ(group, tuple.GetValue(3).GetAs<int32_t>());
+    EXPECT_EQ(group + (rows_per_group - 1) * num_groups,
+              tuple.GetValue(4).GetAs<int32_t>());
+    EXPECT_DOUBLE_EQ(static_cast<double>(sum) / rows_per_group,
+                     tuple.GetValue(5).GetAs<double>());
+  }
+}
+
+TEST_F(ParallelGroupByTranslatorTest, GlobalAggregation) {
+  //
+  // SELECT COUNT(*), SUM(b), MIN(b), MAX(b) FROM table;
+  //
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {
+      {0, {1, 0}}, {1, {1, 1}}, {2, {1, 2}}, {3, {1, 3}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup the aggregations
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1)},
+      {ExpressionType::AGGREGATE_SUM,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1)},
+      {ExpressionType::AGGREGATE_MIN,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1)},
+      {ExpressionType::AGGREGATE_MAX,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1)}};
+
+  // 3) No grouping
+  std::vector<oid_t> gb_cols = {};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::TypeId::BIGINT, 8, "COUNT_*"},
+                           {type::TypeId::INTEGER, 4, "SUM_B"},
+                           {type::TypeId::INTEGER, 4, "MIN_B"},
+                           {type::TypeId::INTEGER, 4, "MAX_B"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+
+  // 6) The scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(TestTableId()), nullptr, {0, 1}, false, true)};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+
+  // Compile and run, making sure the scan feeding the aggregation was
+  // actually run in parallel
+  auto stats = CompileAndExecute(*agg_plan, buffer);
+  EXPECT_LT(0, stats.compile_stats.num_parallel_pipelines);
+
+  // The row IDs 0 .. kNumRows - 1 were aggregated
+  const int32_t num_rows = kNumRows;
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(num_rows, results[0].GetValue(0).GetAs<int64_t>());
+  EXPECT_EQ(num_rows * (num_rows - 1) / 2,
+            results[0].GetValue(1).GetAs<int32_t>());
+  EXPECT_EQ(0, results[0].GetValue(2).GetAs<int32_t>());
+  EXPECT_EQ(num_rows - 1, results[0].GetValue(3).GetAs<int32_t>());
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "codegen/operator/hash_join_translator.h"
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -45,6 +46,99 @@ class HashJoinTranslatorTest : public PelotonCodeGenTest {
   storage::DataTable &GetRightTable() const {
     return GetTestTable(RightTableId());
   }
+
+  //
+  // SELECT
+  //   left_table.a, left_table.b [, right_table.a, right_table.b]
+  // FROM
+  //   left_table
+  // <join_type> JOIN
+  //   right_table ON left_table.a = right_table.a AND left_table.a < 100
+  //
+  // Semi and anti joins only produce the columns of the left table. The left
+  // table is the build side, the right table is scanned to probe the join, in
+  // parallel if requested.
+  //
+  std::unique_ptr<planner::HashJoinPlan> JoinOnA(JoinType join_type,
+                                                 bool parallel_probe) {
+    bool left_only =
+        join_type == JoinType::SEMI || join_type == JoinType::ANTI;
+
+    // Projection: [left_table.a, left_table.b, right_table.a, right_table.b]
+    DirectMapList direct_map_list = {std::make_pair(0, std::make_pair(0, 0)),
+                                     std::make_pair(1, std::make_pair(0, 1))};
+    std::vector<catalog::Column> columns = {
+        TestingExecutorUtil::GetColumnInfo(0),
+        TestingExecutorUtil::GetColumnInfo(1)};
+    if (!left_only) {
+      direct_map_list.push_back(std::make_pair(2, std::make_pair(1, 0)));
+      direct_map_list.push_back(std::make_pair(3, std::make_pair(1, 1)));
+      columns.push_back(TestingExecutorUtil::GetColumnInfo(0));
+      columns.push_back(TestingExecutorUtil::GetColumnInfo(1));
+    }
+    std::unique_ptr<planner::ProjectInfo> projection{
+        new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+    auto schema = std::shared_ptr<const catalog::Schema>(
+        new catalog::Schema(columns));
+
+    // Left and right hash keys
+    std::vector<ConstExpressionPtr> left_hash_keys;
+    left_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+    std::vector<ConstExpressionPtr> right_hash_keys;
+    right_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+    std::vector<ConstExpressionPtr> hash_keys;
+    hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+    // The residual predicate: left_table.a < 100
+    auto predicate = CmpLtExpr(ColRefExpr(type::TypeId::INTEGER, true, 0),
+                               ConstIntExpr(100));
+
+    std::unique_ptr<planner::HashJoinPlan> hj_plan{new planner::HashJoinPlan(
+        join_type, std::move(predicate), std::move(projection), schema,
+        left_hash_keys, right_hash_keys, true)};
+    std::unique_ptr<planner::HashPlan> hash_plan{
+        new planner::HashPlan(hash_keys)};
+
+    std::unique_ptr<planner::AbstractPlan> left_scan{
+        new planner::SeqScanPlan(&GetLeftTable(), nullptr, {0, 1, 2})};
+    std::unique_ptr<planner::AbstractPlan> right_scan{
+        new planner::SeqScanPlan(&GetRightTable(), nullptr, {0, 1, 2}, false,
+                                 parallel_probe)};
+
+    hash_plan->AddChild(std::move(right_scan));
+    hj_plan->AddChild(std::move(left_scan));
+    hj_plan->AddChild(std::move(hash_plan));
+    return hj_plan;
+  }
+
+  // Run the given join, returning its output
+  std::vector<codegen::WrappedTuple> RunJoin(JoinType join_type,
+                                             bool parallel_probe = false) {
+    auto hj_plan = JoinOnA(join_type, parallel_probe);
+
+    // Do binding
+    planner::BindingContext context;
+    hj_plan->PerformBinding(context);
+
+    // We collect the results of the query into an in-memory buffer
+    bool left_only =
+        join_type == JoinType::SEMI || join_type == JoinType::ANTI;
+    std::vector<oid_t> out_cols = {0, 1};
+    if (!left_only) {
+      out_cols.push_back(2);
+      out_cols.push_back(3);
+    }
+    codegen::BufferingConsumer buffer{out_cols, context};
+
+    // COMPILE and run
+    auto stats = CompileAndExecute(*hj_plan, buffer);
+    if (parallel_probe) {
+      EXPECT_LT(0, stats.compile_stats.num_parallel_pipelines);
+    }
+    return buffer.GetOutputTuples();
+  }
 };
 
 TEST_F(HashJoinTranslatorTest, SingleHashJoinColumnTest) {
@@ -127,5 +221,135 @@ TEST_F(HashJoinTranslatorTest, SingleHashJoinColumnTest) {
   }
 }
 
+TEST_F(HashJoinTranslatorTest, RadixPartitionedJoin) {
+  // The join is partitioned once the materialized build side reaches the
+  // threshold. Check the join right at the threshold, which the 20 rows of the
+  // left table reach, and just above it, which they don't. Either way, the
+  // left rows with a < 100 find their partner.
+  auto threshold = codegen::HashJoinTranslator::kRadixPartitionThreshold.load();
+  for (uint64_t join_threshold : {20, 21}) {
+    codegen::HashJoinTranslator::kRadixPartitionThreshold = join_threshold;
+    auto results = RunJoin(JoinType::INNER);
+
+    EXPECT_EQ(10, results.size());
+    for (const auto &tuple : results) {
+      EXPECT_LT(tuple.GetValue(0).GetAs<int32_t>(), 100);
+      EXPECT_EQ(CmpBool::CmpTrue,
+                tuple.GetValue(0).CompareEquals(tuple.GetValue(2)));
+      EXPECT_EQ(CmpBool::CmpTrue,
+                tuple.GetValue(1).CompareEquals(tuple.GetValue(3)));
+    }
+  }
+  codegen::HashJoinTranslator::kRadixPartitionThreshold = threshold;
+}
+
+TEST_F(HashJoinTranslatorTest, ParallelProbeJoin) {
+  // Threads probe the hash table with their share of the right table
+  auto results = RunJoin(JoinType::INNER, true);
+  EXPECT_EQ(10, results.size());
+  for (const auto &tuple : results) {
+    EXPECT_LT(tuple.GetValue(0).GetAs<int32_t>(), 100);
+    EXPECT_EQ(CmpBool::CmpTrue,
+              tuple.GetValue(0).CompareEquals(tuple.GetValue(2)));
+  }
+
+  // Once all threads are done probing, they produce the unmatched left rows
+  // in the epilogue, each from its own share of the hash table
+  results = RunJoin(JoinType::LEFT, true);
+  EXPECT_EQ(20, results.size());
+
+  uint32_t num_unmatched = 0;
+  for (const auto &tuple : results) {
+    num_unmatched += tuple.GetValue(2).IsNull() ? 1 : 0;
+  }
+  EXPECT_EQ(10, num_unmatched);
+
+  // With radix partitioning, the probe rows are partitioned once all threads
+  // buffered theirs, and the threads join the partitions in the epilogue
+  auto threshold = codegen::HashJoinTranslator::kRadixPartitionThreshold.load();
+  codegen::HashJoinTranslator::kRadixPartitionThreshold = 0;
+  results = RunJoin(JoinType::INNER, true);
+  codegen::HashJoinTranslator::kRadixPartitionThreshold = threshold;
+  EXPECT_EQ(10, results.size());
+}
+
+TEST_F(HashJoinTranslatorTest, LeftOuterJoin) {
+  // The left table has 20 rows. Those with a < 100 find their partner in the
+  // right table, the other ten are padded with NULLs.
+  auto results = RunJoin(JoinType::LEFT);
+  EXPECT_EQ(20, results.size());
+
+  uint32_t num_unmatched = 0;
+  for (const auto &tuple : results) {
+    auto a = tuple.GetValue(0).GetAs<int32_t>();
+    if (a < 100) {
+      EXPECT_EQ(CmpBool::CmpTrue,
+                tuple.GetValue(0).CompareEquals(tuple.GetValue(2)));
+    } else {
+      EXPECT_TRUE(tuple.GetValue(2).IsNull());
+      EXPECT_TRUE(tuple.GetValue(3).IsNull());
+      num_unmatched++;
+    }
+  }
+  EXPECT_EQ(10, num_unmatched);
+}
+
+TEST_F(HashJoinTranslatorTest, RightOuterJoin) {
+  // The right table has 80 rows. Ten find their partner in the left table, the
+  // other 70 are padded with NULLs.
+  auto results = RunJoin(JoinType::RIGHT);
+  EXPECT_EQ(80, results.size());
+
+  uint32_t num_unmatched = 0;
+  for (const auto &tuple : results) {
+    if (tuple.GetValue(0).IsNull()) {
+      EXPECT_TRUE(tuple.GetValue(1).IsNull());
+      num_unmatched++;
+    } else {
+      EXPECT_EQ(CmpBool::CmpTrue,
+                tuple.GetValue(0).CompareEquals(tuple.GetValue(2)));
+    }
+  }
+  EXPECT_EQ(70, num_unmatched);
+}
+
+TEST_F(HashJoinTranslatorTest, FullOuterJoin) {
+  // Ten matches, ten unmatched rows from the left and 70 from the right
+  auto results = RunJoin(JoinType::OUTER);
+  EXPECT_EQ(90, results.size());
+
+  uint32_t num_left_unmatched = 0, num_right_unmatched = 0;
+  for (const auto &tuple : results) {
+    if (tuple.GetValue(0).IsNull()) {
+      num_right_unmatched++;
+    } else if (tuple.GetValue(2).IsNull()) {
+      num_left_unmatched++;
+    } else {
+      EXPECT_EQ(CmpBool::CmpTrue,
+                tuple.GetValue(0).CompareEquals(tuple.GetValue(2)));
+    }
+  }
+  EXPECT_EQ(10, num_left_unmatched);
+  EXPECT_EQ(70, num_right_unmatched);
+}
+
+TEST_F(HashJoinTranslatorTest, SemiJoin) {
+  // The left rows with a < 100 have a partner, each is produced exactly once
+  auto results = RunJoin(JoinType::SEMI);
+  EXPECT_EQ(10, results.size());
+  for (const auto &tuple : results) {
+    EXPECT_LT(tuple.GetValue(0).GetAs<int32_t>(), 100);
+  }
+}
+
+TEST_F(HashJoinTranslatorTest, AntiJoin) {
+  // The left rows with a >= 100 have no partner
+  auto results = RunJoin(JoinType::ANTI);
+  EXPECT_EQ(10, results.size());
+  for (const auto &tuple : results) {
+    EXPECT_GE(tuple.GetValue(0).GetAs<int32_t>(), 100);
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
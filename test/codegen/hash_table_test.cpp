@@ -314,5 +314,102 @@ TEST_F(HashTableTest, ParallelMerge) {
   }
 }
 
+TEST_F(HashTableTest, ParallelPartition) {
+  constexpr uint32_t num_threads = 4;
+  constexpr uint32_t num_partitions = 4;
+  constexpr uint32_t to_insert = 20000;
+
+  // Partitions are chosen by the high bits of the hash, which the test key's
+  // hash doesn't use. Put the low bits of the second key part there.
+  auto hash_fn = [](const Key &k) {
+    return k.Hash() ^ (static_cast<uint64_t>(k.k2) << 62);
+  };
+
+  // Allocate hash tables for each thread
+  executor::ExecutorContext exec_ctx{nullptr};
+
+  auto &thread_states = exec_ctx.GetThreadStates();
+  thread_states.Reset(sizeof(codegen::util::HashTable));
+  thread_states.Allocate(num_threads);
+
+  // The partitions
+  std::unique_ptr<char[]> partition_space{
+      new char[sizeof(codegen::util::HashTable) * num_partitions]};
+  auto *partitions =
+      reinterpret_cast<codegen::util::HashTable *>(partition_space.get());
+  for (uint32_t part = 0; part < num_partitions; part++) {
+    codegen::util::HashTable::Init(partitions[part], exec_ctx, sizeof(Key),
+                                   sizeof(Value));
+  }
+
+  // Insert keys disjoint from other threads, then partition them
+  auto insert_fn = [&exec_ctx, &hash_fn, partitions](uint64_t tid) {
+    auto *table = reinterpret_cast<codegen::util::HashTable *>(
+        exec_ctx.GetThreadStates().AccessThreadState(tid));
+    codegen::util::HashTable::Init(*table, exec_ctx, sizeof(Key),
+                                   sizeof(Value));
+
+    for (uint32_t i = tid * to_insert, end = i + to_insert; i != end; i++) {
+      Key k{static_cast<uint32_t>(tid), i};
+      Value v = {.v1 = k.k2, .v2 = k.k1, .v3 = 3, .v4 = 4444};
+      table->TypedInsertLazy(hash_fn(k), k, v);
+    }
+
+    table->PartitionLazyUnfinished(partitions, num_partitions);
+    EXPECT_EQ(0, table->NumElements());
+  };
+  LaunchParallelTest(num_threads, insert_fn);
+
+  // Clean up local tables
+  for (uint32_t tid = 0; tid < num_threads; tid++) {
+    auto *table = reinterpret_cast<codegen::util::HashTable *>(
+        thread_states.AccessThreadState(tid));
+    codegen::util::HashTable::Destroy(*table);
+  }
+
+  // Build each partition in parallel
+  auto build_fn = [partitions](uint64_t part) {
+    partitions[part].BuildLazy();
+  };
+  LaunchParallelTest(num_partitions, build_fn);
+
+  // Every key must be in its partition exactly once
+  for (uint32_t part = 0; part < num_partitions; part++) {
+    EXPECT_EQ(to_insert * num_threads / num_partitions,
+              partitions[part].NumElements());
+  }
+  for (uint32_t tid = 0; tid < num_threads; tid++) {
+    for (uint32_t i = tid * to_insert, end = i + to_insert; i != end; i++) {
+      Key key{tid, i};
+      uint32_t count = 0;
+      std::function<void(const Value &v)> f = [&key, &count](const Value &v) {
+        EXPECT_EQ(key.k2, v.v1);
+        EXPECT_EQ(key.k1, v.v2);
+        count++;
+      };
+      partitions[i % num_partitions].TypedProbe(hash_fn(key), key, f);
+      EXPECT_EQ(1, count) << "Key " << key << " not found in its partition";
+    }
+  }
+
+  for (uint32_t part = 0; part < num_partitions; part++) {
+    codegen::util::HashTable::Destroy(partitions[part]);
+  }
+}
+
+TEST_F(HashTableTest, NumPartitions) {
+  using HashTable = codegen::util::HashTable;
+
+  // Too few entries to partition
+  EXPECT_EQ(0, HashTable::NumPartitions(99, 100, 10, 64));
+
+  // At least two partitions, and a power of two of them
+  EXPECT_EQ(2, HashTable::NumPartitions(100, 100, 1000, 64));
+  EXPECT_EQ(16, HashTable::NumPartitions(150, 100, 10, 64));
+
+  // No more than the maximum
+  EXPECT_EQ(64, HashTable::NumPartitions(100000, 100, 10, 64));
+}
+
 }  // namespace test
 }  // namespace peloton
\ No newline at end of file
@@ -0,0 +1,152 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_translator_test.cpp
+//
+// Identification: test/codegen/index_scan_translator_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "expression/comparison_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "index/index.h"
+#include "planner/index_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+class IndexScanTranslatorTest : public PelotonCodeGenTest {
+ public:
+  IndexScanTranslatorTest() : PelotonCodeGenTest(), num_rows_to_insert(64) {
+    // Load the test table with the primary key on column "a"
+    LoadTestTable(TestTableId(), num_rows_to_insert);
+  }
+
+  uint32_t NumRowsInTestTable() const { return num_rows_to_insert; }
+
+  oid_t TestTableId() { return test_table_oids[4]; }
+
+  // Build an index scan over the primary key of the test table, with a single
+  // key condition on column "a" that the predicate repeats
+  std::shared_ptr<planner::IndexScanPlan> IndexScan(ExpressionType cmp_type,
+                                                    const type::Value &key,
+                                                    ExpressionPtr &&pred) {
+    auto &table = GetTestTable(TestTableId());
+    planner::IndexScanPlan::IndexScanDesc desc{
+        table.GetIndex(0)->GetOid(), {0}, {cmp_type}, {key}, {}};
+    return std::shared_ptr<planner::IndexScanPlan>{new planner::IndexScanPlan(
+        &table, pred.release(), {0, 1, 2, 3}, desc)};
+  }
+
+ private:
+  uint32_t num_rows_to_insert = 64;
+};
+
+TEST_F(IndexScanTranslatorTest, PointLookup) {
+  //
+  // SELECT a, b FROM table WHERE a = 50;
+  //
+
+  auto a_eq_50 = CmpEqExpr(ColRefExpr(type::TypeId::INTEGER, 0),
+                           ConstIntExpr(50));
+  auto scan = IndexScan(ExpressionType::COMPARE_EQUAL,
+                        type::ValueFactory::GetIntegerValue(50),
+                        std::move(a_eq_50));
+
+  // Do binding
+  planner::BindingContext context;
+  scan->PerformBinding(context);
+
+  // Printing consumer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*scan, buffer);
+
+  // Check that we got the single matching row
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(CmpBool::CmpTrue, results[0].GetValue(0).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(50)));
+  EXPECT_EQ(CmpBool::CmpTrue, results[0].GetValue(1).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(51)));
+}
+
+TEST_F(IndexScanTranslatorTest, OpenRangeScan) {
+  //
+  // SELECT a, b FROM table WHERE a > 100;
+  //
+  // The index returns the boundary as well, which the predicate removes. The
+  // rows come out in key order.
+  //
+
+  auto a_gt_100 = CmpGtExpr(ColRefExpr(type::TypeId::INTEGER, 0),
+                            ConstIntExpr(100));
+  auto scan = IndexScan(ExpressionType::COMPARE_GREATERTHAN,
+                        type::ValueFactory::GetIntegerValue(100),
+                        std::move(a_gt_100));
+
+  // Do binding
+  planner::BindingContext context;
+  scan->PerformBinding(context);
+
+  // Printing consumer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*scan, buffer);
+
+  // Rows 11 to 63 match
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(NumRowsInTestTable() - 11, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    int32_t a = 10 * (i + 11);
+    EXPECT_EQ(CmpBool::CmpTrue, results[i].GetValue(0).CompareEquals(
+                                    type::ValueFactory::GetIntegerValue(a)));
+  }
+}
+
+TEST_F(IndexScanTranslatorTest, ParameterizedKey) {
+  //
+  // SELECT a, b FROM table WHERE a = ?;
+  //
+  // The key is a query parameter, so the second scan reuses the compiled query
+  // of the first.
+  //
+
+  bool cached;
+  for (int32_t key : {20, 630}) {
+    auto a_eq_param =
+        CmpEqExpr(ColRefExpr(type::TypeId::INTEGER, 0),
+                  ExpressionPtr{new expression::ParameterValueExpression(0)});
+    auto scan = IndexScan(ExpressionType::COMPARE_EQUAL,
+                          type::ValueFactory::GetParameterOffsetValue(0),
+                          std::move(a_eq_param));
+
+    planner::BindingContext context;
+    scan->PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+
+    std::vector<type::Value> params = {
+        type::ValueFactory::GetIntegerValue(key)};
+    CompileAndExecuteCache(scan, buffer, cached, params);
+
+    const auto &results = buffer.GetOutputTuples();
+    ASSERT_EQ(1, results.size());
+    EXPECT_EQ(CmpBool::CmpTrue, results[0].GetValue(0).CompareEquals(
+                                    type::ValueFactory::GetIntegerValue(key)));
+  }
+  EXPECT_TRUE(cached);
+}
+
+}  // namespace test
+}  // namespace peloton
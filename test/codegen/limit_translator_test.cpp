@@ -0,0 +1,192 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// limit_translator_test.cpp
+//
+// Identification: test/codegen/limit_translator_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <set>
+
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "expression/operator_expression.h"
+#include "planner/limit_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "settings/settings_manager.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+namespace {
+const uint32_t kTuplesPerTileGroup = 16;
+}  // namespace
+
+class LimitTranslatorTest : public PelotonCodeGenTest {
+ public:
+  LimitTranslatorTest()
+      : PelotonCodeGenTest(kTuplesPerTileGroup), num_rows_to_insert(64) {
+    // Load the test table, spreading it over a few tile groups
+    LoadTestTable(TestTableId(), num_rows_to_insert);
+  }
+
+  uint32_t NumRowsInTestTable() const { return num_rows_to_insert; }
+
+  oid_t TestTableId() { return test_table_oids[0]; }
+
+  // SELECT a, b FROM table WHERE <predicate> LIMIT <limit> OFFSET <offset>;
+  std::shared_ptr<planner::AbstractPlan> LimitOverScan(
+      size_t limit, size_t offset, ExpressionPtr &&predicate = nullptr) {
+    std::unique_ptr<planner::AbstractPlan> scan{new planner::SeqScanPlan(
+        &GetTestTable(TestTableId()), predicate.release(), {0, 1})};
+    std::shared_ptr<planner::AbstractPlan> limit_plan{
+        new planner::LimitPlan(limit, offset)};
+    limit_plan->AddChild(std::move(scan));
+    return limit_plan;
+  }
+
+ private:
+  uint32_t num_rows_to_insert = 64;
+};
+
+TEST_F(LimitTranslatorTest, Limit) {
+  //
+  // SELECT a, b FROM table LIMIT 10;
+  //
+
+  auto limit_plan = LimitOverScan(10, 0);
+
+  // Do binding
+  planner::BindingContext context;
+  limit_plan->PerformBinding(context);
+
+  // Printing consumer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*limit_plan, buffer);
+
+  // The table may be scanned in parallel, so we only check that we got ten
+  // distinct rows of the table
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(10, results.size());
+  std::set<int32_t> seen;
+  for (const auto &tuple : results) {
+    auto a = tuple.GetValue(0).GetAs<int32_t>();
+    EXPECT_EQ(0, a % 10);
+    EXPECT_LT(a, static_cast<int32_t>(10 * NumRowsInTestTable()));
+    EXPECT_TRUE(seen.insert(a).second);
+  }
+}
+
+TEST_F(LimitTranslatorTest, LimitWithOffset) {
+  //
+  // SELECT a, b FROM table LIMIT 10 OFFSET 60;
+  //
+  // Only the last four rows are left after the offset
+  //
+
+  {
+    auto limit_plan = LimitOverScan(10, 60);
+
+    planner::BindingContext context;
+    limit_plan->PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecute(*limit_plan, buffer);
+
+    EXPECT_EQ(NumRowsInTestTable() - 60, buffer.GetOutputTuples().size());
+  }
+
+  //
+  // SELECT a, b FROM table LIMIT 10 OFFSET 100;
+  //
+  // The offset is past the end of the table
+  //
+
+  {
+    auto limit_plan = LimitOverScan(10, 100);
+
+    planner::BindingContext context;
+    limit_plan->PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecute(*limit_plan, buffer);
+
+    EXPECT_EQ(0, buffer.GetOutputTuples().size());
+  }
+}
+
+TEST_F(LimitTranslatorTest, StopScanEarly) {
+  //
+  // SELECT a, b FROM table WHERE a / (a - 500) <= 0 LIMIT 5;
+  //
+  // The predicate divides by zero on the row with a = 500, which sits in the
+  // fourth tile group. A scan that stops once the limit is reached never gets
+  // there. We scan serially so the first tile group is visited first.
+  //
+
+  auto parallel_execution = settings::SettingsManager::GetBool(
+      settings::SettingId::parallel_execution);
+  settings::SettingsManager::SetBool(settings::SettingId::parallel_execution,
+                                     false);
+
+  auto a_minus_500 =
+      OpExpr(ExpressionType::OPERATOR_MINUS, type::TypeId::INTEGER,
+             ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(500));
+  auto a_div = OpExpr(ExpressionType::OPERATOR_DIVIDE, type::TypeId::INTEGER,
+                      ColRefExpr(type::TypeId::INTEGER, 0),
+                      std::move(a_minus_500));
+  auto predicate = CmpLteExpr(std::move(a_div), ConstIntExpr(0));
+  auto limit_plan = LimitOverScan(5, 0, std::move(predicate));
+
+  planner::BindingContext context;
+  limit_plan->PerformBinding(context);
+
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+  EXPECT_NO_THROW(CompileAndExecute(*limit_plan, buffer));
+
+  settings::SettingsManager::SetBool(settings::SettingId::parallel_execution,
+                                     parallel_execution);
+
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(5, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(CmpBool::CmpTrue,
+              results[i].GetValue(0).CompareEquals(
+                  type::ValueFactory::GetIntegerValue(10 * i)));
+  }
+}
+
+TEST_F(LimitTranslatorTest, ParameterizedLimit) {
+  //
+  // SELECT a, b FROM table LIMIT ? OFFSET ?;
+  //
+  // The limit and offset are query parameters, so paging through the table
+  // reuses the compiled query of the first page.
+  //
+
+  bool cached;
+  for (size_t page : {0, 1, 2}) {
+    auto limit_plan = LimitOverScan(25, 25 * page);
+
+    planner::BindingContext context;
+    limit_plan->PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecuteCache(limit_plan, buffer, cached);
+
+    auto expected = std::min<size_t>(25, NumRowsInTestTable() - 25 * page);
+    EXPECT_EQ(expected, buffer.GetOutputTuples().size());
+  }
+  EXPECT_TRUE(cached);
+}
+
+}  // namespace test
+}  // namespace peloton
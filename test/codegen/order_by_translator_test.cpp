@@ -193,5 +193,90 @@ TEST_F(OrderByTranslatorTest, MultiIntColMixedTest) {
       }));
 }
 
+TEST_F(OrderByTranslatorTest, SingleIntColDescWithLimitTest) {
+  //
+  // SELECT * FROM test_table ORDER BY a DESC LIMIT 5 OFFSET 3;
+  //
+  // The sorter retains only the top 8 rows. The offset is skipped by a limit
+  // above the sort, which isn't part of this plan.
+  //
+
+  // Load table with 20 rows
+  uint32_t num_test_rows = 20;
+  LoadTestTable(TestTableId(), num_test_rows);
+
+  std::unique_ptr<planner::OrderByPlan> order_by_plan{
+      new planner::OrderByPlan({0}, {true}, {0, 1, 2, 3})};
+  order_by_plan->SetLimit(true);
+  order_by_plan->SetLimitNumber(5);
+  order_by_plan->SetLimitOffset(3);
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(TestTableId()), nullptr, {0, 1, 2, 3})};
+
+  order_by_plan->AddChild(std::move(seq_scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  order_by_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*order_by_plan, buffer);
+
+  // The results should be the 8 largest values of a, in descending order
+  auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(8, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(static_cast<int32_t>(10 * (num_test_rows - 1 - i)),
+              results[i].GetValue(0).GetAs<int32_t>());
+  }
+}
+
+TEST_F(OrderByTranslatorTest, SingleIntColDescWithLimitFromCacheTest) {
+  //
+  // SELECT * FROM test_table ORDER BY a DESC LIMIT 5 OFFSET 3;
+  // SELECT * FROM test_table ORDER BY a DESC LIMIT 2 OFFSET 1;
+  //
+  // The second query reuses the compiled first one, which must pick up the
+  // new limit and offset
+  //
+
+  // Load table with 20 rows
+  uint32_t num_test_rows = 20;
+  LoadTestTable(TestTableId(), num_test_rows);
+
+  for (uint64_t limit : {5, 2}) {
+    uint64_t offset = limit == 5 ? 3 : 1;
+    std::shared_ptr<planner::OrderByPlan> order_by_plan{
+        new planner::OrderByPlan({0}, {true}, {0, 1, 2, 3}, limit, offset)};
+    std::unique_ptr<planner::SeqScanPlan> seq_scan_plan{
+        new planner::SeqScanPlan(&GetTestTable(TestTableId()), nullptr,
+                                 {0, 1, 2, 3})};
+    order_by_plan->AddChild(std::move(seq_scan_plan));
+
+    // Do binding
+    planner::BindingContext context;
+    order_by_plan->PerformBinding(context);
+
+    // We collect the results of the query into an in-memory buffer
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+
+    // COMPILE and execute
+    bool cached;
+    CompileAndExecuteCache(order_by_plan, buffer, cached);
+    EXPECT_EQ(limit == 2, cached);
+
+    // The sorter retains exactly (limit + offset) rows
+    auto &results = buffer.GetOutputTuples();
+    ASSERT_EQ(limit + offset, results.size());
+    for (uint32_t i = 0; i < results.size(); i++) {
+      EXPECT_EQ(static_cast<int32_t>(10 * (num_test_rows - 1 - i)),
+                results[i].GetValue(0).GetAs<int32_t>());
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
\ No newline at end of file
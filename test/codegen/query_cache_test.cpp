@@ -12,11 +12,17 @@
 
 #include "codegen/testing_codegen_util.h"
 
+#include <dirent.h>
+#include <unistd.h>
+
 #include "catalog/catalog.h"
 #include "codegen/query_cache.h"
+#include "codegen/query_compiler.h"
 #include "codegen/testing_codegen_util.h"
 #include "codegen/type/decimal_type.h"
 #include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
 #include "expression/conjunction_expression.h"
 #include "expression/operator_expression.h"
 #include "planner/aggregate_plan.h"
@@ -25,6 +31,7 @@
 #include "planner/nested_loop_join_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/seq_scan_plan.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace test {
@@ -695,5 +702,79 @@ TEST_F(QueryCacheTest, PerformanceBenchmark) {
   LOG_INFO("Time spent w/ codegen & cache is %f ms", timer2.GetDuration());
 }
 
+TEST_F(QueryCacheTest, TieredExecution) {
+  // SELECT b FROM table where a >= 40;
+  std::shared_ptr<planner::SeqScanPlan> scan = GetSeqScanPlan();
+  planner::BindingContext context;
+  scan->PerformBinding(context);
+
+  codegen::BufferingConsumer compile_buffer{{0}, context};
+  codegen::QueryParameters parameters(*scan, {});
+  auto query = codegen::QueryCompiler().Compile(
+      *scan, parameters.GetQueryParametersMap(), compile_buffer);
+  query->CompileInBackground();
+
+  // Run the query until it has switched to native code, which it must give
+  // the same results with
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  bool was_compiled;
+  do {
+    was_compiled = query->IsCompiled();
+
+    auto *txn = txn_manager.BeginTransaction();
+    executor::ExecutorContext exec_ctx{txn,
+                                       codegen::QueryParameters(*scan, {})};
+    codegen::BufferingConsumer buffer{{0}, context};
+    query->Execute(exec_ctx, buffer);
+    txn_manager.CommitTransaction(txn);
+
+    EXPECT_EQ(NumRowsInTestTable() - 4, buffer.GetOutputTuples().size());
+  } while (!was_compiled);
+}
+
+TEST_F(QueryCacheTest, PersistentObjectCache) {
+  char directory[] = "/tmp/peloton_object_cache_XXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(directory));
+  settings::SettingsManager::SetString(
+      settings::SettingId::codegen_object_cache_directory, directory);
+
+  // Compiling the query the first time stores its code, compiling the same
+  // query again finds it, even though it lives in a new code context
+  for (bool cached : {false, true}) {
+    // SELECT b FROM table where a >= 40;
+    std::shared_ptr<planner::SeqScanPlan> scan = GetSeqScanPlan();
+    planner::BindingContext context;
+    scan->PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0}, context};
+    codegen::QueryParameters parameters(*scan, {});
+    codegen::QueryCompiler::CompileStats stats;
+    auto query = codegen::QueryCompiler().Compile(
+        *scan, parameters.GetQueryParametersMap(), buffer, &stats);
+    EXPECT_EQ(cached, stats.object_cache_hit);
+    query->Compile();
+
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto *txn = txn_manager.BeginTransaction();
+    executor::ExecutorContext exec_ctx{txn, std::move(parameters)};
+    query->Execute(exec_ctx, buffer);
+    txn_manager.CommitTransaction(txn);
+
+    EXPECT_EQ(NumRowsInTestTable() - 4, buffer.GetOutputTuples().size());
+  }
+
+  settings::SettingsManager::SetString(
+      settings::SettingId::codegen_object_cache_directory, "");
+  DIR *dir = opendir(directory);
+  while (auto *entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name != "." && name != "..") {
+      unlink((std::string(directory) + "/" + name).c_str());
+    }
+  }
+  closedir(dir);
+  rmdir(directory);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,240 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// set_op_translator_test.cpp
+//
+// Identification: test/codegen/set_op_translator_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <map>
+
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "planner/append_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "planner/set_op_plan.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+namespace {
+const uint32_t kTuplesPerTileGroup = 16;
+}  // namespace
+
+class SetOpTranslatorTest : public PelotonCodeGenTest {
+ public:
+  SetOpTranslatorTest() : PelotonCodeGenTest(kTuplesPerTileGroup) {
+    // Load the test tables, spreading them over a few tile groups. The rows of
+    // the small table are the first rows of the large one.
+    LoadTestTable(SmallTableId(), 20);
+    LoadTestTable(LargeTableId(), 80);
+  }
+
+  oid_t SmallTableId() const { return test_table_oids[0]; }
+
+  oid_t LargeTableId() const { return test_table_oids[1]; }
+
+  // SELECT a, b FROM table
+  std::unique_ptr<planner::AbstractPlan> Scan(oid_t table_id,
+                                              bool parallel = false) {
+    return std::unique_ptr<planner::AbstractPlan>{new planner::SeqScanPlan(
+        &GetTestTable(table_id), nullptr, {0, 1}, false, parallel)};
+  }
+
+  // <input> UNION ALL <input> ...
+  std::unique_ptr<planner::AbstractPlan> UnionAll(
+      std::vector<std::unique_ptr<planner::AbstractPlan>> &&inputs) {
+    std::unique_ptr<planner::AbstractPlan> append{new planner::AppendPlan()};
+    for (auto &input : inputs) {
+      append->AddChild(std::move(input));
+    }
+    return append;
+  }
+
+  // <left> INTERSECT|EXCEPT [ALL] <right>
+  std::unique_ptr<planner::AbstractPlan> SetOp(
+      SetOpType set_op, std::unique_ptr<planner::AbstractPlan> &&left,
+      std::unique_ptr<planner::AbstractPlan> &&right) {
+    std::unique_ptr<planner::AbstractPlan> plan{new planner::SetOpPlan(set_op)};
+    plan->AddChild(std::move(left));
+    plan->AddChild(std::move(right));
+    return plan;
+  }
+
+  // Bind, compile and run the plan, returning how often it produced each
+  // value of "a". All rows must have b = a + 1.
+  std::map<int32_t, uint32_t> Run(planner::AbstractPlan &plan,
+                                  bool parallel = false) {
+    planner::BindingContext context;
+    plan.PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    auto stats = CompileAndExecute(plan, buffer);
+    if (parallel) {
+      EXPECT_LT(0, stats.compile_stats.num_parallel_pipelines);
+    }
+
+    std::map<int32_t, uint32_t> counts;
+    for (const auto &tuple : buffer.GetOutputTuples()) {
+      auto a = tuple.GetValue(0).GetAs<int32_t>();
+      EXPECT_EQ(a + 1, tuple.GetValue(1).GetAs<int32_t>());
+      counts[a]++;
+    }
+    return counts;
+  }
+};
+
+TEST_F(SetOpTranslatorTest, UnionAll) {
+  //
+  // SELECT a, b FROM small_table
+  // UNION ALL
+  // SELECT a, b FROM large_table
+  // UNION ALL
+  // SELECT a, b FROM small_table
+  //
+  // The first input streams through, the others are counted
+  //
+
+  std::vector<std::unique_ptr<planner::AbstractPlan>> inputs;
+  inputs.push_back(Scan(SmallTableId()));
+  inputs.push_back(Scan(LargeTableId()));
+  inputs.push_back(Scan(SmallTableId()));
+  auto plan = UnionAll(std::move(inputs));
+
+  auto counts = Run(*plan);
+  ASSERT_EQ(80, counts.size());
+  for (const auto &count : counts) {
+    EXPECT_EQ(count.first < 200 ? 3 : 1, count.second) << count.first;
+  }
+}
+
+TEST_F(SetOpTranslatorTest, ParallelUnionAll) {
+  //
+  // The same query as above, with all inputs scanned in parallel. The counted
+  // inputs are counted in thread-local tables, and the threads of the first
+  // input produce the counted rows in the epilogue.
+  //
+
+  std::vector<std::unique_ptr<planner::AbstractPlan>> inputs;
+  inputs.push_back(Scan(SmallTableId(), true));
+  inputs.push_back(Scan(LargeTableId(), true));
+  inputs.push_back(Scan(SmallTableId(), true));
+  auto plan = UnionAll(std::move(inputs));
+
+  auto counts = Run(*plan, true);
+  ASSERT_EQ(80, counts.size());
+  for (const auto &count : counts) {
+    EXPECT_EQ(count.first < 200 ? 3 : 1, count.second) << count.first;
+  }
+}
+
+TEST_F(SetOpTranslatorTest, Intersect) {
+  //
+  // SELECT a, b FROM large_table
+  // INTERSECT
+  // SELECT a, b FROM small_table
+  //
+
+  auto plan = SetOp(SetOpType::INTERSECT, Scan(LargeTableId()),
+                    Scan(SmallTableId()));
+
+  auto counts = Run(*plan);
+  ASSERT_EQ(20, counts.size());
+  for (const auto &count : counts) {
+    EXPECT_LT(count.first, 200);
+    EXPECT_EQ(1, count.second);
+  }
+}
+
+TEST_F(SetOpTranslatorTest, IntersectAll) {
+  //
+  // (SELECT a, b FROM small_table UNION ALL SELECT a, b FROM small_table)
+  // INTERSECT ALL
+  // (SELECT a, b FROM large_table UNION ALL SELECT a, b FROM small_table)
+  //
+  // Rows of the small table appear twice on both sides
+  //
+
+  std::vector<std::unique_ptr<planner::AbstractPlan>> left;
+  left.push_back(Scan(SmallTableId()));
+  left.push_back(Scan(SmallTableId()));
+  std::vector<std::unique_ptr<planner::AbstractPlan>> right;
+  right.push_back(Scan(LargeTableId()));
+  right.push_back(Scan(SmallTableId()));
+  auto plan = SetOp(SetOpType::INTERSECT_ALL, UnionAll(std::move(left)),
+                    UnionAll(std::move(right)));
+
+  auto counts = Run(*plan);
+  ASSERT_EQ(20, counts.size());
+  for (const auto &count : counts) {
+    EXPECT_LT(count.first, 200);
+    EXPECT_EQ(2, count.second);
+  }
+}
+
+TEST_F(SetOpTranslatorTest, Except) {
+  //
+  // SELECT a, b FROM large_table
+  // EXCEPT
+  // SELECT a, b FROM small_table
+  //
+
+  auto plan =
+      SetOp(SetOpType::EXCEPT, Scan(LargeTableId()), Scan(SmallTableId()));
+
+  auto counts = Run(*plan);
+  ASSERT_EQ(60, counts.size());
+  for (const auto &count : counts) {
+    EXPECT_GE(count.first, 200);
+    EXPECT_EQ(1, count.second);
+  }
+}
+
+TEST_F(SetOpTranslatorTest, ExceptAll) {
+  //
+  // (SELECT a, b FROM small_table UNION ALL SELECT a, b FROM large_table)
+  // EXCEPT ALL
+  // SELECT a, b FROM small_table
+  //
+  // One copy of each row of the small table survives
+  //
+
+  std::vector<std::unique_ptr<planner::AbstractPlan>> left;
+  left.push_back(Scan(SmallTableId()));
+  left.push_back(Scan(LargeTableId()));
+  auto plan = SetOp(SetOpType::EXCEPT_ALL, UnionAll(std::move(left)),
+                    Scan(SmallTableId()));
+
+  auto counts = Run(*plan);
+  ASSERT_EQ(80, counts.size());
+  for (const auto &count : counts) {
+    EXPECT_EQ(1, count.second) << count.first;
+  }
+}
+
+TEST_F(SetOpTranslatorTest, ParallelExceptAll) {
+  //
+  // The same query as above, with all inputs scanned in parallel
+  //
+
+  std::vector<std::unique_ptr<planner::AbstractPlan>> left;
+  left.push_back(Scan(SmallTableId(), true));
+  left.push_back(Scan(LargeTableId(), true));
+  auto plan = SetOp(SetOpType::EXCEPT_ALL, UnionAll(std::move(left)),
+                    Scan(SmallTableId(), true));
+
+  auto counts = Run(*plan, true);
+  ASSERT_EQ(80, counts.size());
+  for (const auto &count : counts) {
+    EXPECT_EQ(1, count.second) << count.first;
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -131,7 +131,7 @@ TEST_F(SorterTest, ParallelSortTest) {
     auto *sorter = reinterpret_cast<codegen::util::Sorter *>(
         thread_states.AccessThreadState(i));
     codegen::util::Sorter::Init(*sorter, ctx, CompareTuplesForAscending,
-                                sizeof(TestTuple));
+                                sizeof(TestTuple), 0);
     LoadSorter(*sorter, ntuples_per_sorter);
   }
 
@@ -162,5 +162,70 @@ TEST_F(SorterTest, ParallelSortTest) {
   }
 }
 
+TEST_F(SorterTest, TopKTest) {
+  ::peloton::type::EphemeralPool pool;
+
+  // Insert tuples with col_b = 999, 998, ..., 0, retaining the top 10
+  uint64_t top_k = 10;
+  codegen::util::Sorter sorter{pool, CompareTuplesForAscending,
+                               sizeof(TestTuple), top_k};
+  for (uint32_t i = 0; i < 1000; i++) {
+    auto *tuple = reinterpret_cast<TestTuple *>(sorter.StoreInputTuple());
+    tuple->col_a = i;
+    tuple->col_b = 999 - i;
+  }
+  sorter.Sort();
+
+  // Only the ten smallest tuples remain, in order
+  EXPECT_EQ(top_k, sorter.NumTuples());
+  uint32_t expected_col_b = 0;
+  for (auto iter : sorter) {
+    const auto *tt = reinterpret_cast<const TestTuple *>(iter);
+    EXPECT_EQ(expected_col_b++, tt->col_b);
+  }
+}
+
+TEST_F(SorterTest, ParallelTopKTest) {
+  // A fake executor context associated to no transaction
+  executor::ExecutorContext ctx(nullptr);
+
+  uint32_t num_threads = 4;
+  uint64_t top_k = 100;
+
+  // Allocate sorters for fake threads
+  auto &thread_states = ctx.GetThreadStates();
+  thread_states.Reset(sizeof(codegen::util::Sorter));
+  thread_states.Allocate(num_threads);
+
+  // Load each sorter, the last one with fewer tuples than the limit
+  uint32_t ntuples_per_sorter = 10000;
+  for (uint32_t i = 0; i < num_threads; i++) {
+    auto *sorter = reinterpret_cast<codegen::util::Sorter *>(
+        thread_states.AccessThreadState(i));
+    codegen::util::Sorter::Init(*sorter, ctx, CompareTuplesForAscending,
+                                sizeof(TestTuple), top_k);
+    LoadSorter(*sorter, i == num_threads - 1 ? top_k / 2 : ntuples_per_sorter);
+  }
+
+  {
+    codegen::util::Sorter main_sorter{*ctx.GetPool(), CompareTuplesForAscending,
+                                      sizeof(TestTuple), top_k};
+
+    // Sort parallel
+    main_sorter.SortParallel(thread_states, 0);
+
+    // Check main sorter is sorted and only has the top-k tuples
+    CheckSorted(main_sorter, true);
+    EXPECT_EQ(top_k, main_sorter.NumTuples());
+
+    // Clean up
+    for (uint32_t i = 0; i < num_threads; i++) {
+      auto *sorter = reinterpret_cast<codegen::util::Sorter *>(
+          thread_states.AccessThreadState(i));
+      codegen::util::Sorter::Destroy(*sorter);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
\ No newline at end of file
@@ -12,13 +12,16 @@
 
 #include "catalog/catalog.h"
 #include "catalog/system_catalogs.h"
+#include "codegen/operator/table_scan_translator.h"
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "expression/conjunction_expression.h"
 #include "expression/operator_expression.h"
 #include "planner/seq_scan_plan.h"
+#include "settings/settings_manager.h"
 #include "storage/storage_manager.h"
+#include "storage/tile_group.h"
 #include "storage/table_factory.h"
 
 #include "codegen/testing_codegen_util.h"
@@ -348,6 +351,117 @@ TEST_F(TableScanTranslatorTest, ScanWithConjunctionPredicate) {
                                   type::ValueFactory::GetIntegerValue(21)));
 }
 
+TEST_F(TableScanTranslatorTest, ScanWithBitmapIndex) {
+  //
+  // SELECT a, b FROM table where (b = 21 OR b = 41 OR b = 1001) AND a >= 30;
+  //
+  // The tile groups are frozen first, so the equalities are answered by their
+  // bitmap indexes
+  //
+
+  auto old_max_cardinality = settings::SettingsManager::GetInt(
+      settings::SettingId::bitmap_index_max_cardinality);
+  settings::SettingsManager::SetInt(
+      settings::SettingId::bitmap_index_max_cardinality, 64);
+
+  auto &table = GetTestTable(TestTableId());
+  for (oid_t i = 0; i < table.GetTileGroupCount(); i++) {
+    auto tile_group = table.GetTileGroup(i);
+    tile_group->SetImmutability();
+    EXPECT_NE(nullptr, tile_group->GetBitmapIndex());
+  }
+
+  // 1) Construct the components of the predicate
+
+  // b = 21 OR b = 41 OR b = 1001
+  ExpressionPtr b_eq_21 =
+      CmpEqExpr(ColRefExpr(type::TypeId::INTEGER, 1), ConstIntExpr(21));
+  ExpressionPtr b_eq_41 =
+      CmpEqExpr(ColRefExpr(type::TypeId::INTEGER, 1), ConstIntExpr(41));
+  ExpressionPtr b_eq_1001 =
+      CmpEqExpr(ColRefExpr(type::TypeId::INTEGER, 1), ConstIntExpr(1001));
+  auto *b_in_list = new expression::ConjunctionExpression(
+      ExpressionType::CONJUNCTION_OR,
+      new expression::ConjunctionExpression(ExpressionType::CONJUNCTION_OR,
+                                            b_eq_21.release(),
+                                            b_eq_41.release()),
+      b_eq_1001.release());
+
+  // a >= 30
+  ExpressionPtr a_gte_30 =
+      CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(30));
+
+  auto *conj = new expression::ConjunctionExpression(
+      ExpressionType::CONJUNCTION_AND, b_in_list, a_gte_30.release());
+
+  // 2) Setup the scan plan node
+  planner::SeqScanPlan scan{&table, conj, {0, 1}};
+
+  // 3) Do binding
+  planner::BindingContext context;
+  scan.PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(scan, buffer);
+
+  // Check output results, only b = 41 also satisfies a >= 30
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(CmpBool::CmpTrue, results[0].GetValue(0).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(40)));
+  EXPECT_EQ(CmpBool::CmpTrue, results[0].GetValue(1).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(41)));
+
+  settings::SettingsManager::SetInt(
+      settings::SettingId::bitmap_index_max_cardinality, old_max_cardinality);
+}
+
+TEST_F(TableScanTranslatorTest, ScanWithBitmapIndexFromCache) {
+  //
+  // SELECT a, b FROM table where b = 21;
+  // SELECT a, b FROM table where b = 41;
+  //
+  // The second query reuses the compiled first one, whose bitmap predicate
+  // must pick up the new constant
+  //
+
+  auto old_max_cardinality = settings::SettingsManager::GetInt(
+      settings::SettingId::bitmap_index_max_cardinality);
+  settings::SettingsManager::SetInt(
+      settings::SettingId::bitmap_index_max_cardinality, 64);
+
+  auto &table = GetTestTable(TestTableId());
+  for (oid_t i = 0; i < table.GetTileGroupCount(); i++) {
+    table.GetTileGroup(i)->SetImmutability();
+  }
+
+  for (int32_t b : {21, 41}) {
+    ExpressionPtr b_eq_const =
+        CmpEqExpr(ColRefExpr(type::TypeId::INTEGER, 1), ConstIntExpr(b));
+    std::shared_ptr<planner::SeqScanPlan> scan{
+        new planner::SeqScanPlan{&table, b_eq_const.release(), {0, 1}}};
+    planner::BindingContext context;
+    scan->PerformBinding(context);
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+
+    bool cached;
+    CompileAndExecuteCache(scan, buffer, cached);
+    EXPECT_EQ(b != 21, cached);
+
+    const auto &results = buffer.GetOutputTuples();
+    ASSERT_EQ(1, results.size());
+    EXPECT_EQ(CmpBool::CmpTrue,
+              results[0].GetValue(1).CompareEquals(
+                  type::ValueFactory::GetIntegerValue(b)));
+  }
+
+  settings::SettingsManager::SetInt(
+      settings::SettingId::bitmap_index_max_cardinality, old_max_cardinality);
+}
+
 TEST_F(TableScanTranslatorTest, ScanWithAddPredicate) {
   //
   // SELECT a, b FROM table where b = a + 1;
@@ -664,6 +778,51 @@ TEST_F(TableScanTranslatorTest, ScanColumnLayout) {
   ScanLayoutTable(tuples_per_tilegroup, tilegroup_count, column_count);
 }
 
+TEST_F(TableScanTranslatorTest, ScanColumnLayoutWithSimdPredicate) {
+  //
+  // SELECT * FROM table WHERE col_0 >= 37 AND 456 > col_1;
+  //
+  // The columns are contiguous, so the predicate is evaluated with SIMD
+  // instructions. Each tile group ends with a few tuples that don't fill a
+  // whole vector. The result must not depend on how we evaluate it.
+  //
+  uint32_t tuples_per_tilegroup = 100;
+  uint32_t tilegroup_count = 5;
+  uint32_t column_count = 3;
+  bool is_inlined = true;
+  CreateAndLoadTableWithLayout(LayoutType::COLUMN, tuples_per_tilegroup,
+                               tilegroup_count, column_count, is_inlined);
+
+  for (bool use_simd : {true, false}) {
+    codegen::TableScanTranslator::kUseSimdPredicates = use_simd;
+
+    auto col_0_gte_37 =
+        CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(37));
+    auto col_1_lt_456 =
+        CmpGtExpr(ConstIntExpr(456), ColRefExpr(type::TypeId::INTEGER, 1));
+    auto *predicate = new expression::ConjunctionExpression(
+        ExpressionType::CONJUNCTION_AND, col_0_gte_37.release(),
+        col_1_lt_456.release());
+    planner::SeqScanPlan scan{GetLayoutTable(), predicate, {0, 1, 2}};
+
+    planner::BindingContext context;
+    scan.PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0, 1, 2}, context};
+    CompileAndExecute(scan, buffer);
+
+    // The tuple with ID t has the value t + i in column i
+    const auto &results = buffer.GetOutputTuples();
+    ASSERT_EQ(418, results.size());
+    for (uint32_t i = 0; i < results.size(); i++) {
+      EXPECT_EQ(CmpBool::CmpTrue,
+                results[i].GetValue(0).CompareEquals(
+                    type::ValueFactory::GetIntegerValue(37 + i)));
+    }
+  }
+  codegen::TableScanTranslator::kUseSimdPredicates = true;
+}
+
 TEST_F(TableScanTranslatorTest, MultiLayoutScan) {
   //
   // Creates a table with LayoutType::ROW
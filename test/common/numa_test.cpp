@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa_test.cpp
+//
+// Identification: test/common/numa_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/numa.h"
+
+#include <cstring>
+
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+class NumaTest : public PelotonTest {};
+
+TEST_F(NumaTest, TopologyTest) {
+  EXPECT_GE(NumaUtil::GetNumNodes(), 1u);
+
+  int node = NumaUtil::GetCurrentNode();
+  EXPECT_GE(node, 0);
+  EXPECT_LT(static_cast<uint32_t>(node), NumaUtil::GetNumNodes());
+}
+
+TEST_F(NumaTest, AllocateTest) {
+  const std::size_t size = 1 << 20;
+  for (uint32_t node = 0; node < NumaUtil::GetNumNodes(); node++) {
+    auto *data = reinterpret_cast<char *>(NumaUtil::Allocate(size, node));
+    ASSERT_NE(nullptr, data);
+
+    // Memory must come back zeroed and writable
+    for (std::size_t i = 0; i < size; i += 4096) {
+      EXPECT_EQ(0, data[i]);
+    }
+    std::memset(data, 1, size);
+    EXPECT_EQ(1, data[size - 1]);
+
+    NumaUtil::Free(data, size);
+  }
+}
+
+TEST_F(NumaTest, NodeGuardTest) {
+  // Binding to an invalid node is a no-op
+  { NumaNodeGuard guard{NumaUtil::kInvalidNode}; }
+
+  int node = NumaUtil::GetCurrentNode();
+  {
+    NumaNodeGuard guard{node};
+    EXPECT_EQ(node, NumaUtil::GetCurrentNode());
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
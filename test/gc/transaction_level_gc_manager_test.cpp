@@ -17,10 +17,15 @@
 #include "concurrency/epoch_manager.h"
 
 #include "catalog/catalog.h"
+#include "expression/comparison_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "index/index_factory.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
 #include "storage/database.h"
 #include "storage/storage_manager.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 
@@ -83,6 +88,47 @@ ResultType SelectTuple(storage::DataTable *table, const int key,
   return scheduler.schedules[0].txn_result;
 }
 
+ResultType InsertTupleWithValue(storage::DataTable *table, const int key,
+                                const int value) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  TransactionScheduler scheduler(1, table, &txn_manager);
+  scheduler.Txn(0).Insert(key, value);
+  scheduler.Txn(0).Commit();
+  scheduler.Run();
+
+  return scheduler.schedules[0].txn_result;
+}
+
+ResultType UpdateTupleWithValue(storage::DataTable *table, const int key,
+                                const int value) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  TransactionScheduler scheduler(1, table, &txn_manager);
+  scheduler.Txn(0).Update(key, value);
+  scheduler.Txn(0).Commit();
+  scheduler.Run();
+
+  return scheduler.schedules[0].txn_result;
+}
+
+// Add a secondary index on the value column, partial if a predicate is given
+std::shared_ptr<index::Index> AddValueIndex(
+    storage::DataTable *table,
+    const expression::AbstractExpression *predicate = nullptr,
+    IndexConstraintType constraint = IndexConstraintType::DEFAULT) {
+  std::vector<oid_t> key_attrs = {1};
+  auto tuple_schema = table->GetSchema();
+  auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+  auto index_metadata = new index::IndexMetadata(
+      "value_index", 1235, TEST_TABLE_OID, CATALOG_DATABASE_OID,
+      IndexType::BWTREE, constraint, tuple_schema, key_schema, key_attrs,
+      false, {}, predicate);
+  std::shared_ptr<index::Index> value_index(
+      index::IndexFactory::GetIndex(index_metadata));
+  table->AddIndex(value_index);
+  return value_index;
+}
+
 // update -> delete
 TEST_F(TransactionLevelGCManagerTests, UpdateDeleteTest) {
   auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
@@ -211,6 +257,221 @@ TEST_F(TransactionLevelGCManagerTests, UpdateDeleteTest) {
   // EXPECT_FALSE(storage_manager->HasDatabase(db_id));
 }
 
+// insert -> update a secondary key
+TEST_F(TransactionLevelGCManagerTests, UpdateSecondaryKeyTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  gc_manager.Reset();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase("database3");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  // create a table with only one key
+  const int num_key = 1;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      num_key, "TABLE3", db_id, INVALID_OID, 1234, true));
+
+  // add a secondary index on the value column
+  auto value_index = AddValueIndex(table.get());
+
+  //===========================
+  // insert a tuple, then update its value.
+  //===========================
+  auto ret = InsertTupleWithValue(table.get(), 100, 1);
+  EXPECT_TRUE(ret == ResultType::SUCCESS);
+  ret = UpdateTupleWithValue(table.get(), 100, 2);
+  EXPECT_TRUE(ret == ResultType::SUCCESS);
+
+  // both the old and the new value point at the tuple
+  std::vector<ItemPointer *> entries;
+  value_index->ScanAllKeys(entries);
+  EXPECT_EQ(2, entries.size());
+
+  //===========================
+  // unlink the old version.
+  //===========================
+  epoch_manager.SetCurrentEpochId(2);
+  auto expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, expired_eid);
+
+  gc_manager.Reclaim(0, expired_eid);
+  auto unlinked_count = gc_manager.Unlink(0, expired_eid);
+  EXPECT_EQ(1, unlinked_count);
+
+  // only the new value is left
+  entries.clear();
+  value_index->ScanAllKeys(entries);
+  EXPECT_EQ(1, entries.size());
+
+  std::vector<int> results;
+  ret = SelectTuple(table.get(), 100, results);
+  EXPECT_TRUE(ret == ResultType::SUCCESS);
+  EXPECT_EQ(2, results[0]);
+
+  gc_manager.StopGC();
+  gc::GCManagerFactory::Configure(0);
+
+  table.release();
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase("database3");
+}
+
+// insert -> update a secondary key -> delete -> insert
+TEST_F(TransactionLevelGCManagerTests, DeleteSecondaryKeyTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  gc_manager.Reset();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase("database5");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  // create a table with only one key
+  const int num_key = 1;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      num_key, "TABLE5", db_id, INVALID_OID, 1234, true));
+
+  // add a unique index on the value column
+  auto value_index =
+      AddValueIndex(table.get(), nullptr, IndexConstraintType::UNIQUE);
+
+  //===========================
+  // insert a tuple, update its value, then delete it.
+  //===========================
+  auto ret = InsertTupleWithValue(table.get(), 100, 1);
+  EXPECT_TRUE(ret == ResultType::SUCCESS);
+  ret = UpdateTupleWithValue(table.get(), 100, 2);
+  EXPECT_TRUE(ret == ResultType::SUCCESS);
+  ret = DeleteTuple(table.get(), 100);
+  EXPECT_TRUE(ret == ResultType::SUCCESS);
+
+  //===========================
+  // unlink the versions, then recycle the tuple and its indirection.
+  //===========================
+  epoch_manager.SetCurrentEpochId(2);
+  auto expired_eid = epoch_manager.GetExpiredEpochId();
+  gc_manager.Reclaim(0, expired_eid);
+  auto unlinked_count = gc_manager.Unlink(0, expired_eid);
+  EXPECT_EQ(2, unlinked_count);
+
+  epoch_manager.SetCurrentEpochId(3);
+  expired_eid = epoch_manager.GetExpiredEpochId();
+  auto reclaimed_count = gc_manager.Reclaim(0, expired_eid);
+  EXPECT_EQ(2, reclaimed_count);
+
+  // no index points at the indirection anymore
+  std::vector<ItemPointer *> entries;
+  value_index->ScanAllKeys(entries);
+  EXPECT_EQ(0, entries.size());
+  table->GetIndex(0)->ScanAllKeys(entries);
+  EXPECT_EQ(0, entries.size());
+
+  //===========================
+  // a stale entry only conflicts with a tuple that has its key.
+  //===========================
+  ret = InsertTupleWithValue(table.get(), 200, 2);
+  EXPECT_TRUE(ret == ResultType::SUCCESS);
+  value_index->ScanAllKeys(entries);
+  ASSERT_EQ(1, entries.size());
+
+  std::unique_ptr<storage::Tuple> stale_key(
+      new storage::Tuple(value_index->GetKeySchema(), true));
+  stale_key->SetValue(0, type::ValueFactory::GetIntegerValue(1), nullptr);
+  value_index->InsertEntry(stale_key.get(), entries[0]);
+
+  ret = InsertTupleWithValue(table.get(), 300, 1);
+  EXPECT_TRUE(ret == ResultType::SUCCESS);
+  ret = InsertTupleWithValue(table.get(), 400, 2);
+  EXPECT_TRUE(ret == ResultType::ABORTED);
+
+  gc_manager.StopGC();
+  gc::GCManagerFactory::Configure(0);
+
+  table.release();
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase("database5");
+}
+
+// insert -> update out of a partial index
+TEST_F(TransactionLevelGCManagerTests, UpdatePartialIndexTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  gc_manager.Reset();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase("database4");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  // create a table with only one key
+  const int num_key = 1;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      num_key, "TABLE4", db_id, INVALID_OID, 1234, true));
+
+  // only index the values below 10
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      new expression::ComparisonExpression(
+          ExpressionType::COMPARE_LESSTHAN,
+          new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1),
+          new expression::ConstantValueExpression(
+              type::ValueFactory::GetIntegerValue(10))));
+  auto value_index = AddValueIndex(table.get(), predicate.get());
+
+  //===========================
+  // insert a tuple, then move it out of the index.
+  //===========================
+  auto ret = InsertTupleWithValue(table.get(), 100, 1);
+  EXPECT_TRUE(ret == ResultType::SUCCESS);
+  ret = UpdateTupleWithValue(table.get(), 100, 20);
+  EXPECT_TRUE(ret == ResultType::SUCCESS);
+
+  // the old version still has its entry
+  std::vector<ItemPointer *> entries;
+  value_index->ScanAllKeys(entries);
+  EXPECT_EQ(1, entries.size());
+
+  //===========================
+  // unlink the old version.
+  //===========================
+  epoch_manager.SetCurrentEpochId(2);
+  auto expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, expired_eid);
+
+  gc_manager.Reclaim(0, expired_eid);
+  auto unlinked_count = gc_manager.Unlink(0, expired_eid);
+  EXPECT_EQ(1, unlinked_count);
+
+  // the tuple has left the index
+  entries.clear();
+  value_index->ScanAllKeys(entries);
+  EXPECT_EQ(0, entries.size());
+
+  gc_manager.StopGC();
+  gc::GCManagerFactory::Configure(0);
+
+  table.release();
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase("database4");
+}
+
 // insert -> delete -> insert
 TEST_F(TransactionLevelGCManagerTests, ReInsertTest) {
   auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
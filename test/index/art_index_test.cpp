@@ -13,7 +13,9 @@
 #include "common/harness.h"
 #include "gmock/gtest/gtest.h"
 
+#include "catalog/schema.h"
 #include "index/art_index.h"
+#include "index/scan_optimizer.h"
 #include "index/testing_index_util.h"
 #include "type/value_factory.h"
 
@@ -325,5 +327,199 @@ TEST_F(ArtIndexTests, NonUniqueKeyMultiThreadedStressTest) {
   }
 }
 
+TEST_F(ArtIndexTests, ScanKeyBatchTest) {
+  uint32_t scale_factor = 200;
+  GenerateTestInput(scale_factor);
+
+  // INDEX
+  auto &index = GetTestIndex();
+  auto &test_data = GetTestData();
+  LaunchParallelTest(1, ArtIndexTests::InsertHelper, &index, &test_data);
+
+  // Look up every key of the data set, and one that doesn't exist
+  std::vector<const storage::Tuple *> batch;
+  for (const auto &test_entry : test_data) {
+    batch.push_back(test_entry.GetKey());
+  }
+  std::unique_ptr<storage::Tuple> keynonce = CreateIndexKey(1000, "f");
+  batch.push_back(keynonce.get());
+
+  std::vector<std::vector<ItemPointer *>> results;
+  index.ScanKeyBatch(batch, results);
+  ASSERT_EQ(batch.size(), results.size());
+
+  // Every key must find the same values as a single lookup
+  std::vector<ItemPointer *> location_ptrs;
+  for (size_t i = 0; i < batch.size(); i++) {
+    index.ScanKey(batch[i], location_ptrs);
+    EXPECT_EQ(location_ptrs, results[i]);
+    location_ptrs.clear();
+  }
+  EXPECT_EQ(0, results.back().size());
+
+  // (100 * i, b) has three values
+  EXPECT_EQ(3, results[1].size());
+}
+
+TEST_F(ArtIndexTests, KeyEncodingTest) {
+  // Key (A BIGINT, B DECIMAL, C VARCHAR)
+  catalog::Column column1(type::TypeId::BIGINT,
+                          type::Type::GetTypeSize(type::TypeId::BIGINT), "A",
+                          true);
+  catalog::Column column2(type::TypeId::DECIMAL,
+                          type::Type::GetTypeSize(type::TypeId::DECIMAL), "B",
+                          true);
+  catalog::Column column3(type::TypeId::VARCHAR, 64, "C", false);
+  std::vector<oid_t> key_attrs = {0, 1, 2};
+  auto *key_schema = new catalog::Schema({column1, column2, column3});
+  key_schema->SetIndexedColumns(key_attrs);
+  std::unique_ptr<catalog::Schema> tuple_schema(
+      new catalog::Schema({column1, column2, column3}));
+  index::ArtIndex index(new index::IndexMetadata(
+      "encoding_index", 126, INVALID_OID, INVALID_OID, IndexType::ART,
+      IndexConstraintType::DEFAULT, tuple_schema.get(), key_schema, key_attrs,
+      false));
+
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  auto encode = [&](const type::Value &a, const type::Value &b,
+                    const type::Value &c) {
+    storage::Tuple key(key_schema, true);
+    key.SetValue(0, a, pool);
+    key.SetValue(1, b, pool);
+    key.SetValue(2, c, pool);
+    art::Key tree_key;
+    index.ConstructArtKey(key, tree_key);
+    return std::string(reinterpret_cast<const char *>(&tree_key[0]),
+                       tree_key.getKeyLen());
+  };
+  auto bigint = [](int64_t v) {
+    return type::ValueFactory::GetBigIntValue(v);
+  };
+  auto decimal = [](double v) {
+    return type::ValueFactory::GetDecimalValue(v);
+  };
+  auto varchar = [](const char *v, uint32_t len) {
+    return type::ValueFactory::GetVarcharValue(v, len, false);
+  };
+  auto null_bigint =
+      type::ValueFactory::GetNullValueByType(type::TypeId::BIGINT);
+  auto null_varchar =
+      type::ValueFactory::GetNullValueByType(type::TypeId::VARCHAR);
+
+  // Keys in ascending order. NULLs come first, and strings that are a prefix
+  // of another string come before it, whatever the following columns are.
+  // The NUL terminator of a varchar is not part of the string.
+  std::vector<std::string> keys = {
+      encode(null_bigint, decimal(1), varchar("a", 1)),
+      encode(bigint(-1000), decimal(-2.5), varchar("z", 1)),
+      encode(bigint(-1000), decimal(-1), null_varchar),
+      encode(bigint(-1000), decimal(-1), varchar("", 0)),
+      encode(bigint(-1000), decimal(-1), varchar("a", 1)),
+      encode(bigint(-1000), decimal(-1), varchar("a\0", 3)),
+      encode(bigint(-1000), decimal(-1), varchar("a\0\0", 4)),
+      encode(bigint(-1000), decimal(-1), varchar("a\1", 2)),
+      encode(bigint(-1000), decimal(-1), varchar("ab", 2)),
+      encode(bigint(-1000), decimal(0), varchar("a", 1)),
+      encode(bigint(-1000), decimal(0.5), varchar("a", 1)),
+      encode(bigint(-1000), decimal(1e10), varchar("a", 1)),
+      encode(bigint(-1), decimal(0), varchar("a", 1)),
+      encode(bigint(0), decimal(0), varchar("a", 1)),
+      encode(bigint(1LL << 40), decimal(0), varchar("a", 1)),
+  };
+  for (size_t i = 1; i < keys.size(); i++) {
+    EXPECT_LT(keys[i - 1], keys[i]) << "keys " << i - 1 << " and " << i;
+  }
+
+  // Equal values have equal keys, whether or not a varchar carries its NUL
+  // terminator
+  EXPECT_EQ(encode(bigint(3), decimal(0), varchar("ab", 2)),
+            encode(bigint(3), decimal(-0.0), varchar("ab", 3)));
+}
+
+TEST_F(ArtIndexTests, ScanRangeTest) {
+  auto &index = GetTestIndex();
+  auto &test_data = GetTestData();
+  LaunchParallelTest(1, ArtIndexTests::InsertHelper, &index, &test_data);
+
+  auto *art_index = dynamic_cast<index::ArtIndex *>(&index);
+  ASSERT_NE(nullptr, art_index);
+
+  std::vector<ItemPointer *> location_ptrs;
+  auto start = CreateIndexKey(100, "b");
+  auto end = CreateIndexKey(400, "d");
+  art_index->ScanRange(start.get(), end.get(), location_ptrs);
+  EXPECT_EQ(5, location_ptrs.size());
+  location_ptrs.clear();
+
+  // The bounds don't need to be in the index
+  start = CreateIndexKey(100, "bb");
+  end = CreateIndexKey(100, "cc");
+  art_index->ScanRange(start.get(), end.get(), location_ptrs);
+  ASSERT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(4, location_ptrs[0]->offset);
+  location_ptrs.clear();
+
+  start = CreateIndexKey(100, "d");
+  end = CreateIndexKey(400, "c");
+  art_index->ScanRange(start.get(), end.get(), location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+}
+
+TEST_F(ArtIndexTests, ScanLimitTest) {
+  uint32_t scale_factor = 20;
+  GenerateTestInput(scale_factor);
+
+  auto &index = GetTestIndex();
+  auto &test_data = GetTestData();
+  LaunchParallelTest(1, ArtIndexTests::InsertHelper, &index, &test_data);
+
+  // Scan with a predicate on A only, so the high key has the maximum varchar
+  auto scan = [&](ScanDirectionType scan_direction, uint64_t limit,
+                  uint64_t offset) {
+    std::vector<type::Value> values = {
+        type::ValueFactory::GetIntegerValue(300),
+        type::ValueFactory::GetIntegerValue(800)};
+    std::vector<oid_t> key_column_ids = {0, 0};
+    std::vector<ExpressionType> expr_types = {
+        ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+        ExpressionType::COMPARE_LESSTHANOREQUALTO};
+    index::IndexScanPredicate isp;
+    isp.AddConjunctionScanPredicate(&index, values, key_column_ids,
+                                    expr_types);
+
+    std::vector<ItemPointer *> result;
+    index.ScanLimit(values, key_column_ids, expr_types, scan_direction, result,
+                    &isp.GetConjunctionList()[0], limit, offset);
+
+    std::vector<int32_t> a_values;
+    for (auto *item : result) {
+      a_values.push_back(
+          test_data[item->offset].GetKey()->GetValue(0).GetAs<int32_t>());
+    }
+    return a_values;
+  };
+
+  // The values of A in range, in ascending order
+  std::vector<int32_t> expected;
+  for (const auto &entry : test_data) {
+    auto a = entry.GetKey()->GetValue(0).GetAs<int32_t>();
+    if (a >= 300 && a <= 800) {
+      expected.push_back(a);
+    }
+  }
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(33, expected.size());
+
+  EXPECT_EQ(expected, scan(ScanDirectionType::FORWARD, 100, 0));
+  EXPECT_EQ(std::vector<int32_t>(expected.begin() + 5, expected.begin() + 9),
+            scan(ScanDirectionType::FORWARD, 4, 5));
+  EXPECT_EQ(std::vector<int32_t>(expected.rbegin() + 5, expected.rbegin() + 9),
+            scan(ScanDirectionType::BACKWARD, 4, 5));
+  EXPECT_EQ(std::vector<int32_t>(expected.begin() + 30, expected.end()),
+            scan(ScanDirectionType::FORWARD, 10, 30));
+  EXPECT_EQ(0, scan(ScanDirectionType::FORWARD, 10, 33).size());
+  EXPECT_EQ(0, scan(ScanDirectionType::BACKWARD, 0, 0).size());
+}
+
 }  // namespace test
-}  // namespace peloton
\ No newline at end of file
+}  // namespace peloton
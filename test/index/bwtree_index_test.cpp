@@ -13,8 +13,10 @@
 #include "common/harness.h"
 #include "gtest/gtest.h"
 
+#include "index/scan_optimizer.h"
 #include "index/testing_index_util.h"
-#include "index/testing_index_util.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace test {
@@ -65,5 +67,148 @@ TEST_F(BwTreeIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::BWTREE);
 }
 
+TEST_F(BwTreeIndexTests, ScanKeyBatchTest) {
+  TestingIndexUtil::ScanKeyBatchTest(IndexType::BWTREE);
+}
+
+namespace {
+
+// Runs ScanLimit() and returns the blocks of the items found
+std::vector<oid_t> ScanLimitBlocks(index::Index *index,
+                                   const std::vector<type::Value> &values,
+                                   const std::vector<oid_t> &key_column_ids,
+                                   const std::vector<ExpressionType> &expr_types,
+                                   ScanDirectionType scan_direction,
+                                   uint64_t limit, uint64_t offset) {
+  index::IndexScanPredicate isp;
+  isp.AddConjunctionScanPredicate(index, values, key_column_ids, expr_types);
+
+  std::vector<ItemPointer *> result;
+  index->ScanLimit(values, key_column_ids, expr_types, scan_direction, result,
+                   &isp.GetConjunctionList()[0], limit, offset);
+
+  std::vector<oid_t> blocks;
+  for (auto *item : result) {
+    blocks.push_back(item->block);
+  }
+  return blocks;
+}
+
+}  // namespace
+
+TEST_F(BwTreeIndexTests, ScanLimitTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(IndexType::BWTREE, false),
+      [](index::Index *index) { delete index; });
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  // Key (i, "limit") points to block i. Key 7 has three items.
+  const int num_keys = 1000;
+  std::vector<std::unique_ptr<ItemPointer>> items;
+  for (int i = 0; i < num_keys; i++) {
+    storage::Tuple key(key_schema, true);
+    key.SetValue(0, type::ValueFactory::GetIntegerValue(i), pool);
+    key.SetValue(1, type::ValueFactory::GetVarcharValue("limit"), pool);
+    for (oid_t j = 0; j < (i == 7 ? 3 : 1); j++) {
+      items.emplace_back(new ItemPointer(i, j));
+      EXPECT_TRUE(index->InsertEntry(&key, items.back().get()));
+    }
+  }
+
+  auto value = [](int i) { return type::ValueFactory::GetIntegerValue(i); };
+  const auto forward = ScanDirectionType::FORWARD;
+  const auto backward = ScanDirectionType::BACKWARD;
+
+  // 100 <= A <= 400
+  std::vector<type::Value> range_values = {value(100), value(400)};
+  std::vector<oid_t> range_columns = {0, 0};
+  std::vector<ExpressionType> range_exprs = {
+      ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+      ExpressionType::COMPARE_LESSTHANOREQUALTO};
+
+  EXPECT_EQ(std::vector<oid_t>({105, 106, 107, 108}),
+            ScanLimitBlocks(index.get(), range_values, range_columns,
+                            range_exprs, forward, 4, 5));
+  EXPECT_EQ(std::vector<oid_t>({395, 394, 393, 392}),
+            ScanLimitBlocks(index.get(), range_values, range_columns,
+                            range_exprs, backward, 4, 5));
+  EXPECT_EQ(std::vector<oid_t>({400, 399}),
+            ScanLimitBlocks(index.get(), range_values, range_columns,
+                            range_exprs, backward, 2, 0));
+  EXPECT_EQ(0, ScanLimitBlocks(index.get(), range_values, range_columns,
+                               range_exprs, backward, 0, 0).size());
+
+  // The limit reaches past the end of the range
+  EXPECT_EQ(std::vector<oid_t>({102, 101, 100}),
+            ScanLimitBlocks(index.get(), range_values, range_columns,
+                            range_exprs, backward, 100, 298));
+  EXPECT_EQ(std::vector<oid_t>({997, 998, 999}),
+            ScanLimitBlocks(index.get(), {value(990)}, {0},
+                            {ExpressionType::COMPARE_GREATERTHANOREQUALTO},
+                            forward, 100, 7));
+  EXPECT_EQ(0, ScanLimitBlocks(index.get(), {value(990)}, {0},
+                               {ExpressionType::COMPARE_GREATERTHANOREQUALTO},
+                               forward, 100, 10).size());
+
+  // Point query on (7, "limit")
+  std::vector<type::Value> point_values = {
+      value(7), type::ValueFactory::GetVarcharValue("limit")};
+  std::vector<oid_t> point_columns = {0, 1};
+  std::vector<ExpressionType> point_exprs = {ExpressionType::COMPARE_EQUAL,
+                                             ExpressionType::COMPARE_EQUAL};
+  EXPECT_EQ(std::vector<oid_t>({7, 7}),
+            ScanLimitBlocks(index.get(), point_values, point_columns,
+                            point_exprs, forward, 5, 1));
+  EXPECT_EQ(std::vector<oid_t>({7}),
+            ScanLimitBlocks(index.get(), point_values, point_columns,
+                            point_exprs, backward, 1, 2));
+
+  // A != 5 can't be optimized, so this scans the full index
+  std::vector<type::Value> full_values = {value(5)};
+  std::vector<oid_t> full_columns = {0};
+  std::vector<ExpressionType> full_exprs = {ExpressionType::COMPARE_NOTEQUAL};
+  EXPECT_EQ(std::vector<oid_t>({0, 1, 2}),
+            ScanLimitBlocks(index.get(), full_values, full_columns, full_exprs,
+                            forward, 3, 0));
+  EXPECT_EQ(std::vector<oid_t>({998, 997, 996}),
+            ScanLimitBlocks(index.get(), full_values, full_columns, full_exprs,
+                            backward, 3, 1));
+}
+
+TEST_F(BwTreeIndexTests, GarbageCollectionTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(IndexType::BWTREE, false),
+      [](index::Index *index) { delete index; });
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  // Enough updates to consolidate and split nodes, which retires the old ones
+  const int num_keys = 1000;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<std::unique_ptr<ItemPointer>> items;
+  for (int i = 0; i < num_keys; i++) {
+    keys.emplace_back(new storage::Tuple(key_schema, true));
+    keys.back()->SetValue(0, type::ValueFactory::GetIntegerValue(i), pool);
+    keys.back()->SetValue(1, type::ValueFactory::GetVarcharValue("gc"), pool);
+    items.emplace_back(new ItemPointer(i, 0));
+    EXPECT_TRUE(index->InsertEntry(keys.back().get(), items.back().get()));
+  }
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(index->DeleteEntry(keys[i].get(), items[i].get()));
+  }
+  EXPECT_TRUE(index->NeedGC());
+
+  // The first round closes the epoch holding the garbage, the second one
+  // frees it since no operation is running
+  index::Index::PerformRegisteredGC();
+  index::Index::PerformRegisteredGC();
+  EXPECT_FALSE(index->NeedGC());
+
+  std::vector<ItemPointer *> result;
+  index->ScanAllKeys(result);
+  EXPECT_EQ(0, result.size());
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// covering_payload_store_test.cpp
+//
+// Identification: test/index/covering_payload_store_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "executor/testing_executor_util.h"
+#include "index/covering_payload_store.h"
+#include "index/index.h"
+#include "storage/data_table.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+class CoveringPayloadStoreTests : public PelotonTest {};
+
+TEST_F(CoveringPayloadStoreTests, BasicTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  auto tuple_schema = data_table->GetSchema();
+
+  // Key on column 1, covering columns 3 and 1 again
+  std::vector<oid_t> key_attrs = {1};
+  auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+  index::IndexMetadata metadata("covering_index", 125, INVALID_OID,
+                                INVALID_OID, IndexType::BWTREE,
+                                IndexConstraintType::DEFAULT, tuple_schema,
+                                key_schema, key_attrs, false, {3, 1});
+
+  index::CoveringPayloadStore store(&metadata);
+  EXPECT_EQ(std::vector<oid_t>({1, 3, 1}), store.GetColumnIds());
+  EXPECT_EQ(0, store.GetPosition(1));
+  EXPECT_EQ(1, store.GetPosition(3));
+  EXPECT_EQ(INVALID_OID, store.GetPosition(0));
+  EXPECT_TRUE(store.CoversColumns({}));
+  EXPECT_TRUE(store.CoversColumns({3, 1}));
+  EXPECT_FALSE(store.CoversColumns({1, 2}));
+
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::unique_ptr<storage::Tuple> tuple(
+      TestingExecutorUtil::GetTuple(data_table.get(), 7, pool));
+
+  ItemPointer indirection;
+  ItemPointer location(3, 4);
+  store.Put(&indirection, location, 10, *tuple);
+  EXPECT_EQ(1, store.GetSize());
+
+  // The payload keeps its own copy of the values
+  tuple->SetValue(3, type::ValueFactory::GetVarcharValue("other"), pool);
+
+  auto payload = store.Get(&indirection, location, 10);
+  ASSERT_NE(nullptr, payload);
+  index::CoveringTuple covering_tuple(store, *payload);
+  EXPECT_EQ(71, covering_tuple.GetValue(1).GetAs<int32_t>());
+  EXPECT_EQ("12345", covering_tuple.GetValue(3).ToString());
+
+  // Payloads of other versions, or of other entries, are never returned
+  EXPECT_EQ(nullptr, store.Get(&indirection, ItemPointer(3, 5), 10));
+  EXPECT_EQ(nullptr, store.Get(&indirection, location, 11));
+  ItemPointer other_indirection;
+  EXPECT_EQ(nullptr, store.Get(&other_indirection, location, 10));
+
+  // A newer version replaces the payload
+  store.Put(&indirection, ItemPointer(3, 5), 11, *tuple);
+  EXPECT_EQ(1, store.GetSize());
+  EXPECT_EQ(nullptr, store.Get(&indirection, location, 10));
+  payload = store.Get(&indirection, ItemPointer(3, 5), 11);
+  ASSERT_NE(nullptr, payload);
+  covering_tuple.SetPayload(*payload);
+  EXPECT_EQ("other", covering_tuple.GetValue(3).ToString());
+
+  store.Erase(&indirection);
+  EXPECT_EQ(0, store.GetSize());
+  EXPECT_EQ(nullptr, store.Get(&indirection, ItemPointer(3, 5), 11));
+}
+
+}  // namespace test
+}  // namespace peloton
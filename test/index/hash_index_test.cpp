@@ -0,0 +1,185 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index_test.cpp
+//
+// Identification: test/index/hash_index_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "gtest/gtest.h"
+
+#include "common/internal_types.h"
+#include "common/item_pointer.h"
+#include "index/hash_table.h"
+#include "index/index_key.h"
+#include "index/testing_index_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Hash Index Tests
+//===--------------------------------------------------------------------===//
+
+class HashIndexTests : public PelotonTest {};
+
+TEST_F(HashIndexTests, BasicTest) {
+  TestingIndexUtil::BasicTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, MultiMapInsertTest) {
+  TestingIndexUtil::MultiMapInsertTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, UniqueKeyInsertTest) {
+  TestingIndexUtil::UniqueKeyInsertTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, UniqueKeyDeleteTest) {
+  TestingIndexUtil::UniqueKeyDeleteTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, NonUniqueKeyDeleteTest) {
+  TestingIndexUtil::NonUniqueKeyDeleteTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, MultiThreadedInsertTest) {
+  TestingIndexUtil::MultiThreadedInsertTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, UniqueKeyMultiThreadedTest) {
+  TestingIndexUtil::UniqueKeyMultiThreadedTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, NonUniqueKeyMultiThreadedTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, NonUniqueKeyMultiThreadedStressTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, ScanKeyBatchTest) {
+  TestingIndexUtil::ScanKeyBatchTest(IndexType::HASH);
+}
+
+//===--------------------------------------------------------------------===//
+// HashTable Container Tests
+//===--------------------------------------------------------------------===//
+
+namespace {
+
+using IntHashTable =
+    index::HashTable<index::CompactIntsKey<1>, ItemPointer *,
+                     index::CompactIntsHasher<1>,
+                     index::CompactIntsEqualityChecker<1>,
+                     ItemPointerComparator>;
+
+index::CompactIntsKey<1> MakeKey(int32_t value) {
+  index::CompactIntsKey<1> key;
+  key.AddInteger(value, 0);
+  return key;
+}
+
+}  // namespace
+
+TEST_F(HashIndexTests, ContainerTest) {
+  IntHashTable table;
+  std::vector<std::unique_ptr<ItemPointer>> items;
+
+  // Enough keys to make the table grow a few times, two values each
+  const int32_t num_keys = 1000;
+  for (int32_t i = 0; i < num_keys; i++) {
+    for (oid_t j = 0; j < 2; j++) {
+      items.emplace_back(new ItemPointer(i, j));
+      EXPECT_TRUE(table.Insert(MakeKey(i), items.back().get(), false));
+    }
+  }
+  EXPECT_EQ(2 * num_keys, table.GetSize());
+
+  std::vector<ItemPointer *> values;
+  for (int32_t i = 0; i < num_keys; i++) {
+    values.clear();
+    table.GetValue(MakeKey(i), values);
+    ASSERT_EQ(2, values.size());
+    EXPECT_EQ(i, values[0]->block);
+    EXPECT_EQ(i, values[1]->block);
+  }
+  values.clear();
+  table.GetValue(MakeKey(num_keys), values);
+  EXPECT_EQ(0, values.size());
+
+  // Duplicate pairs and, for unique keys, duplicate keys are rejected
+  ItemPointer existing(5, 0);
+  EXPECT_FALSE(table.Insert(MakeKey(5), &existing, false));
+  ItemPointer other(num_keys, 0);
+  EXPECT_FALSE(table.Insert(MakeKey(5), &other, true));
+
+  // Deleting one value of a key leaves the other
+  EXPECT_TRUE(table.Delete(MakeKey(5), &existing));
+  EXPECT_FALSE(table.Delete(MakeKey(5), &existing));
+  values.clear();
+  table.GetValue(MakeKey(5), values);
+  ASSERT_EQ(1, values.size());
+  EXPECT_EQ(1, values[0]->offset);
+
+  // The predicate blocks the insert as long as a matching value exists
+  bool predicate_satisfied = false;
+  auto block_five = [](const void *value) {
+    return static_cast<const ItemPointer *>(value)->block == 5;
+  };
+  EXPECT_FALSE(table.ConditionalInsert(MakeKey(5), &other, block_five,
+                                       &predicate_satisfied));
+  EXPECT_TRUE(predicate_satisfied);
+  EXPECT_TRUE(table.ConditionalInsert(MakeKey(num_keys), &other, block_five,
+                                      &predicate_satisfied));
+  EXPECT_FALSE(predicate_satisfied);
+
+  size_t count = 0;
+  table.ForEach([&count](const index::CompactIntsKey<1> &, ItemPointer *) {
+    count++;
+  });
+  EXPECT_EQ(2 * num_keys, count);
+}
+
+TEST_F(HashIndexTests, ConcurrentInsertDeleteTest) {
+  IntHashTable table;
+  const int num_threads = 4;
+  const int32_t num_keys = 2000;
+
+  // Every thread inserts all keys into its own value space, then deletes
+  // the odd ones again
+  std::vector<std::unique_ptr<ItemPointer>> items;
+  for (int thread_id = 0; thread_id < num_threads; thread_id++) {
+    items.emplace_back(new ItemPointer(thread_id, 0));
+  }
+  LaunchParallelTest(num_threads, [&table, &items, num_keys](
+                                      uint64_t thread_id) {
+    for (int32_t i = 0; i < num_keys; i++) {
+      EXPECT_TRUE(table.Insert(MakeKey(i), items[thread_id].get(), false));
+    }
+    for (int32_t i = 1; i < num_keys; i += 2) {
+      EXPECT_TRUE(table.Delete(MakeKey(i), items[thread_id].get()));
+    }
+  });
+
+  size_t count = 0;
+  table.ForEach([&count](const index::CompactIntsKey<1> &key, ItemPointer *) {
+    EXPECT_EQ(0, key.GetInteger<int32_t>(0) % 2);
+    count++;
+  });
+  EXPECT_EQ(num_threads * num_keys / 2, count);
+  EXPECT_EQ(count, table.GetSize());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,228 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_builder_test.cpp
+//
+// Identification: test/index/index_builder_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "expression/comparison_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "index/index.h"
+#include "index/index_builder.h"
+#include "index/index_factory.h"
+#include "storage/data_table.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+class IndexBuilderTests : public PelotonTest {};
+
+namespace {
+
+std::shared_ptr<index::Index> CreateIndex(
+    storage::DataTable *table, oid_t column_id, bool unique,
+    const expression::AbstractExpression *predicate = nullptr) {
+  std::vector<oid_t> key_attrs = {column_id};
+  auto key_schema = catalog::Schema::CopySchema(table->GetSchema(), key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+
+  auto index_metadata = new index::IndexMetadata(
+      "built_index", 125, INVALID_OID, INVALID_OID, IndexType::BWTREE,
+      (unique ? IndexConstraintType::UNIQUE : IndexConstraintType::DEFAULT),
+      table->GetSchema(), key_schema, key_attrs, unique, {}, predicate);
+  return std::shared_ptr<index::Index>(
+      index::IndexFactory::GetIndex(index_metadata));
+}
+
+std::unique_ptr<storage::Tuple> MakeKey(index::Index *index, int value) {
+  std::unique_ptr<storage::Tuple> key(
+      new storage::Tuple(index->GetKeySchema(), true));
+  key->SetValue(0, type::ValueFactory::GetIntegerValue(value), nullptr);
+  return key;
+}
+
+}  // namespace
+
+TEST_F(IndexBuilderTests, BuildTest) {
+  // Spread the rows over many tile groups, so that the scan is split up
+  const int tuples_per_tile_group = 100;
+  const int num_rows = 5000;
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(tuples_per_tile_group, false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table.get(), num_rows, false, false,
+                                     false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto index = CreateIndex(table.get(), 1, false);
+  table->AddIndex(index);
+
+  index::IndexBuilder builder(table.get(), index.get());
+  EXPECT_TRUE(builder.Build());
+
+  // Every row is in the index, in key order
+  std::vector<ItemPointer *> result;
+  index->ScanAllKeys(result);
+  ASSERT_EQ(num_rows, result.size());
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  int previous_value = -1;
+  for (auto *item : result) {
+    auto tile_group = storage_manager->GetTileGroup(item->block);
+    int value = tile_group->GetValue(item->offset, 1).GetAs<int32_t>();
+    EXPECT_LT(previous_value, value);
+    previous_value = value;
+  }
+
+  for (int row = 0; row < num_rows; row += 7) {
+    int value = TestingExecutorUtil::PopulatedValue(row, 1);
+    result.clear();
+    index->ScanKey(MakeKey(index.get(), value).get(), result);
+    ASSERT_EQ(1, result.size());
+    auto tile_group = storage_manager->GetTileGroup(result[0]->block);
+    EXPECT_EQ(value,
+              tile_group->GetValue(result[0]->offset, 1).GetAs<int32_t>());
+  }
+}
+
+TEST_F(IndexBuilderTests, UniqueViolationTest) {
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+
+  // The first column has only two distinct values
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table.get(), 20, false, false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto index = CreateIndex(table.get(), 0, true);
+
+  index::IndexBuilder builder(table.get(), index.get());
+  EXPECT_FALSE(builder.Build());
+}
+
+TEST_F(IndexBuilderTests, UncommittedWriterTest) {
+  const int num_rows = 50;
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+
+  // The rows are written before the index exists, and committed after it is
+  // built
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto writer_txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table.get(), num_rows, false, false,
+                                     false, writer_txn);
+
+  auto index = CreateIndex(table.get(), 1, false);
+  table->AddIndex(index);
+
+  // An insert that reached the index before the build keeps it from being
+  // built bottom-up, and is not inserted twice
+  auto first_key =
+      MakeKey(index.get(), TestingExecutorUtil::PopulatedValue(0, 1));
+  auto first_item = table->GetTileGroup(0)->GetHeader()->GetIndirection(0);
+  EXPECT_TRUE(index->InsertEntry(first_key.get(), first_item));
+
+  index::IndexBuilder builder(table.get(), index.get());
+  EXPECT_TRUE(builder.Build());
+  txn_manager.CommitTransaction(writer_txn);
+
+  std::vector<ItemPointer *> result;
+  index->ScanAllKeys(result);
+  EXPECT_EQ(num_rows, result.size());
+}
+
+TEST_F(IndexBuilderTests, SideLogTest) {
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  auto index = CreateIndex(table.get(), 1, false);
+
+  ItemPointer logged_item(1, 2);
+  ItemPointer direct_item(3, 4);
+  std::vector<ItemPointer *> result;
+
+  // Inserts made during the build only show up once it finishes
+  index->StartBuild();
+  EXPECT_TRUE(index->InsertOrLogEntry(MakeKey(index.get(), 5).get(),
+                                      &logged_item));
+  index->ScanKey(MakeKey(index.get(), 5).get(), result);
+  EXPECT_EQ(0, result.size());
+
+  index->FinishBuild();
+  index->ScanKey(MakeKey(index.get(), 5).get(), result);
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ(&logged_item, result[0]);
+
+  EXPECT_TRUE(index->InsertOrLogEntry(MakeKey(index.get(), 6).get(),
+                                      &direct_item));
+  result.clear();
+  index->ScanKey(MakeKey(index.get(), 6).get(), result);
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ(&direct_item, result[0]);
+}
+
+TEST_F(IndexBuilderTests, PartialIndexTest) {
+  const int num_rows = 500;
+  const int num_indexed_rows = 100;
+
+  // Only index the rows whose first column is below the bound
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      new expression::ComparisonExpression(
+          ExpressionType::COMPARE_LESSTHAN,
+          new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0),
+          new expression::ConstantValueExpression(
+              type::ValueFactory::GetIntegerValue(
+                  TestingExecutorUtil::PopulatedValue(num_indexed_rows, 0)))));
+
+  // Rows inserted into the table skip the index
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  auto index = CreateIndex(table.get(), 1, false, predicate.get());
+  table->AddIndex(index);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table.get(), num_rows, false, false,
+                                     false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::vector<ItemPointer *> result;
+  index->ScanAllKeys(result);
+  EXPECT_EQ(num_indexed_rows, result.size());
+
+  // So do rows scanned when building the index
+  auto built_index = CreateIndex(table.get(), 1, false, predicate.get());
+  index::IndexBuilder builder(table.get(), built_index.get());
+  EXPECT_TRUE(builder.Build());
+
+  result.clear();
+  built_index->ScanAllKeys(result);
+  EXPECT_EQ(num_indexed_rows, result.size());
+
+  for (int row = 0; row < num_rows; row += 7) {
+    int value = TestingExecutorUtil::PopulatedValue(row, 1);
+    result.clear();
+    built_index->ScanKey(MakeKey(built_index.get(), value).get(), result);
+    EXPECT_EQ(row < num_indexed_rows ? 1 : 0, result.size());
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -14,6 +14,9 @@
 #include "gtest/gtest.h"
 
 #include "common/internal_types.h"
+#include "common/item_pointer.h"
+#include "index/index_key.h"
+#include "index/skiplist.h"
 #include "index/testing_index_util.h"
 
 namespace peloton {
@@ -26,45 +29,178 @@ namespace test {
 class SkipListIndexTests : public PelotonTest {};
 
 TEST_F(SkipListIndexTests, BasicTest) {
-  // TestingIndexUtil::BasicTest(IndexType::SKIPLIST);
-  EXPECT_EQ(2, 1+1);
+  TestingIndexUtil::BasicTest(IndexType::SKIPLIST);
 }
 
-//TEST_F(SkipListIndexTests, MultiMapInsertTest) {
-//  TestingIndexUtil::MultiMapInsertTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, UniqueKeyInsertTest) {
-//  TestingIndexUtil::UniqueKeyInsertTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, UniqueKeyDeleteTest) {
-//  TestingIndexUtil::UniqueKeyDeleteTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyDeleteTest) {
-//  TestingIndexUtil::NonUniqueKeyDeleteTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, MultiThreadedInsertTest) {
-//  TestingIndexUtil::MultiThreadedInsertTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, UniqueKeyMultiThreadedTest) {
-//  TestingIndexUtil::UniqueKeyMultiThreadedTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedTest) {
-//  TestingIndexUtil::NonUniqueKeyMultiThreadedTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest) {
-//  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
-//  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::SKIPLIST);
-//}
+TEST_F(SkipListIndexTests, MultiMapInsertTest) {
+  TestingIndexUtil::MultiMapInsertTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, UniqueKeyInsertTest) {
+  TestingIndexUtil::UniqueKeyInsertTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, UniqueKeyDeleteTest) {
+  TestingIndexUtil::UniqueKeyDeleteTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyDeleteTest) {
+  TestingIndexUtil::NonUniqueKeyDeleteTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, MultiThreadedInsertTest) {
+  TestingIndexUtil::MultiThreadedInsertTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, UniqueKeyMultiThreadedTest) {
+  TestingIndexUtil::UniqueKeyMultiThreadedTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, ScanKeyBatchTest) {
+  TestingIndexUtil::ScanKeyBatchTest(IndexType::SKIPLIST);
+}
+
+//===--------------------------------------------------------------------===//
+// SkipList Container Tests
+//===--------------------------------------------------------------------===//
+
+namespace {
+
+using IntSkipList =
+    index::SkipList<index::CompactIntsKey<1>, ItemPointer *,
+                    index::CompactIntsComparator<1>,
+                    index::CompactIntsEqualityChecker<1>,
+                    ItemPointerComparator>;
+
+index::CompactIntsKey<1> MakeKey(int32_t value) {
+  index::CompactIntsKey<1> key;
+  key.AddInteger(value, 0);
+  return key;
+}
+
+}  // namespace
+
+TEST_F(SkipListIndexTests, OrderedScanTest) {
+  IntSkipList list;
+  std::vector<std::unique_ptr<ItemPointer>> items;
+
+  // Keys 0, 10, ..., 90 with two values each, inserted out of order
+  for (int32_t i = 9; i >= 0; i--) {
+    for (oid_t j = 0; j < 2; j++) {
+      items.emplace_back(new ItemPointer(i, j));
+      EXPECT_TRUE(list.Insert(MakeKey(i * 10), items.back().get(), false));
+    }
+  }
+
+  // Duplicate pairs and, for unique keys, duplicate keys are rejected
+  EXPECT_FALSE(list.Insert(MakeKey(50), items[9].get(), false));
+  ItemPointer other(100, 0);
+  EXPECT_FALSE(list.Insert(MakeKey(50), &other, true));
+
+  // Forward from 35
+  std::vector<int32_t> keys;
+  auto low_key = MakeKey(35);
+  list.ScanForward(&low_key, [&keys](const index::CompactIntsKey<1> &key,
+                                     ItemPointer *) {
+    keys.push_back(key.GetInteger<int32_t>(0));
+    return keys.size() < 6;
+  });
+  EXPECT_EQ((std::vector<int32_t>{40, 40, 50, 50, 60, 60}), keys);
+
+  // Backward from 35
+  keys.clear();
+  list.ScanReverse(&low_key, [&keys](const index::CompactIntsKey<1> &key,
+                                     ItemPointer *) {
+    keys.push_back(key.GetInteger<int32_t>(0));
+    return true;
+  });
+  EXPECT_EQ((std::vector<int32_t>{30, 30, 20, 20, 10, 10, 0, 0}), keys);
+
+  // Backward from the end
+  keys.clear();
+  list.ScanReverse(nullptr, [&keys](const index::CompactIntsKey<1> &key,
+                                    ItemPointer *) {
+    keys.push_back(key.GetInteger<int32_t>(0));
+    return keys.size() < 3;
+  });
+  EXPECT_EQ((std::vector<int32_t>{90, 90, 80}), keys);
+
+  // Deleting one value of a key leaves the other
+  ItemPointer deleted(5, 0);
+  EXPECT_TRUE(list.Delete(MakeKey(50), &deleted));
+  EXPECT_FALSE(list.Delete(MakeKey(50), &deleted));
+  std::vector<ItemPointer *> values;
+  list.GetValue(MakeKey(50), values);
+  ASSERT_EQ(1, values.size());
+  EXPECT_EQ(1, values[0]->offset);
+
+  // The predicate blocks the insert as long as a matching value exists
+  bool predicate_satisfied = false;
+  auto block_five = [](const void *value) {
+    return static_cast<const ItemPointer *>(value)->block == 5;
+  };
+  EXPECT_FALSE(list.ConditionalInsert(MakeKey(50), &other, block_five,
+                                      &predicate_satisfied));
+  EXPECT_TRUE(predicate_satisfied);
+  EXPECT_TRUE(list.ConditionalInsert(MakeKey(55), &other, block_five,
+                                     &predicate_satisfied));
+  EXPECT_FALSE(predicate_satisfied);
+}
+
+TEST_F(SkipListIndexTests, ConcurrentInsertDeleteTest) {
+  IntSkipList list;
+  const int num_threads = 4;
+  const int32_t num_keys = 2000;
+
+  // Every thread inserts all keys into its own value space, then deletes
+  // the odd ones again
+  std::vector<std::unique_ptr<ItemPointer>> items;
+  for (int thread_id = 0; thread_id < num_threads; thread_id++) {
+    items.emplace_back(new ItemPointer(thread_id, 0));
+  }
+  LaunchParallelTest(num_threads, [&list, &items, num_keys](
+                                      uint64_t thread_id) {
+    for (int32_t i = 0; i < num_keys; i++) {
+      EXPECT_TRUE(list.Insert(MakeKey(i), items[thread_id].get(), false));
+    }
+    for (int32_t i = 1; i < num_keys; i += 2) {
+      EXPECT_TRUE(list.Delete(MakeKey(i), items[thread_id].get()));
+    }
+  });
+
+  size_t count = 0;
+  int32_t last_key = -1;
+  list.ScanForward(nullptr, [&count, &last_key](
+                                const index::CompactIntsKey<1> &key,
+                                ItemPointer *) {
+    int32_t value = key.GetInteger<int32_t>(0);
+    EXPECT_EQ(0, value % 2);
+    EXPECT_LE(last_key, value);
+    last_key = value;
+    count++;
+    return true;
+  });
+  EXPECT_EQ(num_threads * num_keys / 2, count);
+
+  // All deleted nodes can be reclaimed once nobody is inside the list
+  size_t footprint = list.GetMemoryFootprint();
+  list.PerformGarbageCollection();
+  list.PerformGarbageCollection();
+  EXPECT_FALSE(list.NeedGarbageCollection());
+  EXPECT_LE(list.GetMemoryFootprint(), footprint);
+}
 
 }  // namespace test
 }  // namespace peloton
@@ -681,6 +681,61 @@ void TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(
   location_ptrs.clear();
 }
 
+void TestingIndexUtil::ScanKeyBatchTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // INDEX
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(index_type, false), DestroyIndex);
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  // Key (i, "batch") has (i % 3) values. Use enough keys for the tree
+  // indexes to grow a few levels.
+  const int num_keys = 3000;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<std::unique_ptr<ItemPointer>> items;
+  for (int i = 0; i < num_keys; i++) {
+    keys.emplace_back(new storage::Tuple(key_schema, true));
+    keys.back()->SetValue(0, type::ValueFactory::GetIntegerValue(i), pool);
+    keys.back()->SetValue(1, type::ValueFactory::GetVarcharValue("batch"),
+                          pool);
+    for (int j = 0; j < i % 3; j++) {
+      items.emplace_back(new ItemPointer(i, j));
+      EXPECT_TRUE(index->InsertEntry(keys.back().get(), items.back().get()));
+    }
+  }
+
+  // Look up every key in reverse order, twice, plus a few missing ones
+  std::vector<const storage::Tuple *> batch;
+  for (int i = num_keys - 1; i >= 0; i--) {
+    batch.push_back(keys[i].get());
+    batch.push_back(keys[i].get());
+  }
+  std::unique_ptr<storage::Tuple> missing_key(
+      new storage::Tuple(key_schema, true));
+  missing_key->SetValue(0, type::ValueFactory::GetIntegerValue(num_keys),
+                        pool);
+  missing_key->SetValue(1, type::ValueFactory::GetVarcharValue("batch"), pool);
+  batch.push_back(missing_key.get());
+
+  std::vector<std::vector<ItemPointer *>> results;
+  index->ScanKeyBatch(batch, results);
+  ASSERT_EQ(batch.size(), results.size());
+
+  for (size_t k = 0; k + 1 < batch.size(); k++) {
+    int i = num_keys - 1 - static_cast<int>(k / 2);
+    ASSERT_EQ(i % 3, results[k].size());
+    for (const auto *item : results[k]) {
+      EXPECT_EQ(i, item->block);
+    }
+  }
+  EXPECT_EQ(0, results.back().size());
+
+  // An empty batch has no results
+  index->ScanKeyBatch({}, results);
+  EXPECT_EQ(0, results.size());
+}
+
 std::unique_ptr<index::IndexMetadata> TestingIndexUtil::BuildTestIndexMetadata(
     const IndexType index_type, const bool unique_keys) {
   LOG_DEBUG("Build index type: %s [unique_keys=%s]",
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimizer_util_test.cpp
+//
+// Identification: test/optimizer/optimizer_util_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "expression/comparison_expression.h"
+#include "expression/conjunction_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "optimizer/util.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+class OptimizerUtilTests : public PelotonTest {};
+
+namespace {
+
+expression::AbstractExpression *Column(oid_t column_id) {
+  auto column = new expression::TupleValueExpression(
+      type::TypeId::INTEGER, 0, static_cast<int>(column_id));
+  column->SetBoundOid(1, 2, column_id);
+  return column;
+}
+
+expression::AbstractExpression *Compare(ExpressionType type, oid_t column_id,
+                                        int value) {
+  return new expression::ComparisonExpression(
+      type, Column(column_id),
+      new expression::ConstantValueExpression(
+          type::ValueFactory::GetIntegerValue(value)));
+}
+
+std::vector<AnnotatedExpression> Predicates(
+    std::vector<expression::AbstractExpression *> exprs) {
+  std::vector<AnnotatedExpression> predicates;
+  std::unordered_set<std::string> table_alias_set = {"test"};
+  for (auto *expr : exprs) {
+    predicates.emplace_back(
+        std::shared_ptr<expression::AbstractExpression>(expr),
+        table_alias_set);
+  }
+  return predicates;
+}
+
+}  // namespace
+
+TEST_F(OptimizerUtilTests, PredicatesImplyTest) {
+  // Index predicate: a < 10 AND b = 3
+  std::unique_ptr<expression::AbstractExpression> index_predicate(
+      new expression::ConjunctionExpression(
+          ExpressionType::CONJUNCTION_AND,
+          Compare(ExpressionType::COMPARE_LESSTHAN, 0, 10),
+          Compare(ExpressionType::COMPARE_EQUAL, 1, 3)));
+
+  // The same conjuncts, with the comparison of a turned around
+  auto predicates = Predicates(
+      {Compare(ExpressionType::COMPARE_EQUAL, 1, 3),
+       Compare(ExpressionType::COMPARE_GREATERTHAN, 0, 10)});
+  EXPECT_FALSE(optimizer::util::PredicatesImply(predicates,
+                                                index_predicate.get()));
+  predicates = Predicates(
+      {Compare(ExpressionType::COMPARE_EQUAL, 1, 3),
+       new expression::ComparisonExpression(
+           ExpressionType::COMPARE_GREATERTHAN,
+           new expression::ConstantValueExpression(
+               type::ValueFactory::GetIntegerValue(10)),
+           Column(0))});
+  EXPECT_TRUE(optimizer::util::PredicatesImply(predicates,
+                                               index_predicate.get()));
+
+  // Tighter ranges imply looser ones
+  predicates = Predicates(
+      {Compare(ExpressionType::COMPARE_LESSTHANOREQUALTO, 0, 9),
+       Compare(ExpressionType::COMPARE_EQUAL, 1, 3)});
+  EXPECT_TRUE(optimizer::util::PredicatesImply(predicates,
+                                               index_predicate.get()));
+  predicates = Predicates(
+      {Compare(ExpressionType::COMPARE_EQUAL, 0, 4),
+       Compare(ExpressionType::COMPARE_EQUAL, 1, 3)});
+  EXPECT_TRUE(optimizer::util::PredicatesImply(predicates,
+                                               index_predicate.get()));
+  predicates = Predicates(
+      {Compare(ExpressionType::COMPARE_LESSTHANOREQUALTO, 0, 10),
+       Compare(ExpressionType::COMPARE_EQUAL, 1, 3)});
+  EXPECT_FALSE(optimizer::util::PredicatesImply(predicates,
+                                                index_predicate.get()));
+
+  // Every conjunct of the index predicate has to be implied
+  predicates = Predicates({Compare(ExpressionType::COMPARE_LESSTHAN, 0, 5)});
+  EXPECT_FALSE(optimizer::util::PredicatesImply(predicates,
+                                                index_predicate.get()));
+
+  // Predicates on another column say nothing about this one
+  predicates = Predicates(
+      {Compare(ExpressionType::COMPARE_LESSTHAN, 2, 5),
+       Compare(ExpressionType::COMPARE_EQUAL, 1, 3)});
+  EXPECT_FALSE(optimizer::util::PredicatesImply(predicates,
+                                                index_predicate.get()));
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -17,6 +17,7 @@
 #include "common/harness.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/create_executor.h"
+#include "optimizer/optimizer.h"
 #include "planner/create_plan.h"
 
 namespace peloton {
@@ -99,6 +100,49 @@ TEST_F(IndexScanSQLTests, CreateIndexAfterInsertOnMultipleColumnsTest) {
   catalog::Catalog::GetInstance()->DropDatabaseWithName(txn, DEFAULT_DB_NAME);
   txn_manager.CommitTransaction(txn);
 }
+TEST_F(IndexScanSQLTests, HashIndexTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+
+  CreateAndLoadTable();
+  TestingSQLUtil::ExecuteSQLQuery("CREATE INDEX i1 ON test USING HASH (a);");
+
+  // Only a lookup of the full key is answered by the hash index
+  std::unique_ptr<optimizer::AbstractOptimizer> optimizer(
+      new optimizer::Optimizer());
+  auto get_scan_type = [&](const std::string &query) {
+    auto plan_txn = txn_manager.BeginTransaction();
+    auto plan =
+        TestingSQLUtil::GeneratePlanWithOptimizer(optimizer, query, plan_txn);
+    txn_manager.CommitTransaction(plan_txn);
+    const planner::AbstractPlan *scan = plan.get();
+    while (scan->GetChildrenSize() > 0) {
+      scan = scan->GetChild(0);
+    }
+    return scan->GetPlanNodeType();
+  };
+  EXPECT_EQ(PlanNodeType::INDEXSCAN,
+            get_scan_type("SELECT b FROM test WHERE a = 2;"));
+  EXPECT_EQ(PlanNodeType::SEQSCAN,
+            get_scan_type("SELECT b FROM test WHERE a < 3;"));
+
+  TestingSQLUtil::ExecuteSQLQueryAndCheckResult(
+      "SELECT b FROM test WHERE a = 2;", {"33"});
+
+  // The hash index can't provide the order
+  TestingSQLUtil::ExecuteSQLQueryAndCheckResult(
+      "SELECT b FROM test WHERE a < 3 ORDER BY a;", {"22", "33"}, true);
+  TestingSQLUtil::ExecuteSQLQueryAndCheckResult(
+      "SELECT b FROM test ORDER BY a;", {"22", "33", "11"}, true);
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+}
+
 TEST_F(IndexScanSQLTests, SQLTest) {
   LOG_INFO("Bootstrapping...");
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
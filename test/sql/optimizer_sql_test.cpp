@@ -18,6 +18,7 @@
 #include "executor/create_executor.h"
 #include "optimizer/optimizer.h"
 #include "planner/create_plan.h"
+#include "planner/index_scan_plan.h"
 #include "planner/order_by_plan.h"
 #include "sql/testing_sql_util.h"
 
@@ -245,6 +246,38 @@ TEST_F(OptimizerSQLTests, SelectLimitTest) {
            true);
 }
 
+TEST_F(OptimizerSQLTests, IndexScanLimitTest) {
+  // The limit is pushed into the index scan below the order by
+  auto query = "SELECT a FROM test WHERE a < 4 ORDER BY a DESC LIMIT 2";
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  auto plan = TestingSQLUtil::GeneratePlanWithOptimizer(optimizer, query, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto plan_ptr = plan.get();
+  while (plan_ptr->GetPlanNodeType() != PlanNodeType::INDEXSCAN) {
+    ASSERT_EQ(1, plan_ptr->GetChildren().size());
+    plan_ptr = plan_ptr->GetChildren()[0].get();
+  }
+  auto index_scan_plan = static_cast<planner::IndexScanPlan *>(plan_ptr);
+  EXPECT_TRUE(index_scan_plan->GetLimit());
+  EXPECT_EQ(2, index_scan_plan->GetLimitNumber());
+  EXPECT_TRUE(index_scan_plan->GetDescend());
+
+  // The open bound drops the first entry the backward scan finds
+  TestUtil(query, {"3", "2"}, true);
+
+  // The offset and limit only count the tuples that pass the predicate
+  TestUtil("SELECT a FROM test WHERE a > 1 AND c > 100 ORDER BY a LIMIT 1 "
+           "OFFSET 1",
+           {"4"}, true);
+
+  // Deleted tuples are not counted either
+  TestingSQLUtil::ExecuteSQLQuery("DELETE FROM test WHERE a = 2;");
+  TestUtil("SELECT a FROM test WHERE a >= 1 ORDER BY a LIMIT 2", {"1", "3"},
+           true);
+}
+
 TEST_F(OptimizerSQLTests, SelectProjectionTest) {
   // Test complex expression projection
   TestUtil("SELECT a * 5 + b, -1 + c from test",
@@ -0,0 +1,227 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bitmap_index_test.cpp
+//
+// Identification: test/storage/bitmap_index_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/bitmap_index.h"
+
+#include "common/harness.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "expression/expression_util.h"
+#include "expression/parameter_value_expression.h"
+#include "settings/settings_manager.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+class BitmapIndexTests : public PelotonTest {};
+
+namespace {
+
+const int kTuplesPerTileGroup = 10;
+
+// Two full tile groups. Column 0 is 0 in the first one and 10 in the second
+// one, the other columns are unique.
+storage::DataTable *CreateTestTable() {
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(kTuplesPerTileGroup, false, 1));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(data_table.get(), 2 * kTuplesPerTileGroup,
+                                     false, false, true, txn);
+  txn_manager.CommitTransaction(txn);
+  return data_table.release();
+}
+
+expression::AbstractExpression *CreateEquality(oid_t col_id, int value) {
+  return expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_EQUAL,
+      expression::ExpressionUtil::TupleValueFactory(type::TypeId::INTEGER, 0,
+                                                    col_id),
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetIntegerValue(value)));
+}
+
+expression::AbstractExpression *CreateConjunction(
+    ExpressionType type, expression::AbstractExpression *left,
+    expression::AbstractExpression *right) {
+  return expression::ExpressionUtil::ConjunctionFactory(type, left, right);
+}
+
+}  // namespace
+
+TEST_F(BitmapIndexTests, PredicateTest) {
+  // a = 0 AND (b = 1 OR b = 11) AND c > 2
+  std::unique_ptr<expression::AbstractExpression> predicate{CreateConjunction(
+      ExpressionType::CONJUNCTION_AND,
+      CreateConjunction(ExpressionType::CONJUNCTION_AND, CreateEquality(0, 0),
+                        CreateConjunction(ExpressionType::CONJUNCTION_OR,
+                                          CreateEquality(1, 1),
+                                          CreateEquality(1, 11))),
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_GREATERTHAN,
+          expression::ExpressionUtil::TupleValueFactory(type::TypeId::INTEGER,
+                                                        0, 2),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(2))))};
+
+  storage::BitmapPredicate bitmap_predicate;
+  EXPECT_TRUE(bitmap_predicate.AddPredicate(predicate.get()));
+
+  const auto &terms = bitmap_predicate.GetTerms();
+  ASSERT_EQ(2, terms.size());
+  EXPECT_EQ(0, terms[0].col_id);
+  EXPECT_EQ(1, terms[0].values.size());
+  EXPECT_EQ(1, terms[1].col_id);
+  EXPECT_EQ(2, terms[1].values.size());
+
+  // A disjunction across columns can't be answered by the bitmaps
+  std::unique_ptr<expression::AbstractExpression> disjunction{
+      CreateConjunction(ExpressionType::CONJUNCTION_OR, CreateEquality(0, 0),
+                        CreateEquality(1, 1))};
+  storage::BitmapPredicate other_predicate;
+  EXPECT_FALSE(other_predicate.AddPredicate(disjunction.get()));
+  EXPECT_TRUE(other_predicate.IsEmpty());
+
+  // b = $0 AND a = 0. Both terms are collected, but only the constant one can
+  // be added before the parameter's value is known.
+  std::unique_ptr<expression::AbstractExpression> parameterized{
+      CreateConjunction(
+          ExpressionType::CONJUNCTION_AND,
+          expression::ExpressionUtil::ComparisonFactory(
+              ExpressionType::COMPARE_EQUAL,
+              expression::ExpressionUtil::TupleValueFactory(
+                  type::TypeId::INTEGER, 0, 1),
+              new expression::ParameterValueExpression(0)),
+          CreateEquality(0, 0))};
+  std::vector<storage::BitmapPredicate::TermExpression> term_exprs;
+  EXPECT_TRUE(storage::BitmapPredicate::CollectTerms(parameterized.get(),
+                                                     term_exprs));
+  ASSERT_EQ(2, term_exprs.size());
+  EXPECT_EQ(1, term_exprs[0].col_id);
+  ASSERT_EQ(1, term_exprs[0].values.size());
+  EXPECT_EQ(ExpressionType::VALUE_PARAMETER,
+            term_exprs[0].values[0]->GetExpressionType());
+
+  storage::BitmapPredicate constant_predicate;
+  EXPECT_TRUE(constant_predicate.AddPredicate(parameterized.get()));
+  ASSERT_EQ(1, constant_predicate.GetTerms().size());
+  EXPECT_EQ(0, constant_predicate.GetTerms()[0].col_id);
+}
+
+TEST_F(BitmapIndexTests, BuildTest) {
+  std::unique_ptr<storage::DataTable> data_table(CreateTestTable());
+  auto tile_group = data_table->GetTileGroup(0);
+
+  // Only the first column has few enough distinct values
+  auto index = storage::BitmapIndex::Build(*tile_group, 4);
+  ASSERT_NE(nullptr, index);
+  EXPECT_EQ(kTuplesPerTileGroup, index->GetTupleCount());
+  EXPECT_TRUE(index->HasColumn(0));
+  EXPECT_EQ(1, index->GetCardinality(0));
+  for (oid_t col_id = 1; col_id < 4; col_id++) {
+    EXPECT_FALSE(index->HasColumn(col_id));
+  }
+
+  // With a higher limit every column is indexed
+  index = storage::BitmapIndex::Build(*tile_group, kTuplesPerTileGroup);
+  ASSERT_NE(nullptr, index);
+  for (oid_t col_id = 1; col_id < 4; col_id++) {
+    EXPECT_EQ(kTuplesPerTileGroup, index->GetCardinality(col_id));
+  }
+  EXPECT_GT(index->GetMemoryFootprint(), 0);
+
+  // Nothing qualifies
+  EXPECT_EQ(nullptr, storage::BitmapIndex::Build(*tile_group, 0));
+}
+
+TEST_F(BitmapIndexTests, SelectTest) {
+  std::unique_ptr<storage::DataTable> data_table(CreateTestTable());
+  auto tile_group = data_table->GetTileGroup(0);
+  auto index = storage::BitmapIndex::Build(*tile_group, kTuplesPerTileGroup);
+  ASSERT_NE(nullptr, index);
+
+  uint32_t sel[kTuplesPerTileGroup + 4];
+  uint32_t num_selected = 0;
+
+  // b = 11 OR b = 31 OR b = 1000, i.e. the tuples in slots 1 and 3
+  std::unique_ptr<expression::AbstractExpression> in_list{CreateConjunction(
+      ExpressionType::CONJUNCTION_OR,
+      CreateConjunction(ExpressionType::CONJUNCTION_OR, CreateEquality(1, 11),
+                        CreateEquality(1, 31)),
+      CreateEquality(1, 1000))};
+  storage::BitmapPredicate predicate;
+  predicate.AddPredicate(in_list.get());
+  ASSERT_TRUE(index->Select(predicate, 0, kTuplesPerTileGroup, sel,
+                            num_selected));
+  ASSERT_EQ(2, num_selected);
+  EXPECT_EQ(1, sel[0]);
+  EXPECT_EQ(3, sel[1]);
+
+  // Restricting the range drops the first match
+  ASSERT_TRUE(index->Select(predicate, 2, kTuplesPerTileGroup, sel,
+                            num_selected));
+  ASSERT_EQ(1, num_selected);
+  EXPECT_EQ(3, sel[0]);
+
+  // AND-ing with a value that doesn't occur leaves nothing
+  std::unique_ptr<expression::AbstractExpression> empty{
+      CreateConjunction(ExpressionType::CONJUNCTION_AND, CreateEquality(0, 10),
+                        CreateEquality(1, 11))};
+  storage::BitmapPredicate empty_predicate;
+  empty_predicate.AddPredicate(empty.get());
+  ASSERT_TRUE(index->Select(empty_predicate, 0, kTuplesPerTileGroup, sel,
+                            num_selected));
+  EXPECT_EQ(0, num_selected);
+
+  // Slots beyond the indexed range are always candidates
+  ASSERT_TRUE(index->Select(predicate, 0, kTuplesPerTileGroup + 2, sel,
+                            num_selected));
+  ASSERT_EQ(4, num_selected);
+  EXPECT_EQ(kTuplesPerTileGroup, sel[2]);
+  EXPECT_EQ(kTuplesPerTileGroup + 1, sel[3]);
+
+  // A predicate on a column without bitmaps can't be answered
+  auto small_index = storage::BitmapIndex::Build(*tile_group, 1);
+  ASSERT_NE(nullptr, small_index);
+  EXPECT_FALSE(small_index->Select(predicate, 0, kTuplesPerTileGroup, sel,
+                                   num_selected));
+}
+
+TEST_F(BitmapIndexTests, ImmutabilityTest) {
+  auto old_max_cardinality = settings::SettingsManager::GetInt(
+      settings::SettingId::bitmap_index_max_cardinality);
+  settings::SettingsManager::SetInt(
+      settings::SettingId::bitmap_index_max_cardinality, 4);
+
+  std::unique_ptr<storage::DataTable> data_table(CreateTestTable());
+  auto tile_group = data_table->GetTileGroup(0);
+  EXPECT_EQ(nullptr, tile_group->GetBitmapIndex());
+
+  // Freezing the tile group builds its bitmaps, thawing it drops them
+  EXPECT_TRUE(tile_group->SetImmutability());
+  auto index = tile_group->GetBitmapIndex();
+  ASSERT_NE(nullptr, index);
+  EXPECT_TRUE(index->HasColumn(0));
+
+  EXPECT_TRUE(tile_group->ResetImmutability());
+  EXPECT_EQ(nullptr, tile_group->GetBitmapIndex());
+
+  settings::SettingsManager::SetInt(
+      settings::SettingId::bitmap_index_max_cardinality, old_max_cardinality);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -15,6 +15,8 @@
 #include "storage/data_table.h"
 
 #include "executor/testing_executor_util.h"
+#include "index/index.h"
+#include "statistics/memory_metric.h"
 #include "storage/tile_group.h"
 #include "storage/database.h"
 
@@ -87,5 +89,75 @@ TEST_F(DataTableTests, GlobalTableTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(DataTableTests, MemoryFootprintTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, true));
+
+  stats::MemoryMetric empty_memory{MetricType::MEMORY};
+  data_table->GetMemoryFootprint(empty_memory);
+  EXPECT_GT(empty_memory.GetTileBytes(), 0);
+  EXPECT_GT(empty_memory.GetHeaderBytes(), 0);
+  EXPECT_GT(empty_memory.GetIndirectionBytes(), 0);
+  EXPECT_EQ(0, empty_memory.GetVersionBytes());
+
+  auto index = data_table->GetIndex(0);
+  auto empty_index_bytes = index->GetMemoryFootprint();
+
+  // Fill up several tile groups
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count * 5, false,
+                                     false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  stats::MemoryMetric memory{MetricType::MEMORY};
+  data_table->GetMemoryFootprint(memory);
+  EXPECT_GT(memory.GetTileBytes(), empty_memory.GetTileBytes());
+  EXPECT_GT(memory.GetHeaderBytes(), empty_memory.GetHeaderBytes());
+  EXPECT_GE(memory.GetIndirectionBytes(), empty_memory.GetIndirectionBytes());
+  EXPECT_GT(memory.GetTotalBytes(), empty_memory.GetTotalBytes());
+
+  EXPECT_GT(index->GetMemoryFootprint(), empty_index_bytes);
+}
+
+TEST_F(DataTableTests, IndirectionRecycleTest) {
+  storage::IndirectionArray indirection_array(INVALID_OID);
+
+  // Hand out every fresh indirection
+  std::vector<ItemPointer *> indirections;
+  for (size_t i = 0; i < storage::INDIRECTION_ARRAY_MAX_SIZE; i++) {
+    auto offset = indirection_array.AllocateIndirection();
+    ASSERT_EQ(i, offset);
+    indirections.push_back(indirection_array.GetIndirectionByOffset(offset));
+  }
+  EXPECT_EQ(storage::INVALID_INDIRECTION_OFFSET,
+            indirection_array.AllocateIndirection());
+
+  // Indirections returned while the array is active are handed out again
+  EXPECT_FALSE(indirection_array.FreeIndirection(indirections[7]));
+  EXPECT_EQ(7u, indirection_array.AllocateIndirection());
+  EXPECT_EQ(storage::INVALID_INDIRECTION_OFFSET,
+            indirection_array.AllocateIndirection());
+
+  // Indirections returned before the array is retired aren't handed out once
+  // it is
+  EXPECT_FALSE(indirection_array.FreeIndirection(indirections[3]));
+  EXPECT_FALSE(indirection_array.Retire());
+  EXPECT_EQ(storage::INVALID_INDIRECTION_OFFSET,
+            indirection_array.AllocateIndirection());
+
+  // Once retired, the array reports when its last indirection is returned
+  for (size_t i = 0; i < indirections.size() - 1; i++) {
+    if (i != 3) {
+      EXPECT_FALSE(indirection_array.FreeIndirection(indirections[i]));
+    }
+  }
+  EXPECT_EQ(storage::INVALID_INDIRECTION_OFFSET,
+            indirection_array.AllocateIndirection());
+  EXPECT_TRUE(indirection_array.FreeIndirection(indirections.back()));
+}
+
 }  // namespace test
 }  // namespace peloton
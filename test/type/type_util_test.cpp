@@ -16,6 +16,7 @@
 #include "storage/tuple.h"
 #include "type/type_util.h"
 #include "type/value_factory.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace test {
@@ -239,5 +240,68 @@ TEST_F(TypeUtilTests, CompareStringsTest) {
   } // FOR (str1)
 }
 
+TEST_F(TypeUtilTests, VarlenSlotTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  type::Type varchar_type(type::TypeId::VARCHAR);
+
+  // Strings on both sides of the inline threshold, sharing prefixes
+  std::vector<std::string> strs = {"",
+                                   "a",
+                                   "abc",
+                                   "abcd",
+                                   "abcde",
+                                   "abcdefghij",
+                                   "abcdefghijk",
+                                   "abcdefghijkl",
+                                   "abcdefghijklmnop",
+                                   "abcdefghijklmnoq",
+                                   "abce",
+                                   "zzzzzzzzzzzzzzzzzzzz"};
+  std::vector<std::vector<char>> slots;
+  for (const auto &str : strs) {
+    auto val = type::ValueFactory::GetVarcharValue(str);
+    std::vector<char> slot(sizeof(type::VarlenSlot));
+    val.SerializeTo(slot.data(), false, pool);
+
+    // Only long values spill into the pool
+    char *out_of_line = type::Value::GetDataFromStorage(type::TypeId::VARCHAR,
+                                                        slot.data());
+    EXPECT_EQ(val.GetLength() > type::VarlenSlot::kInlineSize,
+              out_of_line != nullptr);
+
+    // The value must survive the round trip
+    auto copy = type::Value::DeserializeFrom(slot.data(),
+                                             type::TypeId::VARCHAR, false);
+    EXPECT_EQ(CmpBool::CmpTrue, val.CompareEquals(copy));
+    EXPECT_EQ(str, copy.ToString());
+    slots.push_back(std::move(slot));
+  }
+
+  // Raw comparisons on the slots must agree with comparisons on the values
+  for (size_t i = 0; i < strs.size(); i++) {
+    for (size_t j = 0; j < strs.size(); j++) {
+      auto left = type::ValueFactory::GetVarcharValue(strs[i]);
+      auto right = type::ValueFactory::GetVarcharValue(strs[j]);
+      const char *l = slots[i].data(), *r = slots[j].data();
+      EXPECT_EQ(left.CompareEquals(right),
+                type::TypeUtil::CompareEqualsRaw(varchar_type, l, r, false));
+      EXPECT_EQ(left.CompareLessThan(right),
+                type::TypeUtil::CompareLessThanRaw(varchar_type, l, r, false));
+      EXPECT_EQ(
+          left.CompareGreaterThan(right),
+          type::TypeUtil::CompareGreaterThanRaw(varchar_type, l, r, false));
+    }
+  }
+
+  // NULL is stored as an all-zero slot
+  std::vector<char> null_slot(sizeof(type::VarlenSlot), 1);
+  type::ValueFactory::GetNullValueByType(type::TypeId::VARCHAR)
+      .SerializeTo(null_slot.data(), false, pool);
+  EXPECT_TRUE(type::VarlenSlot::IsNull(null_slot.data()));
+  EXPECT_TRUE(
+      type::Value::DeserializeFrom(null_slot.data(), type::TypeId::VARCHAR,
+                                   false).IsNull());
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -100,6 +100,15 @@ void LeafNode::deleteLeaf(Node *n) {
   }
 }
 
+uint64_t LeafNode::getMemoryUsage(const Node *n) {
+  // Inlined TIDs live in the parent's child pointer
+  if (isExternal(n)) {
+    auto *leaf = getExternal(n);
+    return sizeof(LeafNode) + (sizeof(TID) * leaf->capacity);
+  }
+  return 0;
+}
+
 //===----------------------------------------------------------------------===//
 //
 // LEAF ACCESS
@@ -151,6 +151,9 @@ class Node {
                               std::tuple<uint8_t, Node *> children[],
                               uint32_t &childrenCount, bool &needRestart);
 
+  // Get the number of bytes held by the provided node and all its children
+  static uint64_t getMemoryUsage(const Node *node);
+
   //===--------------------------------------------------------------------===//
   // LEAF MANIPULATION
   //===--------------------------------------------------------------------===//
@@ -398,6 +401,8 @@ class LeafNode {
 
   static void deleteLeaf(Node *n);
 
+  static uint64_t getMemoryUsage(const Node *n);
+
   static TID getLeaf(const Node *n);
   static void readLeaf(const Node *n, std::vector<TID> &results,
                        bool &needRestart);
@@ -303,6 +303,51 @@ uint64_t Node::getChildren(const Node *node, uint8_t start, uint8_t end,
   __builtin_unreachable();
 }
 
+uint64_t Node::getMemoryUsage(const Node *node) {
+  if (Node::isLeaf(node)) {
+    return LeafNode::getMemoryUsage(node);
+  }
+
+  uint64_t size = 0;
+  switch (node->getType()) {
+    case NodeType::N4: {
+      size = sizeof(Node4);
+      break;
+    }
+    case NodeType::N16: {
+      size = sizeof(Node16);
+      break;
+    }
+    case NodeType::N48: {
+      size = sizeof(Node48);
+      break;
+    }
+    case NodeType::N256: {
+      size = sizeof(Node256);
+      break;
+    }
+  }
+
+  // Read the children optimistically. A node that keeps changing (or has
+  // become obsolete) under us is counted without its subtree; the result is
+  // only an estimate anyway.
+  std::tuple<uint8_t, Node *> children[256];
+  uint32_t childrenCount = 0;
+  bool needRestart = true;
+  for (int attempt = 0; needRestart && attempt < 4; attempt++) {
+    needRestart = false;
+    Node::getChildren(node, 0, 255, children, childrenCount, needRestart);
+  }
+  if (needRestart) {
+    return size;
+  }
+
+  for (uint32_t i = 0; i < childrenCount; i++) {
+    size += Node::getMemoryUsage(std::get<1>(children[i]));
+  }
+  return size;
+}
+
 //===----------------------------------------------------------------------===//
 //
 // LEAF MANIPULATION
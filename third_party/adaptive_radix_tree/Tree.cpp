@@ -18,6 +18,36 @@ Tree::~Tree() {
 
 ThreadInfo Tree::getThreadInfo() { return ThreadInfo(epoch); }
 
+uint64_t Tree::getMemoryUsage(ThreadInfo &threadEpochInfo) const {
+  EpochGuardReadonly epochGuard(threadEpochInfo);
+  return Node::getMemoryUsage(root);
+}
+
+namespace {
+
+// Compare two keys in lexicographic byte order, a proper prefix being smaller
+int compareKeys(const Key &a, const Key &b) {
+  uint32_t len = std::min(a.getKeyLen(), b.getKeyLen());
+  int cmp = len == 0 ? 0 : std::memcmp(&a[0], &b[0], len);
+  if (cmp != 0) {
+    return cmp;
+  }
+  if (a.getKeyLen() == b.getKeyLen()) {
+    return 0;
+  }
+  return a.getKeyLen() < b.getKeyLen() ? -1 : 1;
+}
+
+}  // namespace
+
+bool Tree::leafInRange(const Node *leaf, const Key *start,
+                       const Key *end) const {
+  Key leafKey;
+  keyLoader.load(Node::getLeaf(leaf), leafKey);
+  return (start == nullptr || compareKeys(leafKey, *start) >= 0) &&
+         (end == nullptr || compareKeys(leafKey, *end) <= 0);
+}
+
 void yield(int count) {
   if (count > 3) {
     sched_yield();
@@ -104,6 +134,139 @@ restart:
   }
 }
 
+void Tree::lookupBatch(const Key *keys, uint32_t numKeys,
+                       std::vector<TID> *results,
+                       ThreadInfo &threadEpochInfo) const {
+  // The state of one traversal in the group. 'node' is the node to visit in
+  // the next round and has been prefetched, 'parentNode' is read-locked
+  // with version 'v' unless we are at the root.
+  struct Traversal {
+    Node *node;
+    Node *parentNode;
+    uint64_t v;
+    uint32_t level;
+    bool optimisticPrefixMatch;
+    bool done;
+  };
+  static constexpr uint32_t groupSize = 8;
+
+  EpochGuardReadonly epochGuard(threadEpochInfo);
+
+  Traversal group[groupSize];
+  for (uint32_t groupStart = 0; groupStart < numKeys; groupStart += groupSize) {
+    uint32_t count = std::min(groupSize, numKeys - groupStart);
+    uint32_t remaining = count;
+
+    auto restart = [this](Traversal &t) {
+      t.node = root;
+      t.parentNode = nullptr;
+      t.v = 0;
+      t.level = 0;
+      t.optimisticPrefixMatch = false;
+    };
+    auto finish = [&remaining](Traversal &t) {
+      t.done = true;
+      remaining--;
+    };
+
+    for (uint32_t i = 0; i < count; i++) {
+      restart(group[i]);
+      group[i].done = false;
+    }
+
+    // Every round moves each unfinished traversal down by one node
+    while (remaining > 0) {
+      for (uint32_t i = 0; i < count; i++) {
+        Traversal &t = group[i];
+        if (t.done) {
+          continue;
+        }
+        const Key &k = keys[groupStart + i];
+        std::vector<TID> &result = results[groupStart + i];
+        bool needRestart = false;
+
+        // Lock the node we prefetched in the last round, then release its
+        // parent
+        uint64_t nv = t.node->readLockOrRestart(needRestart);
+        if (needRestart) {
+          restart(t);
+          continue;
+        }
+        if (t.parentNode != nullptr) {
+          t.parentNode->readUnlockOrRestart(t.v, needRestart);
+          if (needRestart) {
+            restart(t);
+            continue;
+          }
+        }
+        t.v = nv;
+
+        switch (checkPrefix(t.node, k, t.level)) {  // Increases level
+          case CheckPrefixResult::NoMatch:
+            t.node->readUnlockOrRestart(t.v, needRestart);
+            if (needRestart) {
+              restart(t);
+            } else {
+              finish(t);
+            }
+            continue;
+          case CheckPrefixResult::OptimisticMatch:
+            t.optimisticPrefixMatch = true;
+          // Fallthrough
+          case CheckPrefixResult::Match:
+            break;
+        }
+
+        if (k.getKeyLen() <= t.level) {
+          finish(t);
+          continue;
+        }
+
+        t.parentNode = t.node;
+        t.node = Node::getChild(k[t.level], t.parentNode);
+        t.parentNode->checkOrRestart(t.v, needRestart);
+        if (needRestart) {
+          restart(t);
+          continue;
+        }
+
+        if (t.node == nullptr) {
+          // Not found
+          finish(t);
+          continue;
+        }
+
+        if (Node::isLeaf(t.node)) {
+          t.parentNode->readUnlockOrRestart(t.v, needRestart);
+          if (needRestart) {
+            restart(t);
+            continue;
+          }
+
+          size_t resultStart = result.size();
+          LeafNode::readLeaf(t.node, result, needRestart);
+          if (needRestart) {
+            restart(t);
+            continue;
+          }
+
+          if ((t.level < k.getKeyLen() - 1 || t.optimisticPrefixMatch) &&
+              result.size() > resultStart &&
+              checkKey(result[resultStart], k) == 0) {
+            // Optimistic prefix match failed
+            result.resize(resultStart);
+          }
+          finish(t);
+          continue;
+        }
+
+        t.level++;
+        __builtin_prefetch(t.node);
+      }
+    }
+  }
+}
+
 bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
                        std::vector<TID> &results, uint32_t softMaxResults,
                        ThreadInfo &threadEpochInfo) const {
@@ -153,7 +316,9 @@ bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
           Node *node, uint8_t nodeK, uint32_t level, const Node *parentNode,
           uint64_t vp, bool &needRestart) {
         if (Node::isLeaf(node)) {
-          copy(node, needRestart);
+          if (leafInRange(node, &start, nullptr)) {
+            copy(node, needRestart);
+          }
           return;
         }
         uint64_t v;
@@ -193,7 +358,9 @@ bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
               return;
             }
             if (Node::isLeaf(node)) {
-              copy(node, needRestart);
+              if (leafInRange(node, &start, nullptr)) {
+                copy(node, needRestart);
+              }
               return;
             }
             goto parentRereadSuccess;
@@ -239,7 +406,9 @@ bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
           Node *node, uint8_t nodeK, uint32_t level, const Node *parentNode,
           uint64_t vp, bool &needRestart) {
         if (Node::isLeaf(node)) {
-          copy(node, needRestart);
+          if (leafInRange(node, nullptr, &end)) {
+            copy(node, needRestart);
+          }
           return;
         }
         uint64_t v;
@@ -272,6 +441,9 @@ bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
               return;
             }
             if (Node::isLeaf(node)) {
+              if (leafInRange(node, nullptr, &end)) {
+                copy(node, needRestart);
+              }
               return;
             }
             goto parentRereadSuccess;
@@ -390,8 +562,10 @@ restart:
           }
 
           if (Node::isLeaf(nextNode)) {
-            // Copy single leaf node
-            copy(nextNode, needRestart);
+            // Copy single leaf node, if its key is within the range
+            if (leafInRange(nextNode, &start, &end)) {
+              copy(nextNode, needRestart);
+            }
             if (needRestart) goto restart;
             return false;
           }
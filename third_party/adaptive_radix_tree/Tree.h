@@ -30,6 +30,13 @@ class Tree {
   bool lookup(const Key &k, std::vector<TID> &results,
               ThreadInfo &threadEpochInfo) const;
 
+  /// Lookup the TIDs of several keys at once, placing the TIDs of keys[i] in
+  /// results[i]. The traversals of the keys are interleaved so that their
+  /// cache misses overlap.
+  void lookupBatch(const Key *keys, uint32_t numKeys,
+                   std::vector<TID> *results,
+                   ThreadInfo &threadEpochInfo) const;
+
   /// Looks up all key-value pairs between the provided start and end keys.
   /// Results are placed in the provided result vector (of the provided size).
   /// The actual number of results that were inserted is in the output parameter
@@ -53,6 +60,10 @@ class Tree {
 
   void setLoadKeyFunc(LoadKeyFunction loadKey, void *ctx);
 
+  /// Return the approximate number of bytes held by the nodes and external
+  /// leaves of the tree
+  uint64_t getMemoryUsage(ThreadInfo &threadEpochInfo) const;
+
  private:
   // Class to help loading the key for a given TID
   class KeyLoader {
@@ -79,6 +90,12 @@ class Tree {
   /// done by loading the key and performing a comparison with the provided key.
   TID checkKey(TID tid, const Key &k) const;
 
+  /// Leaves may sit above the level at which their key last branches, so a
+  /// leaf reached along the path of a range bound is not necessarily within
+  /// the range. This loads the key of the leaf and checks it against the
+  /// provided bounds, either of which may be null.
+  bool leafInRange(const Node *leaf, const Key *start, const Key *end) const;
+
   /// Optimistic prefix check
   enum class CheckPrefixResult : uint8_t { Match, NoMatch, OptimisticMatch };
   static CheckPrefixResult checkPrefix(Node *n, const Key &k, uint32_t &level);